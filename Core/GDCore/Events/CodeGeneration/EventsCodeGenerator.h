@@ -313,7 +313,7 @@ protected:
      * <br><br>
      * Other standard parameters type that should be implemented by platforms:
      * - currentScene: Reference to the current runtime scene.
-     * - objectList : a map containing lists of objects which are specified by the object name in another parameter. (C++: std::map <gd::String, std::vector<RuntimeObject*> *>). Example:
+     * - objectList : a map containing lists of objects which are specified by the object name in another parameter. (C++: ObjectsListsView). Example:
      * \code
         AddExpression("Count", _("Object count"), _("Count the number of picked objects"), _("Objects"), "res/conditions/nbObjet.png")
         .AddParameter("objectList", _("Object"))
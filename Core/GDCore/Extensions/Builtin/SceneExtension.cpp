@@ -69,6 +69,17 @@ void GD_CORE_API BuiltinExtensionsImplementer::ImplementsSceneExtension(gd::Plat
         .AddCodeOnlyParameter("currentScene", "")
         .MarkAsAdvanced();
 
+    extension.AddAction("PrefetchScene",
+                   _("Preload a scene"),
+                   _("Start loading the images of the specified scene in background, so that starting this scene later is faster."),
+                   _("Preload the scene _PARAM1_"),
+                   _("Scene"),
+                   "res/actions/pushScene24.png",
+                   "res/actions/pushScene.png")
+        .AddCodeOnlyParameter("currentScene", "")
+        .AddParameter("string", _("Name of the scene"))
+        .MarkAsAdvanced();
+
     extension.AddAction("Quit",
                    _("Quit the game"),
                    _("Quit the game"),
@@ -19,6 +19,7 @@ Point Sprite::badPoint("");
 Sprite::Sprite() :
 #if !defined(EMSCRIPTEN)
     hasItsOwnImage(false),
+    displayedTextureVersion(0),
 #endif
     automaticCollisionMask(true),
     origine("origine"),
@@ -131,7 +132,9 @@ void Sprite::SetCustomCollisionMask(const std::vector<Polygon2d> & collisionMask
 void Sprite::LoadImage(std::shared_ptr<SFMLTextureWrapper> image_)
 {
     sfmlImage = image_;
-    sfmlSprite.setTexture(sfmlImage->texture, true);
+    sfmlSprite.setTexture(sfmlImage->GetDisplayedTexture(), true);
+    sfmlSprite.setTextureRect(sfmlImage->GetDisplayedTextureRect());
+    displayedTextureVersion = sfmlImage->GetDisplayedTextureVersion();
     hasItsOwnImage = false;
 
     if ( automaticCentre )
@@ -142,11 +145,36 @@ void Sprite::MakeSpriteOwnsItsImage()
 {
     if ( !hasItsOwnImage || sfmlImage == std::shared_ptr<SFMLTextureWrapper>() )
     {
-        sfmlImage = std::shared_ptr<SFMLTextureWrapper>(new SFMLTextureWrapper(sfmlImage->texture)); //Copy the texture.
-        sfmlSprite.setTexture(sfmlImage->texture);
+        if ( sfmlImage->GetAtlas() )
+        {
+            //Create a texture from the pixels of the image, as the atlas is shared with other images.
+            auto texture = std::make_shared<SFMLTextureWrapper>();
+            texture->image = sfmlImage->image;
+            texture->texture.loadFromImage(texture->image);
+            texture->texture.setSmooth(sfmlImage->GetAtlas()->texture.isSmooth());
+            sfmlImage = texture;
+        }
+        else
+            sfmlImage = std::shared_ptr<SFMLTextureWrapper>(new SFMLTextureWrapper(sfmlImage->texture)); //Copy the texture.
+
+        sfmlSprite.setTexture(sfmlImage->texture, true);
+        displayedTextureVersion = sfmlImage->GetDisplayedTextureVersion();
         hasItsOwnImage = true;
     }
 }
+
+sf::Sprite & Sprite::GetSFMLSprite()
+{
+    //The image may have been detached from its atlas since it was loaded.
+    if ( sfmlImage && sfmlImage->GetDisplayedTextureVersion() != displayedTextureVersion )
+    {
+        sfmlSprite.setTexture(sfmlImage->GetDisplayedTexture());
+        sfmlSprite.setTextureRect(sfmlImage->GetDisplayedTextureRect());
+        displayedTextureVersion = sfmlImage->GetDisplayedTextureVersion();
+    }
+
+    return sfmlSprite;
+}
 #endif
 
 }
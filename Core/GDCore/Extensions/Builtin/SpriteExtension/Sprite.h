@@ -56,6 +56,12 @@ public:
      */
     std::vector<Polygon2d> GetCollisionMask() const;
 
+    /**
+     * \brief Get the custom collision mask, without copying it.
+     * \note It is only used if IsCollisionMaskAutomatic() returns false.
+     */
+    inline const std::vector<Polygon2d> & GetCustomCollisionMask() const { return customCollisionMask; }
+
     /**
      * \brief Set the custom collision mask.
      * Call then `SetCollisionMaskAutomatic(false)` to use it.
@@ -155,8 +161,11 @@ public:
 
     /**
      * \brief Get the SFML sprite associated with the sprite
+     *
+     * \note The SFML sprite is updated if the texture displaying the image was changed
+     * (see SFMLTextureWrapper::DetachFromAtlas).
      */
-    inline sf::Sprite & GetSFMLSprite() { return sfmlSprite; }
+    sf::Sprite & GetSFMLSprite();
 
     /**
      * \brief Set the SFML texture of the sprite
@@ -187,6 +196,7 @@ private:
     sf::Sprite sfmlSprite; ///< Displayed SFML sprite
     std::shared_ptr<SFMLTextureWrapper> sfmlImage; ///< Pointer to the image displayed by the sprite.
     bool hasItsOwnImage; ///< True if sfmlImage is only owned by this Sprite.
+    unsigned int displayedTextureVersion; ///< The version of the texture of sfmlImage used by sfmlSprite.
     #endif
     gd::String image; ///< Name of the image to be loaded in Image Manager.
 
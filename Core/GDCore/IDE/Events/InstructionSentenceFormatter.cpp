@@ -53,7 +53,7 @@ std::vector< std::pair<gd::String, gd::TextFormatting> > InstructionSentenceForm
     std::vector< std::pair<gd::String, gd::TextFormatting> > formattedStr;
 
     gd::String sentence = metadata.GetSentence();
-    std::replace( sentence.Raw().begin(), sentence.Raw().end(), '\n', ' ');
+    sentence.ModifyRaw([](std::string & raw) { std::replace( raw.begin(), raw.end(), '\n', ' '); });
     bool parse = true;
 
     while ( parse )
@@ -87,7 +87,7 @@ std::vector< std::pair<gd::String, gd::TextFormatting> > InstructionSentenceForm
             format.userData = firstParamIndex;
 
             gd::String text = instr.GetParameter( firstParamIndex ).GetPlainString();
-            std::replace( text.Raw().begin(), text.Raw().end(), '\n', ' '); //Using the raw std::string inside gd::String (no problems because it's only ANSI characters)
+            text.ModifyRaw([](std::string & raw) { std::replace( raw.begin(), raw.end(), '\n', ' '); }); //Using the raw std::string inside gd::String (no problems because it's only ANSI characters)
 
             formattedStr.push_back(std::make_pair(text, format));
             gd::String placeholder = "_PARAM"+gd::String::From(firstParamIndex)+"_";
@@ -0,0 +1,42 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "SceneResourcesFinder.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/IDE/Project/ImagesUsedInventorizer.h"
+
+namespace gd
+{
+
+std::vector<gd::String> SceneResourcesFinder::FindSceneImages(gd::Project & project, gd::Layout & layout)
+{
+    gd::ImagesUsedInventorizer inventorizer;
+    for (std::size_t i = 0;i<layout.GetObjectsCount();++i)
+        layout.GetObject(i).ExposeResources(inventorizer);
+    for (std::size_t i = 0;i<project.GetObjectsCount();++i)
+        project.GetObject(i).ExposeResources(inventorizer);
+    LaunchResourceWorkerOnEvents(project, layout.GetEvents(), inventorizer);
+
+    std::vector<gd::String> images;
+    const std::set<gd::String> & allImages = inventorizer.GetAllUsedImages();
+    for (std::set<gd::String>::const_iterator it = allImages.begin(); it != allImages.end(); ++it)
+    {
+        //Only keep the images really existing in the project.
+        if ( project.GetResourcesManager().HasResource(*it) )
+            images.push_back(*it);
+    }
+
+    return images;
+}
+
+void SceneResourcesFinder::UpdateResourcesManifests(gd::Project & project)
+{
+    for (std::size_t i = 0;i<project.GetLayoutsCount();++i)
+        project.GetLayout(i).SetResourcesManifest(FindSceneImages(project, project.GetLayout(i)));
+}
+
+}
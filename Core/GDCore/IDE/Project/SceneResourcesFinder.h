@@ -0,0 +1,47 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef SCENERESOURCESFINDER_H
+#define SCENERESOURCESFINDER_H
+#include <vector>
+#include "GDCore/String.h"
+namespace gd { class Project; }
+namespace gd { class Layout; }
+
+namespace gd
+{
+
+/**
+ * \brief Find the resources used by a scene, so that they can be loaded in advance by the
+ * game engine.
+ *
+ * \see gd::Layout::GetResourcesManifest
+ * \ingroup IDE
+ */
+class GD_CORE_API SceneResourcesFinder
+{
+public:
+    /**
+     * \brief Return the names of the images used by the objects and the events of the layout,
+     * and by the global objects of the project.
+     *
+     * \param project The project containing the layout.
+     * \param layout The layout to be crawled.
+     *
+     * \return A vector containing the names of the images, sorted.
+     */
+    static std::vector<gd::String> FindSceneImages(gd::Project & project, gd::Layout & layout);
+
+    /**
+     * \brief Update the resources manifest of all the layouts of the project.
+     *
+     * \param project The project to be updated.
+     */
+    static void UpdateResourcesManifests(gd::Project & project);
+};
+
+}
+
+#endif // SCENERESOURCESFINDER_H
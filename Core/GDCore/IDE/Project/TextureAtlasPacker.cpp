@@ -0,0 +1,258 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <set>
+#include <vector>
+#include <SFML/Graphics/Image.hpp>
+#include "GDCore/IDE/Project/ImagesUsedInventorizer.h"
+#include "GDCore/Project/ExternalEvents.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/ResourcesManager.h"
+
+namespace gd
+{
+
+namespace
+{
+
+struct PackedImage
+{
+    gd::ImageResource * resource;
+    sf::Image image;
+    unsigned int x;
+    unsigned int y;
+};
+
+/**
+ * \brief Inventorize the images, and the files (used by events for example).
+ */
+class ImagesAndFilesInventorizer : public gd::ImagesUsedInventorizer
+{
+public:
+    ImagesAndFilesInventorizer() : gd::ImagesUsedInventorizer() {};
+    virtual ~ImagesAndFilesInventorizer() {};
+
+    std::set<gd::String> & GetAllUsedFiles() { return allUsedFiles; };
+
+    virtual void ExposeFile(gd::String & file) { allUsedFiles.insert(file); };
+
+private:
+    std::set<gd::String> allUsedFiles;
+};
+
+/**
+ * \brief Expose the resources of the objects to the sprites inventorizer or to the
+ * inventorizer of the other objects, according to their type.
+ */
+void ExposeObjectsResources(gd::ClassWithObjects & objects, gd::ImagesUsedInventorizer & spritesImages,
+    ImagesAndFilesInventorizer & otherImages)
+{
+    for (std::size_t i = 0;i<objects.GetObjectsCount();++i)
+    {
+        gd::Object & object = objects.GetObject(i);
+        object.ExposeResources(object.GetType() == "Sprite" ? spritesImages : otherImages);
+    }
+}
+
+/**
+ * \brief Return the images which can be packed: used by sprite objects only.
+ * \param otherFiles Filled with the files used by other objects and by events.
+ */
+std::set<gd::String> FindImagesToPack(gd::Project & project, std::set<gd::String> & otherFiles)
+{
+    gd::ImagesUsedInventorizer spritesImages;
+    ImagesAndFilesInventorizer otherImages;
+    ExposeObjectsResources(project, spritesImages, otherImages);
+    for (std::size_t i = 0;i<project.GetLayoutsCount();++i)
+    {
+        ExposeObjectsResources(project.GetLayout(i), spritesImages, otherImages);
+        LaunchResourceWorkerOnEvents(project, project.GetLayout(i).GetEvents(), otherImages);
+    }
+    for (std::size_t i = 0;i<project.GetExternalEventsCount();++i)
+        LaunchResourceWorkerOnEvents(project, project.GetExternalEvents(i).GetEvents(), otherImages);
+
+    std::set<gd::String> imagesToPack;
+    const std::set<gd::String> & allSpritesImages = spritesImages.GetAllUsedImages();
+    for (std::set<gd::String>::const_iterator it = allSpritesImages.begin(); it != allSpritesImages.end(); ++it)
+    {
+        if ( otherImages.GetAllUsedImages().count(*it) == 0 )
+            imagesToPack.insert(*it);
+    }
+
+    otherFiles = otherImages.GetAllUsedFiles();
+    return imagesToPack;
+}
+
+/**
+ * \brief Save an atlas containing the images and update the images so that they are loaded from it.
+ * \return false if the atlas could not be saved.
+ */
+bool CreateAtlas(gd::Project & project, const gd::String & directory, std::vector<PackedImage*> & images, bool smooth)
+{
+    unsigned int width = 0, height = 0;
+    for (std::size_t i = 0;i<images.size();++i)
+    {
+        width = std::max(width, images[i]->x + images[i]->image.getSize().x);
+        height = std::max(height, images[i]->y + images[i]->image.getSize().y);
+    }
+
+    sf::Image atlasImage;
+    atlasImage.create(width, height, sf::Color(0, 0, 0, 0));
+    for (std::size_t i = 0;i<images.size();++i)
+        atlasImage.copy(images[i]->image, images[i]->x, images[i]->y);
+
+    gd::ResourcesManager & resources = project.GetResourcesManager();
+    gd::String name;
+    for (std::size_t i = 0;name.empty() || resources.HasResource(name);++i)
+        name = "GDAtlas" + gd::String::From(i);
+
+    gd::String file = name + ".png";
+    if ( !atlasImage.saveToFile((directory + "/" + file).ToLocale()) )
+    {
+        std::cout << "Unable to save the texture atlas " << file << "." << std::endl;
+        return false;
+    }
+
+    gd::ImageResource atlas;
+    atlas.SetName(name);
+    atlas.SetFile(file);
+    atlas.smooth = smooth;
+    resources.AddResource(atlas);
+
+    for (std::size_t i = 0;i<images.size();++i)
+    {
+        images[i]->resource->SetAtlas(name, images[i]->x, images[i]->y,
+            images[i]->image.getSize().x, images[i]->image.getSize().y);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Pack the images, all having the same smooth filter, in as many atlases as needed.
+ *
+ * The images are sorted by height and put in rows, from top to bottom.
+ * \return The number of images packed.
+ */
+std::size_t PackImagesInAtlases(gd::Project & project, const gd::String & directory, std::vector<PackedImage> & images, bool smooth)
+{
+    std::sort(images.begin(), images.end(), [](const PackedImage & a, const PackedImage & b) {
+        return a.image.getSize().y > b.image.getSize().y ||
+            (a.image.getSize().y == b.image.getSize().y && a.image.getSize().x > b.image.getSize().x);
+    });
+
+    std::size_t packedCount = 0;
+    std::vector<PackedImage*> atlasImages;
+    unsigned int x = 0, y = 0, rowHeight = 0;
+    for (std::size_t i = 0;i<=images.size();++i)
+    {
+        bool atlasFull = false;
+        if ( i < images.size() )
+        {
+            const sf::Vector2u size = images[i].image.getSize();
+            if ( x + size.x > TextureAtlasPacker::atlasSize ) //Start a new row
+            {
+                x = 0;
+                y += rowHeight + TextureAtlasPacker::padding;
+                rowHeight = 0;
+            }
+            atlasFull = y + size.y > TextureAtlasPacker::atlasSize;
+        }
+
+        if ( i == images.size() || atlasFull )
+        {
+            //An atlas with a single image would not improve anything.
+            if ( atlasImages.size() > 1 && CreateAtlas(project, directory, atlasImages, smooth) )
+                packedCount += atlasImages.size();
+
+            atlasImages.clear();
+            x = 0;
+            y = 0;
+            rowHeight = 0;
+            if ( i == images.size() ) break;
+        }
+
+        images[i].x = x;
+        images[i].y = y;
+        atlasImages.push_back(&images[i]);
+        x += images[i].image.getSize().x + TextureAtlasPacker::padding;
+        rowHeight = std::max(rowHeight, images[i].image.getSize().y);
+    }
+
+    return packedCount;
+}
+
+/**
+ * \brief Remove the files of the images packed, which are now loaded from their atlas, unless
+ * the files are used by other resources or in \a otherFiles.
+ */
+void RemovePackedImagesFiles(gd::Project & project, const gd::String & directory, std::set<gd::String> otherFiles)
+{
+    gd::ResourcesManager & resources = project.GetResourcesManager();
+    std::vector<gd::String> resourcesNames = resources.GetAllResourcesList();
+
+    std::set<gd::String> packedFiles;
+    for (std::size_t i = 0;i<resourcesNames.size();++i)
+    {
+        gd::Resource & resource = resources.GetResource(resourcesNames[i]);
+        gd::ImageResource * image = dynamic_cast<gd::ImageResource*>(&resource);
+        if ( image && !image->GetAtlas().empty() )
+            packedFiles.insert(image->GetFile());
+        else if ( resource.UseFile() )
+            otherFiles.insert(resource.GetFile());
+    }
+
+    for (std::set<gd::String>::const_iterator it = packedFiles.begin(); it != packedFiles.end(); ++it)
+    {
+        if ( otherFiles.count(*it) == 0 && std::remove((directory + "/" + *it).ToLocale().c_str()) != 0 )
+            std::cout << "Unable to remove " << *it << ", packed in a texture atlas." << std::endl;
+    }
+}
+
+}
+
+std::size_t TextureAtlasPacker::PackImages(gd::Project & project, const gd::String & directory)
+{
+    std::set<gd::String> otherFiles;
+    std::set<gd::String> imagesToPack = FindImagesToPack(project, otherFiles);
+
+    std::vector<PackedImage> smoothImages;
+    std::vector<PackedImage> notSmoothImages;
+    gd::ResourcesManager & resources = project.GetResourcesManager();
+    for (std::set<gd::String>::const_iterator it = imagesToPack.begin(); it != imagesToPack.end(); ++it)
+    {
+        if ( !resources.HasResource(*it) ) continue;
+        gd::ImageResource * resource = dynamic_cast<gd::ImageResource*>(&resources.GetResource(*it));
+        if ( !resource || resource->excludedFromAtlas || resource->alwaysLoaded || !resource->GetAtlas().empty() )
+            continue;
+
+        PackedImage packedImage;
+        packedImage.resource = resource;
+        packedImage.x = 0;
+        packedImage.y = 0;
+        if ( !packedImage.image.loadFromFile((directory + "/" + resource->GetFile()).ToLocale()) )
+            continue;
+
+        sf::Vector2u size = packedImage.image.getSize();
+        if ( size.x == 0 || size.y == 0 || size.x > maxImageSize || size.y > maxImageSize )
+            continue;
+
+        (resource->smooth ? smoothImages : notSmoothImages).push_back(packedImage);
+    }
+
+    std::size_t packedCount = PackImagesInAtlases(project, directory, smoothImages, true) +
+        PackImagesInAtlases(project, directory, notSmoothImages, false);
+
+    RemovePackedImagesFiles(project, directory, otherFiles);
+    return packedCount;
+}
+
+}
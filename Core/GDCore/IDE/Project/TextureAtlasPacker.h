@@ -0,0 +1,51 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCORE_TEXTUREATLASPACKER_H
+#define GDCORE_TEXTUREATLASPACKER_H
+
+#include <cstddef>
+#include "GDCore/String.h"
+namespace gd { class Project; }
+
+namespace gd
+{
+
+/**
+ * \brief Pack the images of an exported game in texture atlases, so that sprites using
+ * different images can be drawn with the same texture (and so in the same batch).
+ *
+ * Only the images used by sprite objects are packed: images used by other objects or by
+ * events, images always loaded and images excluded from atlases (see gd::ImageResource::excludedFromAtlas)
+ * can be used or modified at runtime in ways requiring their own texture.
+ *
+ * \see gd::ImageResource::GetAtlas
+ * \ingroup IDE
+ */
+class GD_CORE_API TextureAtlasPacker
+{
+public:
+    /**
+     * \brief Pack the images in atlases, which are saved as PNG files in \a directory and added
+     * to the resources of the project. The images packed are updated so that they are loaded
+     * from their atlas.
+     *
+     * The files of the images packed are removed from \a directory, unless they are used
+     * by other resources or by events.
+     *
+     * \param project The exported project, whose images files are relative to \a directory.
+     * \param directory The directory containing the images, where the atlases are saved.
+     * \return The number of images packed.
+     */
+    static std::size_t PackImages(gd::Project & project, const gd::String & directory);
+
+    static const unsigned int atlasSize = 2048; ///< The maximum width and height of an atlas.
+    static const unsigned int maxImageSize = 512; ///< The images larger than this size are not packed.
+    static const unsigned int padding = 2; ///< The space between the images in an atlas, avoiding filtering artifacts.
+};
+
+}
+
+#endif // GDCORE_TEXTUREATLASPACKER_H
@@ -14,6 +14,18 @@ Behavior::~Behavior()
 {
 };
 
+void Behavior::StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    for (std::size_t i = 0;i<behaviors.size();++i)
+        behaviors[i]->StepPreEvents(scene);
+}
+
+void Behavior::StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    for (std::size_t i = 0;i<behaviors.size();++i)
+        behaviors[i]->StepPostEvents(scene);
+}
+
 #if defined(GD_IDE_ONLY)
 std::map<gd::String, gd::PropertyDescriptor> Behavior::GetProperties(gd::Project & project) const
 {
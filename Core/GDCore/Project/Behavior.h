@@ -7,6 +7,7 @@
 #define GDCORE_BEHAVIOR_H
 #include "GDCore/String.h"
 #include <map>
+#include <vector>
 #if defined(GD_IDE_ONLY)
 namespace gd { class PropertyDescriptor; }
 namespace gd { class MainFrameWrapper; }
@@ -17,6 +18,7 @@ namespace gd { class Layout; }
 class wxWindow;
 class RuntimeObject;//TODO : C++ Platform specific code below
 class RuntimeScene;
+class BehaviorsRegistry;
 
 namespace gd
 {
@@ -29,7 +31,7 @@ namespace gd
 class GD_CORE_API Behavior
 {
 public:
-    Behavior() : activated(true) {};
+    Behavior() : activated(true), registryTypeIndex(gd::String::npos), registryIndex(gd::String::npos) {};
     virtual ~Behavior();
     virtual Behavior* Clone() const { return new Behavior(*this);}
 
@@ -118,6 +120,28 @@ public:
      */
     inline void StepPostEvents(RuntimeScene & scene) { if (activated) DoStepPostEvents(scene); };
 
+    /**
+     * Called at each frame before events, on one of the behaviors of the scene having the same type as this one,
+     * with all these behaviors (including this one).
+     *
+     * The default implementation calls StepPreEvents for each behavior. Redefine it so as to update
+     * all the behaviors in a single loop, without a virtual call for each behavior. Only the activated
+     * behaviors must be updated.
+     *
+     * \see BehaviorsRegistry
+     */
+    virtual void StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
+
+    /**
+     * Called at each frame after events, on one of the behaviors of the scene having the same type as this one,
+     * with all these behaviors (including this one).
+     *
+     * The default implementation calls StepPostEvents for each behavior.
+     *
+     * \see StepAllPreEvents
+     */
+    virtual void StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
+
     /**
      * De/Activate the behavior
      */
@@ -164,6 +188,12 @@ protected:
 
     RuntimeObject* object; ///< Object owning the behavior
     bool activated; ///< True if behavior is running
+
+private:
+    friend class ::BehaviorsRegistry;
+
+    std::size_t registryTypeIndex; ///< Used by BehaviorsRegistry: index of the type of the behavior in the registry.
+    std::size_t registryIndex; ///< Used by BehaviorsRegistry: position of the behavior in the behaviors of its type.
 };
 
 }
@@ -9,6 +9,7 @@
 #include "GDCore/Tools/InvalidImage.h"
 #include "GDCore/Project/ResourcesManager.h"
 #include <SFML/OpenGL.hpp>
+#include <algorithm>
 #if !defined(ANDROID) && !defined(MACOS)
 #include <GL/glu.h>
 #endif
@@ -17,7 +18,28 @@
 namespace gd
 {
 
+namespace
+{
+    #if defined(GD_IDE_ONLY)
+    //The editors only need the images they are displaying, and the images of the project can
+    //change at any time: unload them as soon as they are not used.
+    const std::size_t defaultMemoryBudget = 0;
+    #else
+    //Games keep the images of the previous scenes, so that they are not loaded again when a scene
+    //is launched again. 128 MB is a fraction of the video memory of most of the devices.
+    const std::size_t defaultMemoryBudget = 128*1024*1024;
+    #endif
+}
+
 ImageManager::ImageManager() :
+    residentBytes(0),
+    memoryBudget(defaultMemoryBudget),
+    hitsCount(0),
+    missesCount(0),
+    evictionsCount(0),
+    #if defined(GD_IDE_ONLY)
+    preventUnloading(false),
+    #endif
     resourcesManager(NULL)
 {
     #if !defined(EMSCRIPTEN)
@@ -28,6 +50,47 @@ ImageManager::ImageManager() :
     #endif
 }
 
+ImageManager::ImageManager(const ImageManager & other)
+{
+    Init(other);
+}
+
+ImageManager & ImageManager::operator=(const ImageManager & other)
+{
+    if ( this != &other )
+        Init(other);
+
+    return *this;
+}
+
+void ImageManager::Init(const ImageManager & other)
+{
+    alreadyLoadedImages = other.alreadyLoadedImages;
+    permanentlyLoadedImages = other.permanentlyLoadedImages;
+
+    //The positions must refer to the copied list.
+    recentlyUsedImages = other.recentlyUsedImages;
+    recentlyUsedImagesPositions.clear();
+    for (auto it = recentlyUsedImages.begin();it != recentlyUsedImages.end();++it)
+        recentlyUsedImagesPositions[it->name] = it;
+
+    residentBytes = other.residentBytes;
+    memoryBudget = other.memoryBudget;
+    hitsCount = other.hitsCount;
+    missesCount = other.missesCount;
+    evictionsCount = other.evictionsCount;
+
+    #if defined(GD_IDE_ONLY)
+    unloadingPreventer = other.unloadingPreventer;
+    preventUnloading = other.preventUnloading;
+    #endif
+
+    alreadyLoadedOpenGLTextures = other.alreadyLoadedOpenGLTextures;
+    badTexture = other.badTexture;
+    badOpenGLTexture = other.badOpenGLTexture;
+    resourcesManager = other.resourcesManager;
+}
+
 std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(const gd::String & name) const
 {
     if ( !resourcesManager )
@@ -36,9 +99,16 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(const gd::Strin
         return badTexture;
     }
 
-    if ( alreadyLoadedImages.find(name) != alreadyLoadedImages.end() && !alreadyLoadedImages.find(name)->second.expired() )
-        return alreadyLoadedImages.find(name)->second.lock();
+    auto it = alreadyLoadedImages.find(name);
+    if ( it != alreadyLoadedImages.end() && !it->second.expired() )
+    {
+        hitsCount++;
+        std::shared_ptr<SFMLTextureWrapper> texture = it->second.lock();
+        MarkAsRecentlyUsed(name, texture);
+        return texture;
+    }
 
+    missesCount++;
     std::cout << "ImageManager: Loading " << name << ".";
 
     //Load only an image when necessary
@@ -47,15 +117,31 @@ std::shared_ptr<SFMLTextureWrapper> ImageManager::GetSFMLTexture(const gd::Strin
         ImageResource & image = dynamic_cast<ImageResource&>(resourcesManager->GetResource(name));
 
         auto texture = std::make_shared<SFMLTextureWrapper>();
-        ResourcesLoader::Get()->LoadSFMLImage( image.GetFile(), texture->image );
-        texture->texture.loadFromImage(texture->image);
-        texture->texture.setSmooth(image.smooth);
+        if ( !image.GetAtlas().empty() && resourcesManager->HasResource(image.GetAtlas()) )
+        {
+            //The image is displayed using the texture of its atlas: only the pixels of the image
+            //are copied, for pixel perfect collisions.
+            std::cout << " Packed in " << image.GetAtlas() << ".";
+            std::shared_ptr<SFMLTextureWrapper> atlas = GetSFMLTexture(image.GetAtlas());
+            sf::IntRect rect(image.GetAtlasX(), image.GetAtlasY(), image.GetAtlasWidth(), image.GetAtlasHeight());
+            texture->image.create(rect.width, rect.height);
+            texture->image.copy(atlas->image, 0, 0, rect);
+            texture->SetAtlas(atlas, rect);
+        }
+        else
+        {
+            ResourcesLoader::Get()->LoadSFMLImage( image.GetFile(), texture->image );
+            texture->texture.loadFromImage(texture->image);
+            texture->texture.setSmooth(image.smooth);
+        }
 
         alreadyLoadedImages[name] = texture;
         #if defined(GD_IDE_ONLY)
         if ( preventUnloading ) unloadingPreventer.push_back(texture); //If unload prevention is activated, add the image to the list dedicated to prevent images from being unloaded.
         #endif
 
+        MarkAsRecentlyUsed(name, texture);
+        EnforceMemoryBudget();
         return texture;
     }
     catch(...)
@@ -84,6 +170,85 @@ void ImageManager::SetSFMLTextureAsPermanentlyLoaded(const gd::String & name, st
         permanentlyLoadedImages[name] = texture;
 }
 
+std::shared_ptr<SFMLTextureWrapper> ImageManager::SetSFMLTextureAsLoaded(const gd::String & name, std::shared_ptr<SFMLTextureWrapper> texture) const
+{
+    auto it = alreadyLoadedImages.find(name);
+    if ( it != alreadyLoadedImages.end() && !it->second.expired() )
+        return it->second.lock();
+
+    alreadyLoadedImages[name] = texture;
+    #if defined(GD_IDE_ONLY)
+    if ( preventUnloading ) unloadingPreventer.push_back(texture);
+    #endif
+
+    MarkAsRecentlyUsed(name, texture);
+    EnforceMemoryBudget();
+    return texture;
+}
+
+void ImageManager::MarkAsRecentlyUsed(const gd::String & name, const std::shared_ptr<SFMLTextureWrapper> & texture) const
+{
+    auto it = recentlyUsedImagesPositions.find(name);
+    if ( it != recentlyUsedImagesPositions.end() )
+    {
+        //Move the image at the beginning of the list, updating its texture in case it was replaced.
+        recentlyUsedImages.splice(recentlyUsedImages.begin(), recentlyUsedImages, it->second);
+        if ( it->second->texture != texture )
+        {
+            residentBytes -= it->second->textureBytes;
+            it->second->texture = texture;
+            it->second->textureBytes = texture->GetTextureBytes();
+            residentBytes += it->second->textureBytes;
+        }
+    }
+    else
+    {
+        RecentlyUsedImage image = {name, texture, texture->GetTextureBytes()};
+        recentlyUsedImages.push_front(image);
+        recentlyUsedImagesPositions[name] = recentlyUsedImages.begin();
+        residentBytes += image.textureBytes;
+    }
+}
+
+void ImageManager::UpdateTextureBytes(const gd::String & name) const
+{
+    auto it = recentlyUsedImagesPositions.find(name);
+    if ( it == recentlyUsedImagesPositions.end() ) return;
+
+    residentBytes -= it->second->textureBytes;
+    it->second->textureBytes = it->second->texture->GetTextureBytes();
+    residentBytes += it->second->textureBytes;
+    EnforceMemoryBudget();
+}
+
+void ImageManager::EnforceMemoryBudget() const
+{
+    auto it = recentlyUsedImages.end();
+    while ( residentBytes > memoryBudget && it != recentlyUsedImages.begin() )
+    {
+        --it;
+
+        //Unloading an image still used elsewhere would not free any memory.
+        if ( it->texture.use_count() > 1 ) continue;
+
+        gd::String name = it->name;
+        residentBytes -= it->textureBytes;
+        recentlyUsedImagesPositions.erase(name);
+        it = recentlyUsedImages.erase(it); //The image is unloaded, as nothing else is using it.
+        evictionsCount++;
+
+        auto loadedImage = alreadyLoadedImages.find(name);
+        if ( loadedImage != alreadyLoadedImages.end() && loadedImage->second.expired() )
+            alreadyLoadedImages.erase(loadedImage);
+    }
+}
+
+void ImageManager::SetMemoryBudget(std::size_t bytes)
+{
+    memoryBudget = bytes;
+    EnforceMemoryBudget();
+}
+
 void ImageManager::ReloadImage(const gd::String & name) const
 {
     if ( !resourcesManager )
@@ -97,6 +262,7 @@ void ImageManager::ReloadImage(const gd::String & name) const
 
     //Image still in memory, get it and update it.
     std::shared_ptr<SFMLTextureWrapper> oldTexture = alreadyLoadedImages.find(name)->second.lock();
+    if ( oldTexture->GetAtlas() ) return; //Images packed in atlases are only used by exported games and never change.
 
     try
     {
@@ -106,8 +272,10 @@ void ImageManager::ReloadImage(const gd::String & name) const
 
         ResourcesLoader::Get()->LoadSFMLImage( image.GetFile(), oldTexture->image );
         oldTexture->texture.loadFromImage(oldTexture->image);
+        oldTexture->InvalidateAlphaMask();
         oldTexture->texture.setSmooth(image.smooth);
 
+        UpdateTextureBytes(name); //The size of the texture can change.
         return;
     }
     catch(...) { /*The ressource is not an image*/ }
@@ -115,6 +283,7 @@ void ImageManager::ReloadImage(const gd::String & name) const
     //Image not present anymore in image list.
     std::cout << "ImageManager: " << name << " is not available anymore." << std::endl;
     *oldTexture = *badTexture;
+    UpdateTextureBytes(name);
 }
 
 std::shared_ptr<OpenGLTextureWrapper> ImageManager::GetOpenGLTexture(const gd::String & name) const
@@ -179,11 +348,15 @@ void ImageManager::EnableImagesUnloading()
 
 SFMLTextureWrapper::SFMLTextureWrapper(const sf::Texture & texture_) :
     texture(texture_),
-    image(texture.copyToImage())
+    image(texture.copyToImage()),
+    displayedTextureVersion(0),
+    alphaMaskThreshold(-1)
 {
 }
 
-SFMLTextureWrapper::SFMLTextureWrapper()
+SFMLTextureWrapper::SFMLTextureWrapper() :
+    displayedTextureVersion(0),
+    alphaMaskThreshold(-1)
 {
 }
 
@@ -191,6 +364,51 @@ SFMLTextureWrapper::~SFMLTextureWrapper()
 {
 }
 
+void SFMLTextureWrapper::DetachFromAtlas()
+{
+    if ( !atlasTexture ) return;
+
+    texture.setSmooth(atlasTexture->texture.isSmooth());
+    atlasTexture.reset();
+    displayedTextureVersion++;
+}
+
+const AlphaBitmask & SFMLTextureWrapper::GetAlphaMask(sf::Uint8 alphaThreshold) const
+{
+    if ( alphaMaskThreshold != alphaThreshold )
+    {
+        alphaMask.Create(image, alphaThreshold);
+        alphaMaskThreshold = alphaThreshold;
+    }
+
+    return alphaMask;
+}
+
+void AlphaBitmask::Create(const sf::Image & image, sf::Uint8 alphaThreshold)
+{
+    Create(image.getSize().x, image.getSize().y, image.getPixelsPtr(), alphaThreshold);
+}
+
+void AlphaBitmask::Create(unsigned int width_, unsigned int height_, const sf::Uint8 * pixels, sf::Uint8 alphaThreshold)
+{
+    if ( !pixels ) width_ = height_ = 0;
+
+    width = width_;
+    height = height_;
+    wordsPerRow = (width+63)/64;
+    bits.assign(static_cast<std::size_t>(wordsPerRow)*height, 0);
+
+    for (unsigned int y = 0;y<height;++y)
+    {
+        sf::Uint64 * row = &bits[static_cast<std::size_t>(y)*wordsPerRow];
+        const sf::Uint8 * pixel = pixels + (static_cast<std::size_t>(y)*width)*4;
+        for (unsigned int x = 0;x<width;++x, pixel += 4)
+        {
+            if ( pixel[3] > alphaThreshold ) row[x/64] |= sf::Uint64(1) << (x%64);
+        }
+    }
+}
+
 OpenGLTextureWrapper::OpenGLTextureWrapper(std::shared_ptr<SFMLTextureWrapper> sfmlTexture_)
 {
     sfmlTexture = sfmlTexture_;
@@ -9,6 +9,8 @@
 
 #include <iostream>
 #include <vector>
+#include <list>
+#include <map>
 #include "GDCore/String.h"
 #include <memory>
 #include <memory>
@@ -29,7 +31,9 @@ namespace gd
  * Image manager is used by objects to obtain their images from the image name.
  *
  * Images are loaded dynamically when necessary, and are unloaded if there is no
- * more shared_ptr pointing on an image.
+ * more shared_ptr pointing on an image. The images recently used are kept loaded, even if
+ * they are not used anymore, until the memory used by the textures exceeds a budget (see SetMemoryBudget):
+ * the least recently used images are then unloaded. Permanently loaded images are never unloaded.
  *
  * You should in particular be interested by gd::ImageManager::GetOpenGLTexture and gd::ImageManager::GetSFMLTexture.
  *
@@ -42,6 +46,8 @@ class GD_CORE_API ImageManager
 {
 public:
     ImageManager();
+    ImageManager(const ImageManager & other);
+    ImageManager & operator=(const ImageManager & other);
     virtual ~ImageManager() {};
 
     /**
@@ -80,11 +86,72 @@ public:
      */
     void SetSFMLTextureAsPermanentlyLoaded(const gd::String & name, std::shared_ptr<SFMLTextureWrapper> & texture) const;
 
+    /**
+     * \brief Add the SFMLTextureWrapper, loaded from the image called \a name, to loaded images so that it is returned
+     * by ImageManager::GetSFMLTexture. Used to give to the ImageManager textures loaded in advance.
+     *
+     * \return The texture now associated to \a name: \a texture, or the texture already loaded if the image was
+     * loaded in the meantime.
+     */
+    std::shared_ptr<SFMLTextureWrapper> SetSFMLTextureAsLoaded(const gd::String & name, std::shared_ptr<SFMLTextureWrapper> texture) const;
+
     /**
      * \brief Reload a single image from the game resources
      */
     void ReloadImage(const gd::String & name) const;
 
+    /**
+     * \brief Count again the memory used by the texture of an image, after the texture was changed
+     * (for example, created again from a modified image, or detached from its atlas).
+     */
+    void UpdateTextureBytes(const gd::String & name) const;
+
+    /** \name Memory budget
+     * Members functions related to the memory used by the textures.
+     */
+    ///@{
+    /**
+     * \brief Set the memory, in bytes, that the textures should not exceed.
+     *
+     * Images not used anymore are kept loaded while the budget allows it, so that they can be used
+     * again without being reloaded. When the budget is exceeded, the least recently used
+     * of these images are unloaded. Images being used are never unloaded: if they need more than
+     * the budget, the budget is exceeded.
+     *
+     * By default, the budget is 128 MB for games, and 0 in the IDE.
+     *
+     * \note Set the budget to 0 to unload images as soon as they are not used anymore.
+     */
+    void SetMemoryBudget(std::size_t bytes);
+
+    /**
+     * \brief Return the memory, in bytes, that the textures should not exceed.
+     */
+    std::size_t GetMemoryBudget() const { return memoryBudget; }
+
+    /**
+     * \brief Return the memory, in bytes, used by the textures of the images loaded by the ImageManager.
+     * \note The memory is updated when images are loaded, reloaded or unloaded, and by UpdateTextureBytes,
+     * so this is in constant time.
+     */
+    std::size_t GetResidentBytes() const { return residentBytes; }
+
+    /**
+     * \brief Return the number of times an image was requested and already loaded.
+     */
+    std::size_t GetHitsCount() const { return hitsCount; }
+
+    /**
+     * \brief Return the number of times an image was requested and had to be loaded.
+     */
+    std::size_t GetMissesCount() const { return missesCount; }
+
+    /**
+     * \brief Return the number of images unloaded to stay within the memory budget.
+     */
+    std::size_t GetEvictionsCount() const { return evictionsCount; }
+    ///@}
+
     #if defined(GD_IDE_ONLY)
     /**
      * \brief When called, images won't be unloaded from memory until EnableImagesUnloading is called.
@@ -99,9 +166,46 @@ public:
     #endif
 
 private:
+    /**
+     * Initialize from another ImageManager. Used by copy-ctor and assign-op.
+     * Don't forget to update me if members were changed !
+     */
+    void Init(const ImageManager & other);
+
     mutable std::map < gd::String, std::weak_ptr<SFMLTextureWrapper> > alreadyLoadedImages; ///< Reference all images loaded in memory.
     mutable std::map < gd::String, std::shared_ptr<SFMLTextureWrapper> > permanentlyLoadedImages; ///< Contains (smart) pointers to images which should stay loaded even if they are not (currently) used.
 
+    /**
+     * \brief An image recently used, with the memory counted for its texture in residentBytes.
+     */
+    struct RecentlyUsedImage
+    {
+        gd::String name;
+        std::shared_ptr<SFMLTextureWrapper> texture;
+        std::size_t textureBytes;
+    };
+
+    typedef std::list<RecentlyUsedImage> RecentlyUsedImagesList;
+
+    /**
+     * \brief Mark the image as the most recently used one, keeping it loaded while the memory budget allows it.
+     */
+    void MarkAsRecentlyUsed(const gd::String & name, const std::shared_ptr<SFMLTextureWrapper> & texture) const;
+
+    /**
+     * \brief Unload the least recently used images which are not used anymore, until the memory
+     * used by the textures is within the budget.
+     */
+    void EnforceMemoryBudget() const;
+
+    mutable RecentlyUsedImagesList recentlyUsedImages; ///< The images recently used, the most recent first.
+    mutable std::map < gd::String, RecentlyUsedImagesList::iterator > recentlyUsedImagesPositions; ///< The position of the images in recentlyUsedImages.
+    mutable std::size_t residentBytes; ///< The memory, in bytes, used by the textures of the images in recentlyUsedImages.
+    std::size_t memoryBudget; ///< The memory, in bytes, that the textures should not exceed.
+    mutable std::size_t hitsCount;
+    mutable std::size_t missesCount;
+    mutable std::size_t evictionsCount;
+
     #if defined(GD_IDE_ONLY)
 
     /** This list is filled, when PreventImagesUnloading is called, with images already loaded in memory ( and any image loaded after the call to PreventImagesUnloading ).
@@ -125,6 +229,60 @@ private:
 
 }
 
+/**
+ * \brief A mask telling which pixels of an image are opaque, stored as one bit per pixel.
+ *
+ * Each row of the mask is stored in 64 bits words, so that pixel perfect collision tests can
+ * test 64 pixels at once.
+ *
+ * \see SFMLTextureWrapper::GetAlphaMask
+ * \ingroup ResourcesManagement
+ */
+class GD_CORE_API AlphaBitmask
+{
+public:
+    AlphaBitmask() : width(0), height(0), wordsPerRow(0) {};
+    virtual ~AlphaBitmask() {};
+
+    /**
+     * \brief Generate the mask from an image: a pixel is set if its alpha is greater than alphaThreshold.
+     */
+    void Create(const sf::Image & image, sf::Uint8 alphaThreshold);
+
+    /**
+     * \brief Generate the mask from an array of RGBA pixels: a pixel is set if its alpha is greater than alphaThreshold.
+     */
+    void Create(unsigned int width, unsigned int height, const sf::Uint8 * pixels, sf::Uint8 alphaThreshold);
+
+    unsigned int GetWidth() const { return width; }
+    unsigned int GetHeight() const { return height; }
+
+    /**
+     * \brief Return true if the pixel is set. x and y must be inside the mask.
+     */
+    bool IsSet(unsigned int x, unsigned int y) const { return (bits[y*wordsPerRow+x/64] >> (x%64)) & 1; }
+
+    /**
+     * \brief Return the 64 pixels of the row y starting at x, the first pixel being the lowest bit.
+     * x and y must be inside the mask. Pixels after the end of the row are not set.
+     */
+    sf::Uint64 GetBits(unsigned int x, unsigned int y) const
+    {
+        const sf::Uint64 * row = &bits[y*wordsPerRow];
+        unsigned int word = x/64, shift = x%64;
+        sf::Uint64 result = row[word] >> shift;
+        if ( shift != 0 && word+1 < wordsPerRow ) result |= row[word+1] << (64-shift);
+
+        return result;
+    }
+
+private:
+    unsigned int width;
+    unsigned int height;
+    unsigned int wordsPerRow;
+    std::vector<sf::Uint64> bits;
+};
+
 /**
  * \brief Class wrapping an SFML texture.
  *
@@ -138,8 +296,73 @@ public:
     SFMLTextureWrapper();
     ~SFMLTextureWrapper();
 
-    sf::Texture texture;
-    sf::Image image; ///< Associated sfml image, used for pixel perfect collision for example. If you update the image, call LoadFromImage on texture to update it also.
+    /**
+     * \brief Get the mask of the pixels of the image having an alpha greater than alphaThreshold.
+     *
+     * The mask is generated the first time it is needed and then kept until the image is changed.
+     * \see InvalidateAlphaMask
+     */
+    const AlphaBitmask & GetAlphaMask(sf::Uint8 alphaThreshold) const;
+
+    /**
+     * \brief Must be called after changing the image so that the alpha mask is generated again.
+     */
+    void InvalidateAlphaMask() { alphaMaskThreshold = -1; }
+
+    /**
+     * \brief Return the memory, in bytes, used by the texture.
+     * \note The memory of the atlas containing the image, if any, is not included.
+     */
+    std::size_t GetTextureBytes() const { return static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4; }
+
+    /**
+     * \brief Set the texture atlas containing the image. The image is then displayed using the
+     * texture of the atlas, and \a texture is not used.
+     * \param atlas The atlas containing the image.
+     * \param rect The rectangle of the image in the atlas.
+     */
+    void SetAtlas(std::shared_ptr<SFMLTextureWrapper> atlas, const sf::IntRect & rect) { atlasTexture = atlas; atlasRect = rect; displayedTextureVersion++; }
+
+    /**
+     * \brief Return the texture atlas containing the image, or a null pointer if the image is not in an atlas.
+     */
+    const std::shared_ptr<SFMLTextureWrapper> & GetAtlas() const { return atlasTexture; }
+
+    /**
+     * \brief Display the image using \a texture rather than the texture of its atlas, for example
+     * because the image was modified. \a texture must then be updated from the image.
+     *
+     * The sprites displaying the image use \a texture the next time they are drawn (see GetDisplayedTextureVersion).
+     * \see gd::ImageManager::UpdateTextureBytes
+     */
+    void DetachFromAtlas();
+
+    /**
+     * \brief Return the texture to be used to display the image: the texture of the atlas
+     * containing the image, or \a texture.
+     */
+    const sf::Texture & GetDisplayedTexture() const { return atlasTexture ? atlasTexture->texture : texture; }
+
+    /**
+     * \brief Return the rectangle of the image in GetDisplayedTexture().
+     */
+    sf::IntRect GetDisplayedTextureRect() const { return atlasTexture ? atlasRect : sf::IntRect(0, 0, texture.getSize().x, texture.getSize().y); }
+
+    /**
+     * \brief Return a number changed each time the texture used to display the image is changed
+     * (when the image is put in an atlas or detached from it).
+     */
+    unsigned int GetDisplayedTextureVersion() const { return displayedTextureVersion; }
+
+    sf::Texture texture; ///< The texture of the image, not used if the image is in an atlas (see GetDisplayedTexture).
+    sf::Image image; ///< Associated sfml image, used for pixel perfect collision for example. If you update the image, call LoadFromImage on texture and InvalidateAlphaMask to update them also.
+
+private:
+    std::shared_ptr<SFMLTextureWrapper> atlasTexture; ///< The atlas containing the image, if any.
+    sf::IntRect atlasRect; ///< The rectangle of the image in the atlas.
+    unsigned int displayedTextureVersion; ///< See GetDisplayedTextureVersion.
+    mutable AlphaBitmask alphaMask;
+    mutable int alphaMaskThreshold; ///< The threshold used to generate alphaMask, or -1 if it must be generated.
 };
 
 /**
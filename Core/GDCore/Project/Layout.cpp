@@ -253,6 +253,14 @@ void Layout::SerializeTo(SerializerElement & element) const
         dataElement.SetAttribute("name", it->second->GetName());
         it->second->SerializeTo(dataElement);
     }
+
+    if ( !resourcesManifest.empty() )
+    {
+        SerializerElement & manifestElement = element.AddChild("resourcesManifest");
+        manifestElement.ConsiderAsArrayOf("resource");
+        for ( std::size_t i = 0;i < resourcesManifest.size();++i )
+            manifestElement.AddChild("resource").SetAttribute("name", resourcesManifest[i]);
+    }
 }
 #endif
 
@@ -319,6 +327,15 @@ void Layout::UnserializeFrom(gd::Project & project, const SerializerElement & el
         }
 
     }
+
+    resourcesManifest.clear();
+    if ( element.HasChild("resourcesManifest") )
+    {
+        SerializerElement & manifestElement = element.GetChild("resourcesManifest");
+        manifestElement.ConsiderAsArrayOf("resource");
+        for (std::size_t i = 0; i < manifestElement.GetChildrenCount(); ++i)
+            resourcesManifest.push_back(manifestElement.GetChild(i).GetStringAttribute("name"));
+    }
 }
 
 void Layout::Init(const Layout & other)
@@ -334,6 +351,7 @@ void Layout::Init(const Layout & other)
     oglZFar = other.oglZFar;
     stopSoundsOnStartup = other.stopSoundsOnStartup;
     disableInputWhenNotFocused = other.disableInputWhenNotFocused;
+    resourcesManifest = other.resourcesManifest;
     initialInstances = other.initialInstances;
     initialLayers = other.initialLayers;
     variables = other.GetVariables();
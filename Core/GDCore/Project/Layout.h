@@ -320,6 +320,20 @@ public:
      * Get OpenGL far clipping plan
      */
     float GetOpenGLZFar() const { return oglZFar; }
+
+    /**
+     * \brief Return the names of the images used by the scene, which can be loaded in advance
+     * before the scene is launched.
+     *
+     * The list is computed when the game is exported (see gd::SceneResourcesFinder) and is empty otherwise.
+     */
+    const std::vector<gd::String> & GetResourcesManifest() const { return resourcesManifest; }
+
+    /**
+     * \brief Set the names of the images used by the scene.
+     * \see GetResourcesManifest
+     */
+    void SetResourcesManifest(const std::vector<gd::String> & manifest) { resourcesManifest = manifest; }
     ///@}
 
     /** \name Saving and loading
@@ -430,6 +444,7 @@ private:
     float                                       oglZNear; ///< OpenGL Near Z position
     float                                       oglZFar; ///< OpenGL Far Z position
     bool                                        disableInputWhenNotFocused; /// If set to true, the input must be disabled when the window do not have the focus.
+    std::vector<gd::String>                     resourcesManifest; ///< The names of the images used by the scene, see GetResourcesManifest.
     static gd::Layer                            badLayer; ///< Null object, returned when GetLayer can not find an appropriate layer.
     #if defined(GD_IDE_ONLY)
     EventsList                                  events; ///< Scene events
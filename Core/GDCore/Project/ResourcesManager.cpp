@@ -166,6 +166,8 @@ bool ImageResource::ChangeProperty(gd::Project & project, const gd::String & pro
         smooth = (newValue == _("Yes"));
     else if ( property == "alwaysLoaded" )
         alwaysLoaded = (newValue == _("Yes"));
+    else if ( property == "excludedFromAtlas" )
+        excludedFromAtlas = (newValue == _("Yes"));
 
     return true;
 }
@@ -182,6 +184,11 @@ void ImageResource::GetPropertyInformation(gd::Project & project, const gd::Stri
         userFriendlyName = _("Always loaded in memory");
         description = _("Set this to \"Yes\" to let the image always loaded in memory.\nUseful when the image is used by actions.");
     }
+    else if ( property == "excludedFromAtlas" )
+    {
+        userFriendlyName = _("Excluded from texture atlases");
+        description = _("Set this to \"Yes\" to prevent the image from being packed with other images when the game is exported.\nUseful when the image is modified by actions.");
+    }
 }
 
 gd::String ImageResource::GetProperty(gd::Project & project, const gd::String & property)
@@ -194,6 +201,10 @@ gd::String ImageResource::GetProperty(gd::Project & project, const gd::String &
     {
         return alwaysLoaded ? _("Yes") : _("No");
     }
+    else if ( property == "excludedFromAtlas" )
+    {
+        return excludedFromAtlas ? _("Yes") : _("No");
+    }
 
     return "";
 }
@@ -206,6 +217,7 @@ std::vector<gd::String> ImageResource::GetAllProperties(gd::Project & project) c
     std::vector<gd::String> allProperties;
     allProperties.push_back("smooth");
     allProperties.push_back("alwaysLoaded");
+    allProperties.push_back("excludedFromAtlas");
 
     return allProperties;
 }
@@ -602,12 +614,24 @@ void ImageResource::SetFile(const gd::String & newFile)
         file.replace(file.find('\\'), 1, "/");
 }
 
+void ImageResource::SetAtlas(const gd::String & atlasName, int x, int y, int width, int height)
+{
+    atlas = atlasName;
+    atlasX = x;
+    atlasY = y;
+    atlasWidth = width;
+    atlasHeight = height;
+}
+
 void ImageResource::UnserializeFrom(const SerializerElement & element)
 {
     alwaysLoaded = element.GetBoolAttribute("alwaysLoaded");
     smooth = element.GetBoolAttribute("smoothed");
+    excludedFromAtlas = element.GetBoolAttribute("excludedFromAtlas", false);
     SetUserAdded( element.GetBoolAttribute("userAdded") );
     SetFile(element.GetStringAttribute("file"));
+    SetAtlas(element.GetStringAttribute("atlas"), element.GetIntAttribute("atlasX"), element.GetIntAttribute("atlasY"),
+        element.GetIntAttribute("atlasWidth"), element.GetIntAttribute("atlasHeight"));
 }
 
 #if defined(GD_IDE_ONLY)
@@ -617,6 +641,15 @@ void ImageResource::SerializeTo(SerializerElement & element) const
     element.SetAttribute("smoothed", smooth);
     element.SetAttribute("userAdded", IsUserAdded());
     element.SetAttribute("file", GetFile()); //Keep the resource path in the current locale (but save it in UTF8 for compatibility on other OSes)
+    if ( excludedFromAtlas ) element.SetAttribute("excludedFromAtlas", excludedFromAtlas);
+    if ( !atlas.empty() )
+    {
+        element.SetAttribute("atlas", atlas);
+        element.SetAttribute("atlasX", atlasX);
+        element.SetAttribute("atlasY", atlasY);
+        element.SetAttribute("atlasWidth", atlasWidth);
+        element.SetAttribute("atlasHeight", atlasHeight);
+    }
 }
 #endif
 
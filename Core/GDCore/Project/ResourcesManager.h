@@ -148,7 +148,7 @@ private:
 class GD_CORE_API ImageResource : public Resource
 {
 public:
-    ImageResource() : Resource(), smooth(true), alwaysLoaded(false) { SetKind("image"); };
+    ImageResource() : Resource(), smooth(true), alwaysLoaded(false), excludedFromAtlas(false), atlasX(0), atlasY(0), atlasWidth(0), atlasHeight(0) { SetKind("image"); };
     virtual ~ImageResource() {};
     virtual ImageResource* Clone() const { return new ImageResource(*this);}
 
@@ -162,6 +162,25 @@ public:
      */
     virtual void SetFile(const gd::String & newFile);
 
+    /**
+     * \brief Return the name of the image resource of the texture atlas containing the image,
+     * or an empty string if the image is not packed in an atlas.
+     *
+     * Images are packed in atlases when a game is exported, see gd::TextureAtlasPacker.
+     */
+    const gd::String & GetAtlas() const { return atlas; }
+
+    /**
+     * \brief Set the texture atlas containing the image and the position of the image in the atlas.
+     * \param atlasName The name of the image resource of the atlas, or an empty string if the image is not packed in an atlas.
+     */
+    void SetAtlas(const gd::String & atlasName, int x, int y, int width, int height);
+
+    int GetAtlasX() const { return atlasX; } ///< Return the X position of the image in its atlas.
+    int GetAtlasY() const { return atlasY; } ///< Return the Y position of the image in its atlas.
+    int GetAtlasWidth() const { return atlasWidth; } ///< Return the width of the image in its atlas.
+    int GetAtlasHeight() const { return atlasHeight; } ///< Return the height of the image in its atlas.
+
     #if defined(GD_IDE_ONLY)
     virtual bool UseFile() { return true; }
 
@@ -216,8 +235,14 @@ public:
 
     bool smooth; ///< True if smoothing filter is applied
     bool alwaysLoaded; ///< True if the image must always be loaded in memory.
+    bool excludedFromAtlas; ///< True if the image must not be packed in a texture atlas, for example because it is modified at runtime.
 private:
     gd::String file;
+    gd::String atlas; ///< The name of the atlas containing the image, if any.
+    int atlasX;
+    int atlasY;
+    int atlasWidth;
+    int atlasHeight;
 };
 
 
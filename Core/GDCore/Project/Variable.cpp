@@ -15,6 +15,69 @@ using namespace std;
 namespace gd
 {
 
+std::size_t Variable::structureVersion = 0;
+
+Variable::Variable(const Variable & other) :
+    value(other.value),
+    str(other.str),
+    isNumber(other.isNumber),
+    isStructure(other.isStructure),
+    children(other.GetChildrenForCopy()),
+    childrenShareable(true)
+{
+}
+
+Variable::~Variable()
+{
+    //Only the children returned by GetChild can be remembered (see GetStructureVersion).
+    if ( children && !childrenShareable ) structureVersion++;
+}
+
+Variable & Variable::operator=(const Variable & other)
+{
+    if ( this != &other )
+    {
+        if ( children && !childrenShareable ) structureVersion++;
+        value = other.value;
+        str = other.str;
+        isNumber = other.isNumber;
+        isStructure = other.isStructure;
+        children = other.GetChildrenForCopy();
+        childrenShareable = true;
+    }
+
+    return *this;
+}
+
+Variable::Children & Variable::GetChildrenForWriting() const
+{
+    if ( !children )
+        children = std::make_shared<Children>();
+    else if ( !children.unique() ) //Children are shared with other variables, copy them.
+    {
+        children = std::make_shared<Children>(*children);
+        structureVersion++;
+    }
+
+    return *children;
+}
+
+std::shared_ptr<Variable::Children> Variable::GetChildrenForCopy() const
+{
+    //If a reference to a child was returned, it can be used to modify the child:
+    //the children can't be shared.
+    if ( children && !childrenShareable )
+        return std::make_shared<Children>(*children);
+
+    return children;
+}
+
+const std::map<gd::String, Variable> & Variable::GetAllChildren() const
+{
+    static const Children noChildren;
+    return children ? *children : noChildren;
+}
+
 /**
  * Get value as a double
  */
@@ -44,7 +107,7 @@ const gd::String & Variable::GetString() const
 
 bool Variable::HasChild(const gd::String & name) const
 {
-    return isStructure && children.find(name) != children.end();
+    return isStructure && children && children->find(name) != children->end();
 }
 
 /**
@@ -55,13 +118,14 @@ bool Variable::HasChild(const gd::String & name) const
  */
 Variable & Variable::GetChild(const gd::String & name)
 {
-    std::map<gd::String, Variable>::iterator it = children.find(name);
-    if ( it != children.end() ) return it->second;
+    Children & writableChildren = GetChildrenForWriting();
+    childrenShareable = false;
+
+    Children::iterator it = writableChildren.find(name);
+    if ( it != writableChildren.end() ) return it->second;
 
     isStructure = true;
-    Variable newEmptyVariable;
-    children[name] = newEmptyVariable;
-    return children[name];
+    return writableChildren[name];
 }
 
 /**
@@ -72,13 +136,16 @@ Variable & Variable::GetChild(const gd::String & name)
  */
 const Variable & Variable::GetChild(const gd::String & name) const
 {
-    std::map<gd::String, Variable>::iterator it = children.find(name);
-    if ( it != children.end() ) return it->second;
+    if ( children )
+    {
+        Children::const_iterator it = children->find(name);
+        if ( it != children->end() ) return it->second;
+    }
 
-    isStructure = true;
-    Variable newEmptyVariable;
-    children[name] = newEmptyVariable;
-    return children[name];
+    //The child is not added: the variable can be a child stored in children shared
+    //with copies, which must not be modified.
+    static const Variable emptyVariable;
+    return emptyVariable;
 }
 
 /**
@@ -89,8 +156,9 @@ const Variable & Variable::GetChild(const gd::String & name) const
  */
 void Variable::RemoveChild(const gd::String & name)
 {
-    if ( !isStructure ) return;
-    children.erase(name);
+    if ( !isStructure || !children ) return;
+    GetChildrenForWriting().erase(name);
+    structureVersion++;
 }
 
 void Variable::SerializeTo(SerializerElement & element) const
@@ -101,7 +169,8 @@ void Variable::SerializeTo(SerializerElement & element) const
     {
         SerializerElement & childrenElement = element.AddChild("children");
         childrenElement.ConsiderAsArrayOf("variable");
-        for (std::map<gd::String, gd::Variable>::iterator i = children.begin(); i != children.end(); ++i)
+        const Children & allChildren = GetAllChildren();
+        for (Children::const_iterator i = allChildren.begin(); i != allChildren.end(); ++i)
         {
             SerializerElement & variableElement = childrenElement.AddChild("variable");
             variableElement.SetAttribute("name", i->first);
@@ -125,7 +194,7 @@ void Variable::UnserializeFrom(const SerializerElement & element)
 
             gd::Variable childVariable;
             childVariable.UnserializeFrom(childElement);
-            children[name] = childVariable;
+            GetChildrenForWriting()[name] = childVariable;
         }
     }
     else
@@ -142,7 +211,8 @@ void Variable::SaveToXml(TiXmlElement * element) const
     {
         TiXmlElement * childrenElem = new TiXmlElement( "Children" );
         element->LinkEndChild( childrenElem );
-        for (std::map<gd::String, gd::Variable>::iterator i = children.begin(); i != children.end(); ++i)
+        const Children & allChildren = GetAllChildren();
+        for (Children::const_iterator i = allChildren.begin(); i != allChildren.end(); ++i)
         {
             TiXmlElement * variable = new TiXmlElement( "Variable" );
             childrenElem->LinkEndChild( variable );
@@ -167,7 +237,7 @@ void Variable::LoadFromXml(const TiXmlElement * element)
             gd::String name = child->Attribute("Name") ? child->Attribute("Name") : "";
             gd::Variable childVariable;
             childVariable.LoadFromXml(child);
-            children[name] = childVariable;
+            GetChildrenForWriting()[name] = childVariable;
 
             child = child->NextSiblingElement();
         }
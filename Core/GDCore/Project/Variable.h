@@ -8,6 +8,7 @@
 #define GDCORE_VARIABLE_H
 #include "GDCore/String.h"
 #include <map>
+#include <memory>
 namespace gd { class SerializerElement; }
 class TiXmlElement;
 
@@ -17,6 +18,10 @@ namespace gd
 /**
  * \brief Defines a variable which can be used by an object, a layout or a project.
  *
+ * The children of a structure are shared by the copies of the variable (copy-on-write):
+ * copying a variable, for example when an object is created from another one, is done
+ * in constant time and the children are only copied when one of the copies modifies them.
+ *
  * \see gd::VariablesContainer
  *
  * \ingroup PlatformDefinition
@@ -28,8 +33,11 @@ public:
     /**
      * \brief Default constructor creating a variable with 0 as value.
      */
-    Variable() : value(0), isNumber(true), isStructure(false) {};
-    virtual ~Variable() {};
+    Variable() : value(0), isNumber(true), isStructure(false), childrenShareable(true) {};
+    Variable(const Variable & other);
+    virtual ~Variable();
+
+    Variable & operator=(const Variable & other);
 
     /** \name Number or string
      * Methods and operators used when the variable is considered as a number or a string.
@@ -119,8 +127,8 @@ public:
     /**
      * \brief Return the child with the specified name.
      *
-     * If the variable has not the specified child, an empty variable with the specified name
-     * is added as child.
+     * If the variable has not the specified child, an empty variable is returned
+     * (the child is not added to the variable).
      */
     const Variable & GetChild(const gd::String & name) const;
 
@@ -135,7 +143,17 @@ public:
     /**
      * \brief Get the map containing all the children.
      */
-    const std::map<gd::String, Variable> & GetAllChildren() const { return children; }
+    const std::map<gd::String, Variable> & GetAllChildren() const;
+
+    /**
+     * \brief Return a number which is changed each time children returned by GetChild may have been
+     * destroyed or moved (when a structure whose children were returned is destroyed or assigned,
+     * when children are copied before being modified or when a child is removed).
+     *
+     * Adding a child to a variable does not change it: a pointer to a child stays valid as long as
+     * this number is not changed, and can be cached to avoid looking for the child again.
+     */
+    static std::size_t GetStructureVersion() { return structureVersion; }
 
     ///@}
 
@@ -166,11 +184,27 @@ public:
 
 
 private:
+    typedef std::map<gd::String, Variable> Children;
+
+    /**
+     * \brief Return the children, copied first if they are shared with other variables.
+     */
+    Children & GetChildrenForWriting() const;
+
+    /**
+     * \brief Return the children to be used by a copy of the variable: the same children
+     * if they can be shared, or a copy otherwise.
+     */
+    std::shared_ptr<Children> GetChildrenForCopy() const;
+
     mutable double value;
     mutable gd::String str;
     mutable bool isNumber; ///< True if the type of the variable is a number.
     mutable bool isStructure; ///< False when the variable is a primitive ( i.e: Number or String ), true when it is a structure and has may have children.
-    mutable std::map<gd::String, Variable> children; ///<Children, when the variable is considered as a structure.
+    mutable std::shared_ptr<Children> children; ///<Children, when the variable is considered as a structure. Can be shared with copies of the variable, or NULL if there are no children.
+    mutable bool childrenShareable; ///< False when a reference to a child was returned, so that the children must be copied when the variable is copied.
+
+    static std::size_t structureVersion; ///< See GetStructureVersion.
 };
 
 }
@@ -6,6 +6,7 @@
 
 #include "GDCore/String.h"
 
+#include <algorithm>
 #include <SFML/System/String.hpp>
 #include "GDCore/CommonTools.h"
 #include "GDCore/Utf8/utf8proc.h"
@@ -19,45 +20,71 @@ namespace gd
 {
 
 constexpr String::size_type String::npos;
+constexpr String::size_type String::indexStride;
+constexpr String::size_type String::minIndexedSize;
 
-String::String() : m_string()
+String::String() : m_string(), m_size(0), m_ascii(true)
 {
 
 }
 
-String::String(const char *characters) : m_string()
+String::String(const char *characters) : m_string(), m_size(0), m_ascii(true)
 {
     *this = characters;
 }
 
-String::String(const sf::String &string) : m_string()
+String::String(const sf::String &string) : m_string(), m_size(0), m_ascii(true)
 {
     *this = string;
 }
 
-String::String(const std::u32string &string) : m_string()
+String::String(const std::u32string &string) : m_string(), m_size(0), m_ascii(true)
 {
     *this = string;
 }
 
 #if defined(GD_IDE_ONLY) && !defined(GD_NO_WX_GUI)
 
-String::String(const wxString &string) : m_string()
+String::String(const wxString &string) : m_string(), m_size(0), m_ascii(true)
 {
     *this = string;
 }
 
 #endif
 
+String::String(String &&other) noexcept :
+    m_string(std::move(other.m_string)),
+    m_size(other.m_size),
+    m_ascii(other.m_ascii),
+    m_index(std::move(other.m_index))
+{
+    other.clear();
+}
+
+String& String::operator=(String &&other) noexcept
+{
+    if ( this != &other )
+    {
+        m_string = std::move(other.m_string);
+        m_size = other.m_size;
+        m_ascii = other.m_ascii;
+        m_index = std::move(other.m_index);
+        other.clear();
+    }
+
+    return *this;
+}
+
 String& String::operator=(const char *characters)
 {
     m_string = std::string(characters);
+    UpdateMetadata();
     return *this;
 }
 
 String& String::operator=(const sf::String &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -77,7 +104,7 @@ String& String::operator=(const sf::String &string)
 
 String& String::operator=(const std::u32string &string)
 {
-    m_string.clear();
+    clear();
 
     //In theory, an UTF8 character can be up to 6 bytes (even if in the current Unicode standard,
     //the last character is 4 bytes long when encoded in UTF8).
@@ -100,15 +127,111 @@ String& String::operator=(const std::u32string &string)
 String& String::operator=(const wxString &string)
 {
     m_string =  std::string(string.ToUTF8().data());
+    UpdateMetadata();
 
     return *this;
 }
 
 #endif
 
-String::size_type String::size() const
+void String::UpdateMetadata()
+{
+    //Count the bytes which are not continuation bytes (10xxxxxx), as each character
+    //starts with exactly one of them.
+    m_size = 0;
+    m_ascii = true;
+    for( std::string::const_iterator it = m_string.begin(); it != m_string.end(); ++it )
+    {
+        unsigned char byte = static_cast<unsigned char>(*it);
+        if ( byte >= 0x80 ) m_ascii = false;
+        if ( (byte & 0xC0) != 0x80 ) m_size++;
+    }
+
+    m_index.reset();
+    UpdateIndex(0, 0);
+}
+
+void String::UpdateIndex( size_type fromPosition, std::string::size_type fromBytePosition )
+{
+    if ( m_ascii || m_size < minIndexedSize )
+    {
+        m_index.reset();
+        return;
+    }
+
+    if ( !m_index ) //Nothing to keep, index the whole string.
+    {
+        fromPosition = 0;
+        fromBytePosition = 0;
+    }
+
+    //Keep the positions of the characters before fromPosition, and add the next ones.
+    std::size_t keptCount = std::min((fromPosition + indexStride - 1) / indexStride, m_index ? m_index->size() : 0);
+    std::size_t newCount = (m_size + indexStride - 1) / indexStride;
+    if ( m_index && keptCount == newCount && m_index->size() == newCount )
+        return;
+
+    //The index can be shared by copies of the string, so a new one is always created.
+    std::shared_ptr<std::vector<std::string::size_type>> index = std::make_shared<std::vector<std::string::size_type>>();
+    index->reserve(newCount);
+    if ( m_index ) index->assign(m_index->begin(), m_index->begin() + keptCount);
+
+    //As in UpdateMetadata, each character starts with a byte which is not a continuation byte (10xxxxxx).
+    size_type position = fromPosition;
+    for( std::string::size_type bytePosition = fromBytePosition; bytePosition < m_string.size(); ++bytePosition )
+    {
+        if ( (static_cast<unsigned char>(m_string[bytePosition]) & 0xC0) == 0x80 ) continue;
+
+        if ( position % indexStride == 0 )
+            index->push_back( bytePosition );
+        ++position;
+    }
+
+    m_index = index;
+}
+
+std::string::size_type String::GetBytePosition( size_type position ) const
 {
-    return std::distance(begin(), end());
+    if ( position >= m_size ) return m_string.size();
+    if ( m_ascii ) return position;
+
+    //Start from the nearest position stored in the index (if any), and go through the remaining characters.
+    std::string::const_iterator it = m_string.begin();
+    size_type currentPosition = 0;
+    if ( m_size >= minIndexedSize )
+    {
+        it += (*m_index)[position / indexStride];
+        currentPosition = position - position % indexStride;
+    }
+
+    for( ; currentPosition < position; ++currentPosition )
+        ::utf8::unchecked::next(it);
+
+    return std::distance(m_string.begin(), it);
+}
+
+String::size_type String::GetPositionFromBytePosition( std::string::size_type bytePosition ) const
+{
+    if ( m_ascii ) return bytePosition;
+
+    std::string::const_iterator it = m_string.begin();
+    size_type position = 0;
+    if ( m_size >= minIndexedSize )
+    {
+        //Find the last position stored in the index before the position in bytes.
+        const std::vector<std::string::size_type> & index = *m_index;
+        std::vector<std::string::size_type>::const_iterator indexIt =
+            std::upper_bound(index.begin(), index.end(), bytePosition) - 1;
+
+        it += *indexIt;
+        position = std::distance(index.begin(), indexIt) * indexStride;
+    }
+
+    std::string::const_iterator end = m_string.begin() + bytePosition;
+    for( ; it < end; ++position )
+        ::utf8::unchecked::next(it);
+
+    return position;
 }
 
 String::iterator String::begin()
@@ -175,10 +298,11 @@ String String::FromWide( const std::wstring &wstr )
     String str;
 
     #ifdef WINDOWS //std::wstring is an UTF16 string on Windows
-    ::utf8::utf16to8(wstr.begin(), wstr.end(), std::back_inserter(str.Raw()));
+    ::utf8::utf16to8(wstr.begin(), wstr.end(), std::back_inserter(str.m_string));
     #else //and a UTF32 string on other OSes
-    ::utf8::utf32to8(wstr.begin(), wstr.end(), std::back_inserter(str.Raw()));
+    ::utf8::utf32to8(wstr.begin(), wstr.end(), std::back_inserter(str.m_string));
     #endif
+    str.UpdateMetadata();
 
     return str;
 }
@@ -275,20 +399,29 @@ String& String::ReplaceInvalid( value_type replacement )
     ::utf8::replace_invalid(m_string.begin(), m_string.end(), std::back_inserter(validStr), replacement);
 
     m_string = validStr;
+    UpdateMetadata();
 
     return *this;
 }
 
 String::value_type String::operator[]( const String::size_type position ) const
 {
-    const_iterator it = begin();
-    std::advance(it, position);
-    return *it;
+    if ( m_ascii )
+        return static_cast<unsigned char>(m_string[position]);
+
+    return ::utf8::unchecked::peek_next(m_string.begin() + GetBytePosition(position));
 }
 
 String& String::operator+=( const String &other )
 {
+    //Only the appended characters are indexed (other can be the string itself).
+    size_type oldSize = m_size;
+    std::string::size_type oldByteSize = m_string.size();
+    m_ascii = m_ascii && other.m_ascii;
+    m_size += other.m_size;
     m_string += other.m_string;
+
+    UpdateIndex(oldSize, oldByteSize);
     return *this;
 }
 
@@ -316,28 +449,49 @@ String& String::operator+=( const wxString &other )
 
 void String::push_back( String::value_type character )
 {
+    std::string::size_type oldByteSize = m_string.size();
     ::utf8::unchecked::append(character, std::back_inserter(m_string));
+
+    m_size++;
+    m_ascii = m_ascii && character < 0x80;
+    UpdateIndex(m_size - 1, oldByteSize);
 }
 
 void String::pop_back()
 {
+    if ( m_ascii )
+    {
+        m_string.pop_back();
+        m_size--;
+        return;
+    }
+
     m_string.erase((--end()).base(), end().base());
+    UpdateMetadata();
 }
 
 String& String::insert( size_type pos, const String &str )
 {
-    iterator it = begin();
-    std::advance(it, pos);
+    if(pos > size())
+        throw std::out_of_range("[gd::String::insert] starting pos greater than size");
+
+    //Compute the new length before modifying the string, as str can be the string itself.
+    size_type newSize = size() + str.size();
+    bool ascii = m_ascii && str.m_ascii;
 
-    //Use the real position as bytes using the std::string::iterators
-    m_string.insert( std::distance(m_string.begin(), it.base()), str.m_string );
+    std::string::size_type bytePosition = GetBytePosition(pos);
+    m_string.insert( bytePosition, str.m_string );
 
+    m_size = newSize;
+    m_ascii = ascii;
+    UpdateIndex(pos, bytePosition);
     return *this;
 }
 
 String& String::replace( iterator i1, iterator i2, const String &str )
 {
     m_string.replace(i1.base(), i2.base(), str.m_string);
+    UpdateMetadata();
 
     return *this;
 }
@@ -347,27 +501,37 @@ String& String::replace( String::size_type pos, String::size_type len, const Str
     if(pos > size())
         throw std::out_of_range("[gd::String::replace] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance( i1, pos );
+    len = std::min(len, size() - pos);
+    size_type newSize = size() - len + str.size();
+    bool ascii = m_ascii && str.m_ascii;
 
-    iterator i2 = i1;
-    while(i2 != end() && len > 0) //Increment "len" times and stop if end() is reached
+    std::string::size_type byteStart = GetBytePosition(pos);
+    m_string.replace( byteStart, GetBytePosition(pos + len) - byteStart, str.m_string );
+
+    if ( ascii )
     {
-        ++i2;
-        --len;
+        m_size = newSize;
+        m_ascii = true;
+        m_index.reset();
     }
+    else
+        UpdateMetadata(); //The replaced characters could be the only non ASCII ones.
 
-    return replace( i1, i2, str );
+    return *this;
 }
 
 String::iterator String::erase( String::iterator first, String::iterator last )
 {
-    return iterator( m_string.erase( first.base(), last.base() ) );
+    std::string::iterator it = m_string.erase( first.base(), last.base() );
+    UpdateMetadata();
+    return iterator( it );
 }
 
 String::iterator String::erase( String::iterator p )
 {
-    return iterator( m_string.erase( p.base() ) );
+    std::string::iterator it = m_string.erase( p.base() );
+    UpdateMetadata();
+    return iterator( it );
 }
 
 void String::erase( String::size_type pos, String::size_type len )
@@ -375,17 +539,17 @@ void String::erase( String::size_type pos, String::size_type len )
     if(pos > size())
         throw std::out_of_range("[gd::String::erase] starting pos greater than size");
 
-    iterator i1 = begin();
-    std::advance(i1, pos);
+    len = std::min(len, size() - pos);
+    size_type newSize = size() - len;
+    bool ascii = m_ascii;
 
-    iterator i2 = i1;
-    while(i2 != end() && len != 0) //Increment "len" times and stop if end() is reached
-    {
-        ++i2;
-        len--;
-    }
+    std::string::size_type byteStart = GetBytePosition(pos);
+    m_string.erase( byteStart, GetBytePosition(pos + len) - byteStart );
 
-    erase( i1, i2 );
+    if ( ascii )
+        m_size = newSize;
+    else
+        UpdateMetadata(); //The erased characters could be the only non ASCII ones.
 }
 
 std::vector<String> String::Split( String::value_type delimiter ) const
@@ -471,6 +635,7 @@ String& String::Normalize(String::NormForm form)
         newStr = utf8proc_NFKC((unsigned char*)m_string.c_str());
 
     m_string = (char*)newStr;
+    UpdateMetadata();
 
     free(newStr);
 
@@ -479,53 +644,34 @@ String& String::Normalize(String::NormForm form)
 
 String String::substr( String::size_type start, String::size_type length ) const
 {
-    String str;
-
-    const_iterator startIt = begin();
-    while(start > 0 && startIt != end())
-    {
-        ++startIt;
-        --start;
-    }
-    if(start > 0) //We reach the end of the string before the start position
+    if(start > size())
         throw std::out_of_range("[gd::String::substr] starting pos greater than size");
 
-    const_iterator endIt = startIt;
-    while(length > 0 && endIt != end())
-    {
-        ++endIt;
-        --length;
-    }
+    length = std::min(length, size() - start);
 
-    str.m_string = std::string( startIt.base(), endIt.base() );
+    String str;
+    std::string::size_type byteStart = GetBytePosition(start);
+    str.m_string = m_string.substr( byteStart, GetBytePosition(start + length) - byteStart );
+
+    if ( m_ascii ) //A part of an ASCII string is an ASCII string.
+        str.m_size = length;
+    else
+        str.UpdateMetadata();
 
     return str;
 }
 
 String::size_type String::find( const String &search, String::size_type pos ) const
 {
-    const_iterator it = begin();
-
-    //Move to pos
-    if(pos < size())
-        std::advance( it, pos );
-    else
+    if(pos >= size())
         return npos;
 
-    //Use the standard std::string to find a string (using their internal std::strings).
-    //Use the raw std::string iterator to get the offset as a **byte** count for the starting
-    //position.
-    std::string::size_type findPos =
-        m_string.find( search.m_string, std::distance( m_string.begin(), it.base() ) );
+    //Use the standard std::string to find a string (using their internal std::strings),
+    //starting from the position of the character in **bytes**.
+    std::string::size_type findPos = m_string.find( search.m_string, GetBytePosition(pos) );
 
     if( findPos != std::string::npos )
-    {
-        //Create a String::iterator from the std::string::iterator pointing to the find result.
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance in **characters** count (that's why we need a String::iterator).
-        return std::distance( begin(), findPosIt );
-    }
+        return GetPositionFromBytePosition( findPos ); //Return the position in **characters**.
     else
         return npos;
 }
@@ -542,33 +688,14 @@ String::size_type String::find( const String::value_type search, String::size_ty
 
 String::size_type String::rfind( const String &search, String::size_type pos ) const
 {
-    //Move to pos + 1 (we will then get the last byte of the character at pos)
-    const_iterator it = begin();
-    std::string::const_iterator baseIt;
-    if( pos < size() ) //little optimization by testing npos directly (avoid calculating size())
-    {
-        std::advance( it, pos + 1 );
-        baseIt = it.base();
-        --baseIt; //Decrement the std::string::iterator by one because we need
-        //it to point to the last byte of the character at pos
-    }
-
     //The last character is included, so we need to put the position
-    //of the last byte of the character at the position "pos"
+    //of the last byte of the character at the position "pos" (the byte before the next character)
     std::string::size_type findPos = m_string.rfind( search.m_string,
-        pos < size() ? std::distance( m_string.begin(), baseIt ) : std::string::npos
+        pos < size() ? GetBytePosition( pos + 1 ) - 1 : std::string::npos
         );
 
     if( findPos != std::string::npos )
-    {
-        //Create a String::iterator to the find position to be able to get the real
-        //distance as characters count (it would be a distance as bytes count
-        //with a std::string::iterator)
-        const_iterator findPosIt( m_string.begin() + findPos );
-
-        //Return the distance (which is a distance as characters count)
-        return std::distance( begin(), findPosIt );
-    }
+        return GetPositionFromBytePosition( findPos ); //Return the position in **characters**.
     else
         return npos;
 }
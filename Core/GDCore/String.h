@@ -10,6 +10,7 @@
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -33,6 +34,10 @@ class String;
  *
  * This class represents an UTF8 encoded string. It provides almost the same features as the STL std::string class
  * but is UTF8 aware (size() returns the number of characters, not the number of bytes for example).
+ *
+ * The number of characters and whether the string contains only ASCII characters are stored and updated
+ * when the string is modified, so that the methods using positions (size, operator[], substr, find...) are
+ * in constant time (or proportional to the size of the searched string) for ASCII strings. See \ref Performance.
  */
 class GD_CORE_API String
 {
@@ -139,6 +144,13 @@ public:
 
 #endif
 
+    String(const String &other) = default;
+
+    /**
+     * Constructs a string by moving the content of **other**, which becomes empty.
+     */
+    String(String &&other) noexcept;
+
 /**
  * \}
  */
@@ -169,6 +181,10 @@ public:
 
 #endif
 
+    String& operator=(const String &other) = default;
+
+    String& operator=(String &&other) noexcept;
+
 /**
  * \}
  */
@@ -185,8 +201,9 @@ public:
 
     /**
      * \brief Returns the string's length.
+     * \note The length is updated when the string is modified: this method is in constant time.
      */
-    size_type size() const;
+    size_type size() const { return m_size; }
 
     /**
      * \brief Returns the string's length.
@@ -198,7 +215,7 @@ public:
      *
      * **Iterators :** Obviously, all iterators are invalidated.
      */
-    void clear() { m_string.clear(); }
+    void clear() { m_string.clear(); m_size = 0; m_ascii = true; m_index.reset(); }
 
 /**
  * \}
@@ -421,20 +438,32 @@ public:
     /**
      * \brief Returns the code point at the specified position
      * \warning This operator has a linear complexity on the character's
-     * position. You should avoid to use it in a loop and use the iterators
-     * provided by this class instead.
+     * position if the string contains non ASCII characters. You should avoid
+     * to use it in a loop and use the iterators provided by this class instead.
      */
     value_type operator[]( const size_type position ) const;
 
     /**
      * \brief Get the raw UTF8-encoded std::string
      */
-    std::string& Raw() { return m_string; }
+    const std::string& Raw() const { return m_string; }
 
     /**
-     * \brief Get the raw UTF8-encoded std::string
+     * \brief Modify the raw UTF8-encoded std::string, by calling **modify** with a reference to it.
+     *
+     * The length of the string is computed again after the call, so this method is linear on the string size.
+     *
+     * Usage:
+     * \code
+     * str.ModifyRaw([](std::string & raw) { raw.resize(24); });
+     * \endcode
      */
-    const std::string& Raw() const { return m_string; }
+    template<typename Function> String& ModifyRaw( Function modify )
+    {
+        modify(m_string);
+        UpdateMetadata();
+        return *this;
+    }
 
     /**
      * \brief Get the C-string.
@@ -693,8 +722,36 @@ public:
  */
 
 private:
-    std::string m_string; ///< Internal std::string container
+    /**
+     * \brief Compute the length of the string, if it contains only ASCII characters and its index.
+     * Must be called when the string is modified.
+     */
+    void UpdateMetadata();
+
+    /**
+     * \brief Update the index after the characters starting from **fromPosition** (and **fromBytePosition**)
+     * were modified, the characters before being unchanged. m_size and m_ascii must be up to date.
+     */
+    void UpdateIndex( size_type fromPosition, std::string::size_type fromBytePosition );
+
+    /**
+     * \brief Return the position in bytes of the character at the specified position, or the size
+     * of the string in bytes if the position is out of the string.
+     */
+    std::string::size_type GetBytePosition( size_type position ) const;
+
+    /**
+     * \brief Return the position of the character starting at the specified position in bytes.
+     */
+    size_type GetPositionFromBytePosition( std::string::size_type bytePosition ) const;
+
+    static constexpr size_type indexStride = 32; ///< The number of characters between two positions of the index.
+    static constexpr size_type minIndexedSize = 128; ///< The minimum length of the non ASCII strings using an index.
 
+    std::string m_string; ///< Internal std::string container
+    size_type m_size; ///< The number of characters.
+    bool m_ascii; ///< true if the string contains only ASCII characters.
+    std::shared_ptr<const std::vector<std::string::size_type>> m_index; ///< The positions in bytes of every indexStride characters, for long non ASCII strings (shared by the copies, null otherwise).
 };
 
 /**
@@ -902,8 +959,13 @@ namespace std
  * \section Performance Performance
  * The UTF8 encoding has the advantage to reduce the RAM consumption compared to UTF16 or UTF32 for strings using a lot
  * of latin characters. But the characters variable length brings some performance issues compared to fixed size encoding.
- * That's why the complexity of each methods is written in their documentation. For instance, the size() method is linear
- * on the string size and so is the operator[]().
+ * That's why the complexity of each methods is written in their documentation.
+ *
+ * To reduce this cost, the number of characters of the string, and if it contains only ASCII characters, are updated
+ * when the string is modified. For ASCII strings, a position is a position in bytes, so that size(), operator[](), substr()
+ * or find() don't have to go through the string. For long non ASCII strings, the positions in bytes of every 32 characters
+ * are also stored, so that finding a position only goes through a few characters. Appending to a string only goes through
+ * the appended characters. The const methods never modify the string, so it can be read by several threads at the same time.
  *
  * \section Conversion Conversions from/to other string types
  * The String handles implicit conversion with sf::String and wxString (implicit constructor and implicit conversion
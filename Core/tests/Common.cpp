@@ -66,6 +66,41 @@ TEST_CASE( "Variable", "[common]" ) {
         REQUIRE( variable.GetString() == "MyRealStdString" );
         REQUIRE( variable.IsNumber() == false );
     }
+    SECTION("Copies of structures") {
+        gd::Variable variable;
+        variable.GetChild("a").SetValue(1);
+        variable.GetChild("b").GetChild("c").SetString("Hello");
+
+        //Children are shared by the copies until they are modified.
+        gd::Variable copy = variable;
+        REQUIRE( copy.GetChild("a").GetValue() == 1 );
+        copy.GetChild("a").SetValue(2);
+        copy.GetChild("b").GetChild("c").SetString("World");
+        REQUIRE( variable.GetChild("a").GetValue() == 1 );
+        REQUIRE( variable.GetChild("b").GetChild("c").GetString() == "Hello" );
+        REQUIRE( copy.GetChild("b").GetChild("c").GetString() == "World" );
+
+        //A reference to a child can't be used to modify copies made after.
+        gd::Variable & child = variable.GetChild("b");
+        gd::Variable otherCopy = variable;
+        child.GetChild("c").SetString("Changed");
+        REQUIRE( otherCopy.GetChild("b").GetChild("c").GetString() == "Hello" );
+        REQUIRE( variable.GetChild("b").GetChild("c").GetString() == "Changed" );
+
+        //Getting a missing child of a const variable does not add it.
+        const gd::Variable constCopy = otherCopy;
+        REQUIRE( constCopy.GetChild("d").GetValue() == 0 );
+        REQUIRE( !constCopy.HasChild("d") );
+        REQUIRE( !otherCopy.HasChild("d") );
+        REQUIRE( constCopy.GetAllChildren().size() == 2 );
+
+        //Nor does it for a child stored in children shared with other copies.
+        const gd::Variable & sharedChild = constCopy.GetChild("b");
+        REQUIRE( sharedChild.GetChild("e").GetValue() == 0 );
+        REQUIRE( !sharedChild.HasChild("e") );
+        REQUIRE( !otherCopy.GetChild("b").HasChild("e") );
+        REQUIRE( otherCopy.GetChild("b").GetAllChildren().size() == 1 );
+    }
 }
 
 TEST_CASE( "EventsList", "[common][events]" ) {
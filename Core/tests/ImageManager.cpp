@@ -0,0 +1,151 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the memory budget of the images loaded by gd::ImageManager.
+ */
+#include <memory>
+#include "catch.hpp"
+#include "GDCore/Project/ImageManager.h"
+#include "GDCore/Project/ResourcesManager.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
+
+namespace
+{
+
+std::shared_ptr<SFMLTextureWrapper> CreateTexture()
+{
+	auto texture = std::make_shared<SFMLTextureWrapper>();
+	texture->texture.create(32, 32);
+	return texture;
+}
+
+const std::size_t textureBytes = 32*32*4;
+
+}
+
+TEST_CASE( "ImageManager", "[common][resources]" ) {
+	gd::ResourcesManager resourcesManager;
+	gd::ImageManager manager;
+	manager.SetResourcesManager(&resourcesManager);
+	manager.SetMemoryBudget(10*textureBytes);
+
+	SECTION("Counters") {
+		REQUIRE(CreateTexture()->GetTextureBytes() == textureBytes);
+		REQUIRE(manager.GetResidentBytes() == 0);
+
+		std::shared_ptr<SFMLTextureWrapper> a = manager.SetSFMLTextureAsLoaded("a", CreateTexture());
+		manager.SetSFMLTextureAsLoaded("b", CreateTexture());
+		REQUIRE(manager.GetResidentBytes() == 2*textureBytes);
+
+		REQUIRE(manager.GetSFMLTexture("a") == a);
+		REQUIRE(manager.GetSFMLTexture("b") != nullptr);
+		REQUIRE(manager.GetHitsCount() == 2);
+		REQUIRE(manager.GetMissesCount() == 0);
+
+		//The resource does not exist: the texture is not loaded.
+		REQUIRE(manager.GetSFMLTexture("c") != a);
+		REQUIRE(manager.GetMissesCount() == 1);
+		REQUIRE(manager.GetResidentBytes() == 2*textureBytes);
+		REQUIRE(manager.GetEvictionsCount() == 0);
+	}
+	SECTION("Least recently used images are unloaded first") {
+		manager.SetMemoryBudget(2*textureBytes);
+		manager.SetSFMLTextureAsLoaded("a", CreateTexture());
+		manager.SetSFMLTextureAsLoaded("b", CreateTexture());
+		manager.GetSFMLTexture("a"); //"b" is now the least recently used image.
+
+		manager.SetSFMLTextureAsLoaded("c", CreateTexture());
+		REQUIRE(manager.HasLoadedSFMLTexture("a"));
+		REQUIRE(!manager.HasLoadedSFMLTexture("b"));
+		REQUIRE(manager.HasLoadedSFMLTexture("c"));
+		REQUIRE(manager.GetEvictionsCount() == 1);
+		REQUIRE(manager.GetResidentBytes() == 2*textureBytes);
+
+		manager.SetSFMLTextureAsLoaded("d", CreateTexture());
+		REQUIRE(!manager.HasLoadedSFMLTexture("a"));
+		REQUIRE(manager.HasLoadedSFMLTexture("c"));
+		REQUIRE(manager.HasLoadedSFMLTexture("d"));
+		REQUIRE(manager.GetEvictionsCount() == 2);
+	}
+	SECTION("Images being used are not unloaded") {
+		manager.SetMemoryBudget(textureBytes);
+		std::shared_ptr<SFMLTextureWrapper> a = manager.SetSFMLTextureAsLoaded("a", CreateTexture());
+		manager.SetSFMLTextureAsLoaded("b", CreateTexture());
+		std::shared_ptr<SFMLTextureWrapper> c = manager.SetSFMLTextureAsLoaded("c", CreateTexture());
+
+		//Only "b" can be unloaded, so the budget is exceeded.
+		REQUIRE(manager.HasLoadedSFMLTexture("a"));
+		REQUIRE(!manager.HasLoadedSFMLTexture("b"));
+		REQUIRE(manager.HasLoadedSFMLTexture("c"));
+		REQUIRE(manager.GetEvictionsCount() == 1);
+		REQUIRE(manager.GetResidentBytes() == 2*textureBytes);
+
+		a.reset();
+		manager.SetMemoryBudget(textureBytes);
+		REQUIRE(!manager.HasLoadedSFMLTexture("a"));
+		REQUIRE(manager.HasLoadedSFMLTexture("c"));
+		REQUIRE(manager.GetEvictionsCount() == 2);
+		REQUIRE(manager.GetResidentBytes() == textureBytes);
+	}
+	SECTION("No budget") {
+		std::shared_ptr<SFMLTextureWrapper> a = manager.SetSFMLTextureAsLoaded("a", CreateTexture());
+		manager.SetSFMLTextureAsLoaded("b", CreateTexture());
+
+		//Images are unloaded as soon as they are not used.
+		manager.SetMemoryBudget(0);
+		REQUIRE(manager.HasLoadedSFMLTexture("a"));
+		REQUIRE(!manager.HasLoadedSFMLTexture("b"));
+		REQUIRE(manager.GetResidentBytes() == textureBytes);
+
+		//"c" is not used anymore after being loaded, so it is unloaded when "d" is loaded.
+		manager.SetSFMLTextureAsLoaded("c", CreateTexture());
+		manager.SetSFMLTextureAsLoaded("d", CreateTexture());
+		REQUIRE(!manager.HasLoadedSFMLTexture("c"));
+		REQUIRE(manager.HasLoadedSFMLTexture("d"));
+		REQUIRE(manager.GetResidentBytes() == 2*textureBytes);
+		REQUIRE(manager.GetEvictionsCount() == 2);
+	}
+	SECTION("Copy") {
+		manager.SetMemoryBudget(2*textureBytes);
+		manager.SetSFMLTextureAsLoaded("a", CreateTexture());
+		manager.SetSFMLTextureAsLoaded("b", CreateTexture());
+
+		//The copy has its own list of recently used images, sharing the textures.
+		gd::ImageManager copy(manager);
+		REQUIRE(copy.GetResidentBytes() == 2*textureBytes);
+		manager = gd::ImageManager();
+		REQUIRE(manager.GetResidentBytes() == 0);
+
+		copy.GetSFMLTexture("a");
+		copy.SetSFMLTextureAsLoaded("c", CreateTexture());
+		REQUIRE(copy.HasLoadedSFMLTexture("a"));
+		REQUIRE(!copy.HasLoadedSFMLTexture("b"));
+		REQUIRE(copy.HasLoadedSFMLTexture("c"));
+		REQUIRE(copy.GetResidentBytes() == 2*textureBytes);
+	}
+	SECTION("Images detached from their atlas") {
+		std::shared_ptr<SFMLTextureWrapper> atlas = CreateTexture();
+		auto packed = std::make_shared<SFMLTextureWrapper>();
+		packed->image.create(32, 32);
+		packed->SetAtlas(atlas, sf::IntRect(0, 0, 32, 32));
+		manager.SetSFMLTextureAsLoaded("packed", packed);
+		REQUIRE(manager.GetResidentBytes() == 0);
+
+		gd::Sprite sprite;
+		sprite.LoadImage(packed);
+		REQUIRE(sprite.GetSFMLSprite().getTexture() == &atlas->texture);
+
+		//The image is modified (for example by an action): it gets its own texture.
+		packed->DetachFromAtlas();
+		packed->texture.loadFromImage(packed->image);
+		manager.UpdateTextureBytes("packed");
+		REQUIRE(manager.GetResidentBytes() == textureBytes);
+
+		//The sprite displays the new texture.
+		REQUIRE(sprite.GetSFMLSprite().getTexture() == &packed->texture);
+		REQUIRE(sprite.GetSFMLSprite().getTextureRect() == sf::IntRect(0, 0, 32, 32));
+	}
+}
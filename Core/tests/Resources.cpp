@@ -12,8 +12,10 @@
 #include "GDCore/Tools/SystemStats.h"
 #include "GDCore/Tools/VersionWrapper.h"
 #include "GDCore/Project/Project.h"
+#include "GDCore/Project/Layout.h"
 #include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
 #include "GDCore/IDE/Project/ProjectResourcesAdder.h"
+#include "GDCore/IDE/Project/SceneResourcesFinder.h"
 #include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
 #include "GDCore/Serialization/Serializer.h"
 
@@ -45,6 +47,22 @@ TEST_CASE( "Resources", "[common][resources]" ) {
         image.SetFile("Lots\\\\Of\\\\\\..\\Backslashs");
         REQUIRE(image.GetFile() == "Lots//Of///../Backslashs");
     }
+    SECTION("Texture atlas") {
+        gd::ImageResource image;
+        image.SetFile("MyResourceFile");
+        image.SetAtlas("MyAtlas", 10, 20, 30, 40);
+
+        gd::SerializerElement element;
+        image.SerializeTo(element);
+        gd::ImageResource image2;
+        image2.UnserializeFrom(element);
+        REQUIRE(image2.GetAtlas() == "MyAtlas");
+        REQUIRE(image2.GetAtlasX() == 10);
+        REQUIRE(image2.GetAtlasY() == 20);
+        REQUIRE(image2.GetAtlasWidth() == 30);
+        REQUIRE(image2.GetAtlasHeight() == 40);
+        REQUIRE(image2.excludedFromAtlas == false);
+    }
     SECTION("ArbitraryResourceWorker") {
         gd::Project project;
         project.GetResourcesManager().AddResource("res1", "path/to/file1.png", "image");
@@ -89,6 +107,30 @@ TEST_CASE( "Resources", "[common][resources]" ) {
                 REQUIRE(remainingResources[0] == "res1");
                 REQUIRE(remainingResources[1] == "res4");
             }
+            SECTION("SceneResourcesFinder") {
+                gd::Layout & layout = project.InsertNewLayout("Scene", 0);
+                gd::SpriteObject layoutObj("myLayoutObject");
+                gd::Animation layoutAnim;
+                gd::Sprite layoutSprite;
+                layoutSprite.SetImageName("res3");
+                layoutAnim.SetDirectionsCount(1);
+                layoutAnim.GetDirection(0).AddSprite(layoutSprite);
+                layoutSprite.SetImageName("notExistingImage");
+                layoutAnim.GetDirection(0).AddSprite(layoutSprite);
+                layoutObj.AddAnimation(layoutAnim);
+                layout.InsertObject(layoutObj, 0);
+
+                gd::SceneResourcesFinder::UpdateResourcesManifests(project);
+                REQUIRE(layout.GetResourcesManifest().size() == 2);
+                REQUIRE(layout.GetResourcesManifest()[0] == "res1");
+                REQUIRE(layout.GetResourcesManifest()[1] == "res3");
+
+                gd::SerializerElement element;
+                layout.SerializeTo(element);
+                gd::Layout layout2;
+                layout2.UnserializeFrom(project, element);
+                REQUIRE(layout2.GetResourcesManifest() == layout.GetResourcesManifest());
+            }
         }
     }
 }
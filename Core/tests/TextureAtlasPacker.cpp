@@ -0,0 +1,152 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the packing of the images in texture atlases.
+ */
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include "catch.hpp"
+#include <SFML/Graphics/Image.hpp>
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
+#include "GDCore/Project/Project.h"
+#include "GDCore/Project/Layout.h"
+#include "GDCore/Project/ResourcesManager.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/SpriteObject.h"
+#include "GDCore/Extensions/Builtin/SpriteExtension/Animation.h"
+
+namespace
+{
+
+/**
+ * \brief Save an image filled with the color, and add it to the resources of the project.
+ */
+void AddImage(gd::Project & project, const gd::String & name, const gd::String & file,
+	unsigned int width, unsigned int height, sf::Color color)
+{
+	sf::Image image;
+	image.create(width, height, color);
+	image.saveToFile(file.ToLocale());
+
+	gd::ImageResource resource;
+	resource.SetName(name);
+	resource.SetFile(file);
+	project.GetResourcesManager().AddResource(resource);
+}
+
+/**
+ * \brief Add an object of the given type, displaying the images.
+ */
+void AddObject(gd::Layout & layout, const gd::String & type, const std::vector<gd::String> & images)
+{
+	gd::SpriteObject object("Object" + gd::String::From(layout.GetObjectsCount()));
+	object.SetType(type);
+
+	gd::Animation anim;
+	anim.SetDirectionsCount(1);
+	for (std::size_t i = 0;i<images.size();++i)
+	{
+		gd::Sprite sprite;
+		sprite.SetImageName(images[i]);
+		anim.GetDirection(0).AddSprite(sprite);
+	}
+	object.AddAnimation(anim);
+	layout.InsertObject(object, layout.GetObjectsCount());
+}
+
+gd::ImageResource & GetImage(gd::Project & project, const gd::String & name)
+{
+	return dynamic_cast<gd::ImageResource&>(project.GetResourcesManager().GetResource(name));
+}
+
+bool FileExists(const gd::String & file)
+{
+	return std::ifstream(file.ToLocale().c_str()).good();
+}
+
+}
+
+TEST_CASE( "TextureAtlasPacker", "[common][resources]" ) {
+	gd::Project project;
+	gd::Layout & layout = project.InsertNewLayout("Scene", 0);
+
+	AddImage(project, "a", "TextureAtlasPackerA.png", 32, 32, sf::Color::Red);
+	AddImage(project, "b", "TextureAtlasPackerB.png", 64, 16, sf::Color::Green);
+	AddImage(project, "c", "TextureAtlasPackerC.png", 8, 40, sf::Color::Blue);
+	AddImage(project, "shared", "TextureAtlasPackerShared.png", 16, 16, sf::Color::Yellow);
+	AddImage(project, "sharedCopy", "TextureAtlasPackerShared.png", 16, 16, sf::Color::Yellow);
+	AddImage(project, "excluded", "TextureAtlasPackerExcluded.png", 16, 16, sf::Color::White);
+	GetImage(project, "excluded").excludedFromAtlas = true;
+	AddImage(project, "big", "TextureAtlasPackerBig.png", gd::TextureAtlasPacker::maxImageSize+1, 8, sf::Color::Cyan);
+	AddImage(project, "usedByOtherObject", "TextureAtlasPackerOther.png", 16, 16, sf::Color::Magenta);
+
+	AddObject(layout, "Sprite", {"a", "b", "excluded", "usedByOtherObject"});
+	AddObject(layout, "Sprite", {"c", "shared", "big"});
+	AddObject(layout, "OtherObject", {"usedByOtherObject"});
+
+	REQUIRE(gd::TextureAtlasPacker::PackImages(project, ".") == 4);
+
+	SECTION("Packed images") {
+		const std::vector<gd::String> packedImages = {"a", "b", "c", "shared"};
+		const gd::String & atlasName = GetImage(project, "a").GetAtlas();
+		REQUIRE(!atlasName.empty());
+		REQUIRE(project.GetResourcesManager().HasResource(atlasName));
+
+		sf::Image atlas;
+		REQUIRE(atlas.loadFromFile(GetImage(project, atlasName).GetFile().ToLocale()));
+		REQUIRE(atlas.getSize().x <= gd::TextureAtlasPacker::atlasSize);
+		REQUIRE(atlas.getSize().y <= gd::TextureAtlasPacker::atlasSize);
+
+		std::vector<sf::IntRect> rects;
+		for (std::size_t i = 0;i<packedImages.size();++i)
+		{
+			gd::ImageResource & image = GetImage(project, packedImages[i]);
+			REQUIRE(image.GetAtlas() == atlasName);
+
+			sf::IntRect rect(image.GetAtlasX(), image.GetAtlasY(), image.GetAtlasWidth(), image.GetAtlasHeight());
+			REQUIRE(rect.left >= 0);
+			REQUIRE(rect.top >= 0);
+			REQUIRE(rect.left + rect.width <= static_cast<int>(atlas.getSize().x));
+			REQUIRE(rect.top + rect.height <= static_cast<int>(atlas.getSize().y));
+			for (std::size_t j = 0;j<rects.size();++j)
+				REQUIRE(!rect.intersects(rects[j]));
+			rects.push_back(rect);
+		}
+
+		//The rectangles have the size of the images, and contain their pixels.
+		REQUIRE(rects[0].width == 32);
+		REQUIRE(rects[0].height == 32);
+		REQUIRE(rects[1].width == 64);
+		REQUIRE(rects[1].height == 16);
+		REQUIRE(rects[2].width == 8);
+		REQUIRE(rects[2].height == 40);
+		REQUIRE(atlas.getPixel(rects[0].left, rects[0].top) == sf::Color::Red);
+		REQUIRE(atlas.getPixel(rects[0].left+31, rects[0].top+31) == sf::Color::Red);
+		REQUIRE(atlas.getPixel(rects[1].left+63, rects[1].top+15) == sf::Color::Green);
+		REQUIRE(atlas.getPixel(rects[2].left+7, rects[2].top+39) == sf::Color::Blue);
+		REQUIRE(atlas.getPixel(rects[3].left, rects[3].top) == sf::Color::Yellow);
+	}
+	SECTION("Images not packed") {
+		REQUIRE(GetImage(project, "sharedCopy").GetAtlas().empty());
+		REQUIRE(GetImage(project, "excluded").GetAtlas().empty());
+		REQUIRE(GetImage(project, "big").GetAtlas().empty());
+		REQUIRE(GetImage(project, "usedByOtherObject").GetAtlas().empty());
+	}
+	SECTION("Files of the packed images") {
+		//The files only used by packed images are not exported.
+		REQUIRE(!FileExists("TextureAtlasPackerA.png"));
+		REQUIRE(!FileExists("TextureAtlasPackerB.png"));
+		REQUIRE(!FileExists("TextureAtlasPackerC.png"));
+		REQUIRE(FileExists("TextureAtlasPackerShared.png"));
+		REQUIRE(FileExists("TextureAtlasPackerExcluded.png"));
+		REQUIRE(FileExists("TextureAtlasPackerBig.png"));
+		REQUIRE(FileExists("TextureAtlasPackerOther.png"));
+	}
+
+	std::vector<gd::String> resources = project.GetResourcesManager().GetAllResourcesList();
+	for (std::size_t i = 0;i<resources.size();++i)
+		std::remove(project.GetResourcesManager().GetResource(resources[i]).GetFile().ToLocale().c_str());
+}
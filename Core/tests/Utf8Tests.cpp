@@ -7,9 +7,11 @@
  * @file Tests covering utf8 features from GDevelop Core.
  */
 
+#include <chrono>
 #include <exception>
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "catch.hpp"
 #include "GDCore/String.h"
@@ -280,4 +282,156 @@ TEST_CASE( "Utf8 String", "[common][utf8]") {
 		gd::String str6 = u8"ßßß";
 		REQUIRE( str6.FindAndReplace(u8"ßß", u8"ß") == u8"ßß");
 	}
+
+	SECTION("length after modifications") {
+		gd::String str = u8"UTF8 test";
+		REQUIRE( str.size() == 9 );
+		REQUIRE( str[5] == U't' );
+
+		str += u8" a été";
+		REQUIRE( str.size() == 15 );
+		REQUIRE( str[13] == U't' );
+		REQUIRE( str.find(u8"été") == 12 );
+
+		str.erase(9, 2);
+		REQUIRE( str == u8"UTF8 test été" );
+		REQUIRE( str.size() == 13 );
+
+		str.replace(10, 3, u8"ok");
+		REQUIRE( str == u8"UTF8 test ok" );
+		REQUIRE( str.size() == 12 );
+		REQUIRE( str[11] == U'k' );
+
+		str.insert(0, u8"é");
+		REQUIRE( str.size() == 13 );
+		REQUIRE( str[1] == U'U' );
+
+		str.ModifyRaw([](std::string & raw) { raw = "ASCII"; });
+		REQUIRE( str.size() == 5 );
+		REQUIRE( str.Raw() == "ASCII" );
+
+		gd::String moved = std::move(str);
+		REQUIRE( moved.size() == 5 );
+		REQUIRE( str.size() == 0 );
+	}
+
+	SECTION("long non ASCII strings") {
+		gd::String str;
+		for(std::size_t i = 0; i < 100; ++i)
+			str += u8"aé";
+		str += u8"Fin";
+
+		REQUIRE( str.size() == 203 );
+		REQUIRE( str[0] == U'a' );
+		REQUIRE( str[99] == U'é' );
+		REQUIRE( str[200] == U'F' );
+		REQUIRE( str.substr(198, 4) == u8"aéFi" );
+		REQUIRE( str.find(u8"Fin") == 200 );
+		REQUIRE( str.find(u8"éa", 100) == 101 );
+		REQUIRE( str.rfind(u8"aé", 150) == 150 );
+		REQUIRE( str.rfind(u8"aé", 149) == 148 );
+
+		gd::String copy = str;
+		copy.erase(0, 2);
+		REQUIRE( copy.size() == 201 );
+		REQUIRE( copy.find(u8"Fin") == 198 );
+		REQUIRE( str.find(u8"Fin") == 200 );
+	}
+
+	SECTION("positions in long non ASCII strings after modifications") {
+		//Compare the positions with the characters found using the iterators.
+		auto checkPositions = [](const gd::String & str) {
+			std::size_t position = 0;
+			for(gd::String::const_iterator it = str.begin(); it != str.end(); ++it, ++position)
+			{
+				if ( str[position] != *it ) return false;
+			}
+
+			return position == str.size();
+		};
+
+		gd::String str;
+		for(std::size_t i = 0; i < 100; ++i)
+		{
+			str.push_back(U'é');
+			str += u8"ab";
+		}
+		REQUIRE( str.size() == 300 );
+		REQUIRE( checkPositions(str) );
+
+		gd::String copy = str;
+		str.insert(40, u8"ßß");
+		REQUIRE( str.size() == 302 );
+		REQUIRE( checkPositions(str) );
+		REQUIRE( checkPositions(copy) );
+
+		str.erase(10, 100);
+		REQUIRE( str.size() == 202 );
+		REQUIRE( checkPositions(str) );
+
+		str.replace(0, 50, u8"€");
+		REQUIRE( str.size() == 153 );
+		REQUIRE( checkPositions(str) );
+
+		for(std::size_t i = 0; i < 40; ++i)
+			str.pop_back();
+		REQUIRE( str.size() == 113 );
+		REQUIRE( checkPositions(str) );
+
+		str += str;
+		REQUIRE( str.size() == 226 );
+		REQUIRE( checkPositions(str) );
+
+		str.ModifyRaw([](std::string & raw) { raw.erase(0, raw.find("a")); });
+		REQUIRE( checkPositions(str) );
+		REQUIRE( str[0] == U'a' );
+	}
+
+	SECTION("move") {
+		REQUIRE( std::is_nothrow_move_constructible<gd::String>::value );
+		REQUIRE( std::is_nothrow_move_assignable<gd::String>::value );
+	}
+}
+
+TEST_CASE( "Utf8 String benchmark", "[.][benchmark]" ) {
+	//Use the position based methods like StrLength, SubStr and StrFind expressions do,
+	//and compare with going through the characters using the iterators.
+	auto measure = [](const std::string & label, const gd::String & str) {
+		const std::size_t iterations = 200;
+		std::size_t result = 0;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for(std::size_t i = 0; i < iterations; ++i)
+		{
+			gd::String::size_type size = std::distance(str.begin(), str.end());
+			for(std::size_t pos = 0; pos < size; pos += size / 20)
+			{
+				gd::String::const_iterator it = str.begin();
+				std::advance(it, pos);
+				result += *it;
+			}
+		}
+		auto middle = std::chrono::high_resolution_clock::now();
+		for(std::size_t i = 0; i < iterations; ++i)
+		{
+			gd::String::size_type size = str.size();
+			for(std::size_t pos = 0; pos < size; pos += size / 20)
+				result += str[pos] + str.substr(pos, 3).size() + str.find(u8"é", pos);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		std::cout << label << ": iterating " << std::chrono::duration<double, std::micro>(middle - start).count() / iterations
+			<< " us, using positions " << std::chrono::duration<double, std::micro>(end - middle).count() / iterations
+			<< " us (per iteration, " << result % 2 << ")" << std::endl;
+	};
+
+	gd::String asciiStr, nonAsciiStr;
+	for(std::size_t i = 0; i < 1000; ++i)
+	{
+		asciiStr += u8"UTF8 a ete teste ! ";
+		nonAsciiStr += u8"UTF8 a été testé ! ";
+	}
+
+	measure("ASCII string", asciiStr);
+	measure("Non ASCII string", nonAsciiStr);
 }
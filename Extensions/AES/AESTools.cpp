@@ -25,7 +25,7 @@ void GD_EXTENSION_API EncryptFile( const gd::String & srcFile, const gd::String
     while ( passwordWith24characters.Raw().length() < 24 ) //Test the real size as bytes
         passwordWith24characters += " ";
     if ( passwordWith24characters.Raw().length() > 24 )
-        passwordWith24characters.Raw().resize(24);
+        passwordWith24characters.ModifyRaw([](std::string & raw) { raw.resize(24); });
 
     ifstream ifile(srcFile.ToLocale().c_str(),ios_base::binary);
     ofstream ofile(destFile.ToLocale().c_str(),ios_base::binary);
@@ -62,7 +62,7 @@ void GD_EXTENSION_API DecryptFile( const gd::String & srcFile, const gd::String
     while ( passwordWith24characters.Raw().length() < 24 ) //Test the real size as bytes
         passwordWith24characters += " ";
     if ( passwordWith24characters.Raw().length() > 24 )
-        passwordWith24characters.Raw().resize(24);
+        passwordWith24characters.ModifyRaw([](std::string & raw) { raw.resize(24); });
 
     ifstream ifile(srcFile.ToLocale().c_str(),ios_base::binary);
     ofstream ofile(destFile.ToLocale().c_str(),ios_base::binary);
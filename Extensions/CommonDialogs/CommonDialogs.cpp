@@ -70,8 +70,10 @@ void GD_EXTENSION_API ShowOpenFile( RuntimeScene & scene, gd::Variable & variabl
     //Display the dialog
     #if defined(WINDOWS)
     //Process filters to match windows dialogs filters style.
-    filters.Raw() = filters.Raw()+'\0';
-    std::replace(filters.Raw().begin(), filters.Raw().end(), '|', '\0');
+    filters.ModifyRaw([](std::string & raw) {
+        raw += '\0';
+        std::replace(raw.begin(), raw.end(), '|', '\0');
+    });
 
     OPENFILENAMEW toGetFileName; //Struct for the dialog
     wchar_t filePath[MAX_PATH];
@@ -119,8 +121,10 @@ void GD_EXTENSION_API ShowYesNoMsgBox( RuntimeScene & scene, gd::Variable & vari
         result = "no";
     #endif
     #if defined(LINUX) || defined(MACOS)
-    nw::YesNoMsgBox dialog(title.ToLocale(), message.ToLocale(), result.Raw());
+    std::string answer;
+    nw::YesNoMsgBox dialog(title.ToLocale(), message.ToLocale(), answer);
     dialog.wait_until_closed();
+    result = gd::String::FromUTF8(answer);
     #endif
 
     scene.GetTimeManager().NotifyPauseWasMade(timeSpent.getElapsedTime().asMicroseconds());//Don't take the time spent in this function in account.
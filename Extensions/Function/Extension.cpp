@@ -18,6 +18,7 @@ This project is released under the MIT License.
 #if defined(GD_IDE_ONLY)
 #include "GDCore/Events/Parsers/ExpressionParser.h"
 #include "GDCore/Events/Instruction.h"
+#include "GDCpp/Events/CodeGeneration/EventsCodeGenerator.h"
 #endif
 #include "FunctionEvent.h"
 
@@ -69,20 +70,17 @@ public:
                     return "//Function \""+functionName+"\" not found.\n";
                 }
 
-                codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(layout, *functionEvent)+"(RuntimeContext *, std::map <gd::String, std::vector<RuntimeObject*> *>, std::vector<gd::String> &);\n");
+                codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(layout, *functionEvent)+"(RuntimeContext *, ObjectsListsView, std::vector<gd::String> &);\n");
                 gd::String code;
 
                 //Generate code for objects passed as arguments
                 gd::String objectsAsArgumentCode;
                 {
-                    objectsAsArgumentCode += "runtimeContext->ClearObjectListsMap()";
                     std::vector<gd::String> realObjects = codeGenerator.ExpandObjectsName(functionEvent->GetObjectsPassedAsArgument(), context);
                     for (std::size_t i = 0;i<realObjects.size();++i)
-                    {
                         context.EmptyObjectsListNeeded(realObjects[i]);
-                        objectsAsArgumentCode += ".AddObjectListToMap(\""+codeGenerator.ConvertToString(realObjects[i])+"\", "+ManObjListName(realObjects[i])+")";
-                    }
-                    objectsAsArgumentCode += ".ReturnObjectListsMap()";
+
+                    objectsAsArgumentCode += EventsCodeGenerator::GenerateObjectsListsViewCode(codeGenerator, realObjects);
                 }
 
                 //Generate code for evaluating parameters
@@ -114,11 +112,11 @@ public:
                 const gd::Layout & layout = codeGenerator.GetLayout();
 
                 //Declaring function prototype.
-                codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(layout, event)+"(RuntimeContext *, std::map <gd::String, std::vector<RuntimeObject*> *>, std::vector<gd::String> &);\n");
+                codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(layout, event)+"(RuntimeContext *, ObjectsListsView, std::vector<gd::String> &);\n");
 
                 //Generating function code:
                 gd::String functionCode;
-                functionCode += "\nvoid "+FunctionEvent::MangleFunctionName(layout, event)+"(RuntimeContext * runtimeContext, std::map <gd::String, std::vector<RuntimeObject*> *> objectsListsMap, std::vector<gd::String> & currentFunctionParameters)\n{\n";
+                functionCode += "\nvoid "+FunctionEvent::MangleFunctionName(layout, event)+"(RuntimeContext * runtimeContext, ObjectsListsView objectsLists, std::vector<gd::String> & currentFunctionParameters)\n{\n";
 
                 gd::EventsCodeGenerationContext callerContext;
                 {
@@ -127,7 +125,8 @@ public:
                     {
                         callerContext.EmptyObjectsListNeeded(realObjects[i]);
                         functionCode += "std::vector<RuntimeObject*> "+ManObjListName(realObjects[i]) + ";\n";
-                        functionCode += "if ( objectsListsMap[\""+realObjects[i]+"\"] != NULL ) "+ManObjListName(realObjects[i])+" = *objectsListsMap[\""+realObjects[i]+"\"];\n";
+                        gd::String nameIdName = EventsCodeGenerator::GetObjectNameIdName(codeGenerator, realObjects[i]);
+                        functionCode += "if ( objectsLists.Get("+nameIdName+") != NULL ) "+ManObjListName(realObjects[i])+" = *objectsLists.Get("+nameIdName+");\n";
                     }
                 }
                 functionCode += "{";
@@ -25,7 +25,7 @@ namespace LinkedObjects
 std::map < RuntimeScene* , ObjectsLinksManager > ObjectsLinksManager::managers;
 
 bool GD_EXTENSION_API PickObjectsLinkedTo(RuntimeScene & scene,
-                                          std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectsLists,
+                                          ObjectsListsView pickedObjectsLists,
                                           RuntimeObject * object)
 {
     if (!object) return false;
@@ -11,6 +11,7 @@ This project is released under the MIT License.
 #include <map>
 #include <vector>
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 class RuntimeObject;
 class RuntimeScene;
 
@@ -23,7 +24,7 @@ namespace LinkedObjects
 void GD_EXTENSION_API LinkObjects(RuntimeScene & scene, RuntimeObject * a, RuntimeObject * b );
 void GD_EXTENSION_API RemoveLinkBetween(RuntimeScene & scene, RuntimeObject * a, RuntimeObject * b);
 void GD_EXTENSION_API RemoveAllLinksOf(RuntimeScene & scene, RuntimeObject * object);
-bool GD_EXTENSION_API PickObjectsLinkedTo(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectsLists, RuntimeObject * object);
+bool GD_EXTENSION_API PickObjectsLinkedTo(RuntimeScene & scene, ObjectsListsView pickedObjectsLists, RuntimeObject * object);
 
 }
 
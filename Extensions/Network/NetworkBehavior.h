@@ -10,6 +10,7 @@ This project is released under the MIT License.
 
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 #include "SceneNetworkDatas.h"
 #include <map>
 namespace gd { class SerializerElement; }
@@ -61,7 +62,7 @@ public:
     /**
      * Generate a unique identifier for all objects of list, using behavior named behaviorName.
      */
-    static void GenerateObjectNetworkIdentifier(std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists, const gd::String & behaviorName);
+    static void GenerateObjectNetworkIdentifier(ObjectsListsView objectsLists, const gd::String & behaviorName);
 
 private:
 
@@ -10,6 +10,8 @@ This project is released under the MIT License.
 #include "GDCore/Tools/Version.h"
 #include "PathfindingBehavior.h"
 #include "PathfindingObstacleBehavior.h"
+#include "PathfindingJobsQueue.h"
+#include <set>
 
 
 /**
@@ -60,6 +62,33 @@ public:
                 .AddParameter("expression", _("Destination Y position"))
                 .SetFunctionName("MoveTo").SetIncludeFile("PathfindingBehavior/PathfindingBehavior.h");
 
+            aut.AddAction("SetDestinationAsync",
+                           _("Move to a position (computed in background)"),
+                           _("Move the object to a position, computing the path in background. The object moves once the path is ready."),
+                           _("Move _PARAM0_ to _PARAM3_;_PARAM4_ (path computed in background)"),
+                           _(""),
+                           "CppPlatform/Extensions/AStaricon24.png",
+                           "CppPlatform/Extensions/AStaricon16.png")
+                .AddParameter("object", _("Object"))
+                .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+                .AddCodeOnlyParameter("currentScene", "")
+
+                .AddParameter("expression", _("Destination X position"))
+                .AddParameter("expression", _("Destination Y position"))
+                .SetFunctionName("MoveToAsync").SetIncludeFile("PathfindingBehavior/PathfindingBehavior.h");
+
+            aut.AddCondition("PathReady",
+                           _("Path ready"),
+                           _("Return true if the path asked with \"Move to a position (computed in background)\" is ready."),
+                           _("The path of _PARAM0_ is ready"),
+                           _(""),
+                           "CppPlatform/Extensions/AStaricon24.png",
+                           "CppPlatform/Extensions/AStaricon16.png")
+
+                .AddParameter("object", _("Object"))
+                .AddParameter("behavior", _("Behavior"), "PathfindingBehavior")
+                .SetFunctionName("PathReady").SetIncludeFile("PathfindingBehavior/PathfindingBehavior.h");
+
 
             aut.AddCondition("PathFound",
                            _("Path found"),
@@ -555,6 +584,35 @@ public:
 
         GD_COMPLETE_EXTENSION_COMPILATION_INFORMATION();
     };
+
+    /**
+     * \brief Stop the workers computing paths in background.
+     */
+    virtual ~Extension()
+    {
+        PathfindingJobsQueue::DestroySingleton();
+    }
+
+    /**
+     * \brief Remember the scene, so that the workers computing paths are stopped when no scene is loaded.
+     */
+    virtual void SceneLoaded(RuntimeScene & scene)
+    {
+        loadedScenes.insert(&scene);
+    }
+
+    /**
+     * \brief Stop the workers computing paths when the last scene is unloaded (they are started again
+     * when a path is asked).
+     */
+    virtual void SceneUnloaded(RuntimeScene & scene)
+    {
+        loadedScenes.erase(&scene);
+        if ( loadedScenes.empty() ) PathfindingJobsQueue::DestroySingleton();
+    }
+
+private:
+    std::set<RuntimeScene*> loadedScenes; ///< The scenes loaded, using the extension.
 };
 
 /**
@@ -9,9 +9,13 @@ This project is released under the MIT License.
 #include <unordered_map>
 #include <iostream>
 #include <set>
+#include <vector>
 #include "PathfindingBehavior.h"
 #include "PathfindingObstacleBehavior.h"
 #include "ScenePathfindingObstaclesManager.h"
+#include "PathfindingCostGrid.h"
+#include "PathfindingGoalField.h"
+#include "PathfindingJobsQueue.h"
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Extensions/Builtin/MathematicalTools.h"
 #include "GDCpp/Runtime/Project/Layout.h"
@@ -21,10 +25,12 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/CommonTools.h"
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
 #include <algorithm>
 #if defined(GD_IDE_ONLY)
 #include <map>
 #include "GDCore/IDE/Dialogs/PropertyDescriptor.h"
+#include "GDCpp/IDE/BaseProfiler.h"
 #endif
 
 
@@ -75,9 +81,9 @@ namespace
 class Node
 {
 public:
-    Node() : pos(0, 0), cost(0), smallestCost(-1), estimateCost(-1), parent(NULL), open(true) {};
-    Node(int x, int y) : pos(x, y), cost(0), smallestCost(-1), estimateCost(-1), parent(NULL), open(true) {};
-    Node(const NodePosition & pos_) : pos(pos_), cost(0), smallestCost(-1), estimateCost(-1), parent(NULL), open(true) {};
+    Node() : pos(0, 0), cost(0), smallestCost(-1), estimateCost(-1), parent(NULL), open(true), openIndex(0), openOrder(0) {};
+    Node(int x, int y) : pos(x, y), cost(0), smallestCost(-1), estimateCost(-1), parent(NULL), open(true), openIndex(0), openOrder(0) {};
+    Node(const NodePosition & pos_) : pos(pos_), cost(0), smallestCost(-1), estimateCost(-1), parent(NULL), open(true), openIndex(0), openOrder(0) {};
 
     NodePosition pos;
     float cost; ///< The cost for traveling on this node
@@ -85,23 +91,152 @@ public:
     float estimateCost; ///< the estimate cost total to go to the destination through this node (when considering the shortest path).
     const Node * parent; ///< The previous node to be visited to go to this node (when considering the shortest path).
     bool open; ///< true if the node is "open" (must be explored), false if "close" (already explored)
+    std::size_t openIndex; ///< The position of the node in the heap of open nodes.
+    std::size_t openOrder; ///< The number of nodes opened or updated before this one, used to explore first the oldest of nodes having the same estimate cost.
+};
+
+bool operator==(Node const& n1, Node const& n2)
+{
+    return n1.pos.x == n2.pos.x && n1.pos.y == n2.pos.y;
+};
+
+/**
+ * \brief Internal tool class allocating the nodes by blocks, so that creating a node
+ * does not allocate memory most of the time.
+ *
+ * The nodes are never moved, so that pointers to them stay valid until the pool is cleared.
+ */
+class NodesPool
+{
+public:
+    NodesPool() : usedNodesCount(0) {};
 
     /**
-     * \brief Tool function used to store a Node in a priority_queue.
+     * \brief Create a new node at the specified position.
      */
-    class NodeComparator
+    Node & Create(const NodePosition & pos)
     {
-    public:
-        bool operator()(const Node * n1, const Node * n2)
-        {
-            return n1->estimateCost < n2->estimateCost;
-        }
-    };
+        std::size_t blockIndex = usedNodesCount/blockSize;
+        if ( blockIndex >= blocks.size() ) blocks.push_back(std::unique_ptr<Node[]>(new Node[blockSize]));
+
+        Node & node = blocks[blockIndex][usedNodesCount%blockSize];
+        node = Node(pos);
+        usedNodesCount++;
+        return node;
+    }
+
+    /**
+     * \brief Forget all the nodes, keeping the memory for the next ones.
+     */
+    void Clear() { usedNodesCount = 0; }
+
+private:
+    static const std::size_t blockSize = 256;
+
+    std::vector<std::unique_ptr<Node[]>> blocks;
+    std::size_t usedNodesCount;
 };
 
-bool operator==(Node const& n1, Node const& n2)
+/**
+ * \brief Internal tool class storing the open nodes in a binary heap, the most promising node
+ * (the one with the smallest estimate cost) being the first.
+ *
+ * Each node knows its position in the heap, so that its estimate cost can be updated
+ * without searching for it.
+ */
+class OpenNodesHeap
 {
-    return n1.pos.x == n2.pos.x && n1.pos.y == n2.pos.y;
+public:
+    OpenNodesHeap() : openedNodesCount(0) {};
+
+    bool IsEmpty() const { return nodes.empty(); }
+
+    void Clear()
+    {
+        nodes.clear();
+        openedNodesCount = 0;
+    }
+
+    /**
+     * \brief Add a node which is not in the heap.
+     */
+    void Push(Node * node)
+    {
+        node->openOrder = openedNodesCount++;
+        node->openIndex = nodes.size();
+        nodes.push_back(node);
+        SiftUp(node->openIndex);
+    }
+
+    /**
+     * \brief Move a node of the heap after a change of its estimate cost.
+     */
+    void Update(Node * node)
+    {
+        node->openOrder = openedNodesCount++;
+        SiftUp(node->openIndex);
+        SiftDown(node->openIndex);
+    }
+
+    /**
+     * \brief Remove and return the most promising node.
+     */
+    Node * Pop()
+    {
+        Node * first = nodes[0];
+        Node * last = nodes.back();
+        nodes.pop_back();
+        if ( !nodes.empty() )
+        {
+            Place(last, 0);
+            SiftDown(0);
+        }
+
+        return first;
+    }
+
+private:
+    static bool IsBefore(const Node * n1, const Node * n2)
+    {
+        return n1->estimateCost < n2->estimateCost ||
+            (n1->estimateCost == n2->estimateCost && n1->openOrder < n2->openOrder);
+    }
+
+    void Place(Node * node, std::size_t index)
+    {
+        nodes[index] = node;
+        node->openIndex = index;
+    }
+
+    void SiftUp(std::size_t index)
+    {
+        Node * node = nodes[index];
+        while (index > 0 && IsBefore(node, nodes[(index-1)/2]))
+        {
+            Place(nodes[(index-1)/2], index);
+            index = (index-1)/2;
+        }
+        Place(node, index);
+    }
+
+    void SiftDown(std::size_t index)
+    {
+        Node * node = nodes[index];
+        while (true)
+        {
+            std::size_t child = 2*index+1;
+            if ( child >= nodes.size() ) break;
+            if ( child+1 < nodes.size() && IsBefore(nodes[child+1], nodes[child]) ) child++;
+            if ( !IsBefore(nodes[child], node) ) break;
+
+            Place(nodes[child], index);
+            index = child;
+        }
+        Place(node, index);
+    }
+
+    std::vector<Node*> nodes;
+    std::size_t openedNodesCount;
 };
 
 typedef float (*DistanceFunPtr)(const NodePosition & , const NodePosition & );
@@ -113,20 +248,15 @@ typedef float (*DistanceFunPtr)(const NodePosition & , const NodePosition & );
 class SearchContext
 {
 public:
-    SearchContext(ScenePathfindingObstaclesManager & obstacles_, bool allowsDiagonal_ = true) :
-        obstacles(obstacles_),
+    SearchContext(const PathfindingCostGrid & costGrid_, bool allowsDiagonal_ = true) :
+        costGrid(costGrid_),
         finalNode(NULL),
         destination(0, 0),
         startX(0),
         startY(0),
         allowsDiagonal(allowsDiagonal_),
-        maxComplexityFactor(50),
         cellWidth(20),
-        cellHeight(20),
-        leftBorder(0),
-        rightBorder(0),
-        topBorder(0),
-        bottomBorder(0)
+        cellHeight(20)
     {
         distanceFunction = allowsDiagonal ? &SearchContext::EuclideanDistance : &SearchContext::ManhattanDistance;
     }
@@ -143,20 +273,10 @@ public:
         return *this;
     }
 
-    /**
-     * \brief Set the size to be considered for the object for which the path will be planned.
-     */
-    SearchContext & SetObjectSize(float leftBorder_, float topBorder_, float rightBorder_, float bottomBorder_)
-    {
-        leftBorder = leftBorder_;
-        rightBorder = rightBorder_;
-        topBorder = topBorder_;
-        bottomBorder = bottomBorder_;
-        return *this;
-    }
-
     /**
      * \brief Change the size of a virtual cell, in pixels.
+     *
+     * \note It must be the size used by the cost grid passed in the constructor.
      */
     SearchContext & SetCellSize(unsigned int cellWidth_, unsigned int cellHeight_)
     {
@@ -178,24 +298,28 @@ public:
         destination = NodePosition(GDRound(targetX/cellWidth), GDRound(targetY/cellHeight));
         NodePosition start(GDRound(startX/cellWidth), GDRound(startY/cellHeight));
 
+        //An impassable destination can't be reached.
+        if ( costGrid.GetCost(destination.x, destination.y) < 0 ) return false;
+
         //Initialize the algorithm
         allNodes.clear();
+        nodesPool.Clear();
         Node & startNode = GetNode(start);
         startNode.smallestCost = 0;
         startNode.estimateCost = 0 + distanceFunction(start, destination);
-        openNodes.clear();
-        openNodes.insert(&startNode);
+        openNodes.Clear();
+        openNodes.Push(&startNode);
 
         //A* algorithm main loop
         std::size_t iterationCount = 0;
-        std::size_t maxIterationCount = startNode.estimateCost*maxComplexityFactor;
-        while (!openNodes.empty())
+        std::size_t maxIterationCount = PathfindingBehavior::GetMaxExploredCellsCount(start.x, start.y,
+            destination.x, destination.y, allowsDiagonal);
+        while (!openNodes.IsEmpty())
         {
             if (iterationCount++ > maxIterationCount) return false; //Make sure we do not search forever.
 
-            Node * n = *openNodes.begin(); //Get the most promising node...
-            n->open = false;                 //...and flag it as explored
-            openNodes.erase(openNodes.begin()); //Be sure to remove ONLY the first element!
+            Node * n = openNodes.Pop(); //Get the most promising node...
+            n->open = false;            //...and flag it as explored
 
             //Check if we reached destination?
             if ( n->pos.x == destination.x && n->pos.y == destination.y )
@@ -244,45 +368,20 @@ private:
     /**
      * \brief Get (or dynamically construct) a node.
      *
-     * *All* nodes should be created using this method: The cost of the node is computed thanks
-     * to the objects flagged as obstacles.
+     * *All* nodes should be created using this method: The cost of the node is read
+     * from the cost grid of the obstacles.
      */
     Node & GetNode(const NodePosition & pos)
     {
-        if (allNodes.find(pos) != allNodes.end())
-            return allNodes.find(pos)->second;
+        auto it = allNodes.find(pos);
+        if (it != allNodes.end())
+            return *it->second;
 
-        Node newNode(pos);
+        Node & newNode = nodesPool.Create(pos);
+        newNode.cost = costGrid.GetCost(pos.x, pos.y);
 
-        bool objectsOnCell = false;
-        const std::set<PathfindingObstacleBehavior*> & allObstacles = obstacles.GetAllObstacles();
-        for (std::set<PathfindingObstacleBehavior*>::const_iterator it = allObstacles.begin();
-             it != allObstacles.end();
-             ++it)
-        {
-            RuntimeObject * obj = (*it)->GetObject();
-            int topLeftCellX = floor((obj->GetDrawableX()-rightBorder)/(float)cellWidth);
-            int topLeftCellY = floor((obj->GetDrawableY()-bottomBorder)/(float)cellHeight);
-            int bottomRightCellX = ceil((obj->GetDrawableX()+obj->GetWidth()+leftBorder)/(float)cellWidth);
-            int bottomRightCellY = ceil((obj->GetDrawableY()+obj->GetHeight()+topBorder)/(float)cellHeight);
-            if ( topLeftCellX < pos.x && pos.x < bottomRightCellX
-                && topLeftCellY < pos.y && pos.y < bottomRightCellY)
-            {
-                objectsOnCell = true;
-                if ( (*it)->IsImpassable() )
-                {
-                    newNode.cost = -1;
-                    break; //The cell is impassable, stop here.
-                }
-                else //Superimpose obstacles
-                    newNode.cost += (*it)->GetCost();
-            }
-        }
-
-        if (!objectsOnCell) newNode.cost = 1; //Default cost when no objects put on the cell.
-
-        allNodes[pos] = newNode;
-        return allNodes[pos];
+        allNodes[pos] = &newNode;
+        return newNode;
     }
 
     /**
@@ -314,44 +413,64 @@ private:
         if (neighbor.smallestCost == -1
             || neighbor.smallestCost > currentNode.smallestCost + (currentNode.cost+neighbor.cost)/2.0*factor)
         {
-            if (neighbor.smallestCost != -1) //The node is already in the open list:
-            {
-                //remove it as its estimate cost will be updated.
-                auto it = openNodes.find(&neighbor);
-                if (it != openNodes.end()) // /!\ ALWAYS use an iterator with multiset::erase
-                    openNodes.erase(it);   //otherwise, other nodes which are equivalent get removed too.
-            }
+            bool alreadyOpened = neighbor.smallestCost != -1;
 
             neighbor.smallestCost = currentNode.smallestCost + (currentNode.cost+neighbor.cost)/2.0*factor;
             neighbor.parent = &currentNode;
             neighbor.estimateCost = neighbor.smallestCost + distanceFunction(neighbor.pos, destination);
 
-            openNodes.insert(&neighbor);
+            if (alreadyOpened)
+                openNodes.Update(&neighbor);
+            else
+                openNodes.Push(&neighbor);
         }
     }
 
-    std::unordered_map< NodePosition, Node > allNodes; ///< All the nodes
-    std::multiset<Node*, Node::NodeComparator> openNodes; ///< Only the open nodes (Such that Node::open == true)
-    const ScenePathfindingObstaclesManager & obstacles; ///< A reference to all the obstacles of the scene
+    std::unordered_map< NodePosition, Node* > allNodes; ///< All the nodes, stored in nodesPool.
+    NodesPool nodesPool;
+    OpenNodesHeap openNodes; ///< Only the open nodes (Such that Node::open == true)
+    const PathfindingCostGrid & costGrid; ///< The costs of the cells, computed from the obstacles of the scene.
     Node * finalNode; //If computation succeeded, the final node is stored here.
     NodePosition destination;
     int startX; ///< The start X position, in "world" coordinates (not in "node" coordinates!).
     int startY; ///< The start Y position, in "world" coordinates (not in "node" coordinates!).
     DistanceFunPtr distanceFunction;
     bool allowsDiagonal; ///< True to allow diagonals when planning the path.
-    std::size_t maxComplexityFactor;
     float cellWidth;
     float cellHeight;
-    float leftBorder;
-    float rightBorder;
-    float topBorder;
-    float bottomBorder;
 
     static const float sqrt2;
 };
 
 const float SearchContext::sqrt2 = 1.414213562;
 
+/**
+ * \brief Return true if none of the cells of the path, except the start, is impassable.
+ */
+bool IsPathPassable(const PathfindingCostGrid & costGrid, const std::vector<sf::Vector2f> & path,
+    float cellWidth, float cellHeight)
+{
+    for (std::size_t i = 1;i<path.size();++i)
+    {
+        if ( costGrid.GetCost(GDRound(path[i].x/cellWidth), GDRound(path[i].y/cellHeight)) < 0 )
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * \brief The number of times a path computed by a worker thread is computed again when
+ * obstacles changed meanwhile, before computing it synchronously.
+ */
+const std::size_t maxReplansCount = 3;
+
+/**
+ * \brief The maximum number of cells explored when searching a path, relative to the distance
+ * between its start and its destination.
+ */
+const float maxComplexityFactor = 50;
+
 }
 
 PathfindingBehavior::PathfindingBehavior() :
@@ -372,8 +491,22 @@ PathfindingBehavior::PathfindingBehavior() :
     timeOnSegment(0),
     totalSegmentTime(0),
     currentSegment(0),
-    reachedEnd(false)
+    reachedEnd(false),
+    pendingJobReplansCount(0)
+{
+}
+
+PathfindingBehavior::~PathfindingBehavior()
 {
+    CancelPathfindingJob();
+}
+
+Behavior* PathfindingBehavior::Clone() const
+{
+    //The path being computed is not shared with the copy, which keeps moving on its current path.
+    PathfindingBehavior * clone = new PathfindingBehavior(*this);
+    clone->pendingJob.reset();
+    return clone;
 }
 
 void PathfindingBehavior::MoveTo(RuntimeScene & scene, float x, float y)
@@ -385,6 +518,7 @@ void PathfindingBehavior::MoveTo(RuntimeScene & scene, float x, float y)
     }
 
     path.clear();
+    CancelPathfindingJob();
 
     //First be sure that there is a path to compute.
     int targetCellX = GDRound(x/(float)cellWidth);
@@ -401,22 +535,44 @@ void PathfindingBehavior::MoveTo(RuntimeScene & scene, float x, float y)
 
     //Start searching for a path
     //TODO: Customizable heuristic.
-    ::SearchContext ctx(*sceneManager, allowDiagonals);
-    ctx.SetCellSize(cellWidth, cellHeight).SetStartPosition(object->GetX(), object->GetY());
-    ctx.SetObjectSize(object->GetX()-object->GetDrawableX()+extraBorder,
-        object->GetY()-object->GetDrawableY()+extraBorder,
-        object->GetWidth()-(object->GetX()-object->GetDrawableX())+extraBorder,
-        object->GetHeight()-(object->GetY()-object->GetDrawableY())+extraBorder);
-    if (ctx.ComputePathTo(x, y))
+    #if defined(GD_IDE_ONLY)
+    btClock planningClock;
+    #endif
+
+    float leftBorder, topBorder, rightBorder, bottomBorder;
+    GetBorders(leftBorder, topBorder, rightBorder, bottomBorder);
+    const PathfindingCostGrid & costGrid = sceneManager->GetCostGrid(cellWidth, cellHeight,
+        leftBorder, topBorder, rightBorder, bottomBorder);
+    //Objects going to the same cell share the search of the paths to it. The field of the paths
+    //is searched from the destination with the same effort as A*: when it stops before reaching
+    //the object, A* (which explores toward the destination) searches the path alone, so that
+    //sharing the search never loses a path found by A*.
+    bool pathComputed = false;
+    bool pathSearched = false;
+    std::size_t maxExploredCellsCount = GetMaxExploredCellsCount(startCellX, startCellY,
+        targetCellX, targetCellY, allowDiagonals);
+    PathfindingGoalField * goalField = costGrid.GetCost(startCellX, startCellY) >= 0 ?
+        sceneManager->GetGoalField(costGrid, targetCellX, targetCellY, allowDiagonals) : NULL;
+    if ( goalField )
     {
-        //Path found: memorize it
-        const ::Node * node = ctx.GetFinalNode();
-        while (node) {
-            path.push_back(sf::Vector2f(node->pos.x*(float)cellWidth, node->pos.y*(float)cellHeight));
-            node = node->parent;
-        }
+        std::vector<sf::Vector2i> cells;
+        pathComputed = goalField->ComputePathFrom(costGrid, startCellX, startCellY, maxExploredCellsCount, cells);
+        pathSearched = pathComputed || goalField->IsExhausted();
+        for (std::size_t i = 0;i<cells.size();++i)
+            path.push_back(sf::Vector2f(cells[i].x*(float)cellWidth, cells[i].y*(float)cellHeight));
+    }
+
+    if ( !pathSearched )
+        pathComputed = ComputePath(costGrid, allowDiagonals, cellWidth, cellHeight, object->GetX(), object->GetY(), x, y, path);
 
-        std::reverse(path.begin(), path.end());
+    #if defined(GD_IDE_ONLY)
+    if ( scene.GetProfiler() && scene.GetProfiler()->profilingActivated )
+        scene.GetProfiler()->pathfindingTime += planningClock.getTimeMicroseconds();
+    #endif
+
+    if (pathComputed)
+    {
+        //Path found: memorize it
         path[0] = sf::Vector2f(object->GetX(), object->GetY());
         EnterSegment(0);
         pathFound = true;
@@ -427,6 +583,117 @@ void PathfindingBehavior::MoveTo(RuntimeScene & scene, float x, float y)
     pathFound = false;
 }
 
+void PathfindingBehavior::MoveToAsync(RuntimeScene & scene, float x, float y)
+{
+    if ( parentScene != &scene ) //Parent scene has changed
+    {
+        parentScene = &scene;
+        sceneManager = parentScene ? &ScenePathfindingObstaclesManager::managers[&scene] : NULL;
+    }
+
+    //Nothing to compute if the destination is on the cell of the object.
+    if ( GDRound(x/(float)cellWidth) == GDRound(object->GetX()/(float)cellWidth) &&
+         GDRound(y/(float)cellHeight) == GDRound(object->GetY()/(float)cellHeight) )
+    {
+        MoveTo(scene, x, y);
+        return;
+    }
+
+    StartPathfindingJob(x, y, 0);
+}
+
+bool PathfindingBehavior::ComputePath(const PathfindingCostGrid & costGrid, bool allowDiagonals,
+    unsigned int cellWidth, unsigned int cellHeight, float startX, float startY, float targetX, float targetY,
+    std::vector<sf::Vector2f> & path)
+{
+    path.clear();
+
+    ::SearchContext ctx(costGrid, allowDiagonals);
+    ctx.SetCellSize(cellWidth, cellHeight).SetStartPosition(startX, startY);
+    if (!ctx.ComputePathTo(targetX, targetY)) return false;
+
+    const ::Node * node = ctx.GetFinalNode();
+    while (node) {
+        path.push_back(sf::Vector2f(node->pos.x*(float)cellWidth, node->pos.y*(float)cellHeight));
+        node = node->parent;
+    }
+
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+std::size_t PathfindingBehavior::GetMaxExploredCellsCount(int startCellX, int startCellY, int targetCellX, int targetCellY,
+    bool allowDiagonals)
+{
+    //Same distance as the one estimated by A* for the start cell.
+    float distance = allowDiagonals ?
+        std::sqrt((startCellX-targetCellX)*(startCellX-targetCellX)+(startCellY-targetCellY)*(startCellY-targetCellY)) :
+        std::abs(startCellX-targetCellX)+std::abs(startCellY-targetCellY);
+
+    return static_cast<std::size_t>(distance*maxComplexityFactor);
+}
+
+void PathfindingBehavior::GetBorders(float & leftBorder, float & topBorder, float & rightBorder, float & bottomBorder) const
+{
+    leftBorder = object->GetX()-object->GetDrawableX()+extraBorder;
+    topBorder = object->GetY()-object->GetDrawableY()+extraBorder;
+    rightBorder = object->GetWidth()-(object->GetX()-object->GetDrawableX())+extraBorder;
+    bottomBorder = object->GetHeight()-(object->GetY()-object->GetDrawableY())+extraBorder;
+}
+
+void PathfindingBehavior::StartPathfindingJob(float x, float y, std::size_t replansCount)
+{
+    CancelPathfindingJob();
+
+    float leftBorder, topBorder, rightBorder, bottomBorder;
+    GetBorders(leftBorder, topBorder, rightBorder, bottomBorder);
+
+    pendingJob = std::make_shared<PathfindingJob>(
+        sceneManager->GetCostGridSnapshot(cellWidth, cellHeight, leftBorder, topBorder, rightBorder, bottomBorder),
+        allowDiagonals, cellWidth, cellHeight, object->GetX(), object->GetY(), x, y);
+    pendingJobReplansCount = replansCount;
+    PathfindingJobsQueue::Get()->Add(pendingJob);
+}
+
+void PathfindingBehavior::CancelPathfindingJob()
+{
+    if ( !pendingJob ) return;
+
+    pendingJob->Cancel();
+    pendingJob.reset();
+}
+
+void PathfindingBehavior::ApplyPathfindingJob()
+{
+    std::shared_ptr<PathfindingJob> job;
+    job.swap(pendingJob);
+
+    //Compute the path again if obstacles changed while it was computed and are now blocking it.
+    float leftBorder, topBorder, rightBorder, bottomBorder;
+    GetBorders(leftBorder, topBorder, rightBorder, bottomBorder);
+    const PathfindingCostGrid & costGrid = sceneManager->GetCostGrid(job->cellWidth, job->cellHeight,
+        leftBorder, topBorder, rightBorder, bottomBorder);
+    if ( costGrid.GetVersion() != job->costGrid->GetVersion() &&
+         (!job->PathFound() || !IsPathPassable(costGrid, job->GetPath(), job->cellWidth, job->cellHeight)) )
+    {
+        if ( pendingJobReplansCount < maxReplansCount )
+            StartPathfindingJob(job->targetX, job->targetY, pendingJobReplansCount+1);
+        else //Obstacles keep changing: don't follow a blocked path, compute it on the current obstacles.
+            MoveTo(*parentScene, job->targetX, job->targetY);
+
+        return;
+    }
+
+    path = job->GetPath();
+    pathFound = job->PathFound();
+    if ( pathFound )
+    {
+        //The object may have moved since the path was asked.
+        path[0] = sf::Vector2f(object->GetX(), object->GetY());
+        EnterSegment(0);
+    }
+}
+
 void PathfindingBehavior::EnterSegment(std::size_t segmentNumber)
 {
     if ( path.empty() ) return;
@@ -455,6 +722,8 @@ void PathfindingBehavior::DoStepPreEvents(RuntimeScene & scene)
 
     if ( !sceneManager ) return;
 
+    if ( pendingJob && pendingJob->IsDone() ) ApplyPathfindingJob();
+
     if (path.empty() || reachedEnd) return;
 
     //Update the speed of the object
@@ -496,6 +765,24 @@ void PathfindingBehavior::DoStepPostEvents(RuntimeScene & scene)
     }
 }
 
+void PathfindingBehavior::StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        PathfindingBehavior * behavior = static_cast<PathfindingBehavior*>(behaviors[i]);
+        if ( behavior->Activated() ) behavior->PathfindingBehavior::DoStepPreEvents(scene);
+    }
+}
+
+void PathfindingBehavior::StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        PathfindingBehavior * behavior = static_cast<PathfindingBehavior*>(behaviors[i]);
+        if ( behavior->Activated() ) behavior->PathfindingBehavior::DoStepPostEvents(scene);
+    }
+}
+
 float PathfindingBehavior::GetNodeX(std::size_t index) const
 {
     if (index<path.size()) return path[index].x;
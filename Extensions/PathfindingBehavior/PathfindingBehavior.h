@@ -10,11 +10,14 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
 #include <SFML/System/Vector2.hpp>
+#include <memory>
 #include <vector>
 namespace gd { class Layout; }
 class RuntimeScene;
 class PlatformBehavior;
 class ScenePathfindingObstaclesManager;
+class PathfindingCostGrid;
+class PathfindingJob;
 namespace gd { class SerializerElement; }
 class RuntimeScenePlatformData;
 
@@ -25,20 +28,60 @@ class GD_EXTENSION_API PathfindingBehavior : public Behavior
 {
 public:
     PathfindingBehavior();
-    virtual ~PathfindingBehavior() {};
-    virtual Behavior* Clone() const { return new PathfindingBehavior(*this); }
+    virtual ~PathfindingBehavior();
+    virtual Behavior* Clone() const;
+    virtual void StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
+    virtual void StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
 
     /**
      * \brief Compute and move on the path to the specified destination.
      */
     void MoveTo(RuntimeScene & scene, float x, float y);
 
+    /**
+     * \brief Compute the path to the specified destination in a worker thread, and move on it
+     * once it is computed (see PathReady).
+     *
+     * The object keeps moving on its current path until the new one is applied, at the beginning of
+     * the first step of the behavior after the path is computed. If obstacles changed meanwhile and the
+     * path is blocked, a new path is computed (synchronously if obstacles keep blocking the computed paths).
+     */
+    void MoveToAsync(RuntimeScene & scene, float x, float y);
+
+    /**
+     * \brief Compute a path with A*, using the costs of the cells given by the grid.
+     *
+     * It can be called from any thread, as long as the grid is not modified.
+     *
+     * \param path Filled with the positions of the cells of the path, from the start to the destination.
+     * \return true if a path was found.
+     */
+    static bool ComputePath(const PathfindingCostGrid & costGrid, bool allowDiagonals,
+        unsigned int cellWidth, unsigned int cellHeight, float startX, float startY, float targetX, float targetY,
+        std::vector<sf::Vector2f> & path);
+
+    /**
+     * \brief Return the maximum number of cells explored when searching a path between two cells,
+     * so that the search of a path to an unreachable destination stops.
+     *
+     * It is used both by A* and by the fields of the paths shared by objects going to the
+     * same cell (see PathfindingGoalField).
+     */
+    static std::size_t GetMaxExploredCellsCount(int startCellX, int startCellY, int targetCellX, int targetCellY,
+        bool allowDiagonals);
+
     //Path information:
     /**
-     * \brief Return true if the latest call to MoveTo succeeded.
+     * \brief Return true if the latest call to MoveTo or MoveToAsync succeeded.
      */
     bool PathFound() { return pathFound; }
 
+    /**
+     * \brief Return true if the path asked by the latest call to MoveToAsync was computed
+     * and applied (or if MoveTo was called).
+     */
+    bool PathReady() { return !pendingJob; }
+
     /**
      * \brief Return true if the object reached its destination
      */
@@ -98,11 +141,17 @@ private:
     virtual void DoStepPreEvents(RuntimeScene & scene);
     virtual void DoStepPostEvents(RuntimeScene & scene);
     void EnterSegment(std::size_t segmentNumber);
+    void GetBorders(float & leftBorder, float & topBorder, float & rightBorder, float & bottomBorder) const;
+    void StartPathfindingJob(float x, float y, std::size_t replansCount);
+    void ApplyPathfindingJob();
+    void CancelPathfindingJob();
 
     RuntimeScene * parentScene; ///< The scene the object belongs to.
     ScenePathfindingObstaclesManager * sceneManager; ///< The platform objects manager associated to the scene.
     std::vector<sf::Vector2f> path; ///< The computed path
     bool pathFound;
+    std::shared_ptr<PathfindingJob> pendingJob; ///< The path being computed by a worker thread, if any.
+    std::size_t pendingJobReplansCount; ///< The number of times the pending path was computed again because obstacles changed.
 
     //Behavior configuration:
     bool allowDiagonals;
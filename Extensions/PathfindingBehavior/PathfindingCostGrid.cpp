@@ -0,0 +1,169 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingCostGrid.h"
+#include "PathfindingObstacleBehavior.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include <cmath>
+
+std::size_t PathfindingCostGrid::lastVersion = 0;
+
+PathfindingCostGrid::PathfindingCostGrid(float cellWidth_, float cellHeight_,
+    float leftBorder_, float topBorder_, float rightBorder_, float bottomBorder_) :
+    cellWidth(cellWidth_),
+    cellHeight(cellHeight_),
+    leftBorder(leftBorder_),
+    topBorder(topBorder_),
+    rightBorder(rightBorder_),
+    bottomBorder(bottomBorder_),
+    version(++lastVersion)
+{
+}
+
+bool PathfindingCostGrid::IsMadeFor(float cellWidth_, float cellHeight_,
+    float leftBorder_, float topBorder_, float rightBorder_, float bottomBorder_) const
+{
+    return cellWidth == cellWidth_ && cellHeight == cellHeight_ &&
+        leftBorder == leftBorder_ && topBorder == topBorder_ &&
+        rightBorder == rightBorder_ && bottomBorder == bottomBorder_;
+}
+
+std::shared_ptr<const PathfindingCostGrid> PathfindingCostGrid::GetSnapshot()
+{
+    if ( !snapshot || snapshot->GetVersion() != version )
+    {
+        //Only the chunks are needed to get the costs, and they are shared until changed.
+        std::shared_ptr<PathfindingCostGrid> newSnapshot = std::make_shared<PathfindingCostGrid>(cellWidth, cellHeight,
+            leftBorder, topBorder, rightBorder, bottomBorder);
+        newSnapshot->chunks = chunks;
+        newSnapshot->version = version;
+        snapshot = newSnapshot;
+    }
+
+    return snapshot;
+}
+
+void PathfindingCostGrid::Update(const std::set<PathfindingObstacleBehavior*> & obstacles)
+{
+    for (std::set<PathfindingObstacleBehavior*>::const_iterator it = obstacles.begin();
+         it != obstacles.end();
+         ++it)
+    {
+        RasterizedObstacle rasterizedObstacle = Rasterize(**it);
+
+        auto previous = rasterizedObstacles.find(*it);
+        if ( previous != rasterizedObstacles.end() )
+        {
+            if ( previous->second == rasterizedObstacle ) continue; //Nothing changed.
+
+            RemoveFromCells(previous->second);
+            previous->second = rasterizedObstacle;
+        }
+        else
+            rasterizedObstacles[*it] = rasterizedObstacle;
+
+        AddToCells(rasterizedObstacle);
+    }
+}
+
+void PathfindingCostGrid::UpdateChangedObstacles()
+{
+    if ( changedObstacles.empty() ) return;
+
+    Update(changedObstacles);
+    changedObstacles.clear();
+}
+
+void PathfindingCostGrid::RemoveObstacle(PathfindingObstacleBehavior * obstacle)
+{
+    changedObstacles.erase(obstacle);
+
+    auto it = rasterizedObstacles.find(obstacle);
+    if ( it == rasterizedObstacles.end() ) return;
+
+    RemoveFromCells(it->second);
+    rasterizedObstacles.erase(it);
+}
+
+PathfindingCostGrid::RasterizedObstacle PathfindingCostGrid::Rasterize(const PathfindingObstacleBehavior & obstacle) const
+{
+    //An object is on the cells strictly inside the area covered by the obstacle
+    //enlarged by the borders of the object.
+    RuntimeObject * obj = obstacle.GetObject();
+    int topLeftCellX = floor((obj->GetDrawableX()-rightBorder)/cellWidth);
+    int topLeftCellY = floor((obj->GetDrawableY()-bottomBorder)/cellHeight);
+    int bottomRightCellX = ceil((obj->GetDrawableX()+obj->GetWidth()+leftBorder)/cellWidth);
+    int bottomRightCellY = ceil((obj->GetDrawableY()+obj->GetHeight()+topBorder)/cellHeight);
+
+    RasterizedObstacle rasterizedObstacle;
+    rasterizedObstacle.minX = topLeftCellX+1;
+    rasterizedObstacle.minY = topLeftCellY+1;
+    rasterizedObstacle.maxX = bottomRightCellX-1;
+    rasterizedObstacle.maxY = bottomRightCellY-1;
+    rasterizedObstacle.cost = obstacle.GetCost();
+    rasterizedObstacle.impassable = obstacle.IsImpassable();
+    return rasterizedObstacle;
+}
+
+void PathfindingCostGrid::AddToCells(const RasterizedObstacle & obstacle)
+{
+    version = ++lastVersion;
+    for (int y = obstacle.minY;y<=obstacle.maxY;++y)
+    {
+        for (int x = obstacle.minX;x<=obstacle.maxX;++x)
+        {
+            Chunk & chunk = GetChunkForWriting(chunks[GetChunkKey(x, y)]);
+            Cell & cell = chunk.cells[GetCellIndex(x, y)];
+            if ( cell.obstaclesCount == 0 && cell.impassableObstaclesCount == 0 ) chunk.usedCellsCount++;
+
+            if ( obstacle.impassable )
+                cell.impassableObstaclesCount++;
+            else
+            {
+                cell.obstaclesCount++;
+                cell.cost += obstacle.cost;
+            }
+        }
+    }
+}
+
+void PathfindingCostGrid::RemoveFromCells(const RasterizedObstacle & obstacle)
+{
+    version = ++lastVersion;
+    for (int y = obstacle.minY;y<=obstacle.maxY;++y)
+    {
+        for (int x = obstacle.minX;x<=obstacle.maxX;++x)
+        {
+            auto it = chunks.find(GetChunkKey(x, y));
+            if ( it == chunks.end() ) continue;
+
+            Chunk & chunk = GetChunkForWriting(it->second);
+            Cell & cell = chunk.cells[GetCellIndex(x, y)];
+            if ( obstacle.impassable )
+                cell.impassableObstaclesCount--;
+            else
+            {
+                cell.obstaclesCount--;
+                //Reset the cost when the last obstacle is removed, to avoid accumulating rounding errors.
+                cell.cost = cell.obstaclesCount > 0 ? cell.cost - obstacle.cost : 0;
+            }
+
+            if ( cell.obstaclesCount == 0 && cell.impassableObstaclesCount == 0 && --chunk.usedCellsCount == 0 )
+                chunks.erase(it);
+        }
+    }
+}
+
+PathfindingCostGrid::Chunk & PathfindingCostGrid::GetChunkForWriting(std::shared_ptr<Chunk> & chunk)
+{
+    //Snapshots are only made by the main thread, so a chunk used only by the grid can't become shared meanwhile.
+    if ( !chunk )
+        chunk = std::make_shared<Chunk>();
+    else if ( chunk.use_count() > 1 )
+        chunk = std::make_shared<Chunk>(*chunk);
+
+    return *chunk;
+}
@@ -0,0 +1,173 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGCOSTGRID_H
+#define PATHFINDINGCOSTGRID_H
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+class PathfindingObstacleBehavior;
+
+/**
+ * \brief The costs of the cells of a scene, computed from the obstacles, for objects
+ * of a specific size moving on cells of a specific size.
+ *
+ * Obstacles are rasterized on the cells they cover (enlarged by the borders of the moving
+ * object) so that getting the cost of a cell does not iterate on the obstacles. When the
+ * grid is updated, only the obstacles marked as changed (see ObstacleChanged) are rasterized again.
+ *
+ * \see ScenePathfindingObstaclesManager
+ */
+class PathfindingCostGrid
+{
+public:
+    PathfindingCostGrid(float cellWidth, float cellHeight,
+        float leftBorder, float topBorder, float rightBorder, float bottomBorder);
+
+    /**
+     * \brief Return true if the grid was made for these cells and borders.
+     */
+    bool IsMadeFor(float cellWidth, float cellHeight,
+        float leftBorder, float topBorder, float rightBorder, float bottomBorder) const;
+
+    /**
+     * \brief Rasterize the obstacles which were added, moved or changed since they were last rasterized.
+     */
+    void Update(const std::set<PathfindingObstacleBehavior*> & obstacles);
+
+    /**
+     * \brief Mark an obstacle as added, moved or changed, so that it is rasterized again by
+     * the next call to UpdateChangedObstacles.
+     */
+    void ObstacleChanged(PathfindingObstacleBehavior * obstacle) { changedObstacles.insert(obstacle); }
+
+    /**
+     * \brief Rasterize the obstacles marked as changed since the last update.
+     */
+    void UpdateChangedObstacles();
+
+    /**
+     * \brief Remove the cost of an obstacle from the cells it was covering.
+     *
+     * \note The object of the obstacle is not used, so it can be called when the obstacle is destroyed.
+     */
+    void RemoveObstacle(PathfindingObstacleBehavior * obstacle);
+
+    /**
+     * \brief Return the cost of moving on a cell: -1 if the cell is impassable,
+     * the sum of the costs of the obstacles on the cell, or 1 if there is no obstacle.
+     */
+    float GetCost(int x, int y) const
+    {
+        auto it = chunks.find(GetChunkKey(x, y));
+        if ( it == chunks.end() ) return 1;
+
+        const Cell & cell = it->second->cells[GetCellIndex(x, y)];
+        if ( cell.impassableObstaclesCount > 0 ) return -1;
+        return cell.obstaclesCount > 0 ? cell.cost : 1;
+    }
+
+    /**
+     * \brief Return the number of obstacles rasterized in the grid.
+     *
+     * \note Snapshots don't know the obstacles, so this is 0 for them.
+     */
+    std::size_t GetObstaclesCount() const { return rasterizedObstacles.size(); }
+
+    /**
+     * \brief Return a number identifying the costs of the cells: it is changed, and never
+     * used again by any grid, each time an obstacle is added, moved, changed or removed.
+     */
+    std::size_t GetVersion() const { return version; }
+
+    /**
+     * \brief Return an immutable copy of the costs of the cells, which can be read by other threads.
+     *
+     * The copy is shared until the grid is changed, and shares the chunks of cells
+     * with the grid: a chunk is copied only when the grid changes it (see GetChunkForWriting).
+     */
+    std::shared_ptr<const PathfindingCostGrid> GetSnapshot();
+
+private:
+    /**
+     * \brief The cells covered by an obstacle, as they were when it was rasterized.
+     */
+    struct RasterizedObstacle
+    {
+        bool operator==(const RasterizedObstacle & other) const
+        {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY &&
+                cost == other.cost && impassable == other.impassable;
+        }
+
+        int minX; ///< The first covered cell on X axis.
+        int minY; ///< The first covered cell on Y axis.
+        int maxX; ///< The last covered cell on X axis.
+        int maxY; ///< The last covered cell on Y axis.
+        float cost;
+        bool impassable;
+    };
+
+    struct Cell
+    {
+        Cell() : cost(0), obstaclesCount(0), impassableObstaclesCount(0) {};
+
+        float cost; ///< The sum of the costs of the passable obstacles.
+        unsigned int obstaclesCount;
+        unsigned int impassableObstaclesCount;
+    };
+
+    /**
+     * \brief A square of chunkSize*chunkSize cells, allocated when an obstacle is covering it.
+     */
+    struct Chunk
+    {
+        Chunk() : cells(chunkSize*chunkSize), usedCellsCount(0) {};
+
+        std::vector<Cell> cells;
+        std::size_t usedCellsCount; ///< The number of cells with at least one obstacle.
+    };
+
+    RasterizedObstacle Rasterize(const PathfindingObstacleBehavior & obstacle) const;
+    void AddToCells(const RasterizedObstacle & obstacle);
+    void RemoveFromCells(const RasterizedObstacle & obstacle);
+
+    /**
+     * \brief Return the chunk to be modified, copying it first if it is shared with a snapshot.
+     */
+    static Chunk & GetChunkForWriting(std::shared_ptr<Chunk> & chunk);
+
+    static std::uint64_t GetChunkKey(int x, int y)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x >> chunkShift)) << 32) |
+            static_cast<std::uint32_t>(y >> chunkShift);
+    }
+    static std::size_t GetCellIndex(int x, int y)
+    {
+        return (y & (chunkSize-1))*chunkSize + (x & (chunkSize-1));
+    }
+
+    static const int chunkShift = 4;
+    static const int chunkSize = 1 << chunkShift;
+
+    float cellWidth;
+    float cellHeight;
+    float leftBorder;
+    float topBorder;
+    float rightBorder;
+    float bottomBorder;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Chunk>> chunks; ///< The chunks having at least one cell covered by an obstacle, shared with the snapshots.
+    std::unordered_map<PathfindingObstacleBehavior*, RasterizedObstacle> rasterizedObstacles;
+    std::set<PathfindingObstacleBehavior*> changedObstacles; ///< The obstacles to be rasterized again, see ObstacleChanged.
+    std::size_t version;
+    std::shared_ptr<const PathfindingCostGrid> snapshot; ///< The last copy returned by GetSnapshot.
+
+    static std::size_t lastVersion; ///< The last version given to a grid.
+};
+
+#endif
@@ -0,0 +1,117 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingGoalField.h"
+#include "PathfindingCostGrid.h"
+
+const float PathfindingGoalField::sqrt2 = 1.414213562;
+
+PathfindingGoalField::PathfindingGoalField(int goalX, int goalY, bool allowsDiagonal, std::size_t gridVersion) :
+    goal(goalX, goalY),
+    allowsDiagonal_(allowsDiagonal),
+    gridVersion_(gridVersion),
+    seeded(false),
+    openedCellsCount(0),
+    settledCellsCount(0)
+{
+}
+
+bool PathfindingGoalField::ComputePathFrom(const PathfindingCostGrid & grid, int startX, int startY,
+    std::size_t maxSettledCellsCount, std::vector<sf::Vector2i> & path)
+{
+    path.clear();
+    if ( !seeded )
+    {
+        seeded = true;
+        float goalCost = grid.GetCost(goal.x, goal.y);
+        if ( goalCost >= 0 ) //An impassable goal can't be reached.
+        {
+            FieldCell & goalCell = cells[GetKey(goal.x, goal.y)];
+            goalCell.cost = goalCost;
+            goalCell.next = goal;
+
+            OpenCell openCell = {0, openedCellsCount++, goal};
+            openCells.push(openCell);
+        }
+    }
+
+    //Explore the cells around the goal until the start is reached. The start may also have
+    //been reached when searching the path of another object, even farther from the goal.
+    while (!IsSettled(startX, startY) && !openCells.empty() && settledCellsCount <= maxSettledCellsCount)
+        ExploreNextCell(grid);
+
+    if ( !IsSettled(startX, startY) ) return false;
+
+    sf::Vector2i pos(startX, startY);
+    path.push_back(pos);
+    while (pos != goal)
+    {
+        pos = cells.find(GetKey(pos.x, pos.y))->second.next;
+        path.push_back(pos);
+    }
+
+    return true;
+}
+
+bool PathfindingGoalField::IsSettled(int x, int y) const
+{
+    auto it = cells.find(GetKey(x, y));
+    return it != cells.end() && it->second.settled;
+}
+
+void PathfindingGoalField::ExploreNextCell(const PathfindingCostGrid & grid)
+{
+    OpenCell openCell = openCells.top();
+    openCells.pop();
+
+    FieldCell & current = cells[GetKey(openCell.pos.x, openCell.pos.y)];
+    if ( current.settled || openCell.costToGoal > current.costToGoal )
+        return; //The cell was already reached with a smaller cost.
+
+    current.settled = true;
+    settledCellsCount++;
+
+    const sf::Vector2i & pos = openCell.pos;
+    AddOrUpdateCell(grid, sf::Vector2i(pos.x+1, pos.y), pos, current, 1);
+    AddOrUpdateCell(grid, sf::Vector2i(pos.x-1, pos.y), pos, current, 1);
+    AddOrUpdateCell(grid, sf::Vector2i(pos.x, pos.y+1), pos, current, 1);
+    AddOrUpdateCell(grid, sf::Vector2i(pos.x, pos.y-1), pos, current, 1);
+    if ( allowsDiagonal_ )
+    {
+        AddOrUpdateCell(grid, sf::Vector2i(pos.x+1, pos.y+1), pos, current, sqrt2);
+        AddOrUpdateCell(grid, sf::Vector2i(pos.x+1, pos.y-1), pos, current, sqrt2);
+        AddOrUpdateCell(grid, sf::Vector2i(pos.x-1, pos.y-1), pos, current, sqrt2);
+        AddOrUpdateCell(grid, sf::Vector2i(pos.x-1, pos.y+1), pos, current, sqrt2);
+    }
+}
+
+void PathfindingGoalField::AddOrUpdateCell(const PathfindingCostGrid & grid, const sf::Vector2i & pos,
+    const sf::Vector2i & currentPos, const FieldCell & current, float factor)
+{
+    std::uint64_t key = GetKey(pos.x, pos.y);
+    auto it = cells.find(key);
+    if ( it == cells.end() )
+    {
+        float cost = grid.GetCost(pos.x, pos.y);
+        if ( cost < 0 ) return; //Impassable cells are never added.
+
+        it = cells.insert(std::make_pair(key, FieldCell())).first;
+        it->second.cost = cost;
+        it->second.costToGoal = -1;
+    }
+
+    //Same cost as the one used by A* when moving between the two cells.
+    FieldCell & neighbor = it->second;
+    float costToGoal = current.costToGoal + (current.cost+neighbor.cost)/2.0*factor;
+    if ( neighbor.settled || (neighbor.costToGoal != -1 && neighbor.costToGoal <= costToGoal) )
+        return;
+
+    neighbor.costToGoal = costToGoal;
+    neighbor.next = currentPos;
+
+    OpenCell openCell = {costToGoal, openedCellsCount++, pos};
+    openCells.push(openCell);
+}
@@ -0,0 +1,115 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGGOALFIELD_H
+#define PATHFINDINGGOALFIELD_H
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+class PathfindingCostGrid;
+
+/**
+ * \brief The cost of the shortest path from the cells of a scene to a goal cell, shared
+ * by the objects going to the goal.
+ *
+ * The field is computed by a search starting from the goal, which is continued only when an
+ * object asks for a path from a cell which was not reached yet. Objects going to the same goal
+ * (for example, a crowd of units ordered to the same point) read their path by following the
+ * field instead of each searching for it.
+ *
+ * A field is only valid for the version of the cost grid it was made with.
+ *
+ * \see ScenePathfindingObstaclesManager::GetGoalField
+ */
+class PathfindingGoalField
+{
+public:
+    PathfindingGoalField(int goalX, int goalY, bool allowsDiagonal, std::size_t gridVersion);
+
+    /**
+     * \brief Return true if the field was made for this goal and this version of the cost grid.
+     */
+    bool IsMadeFor(int goalX, int goalY, bool allowsDiagonal, std::size_t gridVersion) const
+    {
+        return goalX == goal.x && goalY == goal.y && allowsDiagonal == allowsDiagonal_ && gridVersion == gridVersion_;
+    }
+
+    /**
+     * \brief Return the version of the cost grid used by the field.
+     */
+    std::size_t GetGridVersion() const { return gridVersion_; }
+
+    /**
+     * \brief Compute the shortest path from a cell to the goal, continuing the search if needed.
+     *
+     * \param grid The cost grid, with the version given in the constructor.
+     * \param maxSettledCellsCount The number of cells explored by the search after which it is stopped
+     * (see PathfindingBehavior::GetMaxExploredCellsCount).
+     * \param path Filled with the cells of the path, from the start cell to the goal.
+     * \return true if a path was found, false if there is no path or if the search was stopped
+     * before reaching the start cell (see IsExhausted).
+     */
+    bool ComputePathFrom(const PathfindingCostGrid & grid, int startX, int startY, std::size_t maxSettledCellsCount,
+        std::vector<sf::Vector2i> & path);
+
+    /**
+     * \brief Return true if all the cells which can reach the goal were explored: no path exists
+     * from the other cells.
+     */
+    bool IsExhausted() const { return seeded && openCells.empty(); }
+
+private:
+    struct FieldCell
+    {
+        FieldCell() : cost(1), costToGoal(0), settled(false) {};
+
+        float cost; ///< The cost of moving on the cell.
+        float costToGoal; ///< The cost of the shortest known path from the cell to the goal.
+        sf::Vector2i next; ///< The next cell of the shortest known path to the goal.
+        bool settled; ///< True when costToGoal is the cost of the shortest path.
+    };
+
+    /**
+     * \brief A cell to explore. Cells with the same cost are explored in the order they were opened.
+     */
+    struct OpenCell
+    {
+        bool operator>(const OpenCell & other) const
+        {
+            return costToGoal > other.costToGoal || (costToGoal == other.costToGoal && order > other.order);
+        }
+
+        float costToGoal;
+        std::size_t order;
+        sf::Vector2i pos;
+    };
+
+    bool IsSettled(int x, int y) const;
+    void ExploreNextCell(const PathfindingCostGrid & grid);
+    void AddOrUpdateCell(const PathfindingCostGrid & grid, const sf::Vector2i & pos,
+        const sf::Vector2i & currentPos, const FieldCell & current, float factor);
+
+    static std::uint64_t GetKey(int x, int y)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    sf::Vector2i goal;
+    bool allowsDiagonal_;
+    std::size_t gridVersion_;
+    bool seeded; ///< True when the goal was put in the cells to explore.
+    std::size_t openedCellsCount;
+    std::size_t settledCellsCount;
+    std::unordered_map<std::uint64_t, FieldCell> cells; ///< The cells reached by the search.
+    std::priority_queue<OpenCell, std::vector<OpenCell>, std::greater<OpenCell>> openCells; ///< The cells to explore (possibly with outdated costs).
+
+    static const float sqrt2;
+};
+
+#endif
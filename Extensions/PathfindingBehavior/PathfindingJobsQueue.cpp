@@ -0,0 +1,118 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#include "PathfindingJobsQueue.h"
+#include "PathfindingBehavior.h"
+#include "PathfindingCostGrid.h"
+#include <algorithm>
+
+namespace
+{
+    const unsigned int maxWorkersCount = 4;
+}
+
+PathfindingJobsQueue * PathfindingJobsQueue::_singleton = NULL;
+
+PathfindingJob::PathfindingJob(std::shared_ptr<const PathfindingCostGrid> costGrid_, bool allowDiagonals_,
+    unsigned int cellWidth_, unsigned int cellHeight_,
+    float startX_, float startY_, float targetX_, float targetY_) :
+    costGrid(costGrid_),
+    allowDiagonals(allowDiagonals_),
+    cellWidth(cellWidth_),
+    cellHeight(cellHeight_),
+    startX(startX_),
+    startY(startY_),
+    targetX(targetX_),
+    targetY(targetY_),
+    pathFound(false),
+    done(false),
+    cancelled(false)
+{
+}
+
+void PathfindingJob::Run()
+{
+    pathFound = PathfindingBehavior::ComputePath(*costGrid, allowDiagonals, cellWidth, cellHeight,
+        startX, startY, targetX, targetY, path);
+    done.store(true, std::memory_order_release);
+}
+
+PathfindingJobsQueue::PathfindingJobsQueue() :
+    runningJobsCount(0),
+    stopWorkers(false)
+{
+}
+
+PathfindingJobsQueue::~PathfindingJobsQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopWorkers = true;
+    }
+    jobsCondition.notify_all();
+
+    for (std::size_t i = 0;i<workers.size();++i)
+        workers[i].join();
+}
+
+void PathfindingJobsQueue::StartWorkers()
+{
+    //Keep a core for the main thread.
+    unsigned int coresCount = std::thread::hardware_concurrency();
+    unsigned int workersCount = std::min(coresCount > 2 ? coresCount-1 : 1, maxWorkersCount);
+
+    for (unsigned int i = 0;i<workersCount;++i)
+        workers.push_back(std::thread(&PathfindingJobsQueue::RunWorker, this));
+}
+
+void PathfindingJobsQueue::RunWorker()
+{
+    while (true)
+    {
+        std::shared_ptr<PathfindingJob> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobsCondition.wait(lock, [this]() { return stopWorkers || !pendingJobs.empty(); });
+            if (stopWorkers) return;
+
+            job = pendingJobs.front();
+            pendingJobs.pop_front();
+            runningJobsCount++;
+        }
+
+        if (!job->IsCancelled()) job->Run();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            runningJobsCount--;
+            if (runningJobsCount > 0 || !pendingJobs.empty()) continue;
+        }
+        jobsDoneCondition.notify_all();
+    }
+}
+
+void PathfindingJobsQueue::Add(const std::shared_ptr<PathfindingJob> & job)
+{
+    if (workers.empty()) StartWorkers();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingJobs.push_back(job);
+    }
+    jobsCondition.notify_one();
+}
+
+std::size_t PathfindingJobsQueue::GetPendingJobsCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingJobs.size();
+}
+
+void PathfindingJobsQueue::WaitForAllJobs()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    jobsDoneCondition.wait(lock, [this]() { return pendingJobs.empty() && runningJobsCount == 0; });
+}
@@ -0,0 +1,140 @@
+/**
+
+GDevelop - Pathfinding Behavior Extension
+Copyright (c) 2010-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+#ifndef PATHFINDINGJOBSQUEUE_H
+#define PATHFINDINGJOBSQUEUE_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+class PathfindingCostGrid;
+
+/**
+ * \brief A path to be computed by a worker thread, using an immutable copy of the costs of the cells.
+ *
+ * The inputs are set in the constructor and never changed. The outputs must only be read
+ * when IsDone returns true.
+ *
+ * \see PathfindingJobsQueue
+ */
+class PathfindingJob
+{
+public:
+    PathfindingJob(std::shared_ptr<const PathfindingCostGrid> costGrid_, bool allowDiagonals_,
+        unsigned int cellWidth_, unsigned int cellHeight_,
+        float startX_, float startY_, float targetX_, float targetY_);
+
+    /**
+     * \brief Compute the path. Called by the worker threads.
+     */
+    void Run();
+
+    /**
+     * \brief Return true if the path was computed.
+     */
+    bool IsDone() const { return done.load(std::memory_order_acquire); }
+
+    /**
+     * \brief Mark the path as not needed anymore, so that it is not computed if no worker started it yet.
+     * Called by the object which asked for the path.
+     */
+    void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    /**
+     * \brief Return true if the path is not needed anymore.
+     */
+    bool IsCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    /**
+     * \brief Return true if a path was found (only valid when IsDone returns true).
+     */
+    bool PathFound() const { return pathFound; }
+
+    /**
+     * \brief Return the positions of the cells of the path, from the start to the destination
+     * (only valid when IsDone returns true).
+     */
+    const std::vector<sf::Vector2f> & GetPath() const { return path; }
+
+    const std::shared_ptr<const PathfindingCostGrid> costGrid; ///< The copy of the costs of the cells used to compute the path.
+    const bool allowDiagonals;
+    const unsigned int cellWidth;
+    const unsigned int cellHeight;
+    const float startX;
+    const float startY;
+    const float targetX;
+    const float targetY;
+
+private:
+    std::vector<sf::Vector2f> path;
+    bool pathFound;
+    std::atomic<bool> done; ///< Set by the worker thread once path and pathFound are written.
+    std::atomic<bool> cancelled; ///< Set by the object which asked for the path when it does not need it anymore.
+};
+
+/**
+ * \brief The worker threads computing the paths asked by PathfindingBehavior::MoveToAsync.
+ *
+ * The workers are started when the first job is added.
+ */
+class PathfindingJobsQueue
+{
+public:
+    static PathfindingJobsQueue * Get()
+    {
+        if ( NULL == _singleton )
+            _singleton = new PathfindingJobsQueue;
+
+        return _singleton;
+    }
+
+    static void DestroySingleton()
+    {
+        if ( NULL != _singleton )
+        {
+            delete _singleton;
+            _singleton = NULL;
+        }
+    }
+
+    /**
+     * \brief Add a job to be run by a worker thread.
+     */
+    void Add(const std::shared_ptr<PathfindingJob> & job);
+
+    /**
+     * \brief Return the number of jobs waiting for a worker.
+     */
+    std::size_t GetPendingJobsCount();
+
+    /**
+     * \brief Wait until all the jobs added are run (or skipped, if they were cancelled).
+     */
+    void WaitForAllJobs();
+
+private:
+    PathfindingJobsQueue();
+    virtual ~PathfindingJobsQueue();
+
+    void StartWorkers();
+    void RunWorker();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex; ///< Protect pendingJobs, runningJobsCount and stopWorkers.
+    std::condition_variable jobsCondition; ///< Notified when a job is added or when the workers must stop.
+    std::condition_variable jobsDoneCondition; ///< Notified when the last job running is done.
+    std::deque<std::shared_ptr<PathfindingJob>> pendingJobs;
+    std::size_t runningJobsCount; ///< The number of jobs taken by a worker and not done yet.
+    bool stopWorkers;
+
+    static PathfindingJobsQueue * _singleton;
+};
+
+#endif
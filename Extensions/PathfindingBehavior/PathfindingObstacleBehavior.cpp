@@ -25,7 +25,11 @@ PathfindingObstacleBehavior::PathfindingObstacleBehavior() :
     sceneManager(NULL),
     registeredInManager(false),
     impassable(true),
-    cost(2)
+    cost(2),
+    lastX(0),
+    lastY(0),
+    lastWidth(0),
+    lastHeight(0)
 {
 }
 
@@ -59,11 +63,40 @@ void PathfindingObstacleBehavior::DoStepPreEvents(RuntimeScene & scene)
             registeredInManager = true;
         }
     }
+
+    CheckIfMoved();
 }
 
 void PathfindingObstacleBehavior::DoStepPostEvents(RuntimeScene & scene)
 {
+    CheckIfMoved(); //Take into account the changes done by the events.
+}
+
+void PathfindingObstacleBehavior::CheckIfMoved()
+{
+    float x = object->GetDrawableX();
+    float y = object->GetDrawableY();
+    float width = object->GetWidth();
+    float height = object->GetHeight();
+    if ( x == lastX && y == lastY && width == lastWidth && height == lastHeight ) return;
+
+    lastX = x;
+    lastY = y;
+    lastWidth = width;
+    lastHeight = height;
+    if ( sceneManager && registeredInManager ) sceneManager->ObstacleChanged(this);
+}
 
+void PathfindingObstacleBehavior::SetImpassable(bool impassable_)
+{
+    impassable = impassable_;
+    if ( sceneManager && registeredInManager ) sceneManager->ObstacleChanged(this);
+}
+
+void PathfindingObstacleBehavior::SetCost(float newCost)
+{
+    cost = newCost;
+    if ( sceneManager && registeredInManager ) sceneManager->ObstacleChanged(this);
 }
 
 void PathfindingObstacleBehavior::OnActivate()
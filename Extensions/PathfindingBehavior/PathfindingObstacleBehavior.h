@@ -23,6 +23,9 @@ namespace gd { class Layout; }
 /**
  * \brief Behavior that mark object as being obstacles for objects using
  * pathfinding behavior.
+ *
+ * The behavior notifies the ScenePathfindingObstaclesManager when the object was moved or resized,
+ * which is checked before and after the events, and when its cost is changed.
  */
 class GD_EXTENSION_API PathfindingObstacleBehavior : public Behavior
 {
@@ -44,7 +47,7 @@ public:
     /**
      * \brief Set the object as impassable or not.
      */
-    void SetImpassable(bool impassable_ = true) { impassable = impassable_; }
+    void SetImpassable(bool impassable_ = true);
 
     /**
      * \brief Return the cost of moving on the object.
@@ -54,7 +57,7 @@ public:
     /**
      * \brief Change the cost of moving on the object.
      */
-    void SetCost(float newCost) { cost = newCost; }
+    void SetCost(float newCost);
 
     virtual void UnserializeFrom(const gd::SerializerElement & element);
     #if defined(GD_IDE_ONLY)
@@ -70,11 +73,20 @@ private:
     virtual void DoStepPreEvents(RuntimeScene & scene);
     virtual void DoStepPostEvents(RuntimeScene & scene);
 
+    /**
+     * \brief Notify the obstacles manager if the object was moved or resized since the last check.
+     */
+    void CheckIfMoved();
+
     RuntimeScene * parentScene; ///< The scene the object belongs to.
     ScenePathfindingObstaclesManager * sceneManager; ///< The obstacles manager associated to the scene.
     bool registeredInManager; ///< True if the behavior is registered in the list of obstacles of the scene.
     bool impassable;
     float cost; ///< The cost of moving on the obstacle (for when impassable == false)
+    float lastX; ///< The position of the object on X axis, when last checked by CheckIfMoved.
+    float lastY; ///< The position of the object on Y axis, when last checked by CheckIfMoved.
+    float lastWidth; ///< The width of the object, when last checked by CheckIfMoved.
+    float lastHeight; ///< The height of the object, when last checked by CheckIfMoved.
 };
 
 #endif // PATHFINDINGOBSTACLEBEHAVIOR_H
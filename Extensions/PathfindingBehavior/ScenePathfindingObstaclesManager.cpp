@@ -7,6 +7,7 @@ This project is released under the MIT License.
 #include "ScenePathfindingObstaclesManager.h"
 #include "PathfindingObstacleBehavior.h"
 #include <iostream>
+#include <algorithm>
 
 std::map<RuntimeScene*, ScenePathfindingObstaclesManager> ScenePathfindingObstaclesManager::managers;
 
@@ -23,8 +24,79 @@ ScenePathfindingObstaclesManager::~ScenePathfindingObstaclesManager()
 void ScenePathfindingObstaclesManager::AddObstacle(PathfindingObstacleBehavior * obstacle)
 {
 	allObstacles.insert(obstacle);
+	ObstacleChanged(obstacle);
 }
 void ScenePathfindingObstaclesManager::RemoveObstacle(PathfindingObstacleBehavior * obstacle)
 {
 	allObstacles.erase(obstacle);
+	for (std::size_t i = 0;i<costGrids.size();++i)
+		costGrids[i]->RemoveObstacle(obstacle);
+}
+
+void ScenePathfindingObstaclesManager::ObstacleChanged(PathfindingObstacleBehavior * obstacle)
+{
+	if ( allObstacles.find(obstacle) == allObstacles.end() ) return;
+
+	for (std::size_t i = 0;i<costGrids.size();++i)
+		costGrids[i]->ObstacleChanged(obstacle);
+}
+
+const PathfindingCostGrid & ScenePathfindingObstaclesManager::GetCostGrid(float cellWidth, float cellHeight,
+	float leftBorder, float topBorder, float rightBorder, float bottomBorder)
+{
+	std::size_t i = 0;
+	while (i<costGrids.size() && !costGrids[i]->IsMadeFor(cellWidth, cellHeight, leftBorder, topBorder, rightBorder, bottomBorder))
+		++i;
+
+	if ( i == costGrids.size() )
+	{
+		//Drop the least recently used grid if there are too many sizes of objects.
+		if ( costGrids.size() >= maxCostGridsCount ) costGrids.pop_back();
+		costGrids.insert(costGrids.begin(), std::unique_ptr<PathfindingCostGrid>(new PathfindingCostGrid(
+			cellWidth, cellHeight, leftBorder, topBorder, rightBorder, bottomBorder)));
+		costGrids[0]->Update(allObstacles);
+	}
+	else
+	{
+		std::rotate(costGrids.begin(), costGrids.begin()+i, costGrids.begin()+i+1);
+		costGrids[0]->UpdateChangedObstacles();
+	}
+
+	return *costGrids[0];
+}
+
+std::shared_ptr<const PathfindingCostGrid> ScenePathfindingObstaclesManager::GetCostGridSnapshot(float cellWidth, float cellHeight,
+	float leftBorder, float topBorder, float rightBorder, float bottomBorder)
+{
+	GetCostGrid(cellWidth, cellHeight, leftBorder, topBorder, rightBorder, bottomBorder);
+	return costGrids[0]->GetSnapshot();
+}
+
+PathfindingGoalField * ScenePathfindingObstaclesManager::GetGoalField(const PathfindingCostGrid & grid,
+	int goalX, int goalY, bool allowsDiagonal)
+{
+	//Forget the fields computed with obstacles which changed since then.
+	goalFields.erase(std::remove_if(goalFields.begin(), goalFields.end(),
+		[this](const std::unique_ptr<PathfindingGoalField> & field) {
+			for (std::size_t i = 0;i<costGrids.size();++i)
+				if ( costGrids[i]->GetVersion() == field->GetGridVersion() ) return false;
+
+			return true;
+		}), goalFields.end());
+
+	std::size_t i = 0;
+	while (i<goalFields.size() && !goalFields[i]->IsMadeFor(goalX, goalY, allowsDiagonal, grid.GetVersion()))
+		++i;
+
+	if ( i == goalFields.size() )
+	{
+		//Only remember that an object is going to the goal.
+		if ( goalFields.size() >= maxGoalFieldsCount ) goalFields.pop_back();
+		goalFields.insert(goalFields.begin(), std::unique_ptr<PathfindingGoalField>(new PathfindingGoalField(
+			goalX, goalY, allowsDiagonal, grid.GetVersion())));
+		return NULL;
+	}
+
+	std::rotate(goalFields.begin(), goalFields.begin()+i, goalFields.begin()+i+1);
+	return goalFields[0].get();
 }
@@ -7,8 +7,12 @@ This project is released under the MIT License.
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
 #include <map>
+#include <memory>
 #include <set>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeScene.h"
+#include "PathfindingCostGrid.h"
+#include "PathfindingGoalField.h"
 class PathfindingObstacleBehavior;
 
 /**
@@ -37,13 +41,52 @@ public:
      */
     void RemoveObstacle(PathfindingObstacleBehavior * obstacle);
 
+    /**
+     * \brief Notify the manager that an obstacle was moved, resized or changed, so that
+     * it is rasterized again in the cost grids.
+     * \see PathfindingObstacleBehavior
+     */
+    void ObstacleChanged(PathfindingObstacleBehavior * obstacle);
+
     /**
      * \brief Get a read only access to the list of all obstacles
      */
     const std::set<PathfindingObstacleBehavior*> & GetAllObstacles() const { return allObstacles; }
 
+    /**
+     * \brief Get the costs of the cells for an object with the specified borders, updated
+     * with the current position of the obstacles.
+     *
+     * A grid is kept for each size of cells and of objects, so that only the obstacles
+     * added or changed (see ObstacleChanged) since the last call are rasterized again.
+     */
+    const PathfindingCostGrid & GetCostGrid(float cellWidth, float cellHeight,
+        float leftBorder, float topBorder, float rightBorder, float bottomBorder);
+
+    /**
+     * \brief Same as GetCostGrid, but return an immutable copy of the grid to be used by other threads.
+     */
+    std::shared_ptr<const PathfindingCostGrid> GetCostGridSnapshot(float cellWidth, float cellHeight,
+        float leftBorder, float topBorder, float rightBorder, float bottomBorder);
+
+    /**
+     * \brief Get the field of the paths to a goal cell, to be shared by the objects going to it.
+     *
+     * The first time a path to a goal is asked with a version of the cost grid, NULL is returned:
+     * a single object is better using A*, which explores less cells than the field.
+     * A field is returned when other objects go to the same goal.
+     *
+     * \param grid The cost grid returned by GetCostGrid.
+     */
+    PathfindingGoalField * GetGoalField(const PathfindingCostGrid & grid, int goalX, int goalY, bool allowsDiagonal);
+
 private:
     std::set<PathfindingObstacleBehavior*> allObstacles; ///< The list of all obstacles of the scene.
+    std::vector<std::unique_ptr<PathfindingCostGrid>> costGrids; ///< The grids, the most recently used first.
+    std::vector<std::unique_ptr<PathfindingGoalField>> goalFields; ///< The fields, the most recently used first.
+
+    static const std::size_t maxCostGridsCount = 8;
+    static const std::size_t maxGoalFieldsCount = 16;
 };
 
 
@@ -18,7 +18,13 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Extensions/Builtin/ObjectTools.h"
 #include "../PathfindingBehavior.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
 #include "../PathfindingObstacleBehavior.h"
+#include "../PathfindingJobsQueue.h"
+#include "../PathfindingCostGrid.h"
+#include "../ScenePathfindingObstaclesManager.h"
 
 //Mock objects that can have a specific size
 class ResizableRuntimeObject : public RuntimeObject {
@@ -75,6 +81,26 @@ TEST_CASE( "PathfindingBehavior", "[game-engine][pathfinding]" ) {
 		runtimeBehavior->MoveTo(scene, 1200, 1300);
 		REQUIRE(runtimeBehavior->PathFound() == false);
 		REQUIRE(runtimeBehavior->GetNodeCount() == 0);
+
+		//Move the obstacle away (the path is computed with the new position, once the obstacle
+		//noticed it was moved during the step of the scene)
+		obstacle->SetX(2000);
+		scene.RenderAndStep();
+		runtimeBehavior->MoveTo(scene, 1200, 1300);
+		REQUIRE(runtimeBehavior->PathFound() == true);
+		REQUIRE(runtimeBehavior->GetNodeCount() == 66);
+
+		//Move it back, and remove it
+		obstacle->SetX(1100);
+		scene.RenderAndStep();
+		runtimeBehavior->MoveTo(scene, 1200, 1300);
+		REQUIRE(runtimeBehavior->PathFound() == false);
+
+		scene.objectsInstances.RemoveObject(obstacle);
+		obstacle.reset();
+		runtimeBehavior->MoveTo(scene, 1200, 1300);
+		REQUIRE(runtimeBehavior->PathFound() == true);
+		REQUIRE(runtimeBehavior->GetNodeCount() == 66);
 	}
 	SECTION("Obstacle in the middle") {
 		//Prepare some objects and the context
@@ -198,4 +224,438 @@ TEST_CASE( "PathfindingBehavior", "[game-engine][pathfinding]" ) {
 		REQUIRE(runtimeBehavior->GetNodeX(4) == 20);
 		REQUIRE(runtimeBehavior->GetNodeY(4) == 80);
 	}
+	SECTION("Objects going to the same destination") {
+		//Prepare some objects and the context
+		RuntimeGame game;
+
+		gd::Object playerObj("player");
+		auto behavior = new PathfindingBehavior();
+		behavior->SetName("Pathfinding");
+		playerObj.AddBehavior(behavior);
+
+		gd::Object obstacleObj("obstacle");
+		obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+		RuntimeScene scene(NULL, &game);
+		std::shared_ptr<ResizableRuntimeObject> obstacle(new ResizableRuntimeObject(scene, obstacleObj));
+		scene.objectsInstances.AddObject(obstacle);
+		obstacle->SetX(0);
+		obstacle->SetY(600);
+		obstacle->SetWidth(1300);
+		obstacle->SetHeight(32);
+
+		std::vector<std::shared_ptr<RuntimeObject>> players;
+		for (std::size_t i = 0;i<3;++i)
+		{
+			players.push_back(std::make_shared<RuntimeObject>(scene, playerObj));
+			players.back()->SetX(i*100);
+			scene.objectsInstances.AddObject(players.back());
+		}
+		scene.RenderAndStep();
+
+		//The first object searches the path alone, the others share the search.
+		for (std::size_t i = 0;i<players.size();++i)
+		{
+			PathfindingBehavior * runtimeBehavior =
+				static_cast<PathfindingBehavior *>(players[i]->GetBehaviorRawPointer("Pathfinding"));
+			runtimeBehavior->MoveTo(scene, 1200, 1300);
+			REQUIRE(runtimeBehavior->PathFound() == true);
+			REQUIRE(runtimeBehavior->GetNodeX(0) == i*100);
+			REQUIRE(runtimeBehavior->GetNodeY(0) == 0);
+			REQUIRE(runtimeBehavior->GetDestinationX() == 1200);
+			REQUIRE(runtimeBehavior->GetDestinationY() == 1300);
+			for (std::size_t j = 0;j<runtimeBehavior->GetNodeCount();++j)
+			{
+				float nodeX = runtimeBehavior->GetNodeX(j);
+				float nodeY = runtimeBehavior->GetNodeY(j);
+				REQUIRE((nodeY == 620 && nodeX >= 20 && nodeX <= 1280) == false); //Cells covered by the obstacle
+			}
+		}
+	}
+	SECTION("Objects going to the same far destination") {
+		//Prepare some objects and the context
+		RuntimeGame game;
+
+		gd::Object playerObj("player");
+		auto behavior = new PathfindingBehavior();
+		behavior->SetName("Pathfinding");
+		playerObj.AddBehavior(behavior);
+
+		gd::Object obstacleObj("obstacle");
+		auto obstacleBehavior = new PathfindingObstacleBehavior();
+		obstacleBehavior->SetName("PathfindingObstacle");
+		obstacleObj.AddBehavior(obstacleBehavior);
+
+		RuntimeScene scene(NULL, &game);
+		std::vector<std::shared_ptr<ResizableRuntimeObject>> obstacles;
+		auto addObstacle = [&](float x, float y, float width, float height) {
+			obstacles.push_back(std::make_shared<ResizableRuntimeObject>(scene, obstacleObj));
+			obstacles.back()->SetX(x);
+			obstacles.back()->SetY(y);
+			obstacles.back()->SetWidth(width);
+			obstacles.back()->SetHeight(height);
+			scene.objectsInstances.AddObject(obstacles.back());
+			return static_cast<PathfindingObstacleBehavior*>(obstacles.back()->GetBehaviorRawPointer("PathfindingObstacle"));
+		};
+		auto removeObstacles = [&]() {
+			for (std::size_t i = 0;i<obstacles.size();++i)
+				scene.objectsInstances.RemoveObject(obstacles[i]);
+			obstacles.clear();
+		};
+
+		std::vector<std::shared_ptr<RuntimeObject>> players;
+		for (std::size_t i = 0;i<4;++i)
+		{
+			players.push_back(std::make_shared<RuntimeObject>(scene, playerObj));
+			scene.objectsInstances.AddObject(players.back());
+		}
+
+		//The first object searches the path with A*, the others with the shared field:
+		//they must all find a path, with the same number of nodes.
+		auto checkSamePath = [&players, &scene](float targetX, float targetY) {
+			std::size_t expectedNodeCount = 0;
+			for (std::size_t i = 0;i<players.size();++i)
+			{
+				PathfindingBehavior * runtimeBehavior =
+					static_cast<PathfindingBehavior *>(players[i]->GetBehaviorRawPointer("Pathfinding"));
+				runtimeBehavior->MoveTo(scene, targetX, targetY);
+				REQUIRE(runtimeBehavior->PathFound() == true);
+				if ( i == 0 ) expectedNodeCount = runtimeBehavior->GetNodeCount();
+				REQUIRE(runtimeBehavior->GetNodeCount() == expectedNodeCount);
+			}
+		};
+
+		//A wall to go around.
+		addObstacle(1000, -400, 20, 800);
+		scene.RenderAndStep();
+		checkSamePath(2000, 0);
+		removeObstacles();
+
+		//A ground where moving costs twice more than the distance.
+		PathfindingObstacleBehavior * ground = addObstacle(-400, -800, 1800, 1600);
+		ground->SetImpassable(false);
+		ground->SetCost(2);
+		scene.RenderAndStep();
+		checkSamePath(1000, 0);
+		removeObstacles();
+
+		//A room around the objects, open on the side opposite to the destination:
+		//the path is much longer than the distance to the destination.
+		addObstacle(90, -130, 40, 260);
+		addObstacle(-110, -130, 240, 40);
+		addObstacle(-110, 90, 240, 40);
+		scene.RenderAndStep();
+		checkSamePath(240, 0);
+	}
+	SECTION("Paths computed in background") {
+		//Prepare some objects and the context
+		RuntimeGame game;
+
+		gd::Object playerObj("player");
+		auto behavior = new PathfindingBehavior();
+		behavior->SetName("Pathfinding");
+		behavior->SetMaxSpeed(0); //Objects must not move while paths are computed.
+		playerObj.AddBehavior(behavior);
+
+		gd::Object obstacleObj("obstacle");
+		obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+		RuntimeScene scene(NULL, &game);
+		std::srand(42);
+		std::vector<std::shared_ptr<ResizableRuntimeObject>> obstacles;
+		for (std::size_t i = 0;i<50;++i)
+		{
+			obstacles.push_back(std::make_shared<ResizableRuntimeObject>(scene, obstacleObj));
+			obstacles.back()->SetX(100 + std::rand() % 800);
+			obstacles.back()->SetY(100 + std::rand() % 800);
+			obstacles.back()->SetWidth(20 + std::rand() % 40);
+			obstacles.back()->SetHeight(20 + std::rand() % 40);
+			scene.objectsInstances.AddObject(obstacles.back());
+		}
+
+		std::vector<std::shared_ptr<RuntimeObject>> players;
+		for (std::size_t i = 0;i<300;++i)
+		{
+			players.push_back(std::make_shared<RuntimeObject>(scene, playerObj));
+			players.back()->SetX(std::rand() % 100);
+			players.back()->SetY(std::rand() % 100);
+			scene.objectsInstances.AddObject(players.back());
+		}
+		scene.RenderAndStep();
+
+		//Compute the paths synchronously first, then ask for all of them at once.
+		//Destinations are all different, so that each path is computed with A*.
+		std::vector<std::size_t> expectedNodeCounts;
+		std::vector<sf::Vector2f> targets;
+		for (std::size_t i = 0;i<players.size();++i)
+		{
+			PathfindingBehavior * runtimeBehavior =
+				static_cast<PathfindingBehavior *>(players[i]->GetBehaviorRawPointer("Pathfinding"));
+			targets.push_back(sf::Vector2f(200 + (i % 30)*20, 1000 + (i / 30)*20));
+			runtimeBehavior->MoveTo(scene, targets.back().x, targets.back().y);
+			REQUIRE(runtimeBehavior->PathReady() == true);
+			expectedNodeCounts.push_back(runtimeBehavior->GetNodeCount());
+		}
+		for (std::size_t i = 0;i<players.size();++i)
+		{
+			PathfindingBehavior * runtimeBehavior =
+				static_cast<PathfindingBehavior *>(players[i]->GetBehaviorRawPointer("Pathfinding"));
+			runtimeBehavior->MoveToAsync(scene, targets[i].x, targets[i].y);
+			REQUIRE(runtimeBehavior->PathReady() == false);
+		}
+
+		//The paths are applied at the beginning of the step following their computation.
+		PathfindingJobsQueue::Get()->WaitForAllJobs();
+		scene.RenderAndStep();
+
+		for (std::size_t i = 0;i<players.size();++i)
+		{
+			PathfindingBehavior * runtimeBehavior =
+				static_cast<PathfindingBehavior *>(players[i]->GetBehaviorRawPointer("Pathfinding"));
+			REQUIRE(runtimeBehavior->PathReady() == true);
+			REQUIRE(runtimeBehavior->PathFound() == (expectedNodeCounts[i] > 0));
+			REQUIRE(runtimeBehavior->GetNodeCount() == expectedNodeCounts[i]);
+		}
+	}
+	SECTION("Paths computed in background are computed again when blocked") {
+		//Prepare some objects and the context
+		RuntimeGame game;
+
+		gd::Object playerObj("player");
+		auto behavior = new PathfindingBehavior();
+		behavior->SetName("Pathfinding");
+		behavior->SetMaxSpeed(0);
+		playerObj.AddBehavior(behavior);
+
+		gd::Object obstacleObj("obstacle");
+		obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+		RuntimeScene scene(NULL, &game);
+		std::shared_ptr<RuntimeObject> player(new RuntimeObject(scene, playerObj));
+		std::shared_ptr<ResizableRuntimeObject> obstacle(new ResizableRuntimeObject(scene, obstacleObj));
+		scene.objectsInstances.AddObject(player);
+		scene.objectsInstances.AddObject(obstacle);
+		obstacle->SetX(-1000);
+		obstacle->SetY(-1000);
+		obstacle->SetWidth(40);
+		obstacle->SetHeight(200);
+		scene.RenderAndStep();
+
+		PathfindingBehavior * runtimeBehavior =
+			static_cast<PathfindingBehavior *>(player->GetBehaviorRawPointer("Pathfinding"));
+		runtimeBehavior->MoveToAsync(scene, 400, 0);
+
+		//Put the obstacle on the straight path while it is computed, like events would do.
+		obstacle->SetX(200);
+		obstacle->SetY(-100);
+		scene.objectsInstances.StepBehaviorsPostEvents(scene);
+
+		//The path is blocked when applied, and computed again with the new position of the obstacle.
+		PathfindingJobsQueue::Get()->WaitForAllJobs();
+		scene.RenderAndStep();
+		REQUIRE(runtimeBehavior->PathReady() == false);
+
+		PathfindingJobsQueue::Get()->WaitForAllJobs();
+		scene.RenderAndStep();
+		REQUIRE(runtimeBehavior->PathReady() == true);
+		REQUIRE(runtimeBehavior->PathFound() == true);
+		for (std::size_t i = 0;i<runtimeBehavior->GetNodeCount();++i)
+		{
+			float nodeX = runtimeBehavior->GetNodeX(i);
+			float nodeY = runtimeBehavior->GetNodeY(i);
+			REQUIRE((nodeX == 220 && nodeY >= -80 && nodeY <= 80) == false); //Cells covered by the obstacle
+		}
+	}
+	SECTION("Paths computed in background and always blocked are computed synchronously") {
+		//Prepare some objects and the context
+		RuntimeGame game;
+
+		gd::Object playerObj("player");
+		auto behavior = new PathfindingBehavior();
+		behavior->SetName("Pathfinding");
+		behavior->SetMaxSpeed(0);
+		playerObj.AddBehavior(behavior);
+
+		gd::Object obstacleObj("obstacle");
+		obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+		RuntimeScene scene(NULL, &game);
+		std::shared_ptr<RuntimeObject> player(new RuntimeObject(scene, playerObj));
+		std::shared_ptr<ResizableRuntimeObject> obstacle(new ResizableRuntimeObject(scene, obstacleObj));
+		scene.objectsInstances.AddObject(player);
+		scene.objectsInstances.AddObject(obstacle);
+
+		//A wall that can be bypassed only from above (covering the cells -8 to 100 of the column 11),
+		//and moved to be bypassed only from below (covering the cells -100 to 8): a path avoiding
+		//one position of the wall is always blocked by the other one.
+		auto moveWallDown = [&]() { obstacle->SetY(-180); };
+		auto moveWallUp = [&]() { obstacle->SetY(-2020); };
+		obstacle->SetX(200);
+		obstacle->SetWidth(40);
+		obstacle->SetHeight(2200);
+		moveWallDown();
+		scene.RenderAndStep();
+
+		PathfindingBehavior * runtimeBehavior =
+			static_cast<PathfindingBehavior *>(player->GetBehaviorRawPointer("Pathfinding"));
+		runtimeBehavior->MoveToAsync(scene, 400, 0);
+
+		//Move the wall while each path is computed, like events would do.
+		for (std::size_t i = 0;i<4;++i)
+		{
+			if ( i % 2 == 0 ) moveWallUp(); else moveWallDown();
+			scene.objectsInstances.StepBehaviorsPostEvents(scene);
+
+			PathfindingJobsQueue::Get()->WaitForAllJobs();
+			scene.RenderAndStep();
+			REQUIRE(runtimeBehavior->PathReady() == (i == 3));
+		}
+
+		//After being computed again a few times, the path was computed with the current position of the wall.
+		REQUIRE(runtimeBehavior->PathFound() == true);
+		for (std::size_t i = 0;i<runtimeBehavior->GetNodeCount();++i)
+		{
+			float nodeX = runtimeBehavior->GetNodeX(i);
+			float nodeY = runtimeBehavior->GetNodeY(i);
+			REQUIRE((nodeX == 220 && nodeY >= -160) == false); //Cells covered by the wall
+		}
+	}
+	SECTION("Snapshots of the costs are not changed by obstacles") {
+		RuntimeGame game;
+
+		gd::Object obstacleObj("obstacle");
+		obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+		RuntimeScene scene(NULL, &game);
+		std::shared_ptr<ResizableRuntimeObject> obstacle(new ResizableRuntimeObject(scene, obstacleObj));
+		scene.objectsInstances.AddObject(obstacle);
+		obstacle->SetX(100);
+		obstacle->SetY(100);
+		obstacle->SetWidth(40);
+		obstacle->SetHeight(40);
+		scene.RenderAndStep();
+
+		ScenePathfindingObstaclesManager & manager = ScenePathfindingObstaclesManager::managers[&scene];
+		std::shared_ptr<const PathfindingCostGrid> snapshot = manager.GetCostGridSnapshot(20, 20, 0, 0, 0, 0);
+		REQUIRE(snapshot->GetCost(6, 6) == -1);
+		REQUIRE(snapshot->GetCost(50, 6) == 1);
+		REQUIRE(manager.GetCostGridSnapshot(20, 20, 0, 0, 0, 0) == snapshot); //Shared until obstacles change
+
+		//Move the obstacle: the grid is changed, but not the snapshot.
+		obstacle->SetX(1000);
+		scene.objectsInstances.StepBehaviorsPostEvents(scene);
+		const PathfindingCostGrid & costGrid = manager.GetCostGrid(20, 20, 0, 0, 0, 0);
+		REQUIRE(costGrid.GetCost(6, 6) == 1);
+		REQUIRE(costGrid.GetCost(51, 6) == -1);
+		REQUIRE(snapshot->GetCost(6, 6) == -1);
+		REQUIRE(snapshot->GetCost(51, 6) == 1);
+
+		std::shared_ptr<const PathfindingCostGrid> newSnapshot = manager.GetCostGridSnapshot(20, 20, 0, 0, 0, 0);
+		REQUIRE(newSnapshot != snapshot);
+		REQUIRE(newSnapshot->GetCost(6, 6) == 1);
+		REQUIRE(newSnapshot->GetCost(51, 6) == -1);
+	}
+}
+
+TEST_CASE( "PathfindingBehavior benchmark", "[.][benchmark]" ) {
+	//Plan paths across a scene with more and more obstacles, some of them moving between each path.
+	const std::size_t pathsCount = 20;
+	for (std::size_t obstaclesCount = 0;obstaclesCount<=2000;obstaclesCount = obstaclesCount ? obstaclesCount*4 : 125)
+	{
+		RuntimeGame game;
+		gd::Object playerObj("player");
+		auto behavior = new PathfindingBehavior();
+		behavior->SetName("Pathfinding");
+		playerObj.AddBehavior(behavior);
+
+		gd::Object obstacleObj("obstacle");
+		obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+		RuntimeScene scene(NULL, &game);
+		std::shared_ptr<RuntimeObject> player(new RuntimeObject(scene, playerObj));
+		scene.objectsInstances.AddObject(player);
+
+		std::srand(42);
+		std::vector<std::shared_ptr<ResizableRuntimeObject>> obstacles;
+		for (std::size_t i = 0;i<obstaclesCount;++i)
+		{
+			obstacles.push_back(std::make_shared<ResizableRuntimeObject>(scene, obstacleObj));
+			obstacles.back()->SetX(100 + std::rand() % 3000);
+			obstacles.back()->SetY(100 + std::rand() % 3000);
+			obstacles.back()->SetWidth(20 + std::rand() % 40);
+			obstacles.back()->SetHeight(20 + std::rand() % 40);
+			scene.objectsInstances.AddObject(obstacles.back());
+		}
+		scene.RenderAndStep();
+
+		PathfindingBehavior * runtimeBehavior =
+			static_cast<PathfindingBehavior *>(player->GetBehaviorRawPointer("Pathfinding"));
+
+		std::size_t nodesCount = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (std::size_t i = 0;i<pathsCount;++i)
+		{
+			if ( !obstacles.empty() ) obstacles[i % obstacles.size()]->SetX(100 + std::rand() % 3000);
+			scene.objectsInstances.StepBehaviorsPostEvents(scene); //The obstacles notice they were moved.
+
+			runtimeBehavior->MoveTo(scene, 3200, 3200);
+			nodesCount += runtimeBehavior->GetNodeCount();
+		}
+		double elapsed = std::chrono::duration<double, std::micro>(
+			std::chrono::high_resolution_clock::now() - start).count();
+
+		std::cout << "Planning paths with " << obstaclesCount << " obstacles: "
+			<< elapsed / pathsCount << " us, " << nodesCount / pathsCount << " nodes (per path)" << std::endl;
+	}
+}
+
+TEST_CASE( "PathfindingBehavior crowd benchmark", "[.][benchmark]" ) {
+	//Many objects ordered to go to the same destination, around obstacles.
+	const std::size_t playersCount = 300;
+	RuntimeGame game;
+	gd::Object playerObj("player");
+	auto behavior = new PathfindingBehavior();
+	behavior->SetName("Pathfinding");
+	playerObj.AddBehavior(behavior);
+
+	gd::Object obstacleObj("obstacle");
+	obstacleObj.AddBehavior(new PathfindingObstacleBehavior());
+
+	RuntimeScene scene(NULL, &game);
+	std::srand(42);
+	std::vector<std::shared_ptr<ResizableRuntimeObject>> obstacles;
+	for (std::size_t i = 0;i<500;++i)
+	{
+		obstacles.push_back(std::make_shared<ResizableRuntimeObject>(scene, obstacleObj));
+		obstacles.back()->SetX(100 + std::rand() % 3000);
+		obstacles.back()->SetY(100 + std::rand() % 3000);
+		obstacles.back()->SetWidth(20 + std::rand() % 40);
+		obstacles.back()->SetHeight(20 + std::rand() % 40);
+		scene.objectsInstances.AddObject(obstacles.back());
+	}
+
+	std::vector<std::shared_ptr<RuntimeObject>> players;
+	for (std::size_t i = 0;i<playersCount;++i)
+	{
+		players.push_back(std::make_shared<RuntimeObject>(scene, playerObj));
+		players.back()->SetX(std::rand() % 600);
+		players.back()->SetY(std::rand() % 600);
+		scene.objectsInstances.AddObject(players.back());
+	}
+	scene.RenderAndStep();
+
+	std::size_t pathsFound = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (std::size_t i = 0;i<players.size();++i)
+	{
+		PathfindingBehavior * runtimeBehavior =
+			static_cast<PathfindingBehavior *>(players[i]->GetBehaviorRawPointer("Pathfinding"));
+		runtimeBehavior->MoveTo(scene, 3200, 3200);
+		if ( runtimeBehavior->PathFound() ) pathsFound++;
+	}
+	double elapsed = std::chrono::duration<double, std::micro>(
+		std::chrono::high_resolution_clock::now() - start).count();
+
+	std::cout << "Planning paths of " << playersCount << " objects to the same destination: "
+		<< elapsed << " us, " << pathsFound << " paths found" << std::endl;
 }
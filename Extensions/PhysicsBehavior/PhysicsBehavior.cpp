@@ -543,31 +543,25 @@ double PhysicsBehavior::GetAngularDamping( const RuntimeScene & scene)
 /**
  * Test if there is a contact with another object
  */
-bool PhysicsBehavior::CollisionWith( std::map <gd::String, std::vector<RuntimeObject*> *> otherObjectsLists, RuntimeScene & scene)
+bool PhysicsBehavior::CollisionWith( ObjectsListsView otherObjectsLists, RuntimeScene & scene)
 {
     if ( !body ) CreateBody(scene);
 
-    //Getting a list of all objects which are tested
-    std::vector<RuntimeObject*> objects;
-    for (std::map <gd::String, std::vector<RuntimeObject*> *>::const_iterator it = otherObjectsLists.begin();it!=otherObjectsLists.end();++it)
+    //Test if an object of the lists is in collision with our object.
+    for (ObjectsListsView::const_iterator list = otherObjectsLists.begin();list!=otherObjectsLists.end();++list)
     {
-        if ( it->second != NULL )
-        {
-            objects.reserve(objects.size()+it->second->size());
-            std::copy(it->second->begin(), it->second->end(), std::back_inserter(objects));
-        }
-    }
+        if ( list->second == NULL ) continue;
 
-    //Test if an object of the list is in collision with our object.
-	std::vector<RuntimeObject*>::const_iterator obj_end = objects.end();
-    for (std::vector<RuntimeObject*>::iterator obj = objects.begin(); obj != obj_end; ++obj )
-    {
-        std::set<PhysicsBehavior*>::const_iterator it = currentContacts.begin();
-        std::set<PhysicsBehavior*>::const_iterator end = currentContacts.end();
-        for (;it != end;++it)
+        std::vector<RuntimeObject*>::const_iterator obj_end = list->second->end();
+        for (std::vector<RuntimeObject*>::const_iterator obj = list->second->begin(); obj != obj_end; ++obj )
         {
-            if ( (*it)->GetObject() == (*obj) )
-                return true;
+            std::set<PhysicsBehavior*>::const_iterator it = currentContacts.begin();
+            std::set<PhysicsBehavior*>::const_iterator end = currentContacts.end();
+            for (;it != end;++it)
+            {
+                if ( (*it)->GetObject() == (*obj) )
+                    return true;
+            }
         }
     }
 
@@ -10,6 +10,7 @@ This project is released under the MIT License.
 
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 #include "SFML/Config.hpp"
 #include "SFML/System/Vector2.hpp"
 #include <map>
@@ -132,7 +133,7 @@ public:
     */
     static std::vector<sf::Vector2f> GetCoordsVectorFromString(const gd::String &str, char32_t coordsSep = U'\n', char32_t composantSep = U';');
 
-    bool CollisionWith( std::map <gd::String, std::vector<RuntimeObject*> *> otherObjectsLists, RuntimeScene & scene);
+    bool CollisionWith( ObjectsListsView otherObjectsLists, RuntimeScene & scene);
 
 private:
 
@@ -15,6 +15,7 @@ This project is released under the MIT License.
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/CommonTools.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
 #include <SFML/Window.hpp>
 #include <iostream>
 #include <cmath>
@@ -25,6 +26,14 @@ This project is released under the MIT License.
 #include "GDCore/IDE/Dialogs/PropertyDescriptor.h"
 #endif
 
+namespace
+{
+    const std::vector<PlatformBehavior*> noPlatforms;
+    const double minSkippedMovement = 2; ///< Shorter movements are resolved by the per-pixel loops only.
+    const float collisionMargin = 0.5; ///< The overlap needed to consider that a position surely collides.
+    const double maxSkippingPosition = 500000; ///< Further positions are resolved by the per-pixel loops only.
+}
+
 PlatformerObjectBehavior::PlatformerObjectBehavior() :
     gravity(1000),
     maxFallingSpeed(700),
@@ -50,6 +59,7 @@ PlatformerObjectBehavior::PlatformerObjectBehavior() :
     grabbedPlatform(NULL),
     grabbedPlatformLastX(0),
     grabbedPlatformLastY(0),
+    resolveCollisionsPixelByPixel(false),
     trackSize(true),
     ignoreDefaultControls(false),
     leftKey(false),
@@ -127,18 +137,18 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
     requestedDeltaX += currentSpeed*timeDelta;
 
     //Compute the list of the objects that will be used
-    std::set<PlatformBehavior*> potentialObjects = GetPotentialCollidingObjects(std::max(requestedDeltaX, maxFallingSpeed));
-    std::set<PlatformBehavior*> overlappedJumpThru = GetJumpthruCollidingWith(potentialObjects);
+    GetPotentialCollidingObjects(std::max(requestedDeltaX, maxFallingSpeed), potentialObjects);
+    GetJumpthruCollidingWith(potentialObjects, overlappedJumpThru);
 
     //Check that the floor object still exists and is near the object.
-    if ( isOnFloor && potentialObjects.find(floorPlatform) == potentialObjects.end() )
+    if ( isOnFloor && std::find(potentialObjects.begin(), potentialObjects.end(), floorPlatform) == potentialObjects.end() )
     {
         isOnFloor = false;
         floorPlatform = NULL;
     }
 
     //Check that the grabbed platform object still exists and is near the object.
-    if (isGrabbingPlatform && potentialObjects.find(grabbedPlatform) == potentialObjects.end()) {
+    if (isGrabbingPlatform && std::find(potentialObjects.begin(), potentialObjects.end(), grabbedPlatform) == potentialObjects.end()) {
         ReleaseGrabbedPlatform();
     }
 
@@ -185,6 +195,13 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
         object->SetX(object->GetX()+requestedDeltaX);
         //Colliding: Try to push out from the solid.
         //Note that jump thru are never obstacle on X axis.
+        if ( !resolveCollisionsPixelByPixel && std::abs(requestedDeltaX) >= minSkippedMovement )
+        {
+            //Fast movements: go directly to the last positions before the contact.
+            GetObstacles(potentialObjects, floorPlatform, /*excludeJumpThrus=*/true, noPlatforms, obstacles);
+            if ( IsCollidingWith(obstacles) && SkipCollidingPositions(obstacles, true, requestedDeltaX, oldX, isOnFloor) )
+                currentSpeed = 0; //Collided with a wall
+        }
         while ( IsCollidingWith(potentialObjects, floorPlatform, /*excludeJumpthrus=*/true) )
         {
             if ( (requestedDeltaX > 0 && object->GetX() <= oldX) ||
@@ -255,8 +272,8 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
         bool tryGrabbingPlatform = false;
 
         object->SetX(object->GetX() + (requestedDeltaX > 0 ? xGrabTolerance : -xGrabTolerance));
-        auto collidingObjects = GetPlatformsCollidingWith(potentialObjects, overlappedJumpThru);
-        if (!collidingObjects.empty() && CanGrab(*collidingObjects.begin(), requestedDeltaY)) {
+        PlatformBehavior * collidingPlatform = GetFirstPlatformCollidingWith(potentialObjects, overlappedJumpThru);
+        if (collidingPlatform && CanGrab(collidingPlatform, requestedDeltaY)) {
             tryGrabbingPlatform = true;
         }
         object->SetX(object->GetX() + (requestedDeltaX > 0 ? -xGrabTolerance : xGrabTolerance));
@@ -265,7 +282,6 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
         if (tryGrabbingPlatform)
         {
             double oldY = object->GetY();
-            PlatformBehavior * collidingPlatform = *collidingObjects.begin();
             object->SetY(collidingPlatform->GetObject()->GetY() + collidingPlatform->GetYGrabOffset() - yGrabOffset);
             if (!IsCollidingWith(potentialObjects, NULL, /*excludeJumpthrus=*/true)) {
                 isGrabbingPlatform = true;
@@ -381,6 +397,21 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
         double oldY = object->GetY();
         object->SetY(object->GetY()+requestedDeltaY);
 
+        //Fast movements: go directly to the last positions before the contact.
+        if ( !resolveCollisionsPixelByPixel && std::abs(requestedDeltaY) >= minSkippedMovement )
+        {
+            if ( requestedDeltaY < 0 )
+                GetObstacles(potentialObjects, NULL, /*excludeJumpThrus=*/true, noPlatforms, obstacles);
+            else
+                GetObstacles(potentialObjects, NULL, /*excludeJumpThrus=*/false, overlappedJumpThru, obstacles);
+
+            if ( IsCollidingWith(obstacles) && SkipCollidingPositions(obstacles, false, requestedDeltaY, oldY, false) )
+            {
+                jumping = false;
+                currentJumpSpeed = 0;
+            }
+        }
+
         //Stop when colliding with an obstacle.
         while (  (requestedDeltaY < 0 && IsCollidingWith(potentialObjects, NULL, /*excludeJumpThrus=*/true)) //Jumpthru = obstacle <=> Never when going up
               || (requestedDeltaY > 0 && IsCollidingWith(potentialObjects, overlappedJumpThru)) ) //Jumpthru = obstacle <=> Only if not already overlapped when goign down
@@ -400,7 +431,7 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
     }
 
     //3) Update the current floor data for the next tick:
-    overlappedJumpThru = GetJumpthruCollidingWith(potentialObjects);
+    GetJumpthruCollidingWith(potentialObjects, overlappedJumpThru);
     if ( !isOnLadder )
     {
         //Check if the object is on a floor:
@@ -416,8 +447,8 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
         else
         {
             //Check if landing on a new floor: (Exclude already overlapped jump truh)
-            std::set<PlatformBehavior*> collidingObjects = GetPlatformsCollidingWith(potentialObjects, overlappedJumpThru);
-            if ( !collidingObjects.empty() ) //Just landed on floor
+            PlatformBehavior * collidingPlatform = GetFirstPlatformCollidingWith(potentialObjects, overlappedJumpThru);
+            if ( collidingPlatform ) //Just landed on floor
             {
                 isOnFloor = true;
                 canJump = true;
@@ -425,7 +456,7 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
                 currentJumpSpeed = 0;
                 currentFallSpeed = 0;
 
-                floorPlatform = *collidingObjects.begin();
+                floorPlatform = collidingPlatform;
                 floorLastX = floorPlatform->GetObject()->GetX();
                 floorLastY = floorPlatform->GetObject()->GetY();
 
@@ -452,6 +483,9 @@ void PlatformerObjectBehavior::DoStepPreEvents(RuntimeScene & scene)
 
     //5) Track the movement
     hasReallyMoved = std::abs(object->GetX()-oldX) >= 1;
+
+    //The object can be a platform too: the other objects must see it at its new position.
+    sceneManager->UpdatePlatformsOf(object);
 }
 
 bool PlatformerObjectBehavior::CanGrab(PlatformBehavior * platform, double requestedDeltaY) const
@@ -477,45 +511,43 @@ void PlatformerObjectBehavior::ReleaseGrabbedPlatform()
     grabbedPlatform = nullptr;
 }
 
-bool PlatformerObjectBehavior::SeparateFromPlatforms(const std::set<PlatformBehavior*> & candidates, bool excludeJumpThrus)
+bool PlatformerObjectBehavior::SeparateFromPlatforms(const std::vector<PlatformBehavior*> & candidates, bool excludeJumpThrus)
 {
-    std::vector<RuntimeObject*> objects;
-    for (std::set<PlatformBehavior*>::iterator it = candidates.begin();
+    separatedObjects.clear();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
          it != candidates.end();
          ++it)
     {
         if ( (*it)->GetPlatformType() == PlatformBehavior::Ladder ) continue;
         if ( excludeJumpThrus && (*it)->GetPlatformType() == PlatformBehavior::Jumpthru ) continue;
 
-        objects.push_back((*it)->GetObject());
+        separatedObjects.push_back((*it)->GetObject());
     }
 
-    return object->SeparateFromObjects(objects);
+    return object->SeparateFromObjects(separatedObjects);
 }
 
-std::set<PlatformBehavior*> PlatformerObjectBehavior::GetPlatformsCollidingWith(const std::set<PlatformBehavior*> & candidates,
-    const std::set<PlatformBehavior*> & exceptTheseOnes)
+PlatformBehavior * PlatformerObjectBehavior::GetFirstPlatformCollidingWith(const std::vector<PlatformBehavior*> & candidates,
+    const std::vector<PlatformBehavior*> & exceptTheseOnes)
 {
-    //TODO: This function could be refactored to return only the first colliding platform.
-    std::set<PlatformBehavior*> result;
-    for (std::set<PlatformBehavior*>::iterator it = candidates.begin();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
          it != candidates.end();
          ++it)
     {
-        if ( exceptTheseOnes.find(*it) != exceptTheseOnes.end() ) continue;
+        if ( std::find(exceptTheseOnes.begin(), exceptTheseOnes.end(), *it) != exceptTheseOnes.end() ) continue;
         if ( (*it)->GetPlatformType() == PlatformBehavior::Ladder ) continue;
 
         if ( object->IsCollidingWith((*it)->GetObject()) )
-            result.insert(*it);
+            return *it;
     }
 
-    return result;
+    return NULL;
 }
 
-bool PlatformerObjectBehavior::IsCollidingWith(const std::set<PlatformBehavior*> & candidates,
+bool PlatformerObjectBehavior::IsCollidingWith(const std::vector<PlatformBehavior*> & candidates,
     PlatformBehavior * exceptThisOne, bool excludeJumpThrus)
 {
-    for (std::set<PlatformBehavior*>::iterator it = candidates.begin();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
          it != candidates.end();
          ++it)
     {
@@ -530,14 +562,14 @@ bool PlatformerObjectBehavior::IsCollidingWith(const std::set<PlatformBehavior*>
     return false;
 }
 
-bool PlatformerObjectBehavior::IsCollidingWith(const std::set<PlatformBehavior*> & candidates,
-    const std::set<PlatformBehavior*> & exceptTheseOnes)
+bool PlatformerObjectBehavior::IsCollidingWith(const std::vector<PlatformBehavior*> & candidates,
+    const std::vector<PlatformBehavior*> & exceptTheseOnes)
 {
-    for (std::set<PlatformBehavior*>::iterator it = candidates.begin();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
          it != candidates.end();
          ++it)
     {
-        if ( exceptTheseOnes.find(*it) != exceptTheseOnes.end() ) continue;
+        if ( std::find(exceptTheseOnes.begin(), exceptTheseOnes.end(), *it) != exceptTheseOnes.end() ) continue;
         if ( (*it)->GetPlatformType() == PlatformBehavior::Ladder ) continue;
 
         if ( object->IsCollidingWith((*it)->GetObject()) )
@@ -547,25 +579,177 @@ bool PlatformerObjectBehavior::IsCollidingWith(const std::set<PlatformBehavior*>
     return false;
 }
 
-std::set<PlatformBehavior*> PlatformerObjectBehavior::GetJumpthruCollidingWith(const std::set<PlatformBehavior*> & candidates)
+void PlatformerObjectBehavior::GetJumpthruCollidingWith(const std::vector<PlatformBehavior*> & candidates,
+    std::vector<PlatformBehavior*> & result)
 {
-    std::set<PlatformBehavior*> result;
-    for (std::set<PlatformBehavior*>::iterator it = candidates.begin();
+    result.clear();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
          it != candidates.end();
          ++it)
     {
         if ( (*it)->GetPlatformType() != PlatformBehavior::Jumpthru ) continue;
 
         if ( object->IsCollidingWith((*it)->GetObject()) )
-            result.insert(*it);
+            result.push_back(*it);
+    }
+}
+
+void PlatformerObjectBehavior::GetObstacles(const std::vector<PlatformBehavior*> & candidates,
+    PlatformBehavior * exceptThisOne, bool excludeJumpThrus, const std::vector<PlatformBehavior*> & exceptTheseOnes,
+    std::vector<PlatformBehavior*> & result)
+{
+    result.clear();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
+         it != candidates.end();
+         ++it)
+    {
+        if ( *it == exceptThisOne ) continue;
+        if ( (*it)->GetPlatformType() == PlatformBehavior::Ladder ) continue;
+        if ( excludeJumpThrus && (*it)->GetPlatformType() == PlatformBehavior::Jumpthru ) continue;
+        if ( std::find(exceptTheseOnes.begin(), exceptTheseOnes.end(), *it) != exceptTheseOnes.end() ) continue;
+
+        result.push_back(*it);
+    }
+}
+
+bool PlatformerObjectBehavior::SkipCollidingPositions(const std::vector<PlatformBehavior*> & obstacles, bool onXAxis,
+    double requestedDelta, double oldPosition, bool alsoOnePixelAbove)
+{
+    double position = onXAxis ? object->GetX() : object->GetY();
+    //Far from the origin, rounding errors could be larger than the margin.
+    if ( std::abs(position) > maxSkippingPosition || std::abs(oldPosition) > maxSkippingPosition ) return false;
+
+    //The area covered by the object when moved back to its old position.
+    sf::FloatRect sweptArea = object->GetAABB();
+    float movement = oldPosition - position;
+    if ( onXAxis )
+    {
+        if ( movement < 0 ) sweptArea.left += movement;
+        sweptArea.width += std::abs(movement);
+    }
+    else
+    {
+        if ( movement < 0 ) sweptArea.top += movement;
+        sweptArea.height += std::abs(movement);
+    }
+    if ( alsoOnePixelAbove )
+    {
+        sweptArea.top -= 1;
+        sweptArea.height += 1;
+    }
+
+    ComputeCollidingPositions(obstacles, onXAxis, sweptArea, 0, collidingPositions);
+    if ( alsoOnePixelAbove )
+    {
+        //Keep only the positions where the object also collides when moved one pixel up.
+        ComputeCollidingPositions(obstacles, onXAxis, sweptArea, -1, collidingPositionsAbove);
+        std::size_t count = collidingPositions.size();
+        for (std::size_t i = 0;i<count;++i)
+        {
+            for (std::size_t j = 0;j<collidingPositionsAbove.size();++j)
+            {
+                double start = std::max(collidingPositions[i].first, collidingPositionsAbove[j].first);
+                double end = std::min(collidingPositions[i].second, collidingPositionsAbove[j].second);
+                if ( start < end ) collidingPositions.push_back(std::make_pair(start, end));
+            }
+        }
+        collidingPositions.erase(collidingPositions.begin(), collidingPositions.begin()+count);
     }
 
-    return result;
+    //Follow the positions tried by the per-pixel loop: the position rounded and moved by one pixel toward the
+    //old position, and so on. The positions colliding and not past the old position would only make the
+    //loop continue, so go directly to the first one which is not in this case.
+    bool decreasing = requestedDelta > 0;
+    double newPosition = position;
+    while ( decreasing ? newPosition > oldPosition : newPosition < oldPosition )
+    {
+        auto colliding = std::find_if(collidingPositions.begin(), collidingPositions.end(),
+            [newPosition](const std::pair<double, double> & positions) {
+                return positions.first < newPosition && newPosition < positions.second;
+            });
+        if ( colliding == collidingPositions.end() ) break;
+
+        double roundedPosition = std::floor(newPosition);
+        if ( decreasing )
+        {
+            double bound = std::max(colliding->first, oldPosition);
+            newPosition = roundedPosition - std::max(1.0, std::ceil(roundedPosition - bound));
+        }
+        else
+        {
+            double bound = std::min(colliding->second, oldPosition);
+            newPosition = roundedPosition + std::max(1.0, std::ceil(bound - roundedPosition));
+        }
+    }
+
+    if ( newPosition == position ) return false;
+
+    if ( onXAxis )
+        object->SetX(newPosition);
+    else
+        object->SetY(newPosition);
+    return true;
+}
+
+void PlatformerObjectBehavior::ComputeCollidingPositions(const std::vector<PlatformBehavior*> & obstacles, bool onXAxis,
+    const sf::FloatRect & sweptArea, float offsetY, std::vector<std::pair<double, double>> & positions)
+{
+    positions.clear();
+    sf::Vector2f direction(onXAxis ? 1 : 0, onXAxis ? 0 : 1);
+    double position = onXAxis ? object->GetX() : object->GetY();
+
+    //Copy the hitboxes (reusing the memory of the previous copies) as they are moved by offsetY.
+    const std::vector<Polygon2d> & hitBoxes = object->GetHitBoxesWithEdges(sweptArea);
+    objectHitBoxes.resize(hitBoxes.size());
+    for (std::size_t i = 0;i<hitBoxes.size();++i)
+    {
+        objectHitBoxes[i].vertices = hitBoxes[i].vertices;
+        objectHitBoxes[i].edges = hitBoxes[i].edges;
+        if ( offsetY != 0 ) objectHitBoxes[i].Move(0, offsetY);
+    }
+
+    float o1w = object->GetWidth();
+    float o1h = object->GetHeight();
+    float obj1CenterX = object->GetDrawableX()+object->GetCenterX();
+    float obj1CenterY = object->GetDrawableY()+object->GetCenterY()+offsetY;
+    float obj1BoundingRadius = sqrt(o1w*o1w+o1h*o1h)/2.0;
+
+    for (std::size_t i = 0;i<obstacles.size();++i)
+    {
+        //RuntimeObject::IsCollidingWith first checks the bounding circles: compute the
+        //distances where they are overlapping.
+        RuntimeObject * obj2 = obstacles[i]->GetObject();
+        float o2w = obj2->GetWidth();
+        float o2h = obj2->GetHeight();
+        double x = obj1CenterX-(obj2->GetDrawableX()+obj2->GetCenterX());
+        double y = obj1CenterY-(obj2->GetDrawableY()+obj2->GetCenterY());
+        double radius = obj1BoundingRadius+sqrt(o2w*o2w+o2h*o2h)/2.0-collisionMargin;
+        double alongAxis = onXAxis ? x : y;
+        double discriminant = alongAxis*alongAxis-(x*x+y*y-radius*radius);
+        if ( radius < 0 || discriminant < 0 ) continue;
+
+        double minDistance = -alongAxis-sqrt(discriminant);
+        double maxDistance = -alongAxis+sqrt(discriminant);
+
+        const std::vector<Polygon2d> & obstacleHitBoxes = obj2->GetHitBoxesWithEdges(sweptArea);
+        for (std::size_t k = 0;k<objectHitBoxes.size();++k)
+        {
+            for (std::size_t l = 0;l<obstacleHitBoxes.size();++l)
+            {
+                SweepResult result = PolygonSweepTest(objectHitBoxes[k], direction, obstacleHitBoxes[l], collisionMargin);
+                if ( !result.collision ) continue;
+
+                double start = std::max<double>(result.minDistance, minDistance);
+                double end = std::min<double>(result.maxDistance, maxDistance);
+                if ( start < end ) positions.push_back(std::make_pair(position+start, position+end));
+            }
+        }
+    }
 }
 
-bool PlatformerObjectBehavior::IsOverlappingLadder(const std::set<PlatformBehavior*> & candidates)
+bool PlatformerObjectBehavior::IsOverlappingLadder(const std::vector<PlatformBehavior*> & candidates)
 {
-    for (std::set<PlatformBehavior*>::iterator it = candidates.begin();
+    for (std::vector<PlatformBehavior*>::const_iterator it = candidates.begin();
          it != candidates.end();
          ++it)
     {
@@ -577,21 +761,25 @@ bool PlatformerObjectBehavior::IsOverlappingLadder(const std::set<PlatformBehavi
     return false;
 }
 
-std::set<PlatformBehavior*> PlatformerObjectBehavior::GetPotentialCollidingObjects(double maxMovementLength)
+void PlatformerObjectBehavior::GetPotentialCollidingObjects(double maxMovementLength, std::vector<PlatformBehavior*> & potentialObjects)
 {
     //Compute the "bounding circle" radius of the object.
     float o1w = object->GetWidth();
     float o1h = object->GetHeight();
     float obj1BoundingRadius = sqrt(o1w*o1w+o1h*o1h)/2.0+maxMovementLength/2.0; //Add to it the maximum magnitude of movement.
 
+    //Only test the platforms which could be in the bounding circle.
+    float obj1CenterX = object->GetDrawableX()+object->GetCenterX();
+    float obj1CenterY = object->GetDrawableY()+object->GetCenterY();
+    float searchRadius = std::max(obj1BoundingRadius, 0.0f)+1;
+    sceneManager->GetPlatformsNear(obj1CenterX-searchRadius, obj1CenterY-searchRadius,
+        obj1CenterX+searchRadius, obj1CenterY+searchRadius, potentialObjects);
 
-    std::set<PlatformBehavior*> potentialObjects;
-    for (std::set<PlatformBehavior*>::iterator it = sceneManager->GetAllPlatforms().begin();
-         it != sceneManager->GetAllPlatforms().end();
-         ++it)
+    std::size_t potentialObjectsCount = 0;
+    for (std::size_t i = 0;i<potentialObjects.size();++i)
     {
         //First check if bounding circle are too far.
-        RuntimeObject * obj2 = (*it)->GetObject();
+        RuntimeObject * obj2 = potentialObjects[i]->GetObject();
         float o2w = obj2->GetWidth();
         float o2h = obj2->GetHeight();
 
@@ -600,11 +788,11 @@ std::set<PlatformBehavior*> PlatformerObjectBehavior::GetPotentialCollidingObjec
         float obj2BoundingRadius = sqrt(o2w*o2w+o2h*o2h)/2.0;
 
         if ( sqrt(x*x+y*y) <= obj1BoundingRadius + obj2BoundingRadius ) {
-            potentialObjects.insert(*it);
+            potentialObjects[potentialObjectsCount++] = potentialObjects[i];
         }
     }
 
-    return potentialObjects;
+    potentialObjects.resize(potentialObjectsCount);
 }
 
 void PlatformerObjectBehavior::DoStepPostEvents(RuntimeScene & scene)
@@ -617,6 +805,28 @@ void PlatformerObjectBehavior::DoStepPostEvents(RuntimeScene & scene)
     }
 }
 
+void PlatformerObjectBehavior::StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    //Take into account the platforms moved since the last update.
+    auto manager = ScenePlatformObjectsManager::managers.find(&scene);
+    if ( manager != ScenePlatformObjectsManager::managers.end() ) manager->second.UpdatePlatforms();
+
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        PlatformerObjectBehavior * behavior = static_cast<PlatformerObjectBehavior*>(behaviors[i]);
+        if ( behavior->Activated() ) behavior->PlatformerObjectBehavior::DoStepPreEvents(scene);
+    }
+}
+
+void PlatformerObjectBehavior::StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        PlatformerObjectBehavior * behavior = static_cast<PlatformerObjectBehavior*>(behaviors[i]);
+        if ( behavior->Activated() ) behavior->PlatformerObjectBehavior::DoStepPostEvents(scene);
+    }
+}
+
 void PlatformerObjectBehavior::SimulateControl(const gd::String & input)
 {
     if ( input == "Left" ) leftKey = true;
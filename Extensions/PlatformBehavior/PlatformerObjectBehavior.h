@@ -9,9 +9,12 @@ This project is released under the MIT License.
 #define PLATFORMEROBJECTBEHAVIOR_H
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/Polygon2d.h"
 #include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <map>
 #include <set>
+#include <vector>
 namespace gd { class Layout; }
 class RuntimeScene;
 class PlatformBehavior;
@@ -28,6 +31,8 @@ public:
     PlatformerObjectBehavior();
     virtual ~PlatformerObjectBehavior();
     virtual Behavior* Clone() const { return new PlatformerObjectBehavior(*this); }
+    virtual void StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
+    virtual void StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
 
     double GetGravity() const { return gravity; };
     double GetMaxFallingSpeed() const { return maxFallingSpeed; };
@@ -48,6 +53,13 @@ public:
     void SetCanGrabPlatforms(bool enable);
 
     void IgnoreDefaultControls(bool ignore = true) { ignoreDefaultControls = ignore; };
+
+    /**
+     * \brief Resolve the collisions of fast movements with the per-pixel loops only, without skipping
+     * the positions surely colliding (see SkipCollidingPositions). The final positions are the same.
+     */
+    void ResolveCollisionsPixelByPixel(bool enable = true) { resolveCollisionsPixelByPixel = enable; };
+
     void SimulateControl(const gd::String & input);
     void SimulateLeftKey() { leftKey = true; };
     void SimulateRightKey() { rightKey = true; };
@@ -86,27 +98,29 @@ private:
     virtual void DoStepPostEvents(RuntimeScene & scene);
 
     /**
-     * \brief Return a list of all the platforms that could be colliding with the object if it is moved.
+     * \brief Get a list of all the platforms that could be colliding with the object if it is moved.
      * \param maxMovementLength The maximum length of any movement that could be done by the object, in pixels.
+     * \param potentialObjects Filled with the platforms, sorted as in ScenePlatformObjectsManager::GetAllPlatforms.
      * \warning sceneManager must be valid and not NULL.
      */
-    std::set<PlatformBehavior*> GetPotentialCollidingObjects(double maxMovementLength);
+    void GetPotentialCollidingObjects(double maxMovementLength, std::vector<PlatformBehavior*> & potentialObjects);
 
     /**
      * \brief Separate the object from all platforms passed as parameter, except ladders.
      * \param candidates The platform to be tested for collision
      * \param excludeJumpThrus If set to true, the jump thru platform will be excluded.
      */
-    bool SeparateFromPlatforms(const std::set<PlatformBehavior*> & candidates, bool excludeJumpThrus);
+    bool SeparateFromPlatforms(const std::vector<PlatformBehavior*> & candidates, bool excludeJumpThrus);
 
     /**
-     * \brief Among the platforms passed in parameter, return a list of the platforms colliding with the object.
+     * \brief Among the platforms passed in parameter, return the first platform colliding with the object.
      * \note Ladders are *always* excluded from the test.
      * \param candidates The platform to be tested for collision
      * \param exceptTheseOnes The platforms to be excluded from the test
+     * \return The colliding platform, or NULL if there is none.
      */
-    std::set<PlatformBehavior*> GetPlatformsCollidingWith(const std::set<PlatformBehavior*> & candidates,
-        const std::set<PlatformBehavior*> & exceptTheseOnes);
+    PlatformBehavior * GetFirstPlatformCollidingWith(const std::vector<PlatformBehavior*> & candidates,
+        const std::vector<PlatformBehavior*> & exceptTheseOnes);
 
     /**
      * \brief Among the platforms passed in parameter, return true if there is a platform colliding with the object.
@@ -115,7 +129,7 @@ private:
      * \param exceptThisOne If not NULL, this platform won't be tested for collision.
      * \param excludeJumpThrus If set to true, the jump thru platform will be excluded.
      */
-    bool IsCollidingWith(const std::set<PlatformBehavior*> & candidates,
+    bool IsCollidingWith(const std::vector<PlatformBehavior*> & candidates,
         PlatformBehavior * exceptThisOne = NULL, bool excludeJumpThrus = false);
 
     /**
@@ -124,19 +138,59 @@ private:
      * \param candidates The platforms to be tested for collision
      * \param exceptTheseOnes The platforms to be excluded from the test
      */
-    bool IsCollidingWith(const std::set<PlatformBehavior*> & candidates, const std::set<PlatformBehavior*> & exceptTheseOnes);
+    bool IsCollidingWith(const std::vector<PlatformBehavior*> & candidates, const std::vector<PlatformBehavior*> & exceptTheseOnes);
 
     /**
      * \brief Among the platforms passed in parameter, return true if the object is overlapping a ladder.
      * \param candidates The platform to be tested for collision
      */
-    bool IsOverlappingLadder(const std::set<PlatformBehavior*> & candidates);
+    bool IsOverlappingLadder(const std::vector<PlatformBehavior*> & candidates);
 
     /**
-     * \brief Among the platforms passed in parameter, return a list of the jump thru platforms colliding with the object.
+     * \brief Among the platforms passed in parameter, get the jump thru platforms colliding with the object.
      * \param candidates The platform to be tested for collision
+     * \param result Filled with the colliding jump thru platforms.
+     */
+    void GetJumpthruCollidingWith(const std::vector<PlatformBehavior*> & candidates, std::vector<PlatformBehavior*> & result);
+
+    /**
+     * \brief Among the platforms passed in parameter, get the platforms which are obstacles.
+     * \note Ladders are *always* excluded.
+     * \param candidates The platforms to be filtered
+     * \param exceptThisOne If not NULL, this platform is excluded.
+     * \param excludeJumpThrus If set to true, the jump thru platforms are excluded.
+     * \param exceptTheseOnes The platforms to be excluded
+     * \param result Filled with the obstacles.
      */
-    std::set<PlatformBehavior*> GetJumpthruCollidingWith(const std::set<PlatformBehavior*> & candidates);
+    void GetObstacles(const std::vector<PlatformBehavior*> & candidates, PlatformBehavior * exceptThisOne,
+        bool excludeJumpThrus, const std::vector<PlatformBehavior*> & exceptTheseOnes, std::vector<PlatformBehavior*> & result);
+
+    /**
+     * \brief Move the object toward its old position, on one axis, skipping the positions where the per-pixel
+     * loop pushing the object out of the obstacles would surely find a collision.
+     *
+     * The positions colliding are computed with PolygonSweepTest, so that fast movements don't need
+     * a collision test for each pixel. The loop must then be run from the new position of the object,
+     * to find the exact position.
+     *
+     * \param obstacles The platforms tested by the loop.
+     * \param onXAxis true for the X axis, false for the Y axis.
+     * \param requestedDelta The movement done by the object on the axis.
+     * \param oldPosition The position of the object before the movement.
+     * \param alsoOnePixelAbove If true, a position is only skipped if the object also collides when moved one pixel up.
+     * \return true if the object was moved.
+     */
+    bool SkipCollidingPositions(const std::vector<PlatformBehavior*> & obstacles, bool onXAxis,
+        double requestedDelta, double oldPosition, bool alsoOnePixelAbove);
+
+    /**
+     * \brief Compute the intervals of positions, on one axis, where the object surely collides with the obstacles.
+     * \param sweptArea The area covered by the object during the movement.
+     * \param offsetY Move the object by this on the Y axis before computing the positions.
+     * \param positions Filled with the intervals (the bounds are excluded).
+     */
+    void ComputeCollidingPositions(const std::vector<PlatformBehavior*> & obstacles, bool onXAxis,
+        const sf::FloatRect & sweptArea, float offsetY, std::vector<std::pair<double, double>> & positions);
 
     /**
      * \brief Return true if the object owning the behavior can grab the specified platform. There must be a collision
@@ -180,6 +234,16 @@ private:
     PlatformBehavior * grabbedPlatform; ///< The platform the object is on, when isGrabbingPlatform == true.
     double grabbedPlatformLastX; ///< The last X position of the grabbed platform, when isGrabbingPlatform == true.
     double grabbedPlatformLastY; ///< The last Y position of the grabbed platform, when isGrabbingPlatform == true.
+    std::vector<PlatformBehavior*> potentialObjects; ///< The platforms near the object, kept to avoid allocating them at each update.
+    std::vector<PlatformBehavior*> overlappedJumpThru; ///< The jump thru platforms overlapped by the object.
+
+    //Buffers used by the collision resolution, kept to avoid allocating them at each update:
+    std::vector<PlatformBehavior*> obstacles;
+    std::vector<RuntimeObject*> separatedObjects;
+    std::vector<Polygon2d> objectHitBoxes;
+    std::vector<std::pair<double, double>> collidingPositions;
+    std::vector<std::pair<double, double>> collidingPositionsAbove;
+    bool resolveCollisionsPixelByPixel; ///< If true, SkipCollidingPositions is never used.
 
     //Object size tracking:
     bool trackSize; ///< If true, the behavior try to change the object position to avoid glitch when size change.
@@ -1,7 +1,13 @@
 #include "ScenePlatformObjectsManager.h"
 #include "PlatformBehavior.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include <algorithm>
+#include <cmath>
 
 std::map<RuntimeScene*, ScenePlatformObjectsManager> ScenePlatformObjectsManager::managers;
+const float ScenePlatformObjectsManager::cellSize = 128;
+const unsigned int ScenePlatformObjectsManager::stillUpdatesBeforeStatic = 60;
+const unsigned int ScenePlatformObjectsManager::maxPlatformCellsCount = 256;
 
 ScenePlatformObjectsManager::~ScenePlatformObjectsManager()
 {
@@ -14,9 +20,200 @@ ScenePlatformObjectsManager::~ScenePlatformObjectsManager()
 
 void ScenePlatformObjectsManager::AddPlatform(PlatformBehavior * platform)
 {
-	allPlatforms.insert(platform);
+	if ( !allPlatforms.insert(platform).second ) return;
+
+	PlatformBounds & bounds = platformsBounds[platform];
+	bounds.object = platform->GetObject();
+	ComputeBounds(platform, bounds);
+	AddToCells(platform, bounds);
+	platformsOfObjects.insert(std::make_pair(bounds.object, platform));
 }
 void ScenePlatformObjectsManager::RemovePlatform(PlatformBehavior * platform)
 {
-	allPlatforms.erase(platform);
+	if ( allPlatforms.erase(platform) == 0 ) return;
+
+	auto it = platformsBounds.find(platform);
+	RuntimeObject * object = it->second.object;
+	if ( it->second.moving )
+		RemoveFromList(movingPlatforms, platform);
+	else
+		RemoveFromCells(platform, it->second);
+	platformsBounds.erase(it);
+
+	auto objectPlatforms = platformsOfObjects.equal_range(object);
+	for (auto objectIt = objectPlatforms.first;objectIt != objectPlatforms.second;++objectIt)
+	{
+		if ( objectIt->second == platform )
+		{
+			platformsOfObjects.erase(objectIt);
+			break;
+		}
+	}
+}
+
+void ScenePlatformObjectsManager::UpdatePlatforms()
+{
+	for (auto it = platformsBounds.begin();it != platformsBounds.end();++it)
+	{
+		PlatformBounds & bounds = it->second;
+		if ( ComputeBounds(it->first, bounds) )
+			UpdatePlatform(it->first, bounds);
+		else if ( bounds.moving && ++bounds.stillUpdatesCount >= stillUpdatesBeforeStatic )
+		{
+			//The platform stopped moving: put it back in the grid.
+			RemoveFromList(movingPlatforms, it->first);
+			bounds.moving = false;
+			AddToCells(it->first, bounds);
+		}
+	}
+}
+
+void ScenePlatformObjectsManager::UpdatePlatformsOf(RuntimeObject * object)
+{
+	auto objectPlatforms = platformsOfObjects.equal_range(object);
+	for (auto it = objectPlatforms.first;it != objectPlatforms.second;++it)
+	{
+		PlatformBounds & bounds = platformsBounds[it->second];
+		if ( ComputeBounds(it->second, bounds) )
+			UpdatePlatform(it->second, bounds);
+	}
+}
+
+void ScenePlatformObjectsManager::GetPlatformsNear(float left, float top, float right, float bottom,
+	std::vector<PlatformBehavior*> & result) const
+{
+	result.clear();
+
+	int minCellX = GetCellCoordinate(left);
+	int minCellY = GetCellCoordinate(top);
+	int maxCellX = GetCellCoordinate(right);
+	int maxCellY = GetCellCoordinate(bottom);
+	if ( minCellX <= maxCellX && minCellY <= maxCellY )
+	{
+		double areaCellsCount = (static_cast<double>(maxCellX)-minCellX+1)*(static_cast<double>(maxCellY)-minCellY+1);
+		if ( areaCellsCount <= cells.size() )
+		{
+			for (int y = minCellY;y<=maxCellY;++y)
+			{
+				for (int x = minCellX;x<=maxCellX;++x)
+				{
+					auto it = cells.find(GetCellKey(x, y));
+					if ( it != cells.end() ) result.insert(result.end(), it->second.begin(), it->second.end());
+				}
+			}
+		}
+		else
+		{
+			//The area is larger than the part of the grid which is used: iterate on the used cells instead.
+			for (auto it = cells.begin();it != cells.end();++it)
+			{
+				int x = static_cast<std::int32_t>(it->first >> 32);
+				int y = static_cast<std::int32_t>(it->first & 0xFFFFFFFF);
+				if ( x >= minCellX && x <= maxCellX && y >= minCellY && y <= maxCellY )
+					result.insert(result.end(), it->second.begin(), it->second.end());
+			}
+		}
+	}
+
+	result.insert(result.end(), movingPlatforms.begin(), movingPlatforms.end());
+	result.insert(result.end(), largePlatforms.begin(), largePlatforms.end());
+
+	//Platforms covering several cells are found more than once. Sorting them also
+	//makes the result ordered in the same way as allPlatforms.
+	std::sort(result.begin(), result.end());
+	result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+bool ScenePlatformObjectsManager::ComputeBounds(PlatformBehavior * platform, PlatformBounds & bounds)
+{
+	sf::FloatRect aabb = platform->GetObject()->GetAABB();
+	if ( aabb.left == bounds.aabb.left && aabb.top == bounds.aabb.top &&
+		 aabb.width == bounds.aabb.width && aabb.height == bounds.aabb.height )
+		return false;
+
+	bounds.aabb = aabb;
+	return true;
+}
+
+void ScenePlatformObjectsManager::UpdatePlatform(PlatformBehavior * platform, PlatformBounds & bounds)
+{
+	bounds.stillUpdatesCount = 0;
+	if ( bounds.moving ) return;
+
+	//Moving platforms are not stored in the grid, to avoid updating the cells at each move.
+	RemoveFromCells(platform, bounds);
+	bounds.moving = true;
+	movingPlatforms.push_back(platform);
+}
+
+void ScenePlatformObjectsManager::AddToCells(PlatformBehavior * platform, PlatformBounds & bounds)
+{
+	//Enlarge the area by a pixel so that rounding errors never exclude a platform.
+	bounds.minCellX = GetCellCoordinate(bounds.aabb.left-1);
+	bounds.minCellY = GetCellCoordinate(bounds.aabb.top-1);
+	bounds.maxCellX = GetCellCoordinate(bounds.aabb.left+bounds.aabb.width+1);
+	bounds.maxCellY = GetCellCoordinate(bounds.aabb.top+bounds.aabb.height+1);
+
+	//Huge platforms would fill too many cells: they are always tested instead.
+	double cellsCount = (static_cast<double>(bounds.maxCellX)-bounds.minCellX+1)*
+		(static_cast<double>(bounds.maxCellY)-bounds.minCellY+1);
+	bounds.large = cellsCount > maxPlatformCellsCount;
+	if ( bounds.large )
+	{
+		largePlatforms.push_back(platform);
+		return;
+	}
+
+	for (int y = bounds.minCellY;y<=bounds.maxCellY;++y)
+	{
+		for (int x = bounds.minCellX;x<=bounds.maxCellX;++x)
+			cells[GetCellKey(x, y)].push_back(platform);
+	}
+}
+
+void ScenePlatformObjectsManager::RemoveFromCells(PlatformBehavior * platform, const PlatformBounds & bounds)
+{
+	if ( bounds.large )
+	{
+		RemoveFromList(largePlatforms, platform);
+		return;
+	}
+
+	for (int y = bounds.minCellY;y<=bounds.maxCellY;++y)
+	{
+		for (int x = bounds.minCellX;x<=bounds.maxCellX;++x)
+		{
+			auto it = cells.find(GetCellKey(x, y));
+			if ( it == cells.end() ) continue;
+
+			std::vector<PlatformBehavior*> & cellPlatforms = it->second;
+			auto platformIt = std::find(cellPlatforms.begin(), cellPlatforms.end(), platform);
+			if ( platformIt != cellPlatforms.end() )
+			{
+				*platformIt = cellPlatforms.back();
+				cellPlatforms.pop_back();
+			}
+			if ( cellPlatforms.empty() ) cells.erase(it);
+		}
+	}
+}
+
+void ScenePlatformObjectsManager::RemoveFromList(std::vector<PlatformBehavior*> & platforms, PlatformBehavior * platform)
+{
+	auto it = std::find(platforms.begin(), platforms.end(), platform);
+	if ( it == platforms.end() ) return;
+
+	*it = platforms.back();
+	platforms.pop_back();
+}
+
+int ScenePlatformObjectsManager::GetCellCoordinate(float position)
+{
+	//Clamp the coordinate so that huge (or invalid) positions can't overflow.
+	const int maxCellCoordinate = 1 << 24;
+	float cell = std::floor(position/cellSize);
+	if ( !(cell > -maxCellCoordinate) ) return -maxCellCoordinate;
+	if ( cell > maxCellCoordinate ) return maxCellCoordinate;
+
+	return static_cast<int>(cell);
 }
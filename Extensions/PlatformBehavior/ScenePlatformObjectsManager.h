@@ -6,13 +6,22 @@ This project is released under the MIT License.
 */
 #ifndef SCENEPLATFORMOBJECTSMANAGER_H
 #define SCENEPLATFORMOBJECTSMANAGER_H
+#include <cstdint>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include "GDCpp/Runtime/RuntimeScene.h"
 class PlatformBehavior;
+class RuntimeObject;
 
 /**
  * \brief Contains lists of all platform related objects of a scene.
+ *
+ * Platforms are also indexed by the area covered by their bounding box, so that
+ * platformer objects only test the platforms near them: platforms which are not moving
+ * are stored in the cells of a grid, and platforms which were moved recently, or which are
+ * too large to be stored in the grid, are stored in lists which are always tested.
  */
 class ScenePlatformObjectsManager
 {
@@ -42,8 +51,73 @@ public:
      */
     const std::set<PlatformBehavior*> & GetAllPlatforms() { return allPlatforms; }
 
+    /**
+     * \brief Update the area covered by the platforms which were moved or resized.
+     *
+     * Must be called before the platformer objects are updated, so that GetPlatformsNear
+     * takes into account the changes done by the events.
+     */
+    void UpdatePlatforms();
+
+    /**
+     * \brief Update the area covered by the platforms of an object, which was just moved.
+     */
+    void UpdatePlatformsOf(RuntimeObject * object);
+
+    /**
+     * \brief Get the platforms whose bounding box could be overlapping an area.
+     * \param result Filled with the platforms, sorted as in GetAllPlatforms. It can contain
+     * platforms which are not overlapping the area.
+     */
+    void GetPlatformsNear(float left, float top, float right, float bottom,
+        std::vector<PlatformBehavior*> & result) const;
+
 private:
+    /**
+     * \brief The area covered by the bounding box of a platform, as it was when last updated.
+     */
+    struct PlatformBounds
+    {
+        PlatformBounds() : object(NULL), minCellX(0), minCellY(0),
+            maxCellX(-1), maxCellY(-1), moving(false), large(false), stillUpdatesCount(0) {};
+
+        RuntimeObject * object; ///< The object of the platform when it was added.
+        sf::FloatRect aabb; ///< The bounding box of the object.
+        int minCellX; ///< The first cell on X axis where the platform is stored, when not moving.
+        int minCellY; ///< The first cell on Y axis where the platform is stored, when not moving.
+        int maxCellX; ///< The last cell on X axis where the platform is stored, when not moving.
+        int maxCellY; ///< The last cell on Y axis where the platform is stored, when not moving.
+        bool moving; ///< True if the platform is in movingPlatforms instead of the grid.
+        bool large; ///< True if the platform, when not moving, is in largePlatforms instead of the grid.
+        unsigned int stillUpdatesCount; ///< The number of updates since the platform last moved.
+    };
+
+    /**
+     * \brief Compute the bounds of a platform and return true if they changed.
+     */
+    static bool ComputeBounds(PlatformBehavior * platform, PlatformBounds & bounds);
+
+    void UpdatePlatform(PlatformBehavior * platform, PlatformBounds & bounds);
+    void AddToCells(PlatformBehavior * platform, PlatformBounds & bounds);
+    void RemoveFromCells(PlatformBehavior * platform, const PlatformBounds & bounds);
+    static void RemoveFromList(std::vector<PlatformBehavior*> & platforms, PlatformBehavior * platform);
+
+    static int GetCellCoordinate(float position);
+    static std::uint64_t GetCellKey(int x, int y)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+    }
+
+    static const float cellSize; ///< The size of the cells of the grid, in pixels.
+    static const unsigned int stillUpdatesBeforeStatic; ///< The number of updates without moving before a platform is put back in the grid.
+    static const unsigned int maxPlatformCellsCount; ///< The maximum number of cells covered by a platform stored in the grid.
+
     std::set<PlatformBehavior*> allPlatforms; ///< The list of all platforms of the scene.
+    std::unordered_map<PlatformBehavior*, PlatformBounds> platformsBounds;
+    std::unordered_multimap<RuntimeObject*, PlatformBehavior*> platformsOfObjects;
+    std::unordered_map<std::uint64_t, std::vector<PlatformBehavior*>> cells; ///< The platforms not moving, in each cell they cover.
+    std::vector<PlatformBehavior*> movingPlatforms; ///< The platforms moved recently, not stored in the grid.
+    std::vector<PlatformBehavior*> largePlatforms; ///< The platforms covering too many cells to be stored in the grid.
 };
 
 
@@ -0,0 +1,348 @@
+/**
+
+GDevelop - Platform Behavior Extension
+Copyright (c) 2013-2016 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Tests for the Platform Behavior extension.
+ */
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "../PlatformBehavior.h"
+#include "../PlatformerObjectBehavior.h"
+#include "../ScenePlatformObjectsManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+//Mock objects that can have a specific size and angle
+class ResizableRuntimeObject : public RuntimeObject {
+public:
+	ResizableRuntimeObject(RuntimeScene & scene, const gd::Object & obj) :
+		RuntimeObject(scene, obj),
+		width(0),
+		height(0),
+		angle(0)
+	{}
+
+	float GetWidth() const override { return width; }
+	float GetHeight() const override { return height; }
+	void SetWidth(float newWidth) override { width = newWidth; }
+	void SetHeight(float newHeight) override { height = newHeight; }
+	bool SetAngle(float newAngle) override { angle = newAngle; return true; }
+	float GetAngle() const override { return angle; }
+
+private:
+	float width;
+	float height;
+	float angle;
+};
+
+namespace
+{
+
+/**
+ * \brief Return the platforms whose bounding box is overlapping the area, sorted as
+ * in ScenePlatformObjectsManager::GetAllPlatforms.
+ */
+std::vector<PlatformBehavior*> FilterPlatforms(const std::vector<PlatformBehavior*> & platforms, const sf::FloatRect & area)
+{
+	std::vector<PlatformBehavior*> result;
+	for (std::size_t i = 0;i<platforms.size();++i)
+	{
+		sf::FloatRect aabb = platforms[i]->GetObject()->GetAABB();
+		if ( aabb.left <= area.left+area.width && aabb.left+aabb.width >= area.left &&
+			 aabb.top <= area.top+area.height && aabb.top+aabb.height >= area.top )
+			result.push_back(platforms[i]);
+	}
+
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+/**
+ * \brief Check that the platforms near the area, once filtered, are the same as all
+ * the platforms filtered (as when all the platforms were tested).
+ */
+void CheckPlatformsNear(ScenePlatformObjectsManager & manager, const sf::FloatRect & area)
+{
+	const std::set<PlatformBehavior*> & allPlatformsSet = manager.GetAllPlatforms();
+	std::vector<PlatformBehavior*> allPlatforms(allPlatformsSet.begin(), allPlatformsSet.end());
+
+	std::vector<PlatformBehavior*> platformsNear;
+	manager.GetPlatformsNear(area.left, area.top, area.left+area.width, area.top+area.height, platformsNear);
+	REQUIRE(std::is_sorted(platformsNear.begin(), platformsNear.end()));
+	for (std::size_t i = 0;i<platformsNear.size();++i)
+		REQUIRE(allPlatformsSet.count(platformsNear[i]) == 1);
+
+	REQUIRE(FilterPlatforms(platformsNear, area) == FilterPlatforms(allPlatforms, area));
+}
+
+void CheckPlatformsNear(ScenePlatformObjectsManager & manager)
+{
+	for (std::size_t i = 0;i<200;++i)
+	{
+		CheckPlatformsNear(manager, sf::FloatRect(std::rand() % 4000 - 500, std::rand() % 4000 - 500,
+			std::rand() % 600, std::rand() % 600));
+	}
+	CheckPlatformsNear(manager, sf::FloatRect(-100000, -100000, 200000, 200000));
+}
+
+/**
+ * \brief The position, size and type of a platform of a scenario.
+ */
+struct PlatformDescription
+{
+	float x;
+	float y;
+	float width;
+	float height;
+	float angle;
+	bool jumpthru;
+};
+
+/**
+ * \brief Move a player among the platforms during one second, and return its position after each step.
+ * \param right If true, the player always goes right.
+ * \param jump If true, the player jumps as soon as possible.
+ * \param pixelByPixel If true, the collisions are resolved without skipping the colliding positions.
+ */
+std::vector<sf::Vector2f> SimulatePlayer(const std::vector<PlatformDescription> & descriptions,
+	sf::Vector2f start, bool right, bool jump, bool pixelByPixel)
+{
+	RuntimeGame game;
+	gd::Object platformObj("platform");
+	auto platformBehavior = new PlatformBehavior();
+	platformBehavior->SetName("Platform");
+	platformObj.AddBehavior(platformBehavior);
+
+	gd::Object playerObj("player");
+	auto playerBehavior = new PlatformerObjectBehavior();
+	playerBehavior->SetName("PlatformerObject");
+	playerObj.AddBehavior(playerBehavior);
+
+	RuntimeScene scene(NULL, &game);
+	std::vector<std::shared_ptr<ResizableRuntimeObject>> platforms;
+	std::vector<PlatformBehavior*> platformBehaviors;
+	for (std::size_t i = 0;i<descriptions.size();++i)
+	{
+		platforms.push_back(std::make_shared<ResizableRuntimeObject>(scene, platformObj));
+		platforms.back()->SetX(descriptions[i].x);
+		platforms.back()->SetY(descriptions[i].y);
+		platforms.back()->SetWidth(descriptions[i].width);
+		platforms.back()->SetHeight(descriptions[i].height);
+		platforms.back()->SetAngle(descriptions[i].angle);
+		scene.objectsInstances.AddObject(platforms.back());
+
+		platformBehaviors.push_back(static_cast<PlatformBehavior*>(platforms.back()->GetBehaviorRawPointer("Platform")));
+		if ( descriptions[i].jumpthru ) platformBehaviors.back()->ChangePlatformType("Jumpthru");
+	}
+
+	auto player = std::make_shared<ResizableRuntimeObject>(scene, playerObj);
+	player->SetX(start.x);
+	player->SetY(start.y);
+	player->SetWidth(32);
+	player->SetHeight(64);
+	scene.objectsInstances.AddObject(player);
+
+	//Fast movements, so that the colliding positions are skipped.
+	auto platformer = static_cast<PlatformerObjectBehavior*>(player->GetBehaviorRawPointer("PlatformerObject"));
+	platformer->IgnoreDefaultControls();
+	platformer->ResolveCollisionsPixelByPixel(pixelByPixel);
+	platformer->SetGravity(5000);
+	platformer->SetMaxFallingSpeed(3000);
+	platformer->SetAcceleration(100000);
+	platformer->SetMaxSpeed(1500);
+	platformer->SetJumpSpeed(2000);
+
+	//Step with a fixed elapsed time, so that both simulations get the same movements.
+	std::vector<sf::Vector2f> positions;
+	for (std::size_t step = 0;step<60;++step)
+	{
+		scene.GetTimeManager().Update(1000000/60, 0);
+		for (std::size_t i = 0;i<platformBehaviors.size();++i)
+			platformBehaviors[i]->StepPreEvents(scene);
+
+		if ( right ) platformer->SimulateRightKey();
+		if ( jump ) platformer->SimulateJumpKey();
+		platformer->StepAllPreEvents(scene, {platformer});
+		positions.push_back(sf::Vector2f(player->GetX(), player->GetY()));
+	}
+
+	ScenePlatformObjectsManager::managers.erase(&scene);
+	return positions;
+}
+
+/**
+ * \brief Check that the player has the same positions when the colliding positions are skipped
+ * and when the collisions are resolved pixel by pixel, and return these positions.
+ */
+std::vector<sf::Vector2f> CheckSameMovements(const std::vector<PlatformDescription> & descriptions,
+	sf::Vector2f start, bool right, bool jump)
+{
+	std::vector<sf::Vector2f> positions = SimulatePlayer(descriptions, start, right, jump, false);
+	std::vector<sf::Vector2f> expectedPositions = SimulatePlayer(descriptions, start, right, jump, true);
+
+	REQUIRE(positions.size() == expectedPositions.size());
+	for (std::size_t i = 0;i<positions.size();++i)
+	{
+		REQUIRE(positions[i].x == expectedPositions[i].x);
+		REQUIRE(positions[i].y == expectedPositions[i].y);
+	}
+
+	return positions;
+}
+
+float GetHighestPosition(const std::vector<sf::Vector2f> & positions)
+{
+	float highest = positions[0].y;
+	for (std::size_t i = 0;i<positions.size();++i)
+		highest = std::min(highest, positions[i].y);
+
+	return highest;
+}
+
+}
+
+TEST_CASE( "ScenePlatformObjectsManager", "[game-engine][platformer]" ) {
+	//Prepare some platforms, including a rotated one and huge ones.
+	RuntimeGame game;
+	gd::Object platformObj("platform");
+	auto behavior = new PlatformBehavior();
+	behavior->SetName("Platform");
+	platformObj.AddBehavior(behavior);
+
+	RuntimeScene scene(NULL, &game);
+	std::srand(42);
+	std::vector<std::shared_ptr<ResizableRuntimeObject>> platforms;
+	for (std::size_t i = 0;i<300;++i)
+	{
+		platforms.push_back(std::make_shared<ResizableRuntimeObject>(scene, platformObj));
+		platforms.back()->SetX(std::rand() % 3000);
+		platforms.back()->SetY(std::rand() % 3000);
+		platforms.back()->SetWidth(10 + std::rand() % 300);
+		platforms.back()->SetHeight(10 + std::rand() % 100);
+		scene.objectsInstances.AddObject(platforms.back());
+	}
+	platforms[0]->SetAngle(45);
+	platforms[1]->SetX(-500000);
+	platforms[1]->SetWidth(1000000);
+	platforms[2]->SetY(1000);
+	platforms[2]->SetHeight(1000000);
+	scene.RenderAndStep();
+
+	ScenePlatformObjectsManager & manager = ScenePlatformObjectsManager::managers[&scene];
+	manager.UpdatePlatforms();
+	REQUIRE(manager.GetAllPlatforms().size() == platforms.size());
+
+	SECTION("Static platforms") {
+		CheckPlatformsNear(manager);
+	}
+	SECTION("Moving platforms") {
+		//Move some platforms (including the huge ones) at each step...
+		for (std::size_t step = 0;step<10;++step)
+		{
+			for (std::size_t i = 0;i<platforms.size();i += 3)
+			{
+				platforms[i]->SetX(platforms[i]->GetX() + std::rand() % 50 - 25);
+				platforms[i]->SetY(platforms[i]->GetY() + std::rand() % 50 - 25);
+			}
+			platforms[0]->SetAngle(platforms[0]->GetAngle() + 10);
+			platforms[1]->SetY(platforms[1]->GetY() + 5);
+			scene.RenderAndStep();
+			manager.UpdatePlatforms();
+			CheckPlatformsNear(manager);
+		}
+
+		//...then stop them, so that they are put back in the grid.
+		for (std::size_t step = 0;step<100;++step)
+		{
+			scene.RenderAndStep();
+			manager.UpdatePlatforms();
+		}
+		CheckPlatformsNear(manager);
+	}
+	SECTION("Removed platforms") {
+		//Remove platforms which are not moving, moving platforms and huge platforms.
+		for (std::size_t i = 0;i<platforms.size();i += 3)
+			platforms[i]->SetX(platforms[i]->GetX() + 10);
+		manager.UpdatePlatforms();
+
+		for (std::size_t i = 0;i<platforms.size();i += 2)
+		{
+			scene.objectsInstances.RemoveObject(platforms[i]);
+			platforms[i].reset();
+		}
+		static_cast<PlatformBehavior*>(platforms[1]->GetBehaviorRawPointer("Platform"))->Activate(false);
+		REQUIRE(manager.GetAllPlatforms().size() == platforms.size()/2-1);
+		CheckPlatformsNear(manager);
+
+		//Platforms added back are found again.
+		static_cast<PlatformBehavior*>(platforms[1]->GetBehaviorRawPointer("Platform"))->Activate(true);
+		REQUIRE(manager.GetAllPlatforms().size() == platforms.size()/2);
+		CheckPlatformsNear(manager);
+	}
+
+	//Destroy the manager as when the scene is unloaded.
+	ScenePlatformObjectsManager::managers.erase(&scene);
+}
+
+TEST_CASE( "PlatformerObjectBehavior", "[game-engine][platformer]" ) {
+	SECTION("Falling on a floor") {
+		std::vector<sf::Vector2f> positions = CheckSameMovements({
+			{-100, 500, 400, 50, 0, false}
+		}, sf::Vector2f(0, 0), false, false);
+		REQUIRE(positions.back().y <= 500-64);
+		REQUIRE(positions.back().y > 500-64-2);
+	}
+	SECTION("Falling on a jumpthru") {
+		std::vector<sf::Vector2f> positions = CheckSameMovements({
+			{-100, 300, 400, 20, 0, true},
+			{-100, 500, 400, 50, 0, false}
+		}, sf::Vector2f(0, 0), false, false);
+		REQUIRE(positions.back().y <= 300-64);
+		REQUIRE(positions.back().y > 300-64-2);
+	}
+	SECTION("Jumping through a jumpthru") {
+		std::vector<sf::Vector2f> positions = CheckSameMovements({
+			{-100, 350, 400, 20, 0, true},
+			{-100, 500, 400, 50, 0, false}
+		}, sf::Vector2f(0, 400), false, true);
+		REQUIRE(GetHighestPosition(positions) < 350-64);
+	}
+	SECTION("Running into a wall, through a jumpthru") {
+		//The jumpthru overlaps the player, but is not an obstacle on the X axis.
+		std::vector<sf::Vector2f> positions = CheckSameMovements({
+			{-100, 500, 2000, 50, 0, false},
+			{300, 470, 100, 60, 0, true},
+			{900, 0, 50, 500, 0, false}
+		}, sf::Vector2f(0, 400), true, false);
+		REQUIRE(positions.back().x <= 900-32);
+		REQUIRE(positions.back().x > 900-32-2);
+	}
+	SECTION("Running up a step and a slope") {
+		//The step is only one pixel high: the player goes up instead of stopping.
+		std::vector<sf::Vector2f> positions = CheckSameMovements({
+			{-100, 500, 2000, 50, 0, false},
+			{200, 499, 100, 1, 0, false},
+			{500, 430, 400, 40, -20, false}
+		}, sf::Vector2f(0, 400), true, false);
+		REQUIRE(positions.back().x > 300);
+		REQUIRE(GetHighestPosition(positions) < 500-64-50);
+	}
+	SECTION("Falling into a wall") {
+		std::vector<sf::Vector2f> positions = CheckSameMovements({
+			{300, -500, 50, 2000, 0, false},
+			{-100, 1600, 1000, 50, 0, false}
+		}, sf::Vector2f(0, 0), true, false);
+		REQUIRE(positions.back().x <= 300-32);
+		REQUIRE(positions.back().x > 300-32-2);
+	}
+}
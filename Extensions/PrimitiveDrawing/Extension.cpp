@@ -7,6 +7,10 @@ This project is released under the MIT License.
 
 #include "GDCpp/Extensions/ExtensionBase.h"
 #include "GDCore/Tools/Version.h"
+#if defined(GD_IDE_ONLY)
+#include "GDCore/IDE/Project/ArbitraryResourceWorker.h"
+#include "GDCore/Events/Instruction.h"
+#endif
 #include "ShapePainterObject.h"
 
 
@@ -286,6 +290,41 @@ public:
         #endif
         GD_COMPLETE_EXTENSION_COMPILATION_INFORMATION();
     };
+
+    #if defined(GD_IDE_ONLY)
+    /**
+     * Expose the images modified by the actions so that they are not packed into a texture atlas:
+     * their texture is rewritten at runtime.
+     */
+    virtual void ExposeActionsResources(gd::Instruction & action, gd::ArbitraryResourceWorker & worker)
+    {
+        if ( action.GetType() == "PrimitiveDrawing::CopyImageOnAnother" )
+            ExposeImageParameter(action, 0, worker);
+        else if ( action.GetType() == "PrimitiveDrawing::CaptureScreen" )
+            ExposeImageParameter(action, 2, worker);
+        else if ( action.GetType() == "PrimitiveDrawing::CreateSFMLTexture" )
+            ExposeImageParameter(action, 1, worker);
+        else if ( action.GetType() == "PrimitiveDrawing::OpenSFMLTextureFromFile" )
+            ExposeImageParameter(action, 2, worker);
+    }
+
+private:
+    /**
+     * Expose the image named by a string parameter, if the name is a literal.
+     */
+    static void ExposeImageParameter(gd::Instruction & action, std::size_t index, gd::ArbitraryResourceWorker & worker)
+    {
+        gd::String parameter = action.GetParameter(index).GetPlainString();
+        if ( parameter.size() < 2 || parameter[0] != '"' || parameter[parameter.size()-1] != '"' )
+            return;
+
+        gd::String imageName = parameter.substr(1, parameter.size()-2);
+        if ( imageName.empty() ) return;
+
+        worker.ExposeImage(imageName);
+        action.SetParameter(index, "\""+imageName+"\"");
+    }
+    #endif
 };
 
 #if !defined(EMSCRIPTEN)
@@ -24,12 +24,16 @@ void GD_EXTENSION_API CopyImageOnAnother( const gd::String & destName, const gd:
 
     std::shared_ptr<SFMLTextureWrapper> dest = scene.GetImageManager()->GetSFMLTexture(destName);
 
-    //Make sure the coordinates are correct.
-    if ( destX < 0 || static_cast<unsigned>(destX) >= dest->texture.getSize().x) return;
-    if ( destY < 0 || static_cast<unsigned>(destY) >= dest->texture.getSize().y) return;
+    //Make sure the coordinates are correct (the texture of an image packed in an atlas is empty).
+    const sf::IntRect destRect = dest->GetDisplayedTextureRect();
+    if ( destX < 0 || destX >= destRect.width) return;
+    if ( destY < 0 || destY >= destRect.height) return;
 
     dest->image.copy(scene.GetImageManager()->GetSFMLTexture(srcName)->image, destX, destY, sf::IntRect(0, 0, 0, 0), useTransparency);
+    dest->DetachFromAtlas();
     dest->texture.loadFromImage(dest->image);
+    dest->InvalidateAlphaMask();
+    scene.GetImageManager()->UpdateTextureBytes(destName);
 }
 
 void GD_EXTENSION_API CaptureScreen( RuntimeScene & scene, const gd::String & destFileName, const gd::String & destImageName )
@@ -42,7 +46,10 @@ void GD_EXTENSION_API CaptureScreen( RuntimeScene & scene, const gd::String & de
     {
         std::shared_ptr<SFMLTextureWrapper> sfmlTexture = scene.GetImageManager()->GetSFMLTexture(destImageName);
         sfmlTexture->image = capture;
+        sfmlTexture->DetachFromAtlas();
         sfmlTexture->texture.loadFromImage(sfmlTexture->image); //Do not forget to update the associated texture
+        sfmlTexture->InvalidateAlphaMask();
+        scene.GetImageManager()->UpdateTextureBytes(destImageName);
     }
 }
 
@@ -74,7 +81,10 @@ void GD_EXTENSION_API CreateSFMLTexture( RuntimeScene & scene, const gd::String
     if ( width != 0 && height != 0 && colorIsOk )
         newTexture->image.create(width, height, color);
 
+    newTexture->DetachFromAtlas();
     newTexture->texture.loadFromImage(newTexture->image); //Do not forget to update the associated texture
+    newTexture->InvalidateAlphaMask();
+    scene.GetImageManager()->UpdateTextureBytes(imageName);
 
     scene.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(imageName, newTexture); //Otherwise
 }
@@ -90,7 +100,10 @@ void GD_EXTENSION_API OpenSFMLTextureFromFile( RuntimeScene & scene, const gd::S
 
     //Open the SFML image and the SFML texture
     newTexture->image.loadFromFile(fileName.ToLocale());
+    newTexture->DetachFromAtlas();
     newTexture->texture.loadFromImage(newTexture->image); //Do not forget to update the associated texture
+    newTexture->InvalidateAlphaMask();
+    scene.GetImageManager()->UpdateTextureBytes(imageName);
 
     scene.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(imageName, newTexture);
 }
@@ -264,11 +264,11 @@ void RuntimeTileMapObject::ChangeTexture(const gd::String &textureName, RuntimeS
     needGeneration = true;
 }
 
-bool GD_EXTENSION_API SingleTileCollision(std::map<gd::String, std::vector<RuntimeObject*>*> tileMapList,
+bool GD_EXTENSION_API SingleTileCollision(ObjectsListsView tileMapList,
                          int layer,
                          int column,
                          int row,
-                         std::map<gd::String, std::vector<RuntimeObject*>*> objectLists,
+                         ObjectsListsView objectLists,
                          bool conditionInverted)
 {
     return TwoObjectListsTest(tileMapList, objectLists, conditionInverted, [layer, column, row](RuntimeObject* tileMapObject_, RuntimeObject * object) {
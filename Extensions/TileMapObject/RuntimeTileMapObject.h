@@ -96,11 +96,11 @@ private:
     float oldY;
 };
 
-bool GD_EXTENSION_API SingleTileCollision(std::map<gd::String, std::vector<RuntimeObject*>*> tileMapList,
+bool GD_EXTENSION_API SingleTileCollision(ObjectsListsView tileMapList,
                          int layer,
                          int column,
                          int row,
-                         std::map<gd::String, std::vector<RuntimeObject*>*> objectLists,
+                         ObjectsListsView objectLists,
                          bool conditionInverted);
 
 #endif
@@ -148,6 +148,20 @@ void TopDownMovementBehavior::DoStepPreEvents(RuntimeScene & scene)
     downKey = false;
 }
 
+void TopDownMovementBehavior::StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        TopDownMovementBehavior * behavior = static_cast<TopDownMovementBehavior*>(behaviors[i]);
+        if ( behavior->Activated() ) behavior->TopDownMovementBehavior::DoStepPreEvents(scene);
+    }
+}
+
+void TopDownMovementBehavior::StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+{
+    //Nothing to do after the events.
+}
+
 void TopDownMovementBehavior::SimulateControl(const gd::String & input)
 {
     if ( input == "Left" ) leftKey = true;
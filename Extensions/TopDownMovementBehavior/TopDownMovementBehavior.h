@@ -27,6 +27,8 @@ public:
     TopDownMovementBehavior();
     virtual ~TopDownMovementBehavior() {};
     virtual Behavior* Clone() const { return new TopDownMovementBehavior(*this); }
+    virtual void StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
+    virtual void StepAllPostEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors);
 
     //Configuration:
     bool DiagonalsAllowed() { return allowDiagonals; };
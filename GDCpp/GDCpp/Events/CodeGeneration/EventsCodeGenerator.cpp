@@ -14,6 +14,7 @@
 #include "GDCore/Project/Project.h"
 #include "GDCore/Project/ExternalEvents.h"
 #include "GDCore/Project/Layout.h"
+#include "GDCore/Project/Object.h"
 #include "GDCore/Events/Tools/EventsCodeNameMangler.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerator.h"
 #include "GDCore/CommonTools.h"
@@ -77,19 +78,40 @@ gd::String EventsCodeGenerator::GenerateObjectBehaviorFunctionCall(gd::String ob
     else if ( context.GetCurrentObject() == objectListName && !context.GetCurrentObject().empty())
     {
         if ( !castNeeded )
-            return "("+ManObjListName(objectListName)+"[i]->GetBehaviorRawPointer(\""+behaviorName+"\")->"+codeInfo.functionCallName+"("+parametersStr+"))";
+            return "("+ManObjListName(objectListName)+"[i]->"+GenerateBehaviorRawPointerCall(objectListName, behaviorName)+"->"+codeInfo.functionCallName+"("+parametersStr+"))";
         else
-            return "(static_cast<"+autoInfo.className+"*>("+ManObjListName(objectListName)+"[i]->GetBehaviorRawPointer(\""+behaviorName+"\"))->"+codeInfo.functionCallName+"("+parametersStr+"))";
+            return "(static_cast<"+autoInfo.className+"*>("+ManObjListName(objectListName)+"[i]->"+GenerateBehaviorRawPointerCall(objectListName, behaviorName)+")->"+codeInfo.functionCallName+"("+parametersStr+"))";
     }
     else
     {
         if ( !castNeeded )
-            return "(( "+ManObjListName(objectListName)+".empty() ) ? "+defaultOutput+" :"+ManObjListName(objectListName)+"[0]->GetBehaviorRawPointer(\""+behaviorName+"\")->"+codeInfo.functionCallName+"("+parametersStr+"))";
+            return "(( "+ManObjListName(objectListName)+".empty() ) ? "+defaultOutput+" :"+ManObjListName(objectListName)+"[0]->"+GenerateBehaviorRawPointerCall(objectListName, behaviorName)+"->"+codeInfo.functionCallName+"("+parametersStr+"))";
         else
-            return "(( "+ManObjListName(objectListName)+".empty() ) ? "+defaultOutput+" : "+"static_cast<"+autoInfo.className+"*>("+ManObjListName(objectListName)+"[0]->GetBehaviorRawPointer(\""+behaviorName+"\"))->"+codeInfo.functionCallName+"("+parametersStr+"))";
+            return "(( "+ManObjListName(objectListName)+".empty() ) ? "+defaultOutput+" : "+"static_cast<"+autoInfo.className+"*>("+ManObjListName(objectListName)+"[0]->"+GenerateBehaviorRawPointerCall(objectListName, behaviorName)+")->"+codeInfo.functionCallName+"("+parametersStr+"))";
     }
 }
 
+gd::String EventsCodeGenerator::GenerateBehaviorRawPointerCall(const gd::String & objectName, const gd::String & behaviorName)
+{
+    const gd::Object * object = NULL;
+    if ( GetLayout().HasObjectNamed(objectName) ) //We check first layout's objects' list.
+        object = &GetLayout().GetObject(objectName);
+    else if ( GetProject().HasObjectNamed(objectName) ) //Then the global objects list.
+        object = &GetProject().GetObject(objectName);
+
+    //Optimize the lookup of the behavior when the object is known: runtime objects
+    //store their behaviors in the same order as the object, so we know its position.
+    if ( object )
+    {
+        const auto & behaviors = object->GetAllBehaviors();
+        auto it = behaviors.find(behaviorName);
+        if ( it != behaviors.end() )
+            return "GetBehaviorRawPointer("+gd::String::From(std::distance(behaviors.begin(), it))+")";
+    }
+
+    return "GetBehaviorRawPointer(\""+behaviorName+"\")";
+}
+
 gd::String EventsCodeGenerator::GenerateObjectCondition(const gd::String & objectName,
                                                                    const gd::ObjectMetadata & objInfo,
                                                                    const std::vector<gd::String> & arguments,
@@ -158,8 +180,8 @@ gd::String EventsCodeGenerator::GenerateBehaviorCondition(const gd::String & obj
     //Add a static_cast if necessary
     gd::String objectFunctionCallNamePart =
     ( !instrInfos.parameters[1].supplementaryInformation.empty() ) ?
-        "static_cast<"+autoInfo.className+"*>("+ManObjListName(objectName)+"[i]->GetBehaviorRawPointer(\""+behaviorName+"\"))->"+instrInfos.codeExtraInformation.functionCallName
-    :   ManObjListName(objectName)+"[i]->GetBehaviorRawPointer(\""+behaviorName+"\")->"+instrInfos.codeExtraInformation.functionCallName;
+        "static_cast<"+autoInfo.className+"*>("+ManObjListName(objectName)+"[i]->"+GenerateBehaviorRawPointerCall(objectName, behaviorName)+")->"+instrInfos.codeExtraInformation.functionCallName
+    :   ManObjListName(objectName)+"[i]->"+GenerateBehaviorRawPointerCall(objectName, behaviorName)+"->"+instrInfos.codeExtraInformation.functionCallName;
 
     //Create call
     gd::String predicat;
@@ -261,8 +283,8 @@ gd::String EventsCodeGenerator::GenerateBehaviorAction(const gd::String & object
     //Add a static_cast if necessary
     gd::String objectPart =
     ( !instrInfos.parameters[1].supplementaryInformation.empty() ) ?
-        "static_cast<"+autoInfo.className+"*>("+ManObjListName(objectName)+"[i]->GetBehaviorRawPointer(\""+behaviorName+"\"))->"
-    :   ManObjListName(objectName)+"[i]->GetBehaviorRawPointer(\""+behaviorName+"\")->";
+        "static_cast<"+autoInfo.className+"*>("+ManObjListName(objectName)+"[i]->"+GenerateBehaviorRawPointerCall(objectName, behaviorName)+")->"
+    :   ManObjListName(objectName)+"[i]->"+GenerateBehaviorRawPointerCall(objectName, behaviorName)+"->";
 
     //Create call
     gd::String call;
@@ -319,27 +341,19 @@ gd::String EventsCodeGenerator::GenerateParameterCodes(const gd::String & parame
     else if ( metadata.type == "objectList" )
     {
         std::vector<gd::String> realObjects = ExpandObjectsName(parameter, context);
-
-        argOutput += "runtimeContext->ClearObjectListsMap()";
         for (std::size_t i = 0;i<realObjects.size();++i)
-        {
             context.ObjectsListNeeded(realObjects[i]);
-            argOutput += ".AddObjectListToMap(\""+ConvertToString(realObjects[i])+"\", "+ManObjListName(realObjects[i])+")";
-        }
-        argOutput += ".ReturnObjectListsMap()";
+
+        argOutput += GenerateObjectsListsViewCode(*this, realObjects);
     }
     //Code only parameter type
     else if ( metadata.type == "objectListWithoutPicking" )
     {
         std::vector<gd::String> realObjects = ExpandObjectsName(parameter, context);
-
-        argOutput += "runtimeContext->ClearObjectListsMap()";
         for (std::size_t i = 0;i<realObjects.size();++i)
-        {
             context.EmptyObjectsListNeeded(realObjects[i]);
-            argOutput += ".AddObjectListToMap(\""+ConvertToString(realObjects[i])+"\", "+ManObjListName(realObjects[i])+")";
-        }
-        argOutput += ".ReturnObjectListsMap()";
+
+        argOutput += GenerateObjectsListsViewCode(*this, realObjects);
     }
     //Code only parameter type
     else if ( metadata.type == "objectPtr")
@@ -495,6 +509,68 @@ gd::String EventsCodeGenerator::GenerateExternalEventsCompleteCode(gd::Project &
     return output;
 }
 
+gd::String EventsCodeGenerator::GenerateObjectsDeclarationCode(gd::EventsCodeGenerationContext & context)
+{
+    gd::String declarationsCode;
+    for ( set<gd::String>::iterator it = context.GetObjectsListsToBeDeclared().begin() ; it != context.GetObjectsListsToBeDeclared().end(); ++it )
+    {
+        if ( !context.ObjectAlreadyDeclared(*it) )
+        {
+            declarationsCode += "std::vector<RuntimeObject*> "+GetObjectListName(*it, context)
+                                +" = runtimeContext->GetObjectsRawPointers("+GetObjectNameIdName(*this, *it)+");\n";
+            context.SetObjectDeclared(*it);
+        }
+        else
+        {
+            //Could normally be done in one line, but clang sometimes miscompile it.
+            declarationsCode += "std::vector<RuntimeObject*> & "+GetObjectListName(*it, context)+"T = "+GetObjectListName(*it, context)+";\n";
+            declarationsCode += "std::vector<RuntimeObject*> "+GetObjectListName(*it, context)+" = "+GetObjectListName(*it, context)+"T;\n";
+        }
+    }
+    for ( set<gd::String>::iterator it = context.GetObjectsListsToBeDeclaredEmpty().begin() ; it != context.GetObjectsListsToBeDeclaredEmpty().end(); ++it )
+    {
+        if ( !context.ObjectAlreadyDeclared(*it) )
+        {
+            declarationsCode += "std::vector<RuntimeObject*> "+GetObjectListName(*it, context)+";\n";
+            context.SetObjectDeclared(*it);
+        }
+        else
+        {
+            //Could normally be done in one line, but clang sometimes miscompile it.
+            declarationsCode += "std::vector<RuntimeObject*> & "+GetObjectListName(*it, context)+"T = "+GetObjectListName(*it, context)+";\n";
+            declarationsCode += "std::vector<RuntimeObject*> "+GetObjectListName(*it, context)+" = "+GetObjectListName(*it, context)+"T;\n";
+        }
+    }
+
+    return declarationsCode;
+}
+
+gd::String EventsCodeGenerator::GetObjectNameIdName(gd::EventsCodeGenerator & codeGenerator, const gd::String & objectName)
+{
+    //The identifier of the name is computed only once, when the events code is loaded.
+    gd::String nameIdName = "GD"+EventsCodeNameMangler::Get()->GetMangledObjectsListName(objectName)+"NameId";
+    codeGenerator.AddGlobalDeclaration("static const ObjectNameId "+nameIdName
+                                       +" = RuntimeNamesTable::Get()->GetObjectNameId(\""+codeGenerator.ConvertToString(objectName)+"\");");
+
+    return nameIdName;
+}
+
+gd::String EventsCodeGenerator::GenerateObjectsListsViewCode(gd::EventsCodeGenerator & codeGenerator, const std::vector<gd::String> & objectsNames)
+{
+    if ( objectsNames.empty() ) return "ObjectsListsView()";
+
+    //The array of lists is a temporary living until the end of the call using the view.
+    gd::String code = "ObjectsListsView({";
+    for (std::size_t i = 0;i<objectsNames.size();++i)
+    {
+        if ( i != 0 ) code += ", ";
+        code += "{"+GetObjectNameIdName(codeGenerator, objectsNames[i])+", &"+ManObjListName(objectsNames[i])+"}";
+    }
+    code += "})";
+
+    return code;
+}
+
 EventsCodeGenerator::EventsCodeGenerator(gd::Project & project, const gd::Layout & layout) :
     gd::EventsCodeGenerator(project, layout, CppPlatform::Get())
 {
@@ -49,6 +49,28 @@ public:
      */
     void PreprocessEventList( gd::EventsList & listEvent );
 
+    /**
+     * \brief Generate the declarations of objects lists.
+     *
+     * GD C++ Platform uses the identifier of the name of the objects (see RuntimeNamesTable),
+     * which is computed only once, to get the objects lists.
+     */
+    virtual gd::String GenerateObjectsDeclarationCode(gd::EventsCodeGenerationContext & context);
+
+    /**
+     * \brief Get the name of the global constant containing the identifier of the name of an object
+     * (see RuntimeNamesTable), declaring it if needed.
+     */
+    static gd::String GetObjectNameIdName(gd::EventsCodeGenerator & codeGenerator, const gd::String & objectName);
+
+    /**
+     * \brief Generate the code creating an ObjectsListsView on the lists of the specified objects.
+     *
+     * The lists must have been declared as needed in the context.
+     * \note This is a static method so that it can be used by extensions generating code with a gd::EventsCodeGenerator.
+     */
+    static gd::String GenerateObjectsListsViewCode(gd::EventsCodeGenerator & codeGenerator, const std::vector<gd::String> & objectsNames);
+
 protected:
     virtual gd::String GenerateParameterCodes(const gd::String & parameter, const gd::ParameterMetadata & metadata,
                                                gd::EventsCodeGenerationContext & context,
@@ -100,6 +122,12 @@ protected:
                                                             const gd::InstructionMetadata & instrInfos,
                                                             gd::EventsCodeGenerationContext & context);
 
+    /**
+     * \brief Generate the call to RuntimeObject::GetBehaviorRawPointer returning the specified behavior
+     * of an object, using the position of the behavior when it is known.
+     */
+    gd::String GenerateBehaviorRawPointerCall(const gd::String & objectName, const gd::String & behaviorName);
+
     /**
      * \brief Construct a code generator for the specified project and layout.
      */
@@ -16,6 +16,7 @@
 #include "GDCore/Extensions/Metadata/ObjectMetadata.h"
 #include "GDCore/Extensions/Metadata/MetadataProvider.h"
 #include "GDCore/Events/CodeGeneration/EventsCodeGenerationContext.h"
+#include "GDCore/Events/Tools/EventsCodeNameMangler.h"
 #include "GDCpp/Events/CodeGeneration/VariableParserCallbacks.h"
 #include "GDCpp/Runtime/CommonTools.h"
 
@@ -92,12 +93,22 @@ void VariableCodeGenerationCallbacks::OnRootVariable(gd::String variableName)
 		}
 	}
 
-	output += ".Get(\""+variableName+"\")";
+	//Otherwise, use the identifier of the name of the variable, computed only once,
+	//so that the variable is found without comparing strings.
+	gd::String nameIdName = "GD"+EventsCodeNameMangler::Get()->GetMangledObjectsListName(variableName)+"VariableNameId";
+	codeGenerator.AddGlobalDeclaration("static const VariableNameId "+nameIdName
+		+" = RuntimeNamesTable::Get()->GetVariableNameId(\""+codeGenerator.ConvertToString(variableName)+"\");");
+	output += ".GetByNameId("+nameIdName+")";
 }
 
 void VariableCodeGenerationCallbacks::OnChildVariable(gd::String variableName)
 {
-	output += ".GetChild(\""+variableName+"\")";
+	//Each access to a child has its own cache, remembering the child found the last time.
+	gd::String cacheName = "GDCachedVariableChild"+gd::String::From(codeGenerator.GetCustomGlobalDeclaration().size());
+	codeGenerator.AddIncludeFile("GDCpp/Runtime/CachedVariableChild.h");
+	codeGenerator.AddGlobalDeclaration("static CachedVariableChild "+cacheName
+		+"(\""+codeGenerator.ConvertToString(variableName)+"\");");
+	output = cacheName+".Get("+output+")";
 }
 
 void VariableCodeGenerationCallbacks::OnChildSubscript(gd::String stringExpression)
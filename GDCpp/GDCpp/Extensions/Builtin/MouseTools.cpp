@@ -69,7 +69,7 @@ int GD_API GetMouseWheelDelta(RuntimeScene & scene)
     return scene.GetInputManager().GetMouseWheelDelta();
 }
 
-bool GD_API CursorOnObject(std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists, RuntimeScene & scene, bool precise, bool conditionInverted)
+bool GD_API CursorOnObject(ObjectsListsView objectsLists, RuntimeScene & scene, bool precise, bool conditionInverted)
 {
     return PickObjectsIf(objectsLists, conditionInverted, [&scene, precise](RuntimeObject * obj) {
         return obj->CursorOnObject(scene, precise);
@@ -5,6 +5,7 @@
 #include <map>
 #include <vector>
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 
 class RuntimeScene;
 class RuntimeObject;
@@ -20,6 +21,6 @@ double GD_API GetCursorYPosition(RuntimeScene & scene, const gd::String & layer,
 bool GD_API MouseButtonPressed(RuntimeScene & scene, const gd::String & key);
 bool GD_API MouseButtonReleased(RuntimeScene & scene, const gd::String & key);
 int GD_API GetMouseWheelDelta(RuntimeScene & scene);
-bool GD_API CursorOnObject(std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists, RuntimeScene & scene, bool precise, bool conditionInverted);
+bool GD_API CursorOnObject(ObjectsListsView objectsLists, RuntimeScene & scene, bool precise, bool conditionInverted);
 
 #endif // MOUSETOOLS_H
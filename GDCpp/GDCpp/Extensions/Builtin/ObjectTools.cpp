@@ -14,10 +14,10 @@
 
 using namespace std;
 
-double GD_API PickedObjectsCount( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists )
+double GD_API PickedObjectsCount( ObjectsListsView objectsLists )
 {
     std::size_t size = 0;
-    std::map <gd::String, std::vector<RuntimeObject*> *>::const_iterator it = objectsLists.begin();
+    ObjectsListsView::const_iterator it = objectsLists.begin();
     for (;it!=objectsLists.end();++it)
     {
         if ( it->second == NULL ) continue;
@@ -28,14 +28,19 @@ double GD_API PickedObjectsCount( std::map <gd::String, std::vector<RuntimeObjec
     return size;
 }
 
-bool GD_API HitBoxesCollision(std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, bool conditionInverted )
+bool GD_API HitBoxesCollision(ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, bool conditionInverted )
 {
-    return TwoObjectListsTest(objectsLists1, objectsLists2, conditionInverted, [](RuntimeObject * obj1, RuntimeObject * obj2) {
+    //Objects can only collide if their bounding circles are overlapping (see RuntimeObject::IsCollidingWith).
+    auto boundingRadius = [](RuntimeObject * obj) {
+        return sqrt(obj->GetWidth()*obj->GetWidth()+obj->GetHeight()*obj->GetHeight())/2.0;
+    };
+
+    return TwoObjectListsTestWithBroadphase(objectsLists1, objectsLists2, conditionInverted, boundingRadius, [](RuntimeObject * obj1, RuntimeObject * obj2) {
         return obj1->IsCollidingWith(obj2);
     });
 }
 
-bool GD_API ObjectsTurnedToward( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, float tolerance, bool conditionInverted )
+bool GD_API ObjectsTurnedToward( ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, float tolerance, bool conditionInverted )
 {
     return TwoObjectListsTest(objectsLists1, objectsLists2, conditionInverted, [tolerance](RuntimeObject * obj1, RuntimeObject * obj2) {
         double objAngle = atan2(obj2->GetDrawableY()+obj2->GetCenterY() - (obj1->GetDrawableY()+obj1->GetCenterY()),
@@ -46,10 +51,13 @@ bool GD_API ObjectsTurnedToward( std::map <gd::String, std::vector<RuntimeObject
     });
 }
 
-float GD_API DistanceBetweenObjects( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, float length, bool conditionInverted)
+float GD_API DistanceBetweenObjects( ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, float length, bool conditionInverted)
 {
+    float radius = abs(length)/2;
     length *= length;
-    return TwoObjectListsTest(objectsLists1, objectsLists2, conditionInverted, [length](RuntimeObject * obj1, RuntimeObject * obj2) {
+    return TwoObjectListsTestWithBroadphase(objectsLists1, objectsLists2, conditionInverted, [radius](RuntimeObject *) {
+        return radius;
+    }, [length](RuntimeObject * obj1, RuntimeObject * obj2) {
         float X = obj1->GetDrawableX()+obj1->GetCenterX() - (obj2->GetDrawableX()+obj2->GetCenterX());
         float Y = obj1->GetDrawableY()+obj1->GetCenterY() - (obj2->GetDrawableY()+obj2->GetCenterY());
 
@@ -57,7 +65,7 @@ float GD_API DistanceBetweenObjects( std::map <gd::String, std::vector<RuntimeOb
     });
 }
 
-bool GD_API MovesToward( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, float tolerance, bool conditionInverted )
+bool GD_API MovesToward( ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, float tolerance, bool conditionInverted )
 {
     return TwoObjectListsTest(objectsLists1, objectsLists2, conditionInverted, [tolerance](RuntimeObject * obj1, RuntimeObject * obj2) {
         if ( obj1->TotalForceLength() == 0 ) return false;
@@ -10,6 +10,7 @@
 #include <vector>
 #include <map>
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 
 class RuntimeScene;
 class RuntimeObject;
@@ -17,26 +18,26 @@ class RuntimeObject;
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API ObjectsTurnedToward( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, float tolerance, bool conditionInverted );
+bool GD_API ObjectsTurnedToward( ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, float tolerance, bool conditionInverted );
 
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API HitBoxesCollision( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, bool conditionInverted );
+bool GD_API HitBoxesCollision( ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, bool conditionInverted );
 
 /**
  * Only used internally by GD events generated code.
  */
-double GD_API PickedObjectsCount( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists );
+double GD_API PickedObjectsCount( ObjectsListsView objectsLists );
 
 /**
  * Only used internally by GD events generated code.
  */
-float GD_API DistanceBetweenObjects(std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, float length, bool conditionInverted);
+float GD_API DistanceBetweenObjects(ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, float length, bool conditionInverted);
 
 /**
  * Only used internally by GD events generated code.
  */
-bool GD_API MovesToward( std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, float tolerance, bool conditionInverted );
+bool GD_API MovesToward( ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, float tolerance, bool conditionInverted );
 
 #endif // OBJECTTOOLS_H
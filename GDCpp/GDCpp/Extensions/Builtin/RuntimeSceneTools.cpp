@@ -75,6 +75,12 @@ void GD_API PopScene(RuntimeScene & scene)
     scene.RequestChange(RuntimeScene::SceneChange::POP_SCENE);
 }
 
+void GD_API PrefetchScene(RuntimeScene & scene, gd::String sceneName)
+{
+    if (!scene.game->HasLayoutNamed(sceneName)) return;
+    scene.RequestPrefetch(sceneName);
+}
+
 bool GD_API SceneJustBegins(RuntimeScene & scene )
 {
     return scene.GetTimeManager().IsFirstLoop();
@@ -82,10 +88,10 @@ bool GD_API SceneJustBegins(RuntimeScene & scene )
 
 void GD_API MoveObjects( RuntimeScene & scene )
 {
-    RuntimeObjList allObjects = scene.objectsInstances.GetAllObjects();
+    const RuntimeObjList & allObjects = scene.objectsInstances.GetAllObjects();
 
     double elapsedTime = static_cast<double>(scene.GetTimeManager().GetElapsedTime()) / 1000000.0;
-    for (std::size_t id = 0;id < allObjects.size();++id)
+    for (std::size_t id = 0, count = allObjects.size();id < count;++id)
     {
         allObjects[id]->SetX(allObjects[id]->GetX() + allObjects[id]->TotalForceX() * elapsedTime);
         allObjects[id]->SetY(allObjects[id]->GetY() + allObjects[id]->TotalForceY() * elapsedTime);
@@ -98,9 +104,12 @@ void GD_API MoveObjects( RuntimeScene & scene )
 
 namespace {
 
-void DoCreateObjectOnScene(RuntimeScene & scene, gd::String objectName, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, float positionX, float positionY, const gd::String & layer)
+void DoCreateObjectOnScene(RuntimeScene & scene, ObjectNameId objectNameId, ObjectsListsView pickedObjectLists, float positionX, float positionY, const gd::String & layer)
 {
-    if ( pickedObjectLists.empty() ) return;
+    std::vector<RuntimeObject*> * pickedObjects = pickedObjectLists.Get(objectNameId);
+    if ( pickedObjects == NULL ) return;
+
+    const gd::String & objectName = RuntimeNamesTable::Get()->GetObjectName(objectNameId);
 
     //Find the object to be created
     std::vector<ObjSPtr>::const_iterator sceneObject = std::find_if(scene.GetObjects().begin(), scene.GetObjects().end(), std::bind2nd(ObjectHasName(), objectName));
@@ -123,27 +132,28 @@ void DoCreateObjectOnScene(RuntimeScene & scene, gd::String objectName, std::map
 
     //Add object to scene and let it be concerned by futures actions
     scene.objectsInstances.AddObject(newObject);
-    pickedObjectLists[objectName]->push_back( newObject.get() );
+    pickedObjects->push_back( newObject.get() );
 }
 
 
 }
 
-void GD_API CreateObjectOnScene(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, float positionX, float positionY, const gd::String & layer)
+void GD_API CreateObjectOnScene(RuntimeScene & scene, ObjectsListsView pickedObjectLists, float positionX, float positionY, const gd::String & layer)
 {
     if ( pickedObjectLists.empty() ) return;
 
     ::DoCreateObjectOnScene(scene, pickedObjectLists.begin()->first, pickedObjectLists, positionX, positionY, layer);
 }
 
-void GD_API CreateObjectFromGroupOnScene(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, const gd::String & objectWanted, float positionX, float positionY, const gd::String & layer)
+void GD_API CreateObjectFromGroupOnScene(RuntimeScene & scene, ObjectsListsView pickedObjectLists, const gd::String & objectWanted, float positionX, float positionY, const gd::String & layer)
 {
-    if ( pickedObjectLists[objectWanted] == NULL ) return; //Bail out if the object is not present in the specified group
+    ObjectNameId objectWantedId = RuntimeNamesTable::Get()->GetObjectNameId(objectWanted);
+    if ( pickedObjectLists.Get(objectWantedId) == NULL ) return; //Bail out if the object is not present in the specified group
 
-    ::DoCreateObjectOnScene(scene, objectWanted, pickedObjectLists, positionX, positionY, layer);
+    ::DoCreateObjectOnScene(scene, objectWantedId, pickedObjectLists, positionX, positionY, layer);
 }
 
-bool GD_API PickAllObjects(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists)
+bool GD_API PickAllObjects(RuntimeScene & scene, ObjectsListsView pickedObjectLists)
 {
     for (auto it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
     {
@@ -162,7 +172,7 @@ bool GD_API PickAllObjects(RuntimeScene & scene, std::map <gd::String, std::vect
     return true;
 }
 
-bool GD_API PickRandomObject(RuntimeScene &, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists)
+bool GD_API PickRandomObject(RuntimeScene &, ObjectsListsView pickedObjectLists)
 {
     //Create a list with all objects
     std::vector<RuntimeObject*> allObjects;
@@ -180,7 +190,7 @@ bool GD_API PickRandomObject(RuntimeScene &, std::map <gd::String, std::vector<R
     return true;
 }
 
-bool GD_API PickNearestObject(std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, double x, double y, bool inverted)
+bool GD_API PickNearestObject(ObjectsListsView pickedObjectLists, double x, double y, bool inverted)
 {
     double best = 0;
     bool first = true;
@@ -188,7 +198,7 @@ bool GD_API PickNearestObject(std::map <gd::String, std::vector<RuntimeObject*>
     for (auto it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
     {
         if ( it->second == NULL ) continue;
-        auto list = *it->second;
+        const std::vector<RuntimeObject*> & list = *it->second;
 
         for (std::size_t i = 0;i<list.size();++i)
         {
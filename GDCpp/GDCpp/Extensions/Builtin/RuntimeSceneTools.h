@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include "GDCpp/Runtime/ObjectsListsView.h"
 class RuntimeScene;
 namespace gd { class Variable; }
 class RuntimeObject;
@@ -48,6 +49,11 @@ void GD_API PushScene(RuntimeScene & scene, gd::String newSceneName);
  */
 void GD_API PopScene(RuntimeScene & scene);
 
+/**
+ * Only used internally by GD events generated code.
+ */
+void GD_API PrefetchScene(RuntimeScene & scene, gd::String sceneName);
+
 /**
  * Only used internally by GD events generated code.
  */
@@ -66,33 +72,33 @@ void GD_API DisableInputWhenFocusIsLost(RuntimeScene & scene, bool disable);
 /**
  * Only used internally by GD events generated code.
  */
-void GD_API CreateObjectOnScene(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, float positionX, float positionY, const gd::String & layer);
+void GD_API CreateObjectOnScene(RuntimeScene & scene, ObjectsListsView pickedObjectLists, float positionX, float positionY, const gd::String & layer);
 
 /**
  * Only used internally by GD events generated code.
  */
-void GD_API CreateObjectFromGroupOnScene(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, const gd::String & objectWanted, float positionX, float positionY, const gd::String & layer);
+void GD_API CreateObjectFromGroupOnScene(RuntimeScene & scene, ObjectsListsView pickedObjectLists, const gd::String & objectWanted, float positionX, float positionY, const gd::String & layer);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true ( always )
  */
-bool GD_API PickAllObjects(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists);
+bool GD_API PickAllObjects(RuntimeScene & scene, ObjectsListsView pickedObjectLists);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true if an object was picked, false otherwise
  */
-bool GD_API PickRandomObject(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists);
+bool GD_API PickRandomObject(RuntimeScene & scene, ObjectsListsView pickedObjectLists);
 
 /**
  * Only used internally by GD events generated code.
  *
  * \return true if an object was picked, false otherwise
  */
-bool GD_API PickNearestObject(std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists, double x, double y, bool inverted);
+bool GD_API PickNearestObject(ObjectsListsView pickedObjectLists, double x, double y, bool inverted);
 
 /**
  * Only used internally by GD events generated code.
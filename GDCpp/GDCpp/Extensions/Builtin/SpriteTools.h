@@ -6,10 +6,11 @@
 #include <vector>
 
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 
 class RuntimeScene;
 class RuntimeObject;
 
-bool GD_API SpriteCollision(std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists1, std::map <gd::String, std::vector<RuntimeObject*> *> objectsLists2, bool conditionInverted);
+bool GD_API SpriteCollision(ObjectsListsView objectsLists1, ObjectsListsView objectsLists2, bool conditionInverted);
 
 #endif // SPRITETOOLS_H
@@ -27,6 +27,9 @@ BaseProfiler::BaseProfiler() :
 profilingActivated(false),
 lastEventsTime(0),
 lastRenderingTime(0),
+lastDrawCallsCount(0),
+lastPathfindingTime(0),
+pathfindingTime(0),
 totalSceneTime(0),
 totalEventsTime(0),
 stepTime(50)
@@ -47,6 +50,9 @@ void BaseProfiler::Reset()
 {
     lastEventsTime = 0;
     lastRenderingTime = 0;
+    lastDrawCallsCount = 0;
+    lastPathfindingTime = 0;
+    pathfindingTime = 0;
     totalSceneTime = 0;
     totalEventsTime = 0;
 
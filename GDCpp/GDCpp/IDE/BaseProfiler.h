@@ -44,6 +44,9 @@ public:
 
     unsigned long int lastEventsTime; ///< Time used by events during the last frame
     unsigned long int lastRenderingTime; ///< Time used by rendering during the last frame
+    unsigned long int lastDrawCallsCount; ///< Number of draw calls done by rendering during the last frame
+    unsigned long int lastPathfindingTime; ///< Time used by pathfinding behaviors to plan paths during the last frame
+    unsigned long int pathfindingTime; ///< Time used by pathfinding behaviors to plan paths during the current frame
     unsigned long int totalSceneTime; ///< Total time used by events and rendering since the beginning.
     unsigned long int totalEventsTime; ///< Total time used by events since the beginning.
 
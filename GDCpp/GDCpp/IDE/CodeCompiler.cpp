@@ -633,33 +633,33 @@ void CodeCompilerProcess::ReadOutput()
 
     if(IsInputAvailable())
     {
-        gd::String line;
+        std::string line;
         do
         {
             c = GetInputStream()->GetC();
             if ( GetInputStream()->Eof() ) break; // Check we've not just overrun
 
             if ( c=='\n' ) break; // If \n, break to print the line
-            line.Raw() += c;
+            line += c;
         }
         while ( IsInputAvailable() ); // Unless \n, loop to get another char
 
-        output.push_back(line.ReplaceInvalid()); // Either there's a full line in 'line', or we've run out of input. Either way, print it
+        output.push_back(gd::String::FromUTF8(line).ReplaceInvalid()); // Either there's a full line in 'line', or we've run out of input. Either way, print it
     }
     if(IsErrorAvailable())
     {
-        gd::String line;
+        std::string line;
         do
         {
             c = GetErrorStream()->GetC();
             if ( GetErrorStream()->Eof() ) break; // Check we've not just overrun
 
             if ( c=='\n' ) break; // If \n, break to print the line
-            line.Raw() += c;
+            line += c;
         }
         while ( IsErrorAvailable() );                           // Unless \n, loop to get another char
 
-        outputErrors.push_back(line.ReplaceInvalid()); // Either there's a full line in 'line', or we've run out of input. Either way, print it
+        outputErrors.push_back(gd::String::FromUTF8(line).ReplaceInvalid()); // Either there's a full line in 'line', or we've run out of input. Either way, print it
     }
 }
 
@@ -160,10 +160,12 @@ void ProfileDlg::UpdateGUI()
     eventsTimeTxt->SetLabel(_("Events:")+gd::String::From(static_cast<double>(lastEventsTime)/1000.0f)+_("ms")
                             +_("/ Percent of time used by events:")
                                      +gd::String::From(static_cast<double>(lastEventsTime)/static_cast<double>((lastEventsTime+lastRenderingTime))*100.0f)
-                                     +"%");
+                                     +"%"
+                            +_("/ Pathfinding:")+gd::String::From(static_cast<double>(lastPathfindingTime)/1000.0f)+_("ms"));
 
     totalTimeTxt->SetLabel(_("Total rendering time ( Display + Events ):")+
-        gd::String::From(static_cast<double>((lastRenderingTime+lastEventsTime))/1000.0f)+_("ms"));
+        gd::String::From(static_cast<double>((lastRenderingTime+lastEventsTime))/1000.0f)+_("ms")
+        +_("/ Draw calls:")+gd::String::From(lastDrawCallsCount));
 
     std::size_t currentObjectCount = sceneCanvas.GetRuntimeScene().objectsInstances.GetAllObjects().size();
     objectsCountTxt->SetLabel(_("Number of objects:")+gd::String::From(currentObjectCount));
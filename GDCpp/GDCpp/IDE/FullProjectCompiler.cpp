@@ -41,6 +41,8 @@
 #include "GDCore/Extensions/Platform.h"
 #include "GDCore/IDE/ProjectStripper.h"
 #include "GDCore/IDE/Project/ResourcesMergingHelper.h"
+#include "GDCore/IDE/Project/SceneResourcesFinder.h"
+#include "GDCore/IDE/Project/TextureAtlasPacker.h"
 #include "GDCpp/IDE/ExecutableIconChanger.h"
 #include "GDCpp/IDE/BaseProfiler.h"
 #include "GDCpp/IDE/DependenciesAnalyzer.h"
@@ -255,6 +257,8 @@ void FullProjectCompiler::LaunchProjectCompilation()
     gd::SafeYield::Do();
     diagnosticManager.OnMessage(_( "Copying resources..." ), _( "Step 1 out of 3" ));
     gd::Project strippedProject = game;
+    gd::SceneResourcesFinder::UpdateResourcesManifests(strippedProject); //Must be done before the events are stripped.
+    gd::TextureAtlasPacker::PackImages(strippedProject, tempDir); //Must be done before the events are stripped.
     gd::ProjectStripper::StripProject(strippedProject);
     gd::ProjectFileWriter::SaveToFile(strippedProject, tempDir + "/GDProjectSrcFile.gdg", true);
     diagnosticManager.OnPercentUpdate(80);
@@ -0,0 +1,104 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/BehaviorsRegistry.h"
+#include "GDCpp/Runtime/Project/Behavior.h"
+
+void BehaviorsRegistry::Add(gd::Behavior * behavior)
+{
+    if ( stepping )
+    {
+        behaviorsAddedWhileStepping.push_back(behavior);
+        return;
+    }
+
+    std::size_t typeIndex = 0;
+    for (;typeIndex<types.size();++typeIndex)
+    {
+        if ( types[typeIndex].type == behavior->GetTypeName() ) break;
+    }
+    if ( typeIndex == types.size() )
+    {
+        types.push_back(BehaviorsOfType());
+        types.back().type = behavior->GetTypeName();
+    }
+
+    std::vector<gd::Behavior*> & behaviors = types[typeIndex].behaviors;
+    behavior->registryTypeIndex = typeIndex;
+    behavior->registryIndex = behaviors.size();
+    behaviors.push_back(behavior);
+}
+
+void BehaviorsRegistry::Remove(gd::Behavior * behavior)
+{
+    std::size_t typeIndex = behavior->registryTypeIndex;
+    std::size_t index = behavior->registryIndex;
+    if ( typeIndex >= types.size() || index >= types[typeIndex].behaviors.size() ||
+         types[typeIndex].behaviors[index] != behavior )
+    {
+        //The behavior can still be waiting to be added.
+        for (std::size_t i = 0;i<behaviorsAddedWhileStepping.size();++i)
+        {
+            if ( behaviorsAddedWhileStepping[i] == behavior )
+            {
+                behaviorsAddedWhileStepping.erase(behaviorsAddedWhileStepping.begin()+i);
+                return;
+            }
+        }
+        return;
+    }
+
+    behavior->registryTypeIndex = gd::String::npos;
+    behavior->registryIndex = gd::String::npos;
+
+    //Move the last behavior at the position of the removed behavior.
+    std::vector<gd::Behavior*> & behaviors = types[typeIndex].behaviors;
+    if ( index != behaviors.size()-1 )
+    {
+        behaviors[index] = behaviors.back();
+        behaviors[index]->registryIndex = index;
+    }
+    behaviors.pop_back();
+}
+
+void BehaviorsRegistry::Clear()
+{
+    types.clear();
+    behaviorsAddedWhileStepping.clear();
+}
+
+void BehaviorsRegistry::StepPreEvents(RuntimeScene & scene)
+{
+    stepping = true;
+    for (std::size_t i = 0;i<types.size();++i)
+    {
+        if ( !types[i].behaviors.empty() )
+            types[i].behaviors[0]->StepAllPreEvents(scene, types[i].behaviors);
+    }
+    stepping = false;
+
+    AddBehaviorsAddedWhileStepping();
+}
+
+void BehaviorsRegistry::StepPostEvents(RuntimeScene & scene)
+{
+    stepping = true;
+    for (std::size_t i = 0;i<types.size();++i)
+    {
+        if ( !types[i].behaviors.empty() )
+            types[i].behaviors[0]->StepAllPostEvents(scene, types[i].behaviors);
+    }
+    stepping = false;
+
+    AddBehaviorsAddedWhileStepping();
+}
+
+void BehaviorsRegistry::AddBehaviorsAddedWhileStepping()
+{
+    for (std::size_t i = 0;i<behaviorsAddedWhileStepping.size();++i)
+        Add(behaviorsAddedWhileStepping[i]);
+
+    behaviorsAddedWhileStepping.clear();
+}
@@ -0,0 +1,87 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_BEHAVIORSREGISTRY_H
+#define GDCPP_BEHAVIORSREGISTRY_H
+
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+namespace gd { class Behavior; }
+class RuntimeScene;
+
+/**
+ * \brief Contains the behaviors of the objects of a scene, grouped by type, so that the
+ * behaviors of each type are updated one after the other in a single loop.
+ *
+ * For each type, the behaviors are stored in a contiguous list which is passed to
+ * gd::Behavior::StepAllPreEvents (and StepAllPostEvents) of the first behavior of the list.
+ *
+ * Behaviors are added and removed by ObjInstancesHolder, when objects are added to or removed from it.
+ * Behaviors added while the behaviors are updated are only updated from the next update.
+ *
+ * \see ObjInstancesHolder
+ * \ingroup GameEngine
+ */
+class GD_API BehaviorsRegistry
+{
+public:
+    BehaviorsRegistry() : stepping(false) {};
+    virtual ~BehaviorsRegistry() {};
+
+    /**
+     * \brief Add a behavior to the behaviors having the same type.
+     */
+    void Add(gd::Behavior * behavior);
+
+    /**
+     * \brief Remove a behavior, in constant time.
+     * \warning Behaviors must not be removed while they are updated.
+     */
+    void Remove(gd::Behavior * behavior);
+
+    /**
+     * \brief Remove all the behaviors.
+     */
+    void Clear();
+
+    /**
+     * \brief Update the behaviors before the events, type by type.
+     */
+    void StepPreEvents(RuntimeScene & scene);
+
+    /**
+     * \brief Update the behaviors after the events, type by type.
+     */
+    void StepPostEvents(RuntimeScene & scene);
+
+    /**
+     * \brief Return the number of types of behaviors that were added to the registry.
+     */
+    std::size_t GetTypesCount() const { return types.size(); }
+
+    /**
+     * \brief Return the behaviors of a type.
+     * \param typeIndex The index of the type, in the order the types were added.
+     */
+    const std::vector<gd::Behavior*> & GetBehaviors(std::size_t typeIndex) const { return types[typeIndex].behaviors; }
+
+private:
+    struct BehaviorsOfType
+    {
+        gd::String type;
+        std::vector<gd::Behavior*> behaviors;
+    };
+
+    /**
+     * \brief Add the behaviors that were added during an update.
+     */
+    void AddBehaviorsAddedWhileStepping();
+
+    std::vector<BehaviorsOfType> types; ///< The behaviors, grouped by type.
+    std::vector<gd::Behavior*> behaviorsAddedWhileStepping; ///< The behaviors added during an update, to be added after it.
+    bool stepping; ///< True while the behaviors are updated.
+};
+
+#endif
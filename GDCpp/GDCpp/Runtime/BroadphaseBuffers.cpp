@@ -0,0 +1,28 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/BroadphaseBuffers.h"
+
+std::vector<std::unique_ptr<BroadphaseBuffers::Buffers>> BroadphaseBuffers::unusedBuffers;
+
+BroadphaseBuffers::BroadphaseBuffers()
+{
+    if ( !unusedBuffers.empty() )
+    {
+        buffers = std::move(unusedBuffers.back());
+        unusedBuffers.pop_back();
+    }
+    else
+        buffers.reset(new Buffers);
+
+    buffers->bounds1.clear();
+    buffers->bounds2.clear();
+    buffers->candidates.clear();
+}
+
+BroadphaseBuffers::~BroadphaseBuffers()
+{
+    unusedBuffers.push_back(std::move(buffers));
+}
@@ -0,0 +1,81 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_BROADPHASEBUFFERS_H
+#define GDCPP_BROADPHASEBUFFERS_H
+
+#include <memory>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include "GDCpp/Runtime/SpatialHash.h"
+class RuntimeObject;
+
+/**
+ * \brief The bounds of the objects and the grid used by TwoObjectListsTestWithBroadphase.
+ *
+ * The buffers are taken from a pool when created, and given back to the pool when destroyed
+ * (like PickedObjectsFlags): once they are large enough for the lists of the events, testing
+ * objects does not allocate memory anymore. The buffers are empty when taken from the pool.
+ *
+ * \note The pool is shared by all the scenes and is not thread safe: buffers must only be used
+ * by the thread running the events.
+ *
+ * \see TwoObjectListsTestWithBroadphase
+ * \ingroup GameEngine
+ */
+class GD_API BroadphaseBuffers
+{
+public:
+    /**
+     * \brief An object of the second lists, which can be near an object of the first lists.
+     */
+    struct Candidate
+    {
+        RuntimeObject * object;
+        std::size_t list; ///< The index of the list of the object in the second lists
+        std::size_t index; ///< The index of the object in its list
+    };
+
+    BroadphaseBuffers();
+    ~BroadphaseBuffers();
+
+    BroadphaseBuffers(const BroadphaseBuffers &) = delete;
+    BroadphaseBuffers & operator=(const BroadphaseBuffers &) = delete;
+
+    /**
+     * \brief The bounds of the objects of the first lists.
+     */
+    std::vector<sf::FloatRect> & GetBounds1() { return buffers->bounds1; }
+
+    /**
+     * \brief The bounds of the objects of the second lists.
+     */
+    std::vector<sf::FloatRect> & GetBounds2() { return buffers->bounds2; }
+
+    /**
+     * \brief The objects of the second lists, in the same order as their bounds.
+     */
+    std::vector<Candidate> & GetCandidates() { return buffers->candidates; }
+
+    /**
+     * \brief The grid in which the objects of the second lists are inserted.
+     */
+    SpatialHash & GetGrid() { return buffers->grid; }
+
+private:
+    struct Buffers
+    {
+        std::vector<sf::FloatRect> bounds1;
+        std::vector<sf::FloatRect> bounds2;
+        std::vector<Candidate> candidates;
+        SpatialHash grid;
+    };
+
+    std::unique_ptr<Buffers> buffers;
+
+    static std::vector<std::unique_ptr<Buffers>> unusedBuffers; ///< The pool of buffers given back by destroyed instances.
+};
+
+#endif
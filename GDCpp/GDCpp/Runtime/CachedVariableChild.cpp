@@ -0,0 +1,15 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/CachedVariableChild.h"
+
+gd::Variable & CachedVariableChild::Update(gd::Variable & parentVariable)
+{
+    parent = &parentVariable;
+    child = &parentVariable.GetChild(name);
+    structureVersion = gd::Variable::GetStructureVersion();
+
+    return *child;
+}
@@ -0,0 +1,50 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_CACHEDVARIABLECHILD_H
+#define GDCPP_CACHEDVARIABLECHILD_H
+
+#include "GDCpp/Runtime/String.h"
+#include "GDCore/Project/Variable.h"
+
+/**
+ * \brief Get the child of a variable, remembering the last child returned.
+ *
+ * Used by code generated from events for accessing the children of variables with
+ * names known at the time of the code generation (like "Player.Stats.HP"): when the
+ * same child of the same variable is accessed again, it is returned without looking for it,
+ * unless the structure of variables has changed (see gd::Variable::GetStructureVersion).
+ *
+ * \see VariableCodeGenerationCallbacks
+ * \ingroup GameEngine
+ */
+class GD_API CachedVariableChild
+{
+public:
+    CachedVariableChild(const gd::String & name_) : name(name_), parent(NULL), child(NULL), structureVersion(0) {};
+    virtual ~CachedVariableChild() {};
+
+    /**
+     * \brief Return the child of the variable, creating it if necessary.
+     */
+    gd::Variable & Get(gd::Variable & parentVariable)
+    {
+        if ( &parentVariable == parent && structureVersion == gd::Variable::GetStructureVersion() ) return *child;
+        return Update(parentVariable);
+    }
+
+private:
+    /**
+     * \brief Look for the child of the variable and remember it.
+     */
+    gd::Variable & Update(gd::Variable & parentVariable);
+
+    gd::String name; ///< The name of the child.
+    gd::Variable * parent; ///< The variable passed to the last call to Get.
+    gd::Variable * child; ///< The child returned by the last call to Get.
+    std::size_t structureVersion; ///< The structure version when child was found.
+};
+
+#endif
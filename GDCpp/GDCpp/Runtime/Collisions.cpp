@@ -4,60 +4,116 @@
  * This project is released under the MIT License.
  */
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
 #include "GDCore/Extensions/Builtin/SpriteExtension/Sprite.h"
 #include "GDCore/Project/ImageManager.h"
 #include "GDCpp/Runtime/RuntimeSpriteObject.h"
 #include "GDCpp/Runtime/Collisions.h"
 
-bool PixelPerfectTest( const sf::Sprite& object1, const sf::Sprite& object2, sf::Uint8 AlphaLimit, const sf::Image & object1CollisionMask,  const sf::Image & object2CollisionMask )
+namespace
 {
-    sf::FloatRect intersection;
-    if ( object1.getGlobalBounds().intersects( object2.getGlobalBounds(), intersection ) )
+
+/**
+ * \brief Return true if the inverse transform is only a translation, so that the pixels
+ * of the mask are aligned with the pixels of the scene.
+ */
+bool IsTranslation(const float * matrix)
+{
+    return matrix[0] == 1 && matrix[1] == 0 && matrix[4] == 0 && matrix[5] == 1;
+}
+
+/**
+ * \brief Compute the range [first, last[ of the coordinates in the scene which are inside both masks,
+ * the masks being only translated by offset1 and offset2 (in pixels).
+ */
+void GetAlignedRange(int first, int last, int offset1, int size1, int offset2, int size2, int & rangeFirst, int & rangeLast)
+{
+    rangeFirst = std::max(first, std::max(-offset1, -offset2));
+    rangeLast = std::min(last, std::min(size1-offset1, size2-offset2));
+}
+
+bool AlignedBitmasksCollisionTest(const AlphaBitmask & mask1, const float * matrix1,
+    const AlphaBitmask & mask2, const float * matrix2, int left, int top, int right, int bottom)
+{
+    //Scene pixel (i, j) is the pixel (i+offsetX, j+offsetY) of a mask.
+    int offset1X = std::floor(matrix1[12]);
+    int offset1Y = std::floor(matrix1[13]);
+    int offset2X = std::floor(matrix2[12]);
+    int offset2Y = std::floor(matrix2[13]);
+
+    int first, last, firstRow, lastRow;
+    GetAlignedRange(left, right, offset1X, mask1.GetWidth(), offset2X, mask2.GetWidth(), first, last);
+    GetAlignedRange(top, bottom, offset1Y, mask1.GetHeight(), offset2Y, mask2.GetHeight(), firstRow, lastRow);
+
+    for (int j = firstRow;j<lastRow;++j)
     {
-        //We've got an intersection we need to process the pixels
-        //in that Rect.
+        for (int i = first;i<last;i += 64)
+        {
+            sf::Uint64 bits = mask1.GetBits(i+offset1X, j+offset1Y) & mask2.GetBits(i+offset2X, j+offset2Y);
+            if ( last-i < 64 ) bits &= (sf::Uint64(1) << (last-i)) - 1;
+
+            if ( bits != 0 ) return true;
+        }
+    }
 
-        //Bail out now if AlphaLimit = 0
-        if ( AlphaLimit == 0 ) return true;
+    return false;
+}
 
-        //There are a few hacks here, sometimes the TransformToLocal returns negative points
-        //Or Points outside the image.  We need to check for these as they print to the error console
-        //which is slow, and then return black which registers as a hit.
+}
 
-        sf::Vector2f o1v;
-        sf::Vector2f o2v;
-        //Loop through our pixels
-        for ( int i = intersection.left; i < intersection.left+intersection.width; i++ ) //4ian : Rect now uses width/height.
+bool GD_API AlphaBitmasksCollisionTest(const AlphaBitmask & mask1, const sf::Transform & inverseTransform1,
+    const AlphaBitmask & mask2, const sf::Transform & inverseTransform2, const sf::FloatRect & area)
+{
+    int left = std::floor(area.left);
+    int top = std::floor(area.top);
+    int right = std::ceil(area.left+area.width);
+    int bottom = std::ceil(area.top+area.height);
+
+    const float * matrix1 = inverseTransform1.getMatrix();
+    const float * matrix2 = inverseTransform2.getMatrix();
+    if ( IsTranslation(matrix1) && IsTranslation(matrix2) )
+        return AlignedBitmasksCollisionTest(mask1, matrix1, mask2, matrix2, left, top, right, bottom);
+
+    float width1 = mask1.GetWidth(), height1 = mask1.GetHeight();
+    float width2 = mask2.GetWidth(), height2 = mask2.GetHeight();
+    for (int j = top;j<bottom;++j)
+    {
+        //The transforms are affine: moving to the next pixel of a row of the scene is
+        //always the same move in the masks.
+        sf::Vector2f rowStart1 = inverseTransform1.transformPoint(left, j);
+        sf::Vector2f rowStart2 = inverseTransform2.transformPoint(left, j);
+        for (int i = 0;i<right-left;++i)
         {
-            for ( int j = intersection.top; j < intersection.top+intersection.height; j++ ) //4ian : Rect now uses width/height.
-            {
+            float x1 = rowStart1.x + i*matrix1[0], y1 = rowStart1.y + i*matrix1[1];
+            float x2 = rowStart2.x + i*matrix2[0], y2 = rowStart2.y + i*matrix2[1];
 
-                o1v = object1.getInverseTransform().transformPoint( i, j ); //Creating objects each loop :(
-                o2v = object2.getInverseTransform().transformPoint( i, j );
-
-                //Hack to make sure pixels fall within the Sprite's Image
-                if ( o1v.x > 0 && o1v.y > 0 && o2v.x > 0 && o2v.y > 0 &&
-                        o1v.x < object1CollisionMask.getSize().x && o1v.y < object1CollisionMask.getSize().y &&
-                        o2v.x < object2CollisionMask.getSize().x && o2v.y < object2CollisionMask.getSize().y )
-                {
-                    //If both sprites have opaque pixels at the same point we've got a hit
-                    if (( object1CollisionMask.getPixel( static_cast<int>( o1v.x ), static_cast<int>( o1v.y ) ).a > AlphaLimit ) &&
-                        ( object2CollisionMask.getPixel( static_cast<int>( o2v.x ), static_cast<int>( o2v.y ) ).a > AlphaLimit ) )
-                    {
-                        return true;
-                    }
-                }
+            if ( x1 >= 0 && y1 >= 0 && x1 < width1 && y1 < height1 &&
+                 x2 >= 0 && y2 >= 0 && x2 < width2 && y2 < height2 &&
+                 mask1.IsSet(x1, y1) && mask2.IsSet(x2, y2) )
+            {
+                return true;
             }
         }
-        return false;
     }
+
     return false;
 }
 
 /**
  * Check for collision between two sprite objects
  */
-bool GD_API CheckCollision( const RuntimeSpriteObject * const objet1, const RuntimeSpriteObject * const objet2)
+bool GD_API CheckCollision( const RuntimeSpriteObject * const objet1, const RuntimeSpriteObject * const objet2, sf::Uint8 alphaThreshold)
 {
-    return PixelPerfectTest( objet1->GetCurrentSFMLSprite(), objet2->GetCurrentSFMLSprite(), 1, objet1->GetCurrentSprite().GetSFMLTexture()->image, objet2->GetCurrentSprite().GetSFMLTexture()->image  );
+    const sf::Sprite & sprite1 = objet1->GetCurrentSFMLSprite();
+    const sf::Sprite & sprite2 = objet2->GetCurrentSFMLSprite();
+
+    sf::FloatRect intersection;
+    if ( !sprite1.getGlobalBounds().intersects(sprite2.getGlobalBounds(), intersection) )
+        return false;
+
+    return AlphaBitmasksCollisionTest(
+        objet1->GetCurrentSprite().GetSFMLTexture()->GetAlphaMask(alphaThreshold), sprite1.getInverseTransform(),
+        objet2->GetCurrentSprite().GetSFMLTexture()->GetAlphaMask(alphaThreshold), sprite2.getInverseTransform(),
+        intersection);
 }
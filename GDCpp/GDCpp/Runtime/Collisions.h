@@ -6,16 +6,34 @@
 #ifndef COLLISIONS_H_INCLUDED
 #define COLLISIONS_H_INCLUDED
 #include "GDCpp/Runtime/RuntimeSpriteObject.h"
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+class AlphaBitmask;
 
 /**
  * \brief Pixel perfect collision test between two sprite objects
  * Alpha transparency, rotation and zooms are taken into account.
  *
+ * \param alphaThreshold Pixels having an alpha lower or equal to this value are considered as transparent.
  * \return true if the sprite are overlapping
  *
  * \ingroup GameEngine
  * \ingroup SpriteObjectExtension
  */
-bool GD_API CheckCollision( const RuntimeSpriteObject* const objet1, const RuntimeSpriteObject* const objet2);
+bool GD_API CheckCollision( const RuntimeSpriteObject* const objet1, const RuntimeSpriteObject* const objet2, sf::Uint8 alphaThreshold = 1);
+
+/**
+ * \brief Test if two alpha masks have pixels set at the same position of the scene.
+ *
+ * Each point of the area with integer coordinates is transformed into the coordinates of the masks
+ * using the inverse transforms. When the two masks are only translated, rows are compared 64 pixels at once.
+ *
+ * \param area The part of the scene to be tested, usually the intersection of the bounding boxes.
+ * \return true if a point of the area is set in both masks.
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API AlphaBitmasksCollisionTest(const AlphaBitmask & mask1, const sf::Transform & inverseTransform1,
+    const AlphaBitmask & mask2, const sf::Transform & inverseTransform2, const sf::FloatRect & area);
 
 #endif // COLLISIONS_H_INCLUDED
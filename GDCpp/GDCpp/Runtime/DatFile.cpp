@@ -1,28 +1,94 @@
 #include "GDCpp/Runtime/DatFile.h"
+#include <algorithm>
 #include <iostream>
 #include <stdio.h>
 #include <string.h>
 #include <fstream>
-DatFile::DatFile (void)
+#if defined(WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+/**
+ * Hash of the names of the files (FNV-1a), used to sort and search the entries of DAT files of version 0.2.
+ */
+uint64_t HashName(const std::string & name)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0;i<name.size();i++)
+    {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+}
+
+const std::size_t DatFile::dataAlignment;
+
+DatFile::DatFile (void) :
+    m_entriesV2(NULL),
+    m_names(NULL),
+    m_mappedData(NULL),
+    m_mappedSize(0),
+    m_fileHandle(NULL),
+    m_mappingHandle(NULL)
 {
     m_buffer = NULL;
+    memset (&m_header, 0, sizeof(m_header));
 }
 
 DatFile::~DatFile (void)
+{
+    Close();
+}
+
+void DatFile::Close ()
 {
     if (m_buffer!=NULL)
         delete[] m_buffer;
+    m_buffer = NULL;
+
+    #if defined(WINDOWS)
+    if (m_mappedData != NULL) UnmapViewOfFile(m_mappedData);
+    if (m_mappingHandle != NULL) CloseHandle(m_mappingHandle);
+    if (m_fileHandle != NULL) CloseHandle(m_fileHandle);
+    #else
+    if (m_mappedData != NULL) munmap(const_cast<char*>(m_mappedData), m_mappedSize);
+    #endif
+    m_mappedData = NULL;
+    m_mappedSize = 0;
+    m_mappingHandle = NULL;
+    m_fileHandle = NULL;
+
+    memset (&m_header, 0, sizeof(m_header));
+    m_entries.clear();
+    m_entriesIndices.clear();
+    m_entriesV2 = NULL;
+    m_names = NULL;
+    m_readEntriesV2.clear();
+    m_readNames.clear();
+    m_datfile.clear();
 }
+
 bool DatFile::Create (std::vector<gd::String> files, gd::String directory, gd::String destination)
 {
-    //An file entry in order to push it in the object's std::vector
-    sFileEntry entry;
+    //The file entries, and the names table
+    std::vector<sFileEntryV2> entries;
+    std::string names;
     //An input file stream to read each file included
     std::ifstream file;
     //An output file stream to write our DAT file
     std::ofstream datfile;
-    //The buffer used to read/write the DAT file
-    char buffer[1];
 
     //DATHeader
     //We start by filling it with 0
@@ -30,31 +96,36 @@ bool DatFile::Create (std::vector<gd::String> files, gd::String directory, gd::S
     //Then we copy the ID
     memcpy (m_header.uniqueID, "EXEGD", 5); //EXEcutable GDevelop
     //Then the version
-    memcpy (m_header.version, "0.1", 3);
+    memcpy (m_header.version, "0.2", 3);
     //Then the number of files to include
     m_header.nb_files = files.size();
 
-    //Next, we open each file in orderto create the File Entries Table
+    //Next, we open each file in order to create the File Entries Table
     for (std::size_t i = 0; i<files.size(); i++)
     {
         gd::String fileToOpen = directory + "/" + files[i];
         file.open (fileToOpen.ToLocale().c_str(), std::ifstream::in | std::ifstream::binary);
         if (file.is_open())
         {
+            sFileEntryV2 entry;
             //Filling the FileEntry with 0
-            memset (&entry, 0, sizeof(sFileEntry) );
-            //We keep the file name
-            memcpy (entry.name, files[i].c_str(), strlen ( files[i].c_str() ) );
+            memset (&entry, 0, sizeof(sFileEntryV2) );
+            //We keep the file name in the names table
+            entry.nameHash = HashName(files[i].Raw());
+            entry.nameOffset = names.size();
+            entry.nameLength = files[i].Raw().size();
+            names += files[i].Raw();
             //We calculate its size
             file.seekg (0, std::ios::end);
             entry.size = file.tellg();
-            //Since we don't know exactly its final position in the DAT file, let's use 0
-            entry.offset = 0;
+            entry.uncompressedSize = entry.size;
+            entry.compression = NoCompression;
+            //We store the index of the file until its final position in the DAT file is known
+            entry.offset = i;
             //We finished with this file
             file.close();
 
-            //Finally, we add this File Entry in our std::vector
-            m_entries.push_back(entry);
+            entries.push_back(entry);
         }
         else
         {
@@ -64,39 +135,57 @@ bool DatFile::Create (std::vector<gd::String> files, gd::String directory, gd::S
         }
     }
 
+    //Sort the entries, so that they can be searched by the hashes of their names.
+    std::vector<std::size_t> filesIndices(entries.size());
+    std::sort(entries.begin(), entries.end(), [](const sFileEntryV2 & a, const sFileEntryV2 & b) {
+        return a.nameHash < b.nameHash;
+    });
+    for (std::size_t i=0;i<entries.size();i++)
+        filesIndices[i] = entries[i].offset;
+
     //Now, we know everything about our files, we can update offsets
-    long actual_offset = 0;
-    actual_offset += sizeof(sDATHeader);
-    actual_offset += m_header.nb_files * sizeof(sFileEntry);
-    for (std::size_t i=0;i<m_entries.size();i++)
+    uint32_t namesSize = names.size();
+    uint64_t actual_offset = sizeof(sDATHeader) + sizeof(uint32_t) + entries.size() * sizeof(sFileEntryV2) + names.size();
+    for (std::size_t i=0;i<entries.size();i++)
     {
-        m_entries[i].offset = actual_offset;
-        actual_offset += m_entries[i].size;
+        actual_offset = (actual_offset + dataAlignment - 1) / dataAlignment * dataAlignment;
+        entries[i].offset = actual_offset;
+        actual_offset += entries[i].size;
     }
 
     //And finally, we are writing the DAT file
     datfile.open (destination.ToLocale().c_str(), std::ofstream::out | std::ofstream::binary);
+    if (!datfile.is_open())
+    {
+        std::cout<<"Unable to create "<<destination<<"."<<std::endl;
+        return (false);
+    }
 
     //First, we write the header
     datfile.write ((char*)&m_header, sizeof(sDATHeader) );
+    datfile.write ((char*)&namesSize, sizeof(uint32_t) );
 
-    //Then, the File Entries Table
-    for (std::size_t i=0;i<m_entries.size();i++)
-    {
-        datfile.write ((char*)&m_entries[i], sizeof(sFileEntry) );
-    }
+    //Then, the File Entries Table and the names
+    if (!entries.empty())
+        datfile.write ((char*)&entries[0], entries.size() * sizeof(sFileEntryV2) );
+    datfile.write (names.data(), names.size());
 
     //Finally, we write each file
-    for (std::size_t i = 0; i<m_entries.size(); i++)
+    std::vector<char> buffer(64*1024);
+    for (std::size_t i = 0; i<entries.size(); i++)
     {
-        gd::String fileToOpen = directory + "/" + files[i];
+        //Padding to align the file
+        while (static_cast<uint64_t>(datfile.tellp()) < entries[i].offset)
+            datfile.put(0);
+
+        gd::String fileToOpen = directory + "/" + files[filesIndices[i]];
         file.open (fileToOpen.ToLocale().c_str(), std::ifstream::in | std::ifstream::binary);
         if (file.is_open())
         {
             file.seekg (0, std::ios::beg);
-            while (file.read (buffer, 1))
+            while (file.read (&buffer[0], buffer.size()) || file.gcount() > 0)
             {
-                datfile.write (buffer, 1);
+                datfile.write (&buffer[0], file.gcount());
             }
             file.close();
         }
@@ -112,38 +201,187 @@ bool DatFile::Create (std::vector<gd::String> files, gd::String directory, gd::S
 */
 bool DatFile::Read (gd::String source)
 {
-    bool success = false;
+    Close();
 
     //The input file stream from which we want informations
     std::ifstream datfile;
-    //A file entry in order to push it in the object's std::vector
-    sFileEntry entry;
 
-    //Filling the header with 0
-    memset (&m_header, 0, sizeof(m_header));
     //We open the DAT file to read it
     datfile.open (source.ToLocale(), std::ifstream::in | std::ifstream::binary);
-    if (datfile.is_open())
+    if (!datfile.is_open())
+        return false;
+
+    //Reading the DAT Header
+    datfile.read ((char*)&m_header, sizeof(sDATHeader));
+    if (!datfile || memcmp(m_header.uniqueID, "EXEGD", 5) != 0)
     {
-        //Getting to the Header position
-        datfile.seekg (0, std::ios::beg);
-        //Reading the DAT Header
-        datfile.read ((char*)&m_header, sizeof(sDATHeader));
+        Close();
+        return false;
+    }
+
+    if (memcmp(m_header.version, "0.1", 3) == 0)
+    {
+        Map(source); //If the mapping fails, files will be read when requested.
+
         //Next we are reading each file entry
+        sFileEntry entry;
         for (std::size_t i=0;i<m_header.nb_files;i++)
         {
             //Reading a File Entry
             datfile.read ((char*)&entry, sizeof(sFileEntry));
+            entry.name[sizeof(entry.name)-1] = 0;
             //Pushing it in our std::vector
             m_entries.push_back(entry);
+            m_entriesIndices[gd::String(entry.name)] = i;
+        }
+        if (!datfile)
+        {
+            Close();
+            return false;
         }
-        //Since all seems ok, we keep the DAT file name
-        m_datfile = source;
-        success = true;
     }
-    //Closing the DAT file
-    datfile.close();
-    return success;
+    else if (memcmp(m_header.version, "0.2", 3) == 0)
+    {
+        uint32_t namesSize = 0;
+        datfile.read ((char*)&namesSize, sizeof(uint32_t));
+
+        std::size_t entriesOffset = sizeof(sDATHeader) + sizeof(uint32_t);
+        std::size_t namesOffset = entriesOffset + m_header.nb_files * sizeof(sFileEntryV2);
+        if (Map(source) && namesOffset + namesSize <= m_mappedSize)
+        {
+            //The entries and the names are used directly from the mapped DAT file.
+            m_entriesV2 = reinterpret_cast<const sFileEntryV2*>(m_mappedData + entriesOffset);
+            m_names = m_mappedData + namesOffset;
+        }
+        else
+        {
+            m_readEntriesV2.resize(m_header.nb_files);
+            m_readNames.resize(namesSize);
+            if (!m_readEntriesV2.empty())
+                datfile.read ((char*)&m_readEntriesV2[0], m_readEntriesV2.size() * sizeof(sFileEntryV2));
+            if (!m_readNames.empty())
+                datfile.read (&m_readNames[0], m_readNames.size());
+
+            m_entriesV2 = m_readEntriesV2.empty() ? NULL : &m_readEntriesV2[0];
+            m_names = m_readNames.data();
+        }
+
+        if (!datfile)
+        {
+            Close();
+            return false;
+        }
+
+        //Check once that the names of the entries are in the names table, so that they can be compared without checks.
+        for (std::size_t i=0;i<m_header.nb_files;i++)
+        {
+            if (static_cast<uint64_t>(m_entriesV2[i].nameOffset) + m_entriesV2[i].nameLength > namesSize)
+            {
+                std::cout << "Invalid names table in resource file " << source << std::endl;
+                Close();
+                return false;
+            }
+        }
+    }
+    else
+    {
+        std::cout << "Unsupported version of resource file " << source << std::endl;
+        Close();
+        return false;
+    }
+
+    //Since all seems ok, we keep the DAT file name
+    m_datfile = source;
+    return true;
+}
+
+bool DatFile::Map (const gd::String & source)
+{
+    #if defined(WINDOWS)
+    HANDLE file = CreateFileW(source.ToWide().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void * data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_mappedData = static_cast<const char*>(data);
+    m_mappedSize = size.QuadPart;
+    return true;
+    #else
+    int file = open(source.ToLocale().c_str(), O_RDONLY);
+    if (file == -1) return false;
+
+    struct stat fileStatus;
+    if (fstat(file, &fileStatus) != 0 || fileStatus.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void * data = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); //The mapping stays valid after the file is closed.
+    if (data == MAP_FAILED) return false;
+
+    m_mappedData = static_cast<const char*>(data);
+    m_mappedSize = fileStatus.st_size;
+    return true;
+    #endif
+}
+
+bool DatFile::FindEntry (const gd::String & filename, sFileEntryV2 & entry) const
+{
+    if (m_entriesV2 != NULL)
+    {
+        //Search the entries having the same name hash, and then the entry having the same name.
+        uint64_t hash = HashName(filename.Raw());
+        const sFileEntryV2 * end = m_entriesV2 + m_header.nb_files;
+        const sFileEntryV2 * it = std::lower_bound(m_entriesV2, end, hash, [](const sFileEntryV2 & e, uint64_t h) {
+            return e.nameHash < h;
+        });
+        for (;it != end && it->nameHash == hash;++it)
+        {
+            if (filename.Raw().compare(0, std::string::npos, m_names + it->nameOffset, it->nameLength) == 0)
+            {
+                entry = *it;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::unordered_map<gd::String, std::size_t>::const_iterator it = m_entriesIndices.find(filename);
+    if (it == m_entriesIndices.end())
+        return false;
+
+    const sFileEntry & entryV1 = m_entries[it->second];
+    memset (&entry, 0, sizeof(sFileEntryV2));
+    entry.offset = entryV1.offset;
+    entry.size = entryV1.size;
+    entry.uncompressedSize = entryV1.size;
+    entry.compression = NoCompression;
+    return true;
 }
 
 ////////////////////////////////////////////////////////////
@@ -151,19 +389,60 @@ bool DatFile::Read (gd::String source)
 ////////////////////////////////////////////////////////////
 bool DatFile::ContainsFile(const gd::String & filename)
 {
-    if ( m_header.nb_files != m_entries.size() )
-        return false;
+    sFileEntryV2 entry;
+    return FindEntry(filename, entry);
+}
 
-    for (std::size_t i=0; i<m_header.nb_files;i++)
+DatFile::FileData DatFile::GetFileData (const gd::String & filename)
+{
+    sFileEntryV2 entry;
+    if (!FindEntry(filename, entry))
+        return FileData();
+
+    if (entry.compression != NoCompression)
     {
-        if (gd::String(m_entries[i].name) == filename)
-            return true;
+        cout << "Unsupported compression for " << filename << " in " << m_datfile << endl;
+        return FileData();
     }
 
-    return false;
+    if (m_mappedData != NULL)
+    {
+        if (entry.offset + entry.size > m_mappedSize)
+        {
+            cout << "Invalid file entry for " << filename << " in " << m_datfile << endl;
+            return FileData();
+        }
+
+        return FileData(m_mappedData + entry.offset, entry.size);
+    }
+
+    char * buffer = ReadEntry(entry, filename);
+    return buffer ? FileData(buffer, entry.size) : FileData();
 }
 
 char* DatFile::GetFile (gd::String filename)
+{
+    sFileEntryV2 entry;
+    if (!FindEntry(filename, entry))
+        return (NULL); //There is no such file in our DAT file
+
+    if (m_mappedData == NULL)
+        return ReadEntry(entry, filename);
+
+    FileData file = GetFileData(filename);
+    if (file.data == NULL)
+        return (NULL);
+
+    //Cleaning properly an ancient file loaded
+    if (m_buffer != NULL)
+        delete[] m_buffer;
+
+    m_buffer = new char[file.size];
+    memcpy(m_buffer, file.data, file.size);
+    return (m_buffer);
+}
+
+char* DatFile::ReadEntry (const sFileEntryV2 & entry, const gd::String & filename)
 {
     //The input file stream from which we want information
     std::ifstream datfile;
@@ -175,53 +454,39 @@ char* DatFile::GetFile (gd::String filename)
         m_buffer = NULL;
     }
 
-    //First, we have to find the file needed
-    for (std::size_t i=0; i<m_header.nb_files;i++)
+    if (entry.compression != NoCompression)
     {
-        //If we found it
-        if(gd::String(m_entries[i].name) == filename)
-        {
-            //We are allocating memory to the buffer
-            m_buffer = new char[(m_entries[i].size)];
-            //Simple error catch
-            if (m_buffer==NULL)
-            {
-                cout << "Unable to allocate a buffer of length " << (m_entries[i].size) << " when loading " << filename << endl;
-                return (NULL);
-            }
+        cout << "Unsupported compression for " << filename << " in " << m_datfile << endl;
+        return (NULL);
+    }
 
-            //Opening the DAT file ot read the file datas needed
-            datfile.open (m_datfile.ToLocale().c_str(), std::ifstream::in | std::ifstream::binary);
-            if (datfile.is_open())
-            {
-                //Going to the right position
-                datfile.seekg (m_entries[i].offset, std::ios::beg);
-                //Reading
-                datfile.read (m_buffer, m_entries[i].size);
-                //We can close the DAT file
-                datfile.close();
-                //Returning the buffer
-                cout << "Successfully loaded " << filename << endl;
-                return (m_buffer);
-            }
-            cout << "Unable to open file " << m_datfile << " when loading " << filename << endl;
-        }
+    //We are allocating memory to the buffer
+    m_buffer = new char[(entry.size)];
+
+    //Opening the DAT file ot read the file datas needed
+    datfile.open (m_datfile.ToLocale().c_str(), std::ifstream::in | std::ifstream::binary);
+    if (datfile.is_open())
+    {
+        //Going to the right position
+        datfile.seekg (entry.offset, std::ios::beg);
+        //Reading
+        datfile.read (m_buffer, entry.size);
+        //We can close the DAT file
+        datfile.close();
+        //Returning the buffer
+        cout << "Successfully loaded " << filename << endl;
+        return (m_buffer);
     }
-    //Finally, there is no such file in our DAT file
+
+    cout << "Unable to open file " << m_datfile << " when loading " << filename << endl;
     return (NULL);
 }
 
 long int DatFile::GetFileSize (gd::String filename)
 {
-    //First, we have to find the file needed
-    for (std::size_t i=0; i<m_header.nb_files;i++)
-    {
-        //If we found it
-        if (gd::String(m_entries[i].name) == filename)
-        {
-            //Returning the size of the file found
-            return (m_entries[i].size);
-        }
-    }
+    sFileEntryV2 entry;
+    if (FindEntry(filename, entry))
+        return (entry.uncompressedSize); //Returning the size of the file found
+
     return (0);
 }
@@ -7,7 +7,9 @@
 #ifndef DATFILE_H
 #define DATFILE_H
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "GDCpp/Runtime/String.h"
 
@@ -26,7 +28,7 @@ struct sDATHeader
 };
 
 /**
- * \brief Internal class related to DatFile
+ * \brief Internal class related to DatFile: a file entry of a DAT file of version 0.1
  *
  * \ingroup ResourcesManagement
  */
@@ -37,26 +39,125 @@ struct sFileEntry
     long offset; /// Offset, in the DAT file where the file is
 };
 
+/**
+ * \brief Internal class related to DatFile: a file entry of a DAT file of version 0.2
+ *
+ * The entries are sorted by the hash of their names, and the names are stored
+ * after the entries, in a names table.
+ *
+ * \ingroup ResourcesManagement
+ */
+struct sFileEntryV2
+{
+    uint64_t nameHash; /// Hash of the name of the data file (FNV-1a of its UTF8 bytes)
+    uint64_t offset; /// Offset, in the DAT file where the file is (multiple of DatFile::dataAlignment)
+    uint64_t size; /// Size of the data file, as stored in the DAT file
+    uint64_t uncompressedSize; /// Size of the data file once uncompressed
+    uint32_t nameOffset; /// Offset, in the names table, of the name of the data file
+    uint32_t nameLength; /// Length, in bytes, of the name of the data file
+    uint32_t compression; /// Compression of the data file (see DatFile::Compression)
+    uint32_t reserved; /// Unused, 0
+};
+
 /**
  * \brief Internal class used to create and access "DAT files".
  *
+ * DAT files of version 0.2 (the ones created by Create) are made of the header, the
+ * number of bytes of the names table (as an uint32_t), the file entries (see sFileEntryV2),
+ * the names table and then the files, each one starting at an offset aligned on dataAlignment bytes.
+ *
+ * When possible, the DAT file is mapped in memory, so that reading it does not load
+ * the files it contains, and these files can be accessed without copies (see GetFileData).
+ * Otherwise, files are read when requested. DAT files of version 0.1 can still be read.
+ *
  * \ingroup ResourcesManagement
  */
 class GD_API DatFile
 {
-private :
-    gd::String m_datfile; /// name of the DAT file
-    sDATHeader m_header; /// file header
-    std::vector<sFileEntry> m_entries; /// vector of files entries
-    char* m_buffer; /// Buffer pointing on a file in memory
 public :
+    /**
+     * \brief The compressions of the files stored in a DAT file.
+     * \note No compression is supported for now: other values are reserved for compressed
+     * files, which are reported as not being readable.
+     */
+    enum Compression
+    {
+        NoCompression = 0
+    };
+
+    /**
+     * \brief The content of a file stored in a DAT file.
+     */
+    struct FileData
+    {
+        FileData() : data(NULL), size(0) {};
+        FileData(const char * data_, std::size_t size_) : data(data_), size(size_) {};
+
+        const char * data; ///< The content of the file, or NULL if it can't be read.
+        std::size_t size; ///< The size of the file, in bytes.
+    };
+
+    static const std::size_t dataAlignment = 16; ///< The alignment, in bytes, of the files stored in a DAT file of version 0.2.
+
     DatFile (void);
     ~DatFile (void);
     bool Create (std::vector<gd::String> files, gd::String directory, gd::String destination);
     bool ContainsFile(const gd::String & filename);
     bool Read (gd::String source);
+
+    /**
+     * \brief Return a copy of the content of the file, valid until the next call to GetFile
+     * or GetFileData, or NULL if the file can't be read.
+     */
     char* GetFile (gd::String filename);
     long int GetFileSize (gd::String filename);
+
+    /**
+     * \brief Return the content of the file.
+     *
+     * If the DAT file is mapped in memory, the content is not copied and stays valid
+     * until the DatFile is destroyed or reads another DAT file. Otherwise, the content
+     * is read in a buffer which is valid until the next call to GetFile or GetFileData.
+     */
+    FileData GetFileData (const gd::String & filename);
+
+    /**
+     * \brief Return true if the DAT file is mapped in memory. In this case, GetFileData
+     * can be called from several threads at once.
+     */
+    bool IsMapped() const { return m_mappedData != NULL; }
+
+private :
+    DatFile(const DatFile &) = delete;
+    DatFile & operator=(const DatFile &) = delete;
+
+    /**
+     * \brief Find the entry of the file, converted to a sFileEntryV2 for DAT files of version 0.1.
+     * \return false if the file is not in the DAT file.
+     */
+    bool FindEntry (const gd::String & filename, sFileEntryV2 & entry) const;
+
+    /**
+     * \brief Read the content of an entry in m_buffer.
+     */
+    char* ReadEntry (const sFileEntryV2 & entry, const gd::String & filename);
+
+    bool Map (const gd::String & source);
+    void Close ();
+
+    gd::String m_datfile; /// name of the DAT file
+    sDATHeader m_header; /// file header
+    std::vector<sFileEntry> m_entries; /// vector of files entries (version 0.1)
+    std::unordered_map<gd::String, std::size_t> m_entriesIndices; /// index of the entry of each file (version 0.1)
+    const sFileEntryV2 * m_entriesV2; /// files entries, sorted by their name hashes (version 0.2)
+    const char * m_names; /// names table (version 0.2)
+    std::vector<sFileEntryV2> m_readEntriesV2; /// files entries, if the DAT file is not mapped (version 0.2)
+    std::string m_readNames; /// names table, if the DAT file is not mapped (version 0.2)
+    const char * m_mappedData; /// DAT file mapped in memory, or NULL
+    std::size_t m_mappedSize; /// size of the DAT file mapped in memory
+    void * m_fileHandle; /// handle of the mapped DAT file (Windows only)
+    void * m_mappingHandle; /// handle of the mapping of the DAT file (Windows only)
+    char* m_buffer; /// Buffer pointing on a file in memory
 };
 
 #endif // DATFILE_H
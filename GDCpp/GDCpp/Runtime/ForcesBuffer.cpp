@@ -0,0 +1,44 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ForcesBuffer.h"
+
+void ForcesBuffer::Clear()
+{
+    count = 0;
+    otherForces.clear();
+    totalX = 0;
+    totalY = 0;
+}
+
+void ForcesBuffer::Update(float elapsedTime)
+{
+    totalX = 0;
+    totalY = 0;
+    for (std::size_t i = 0;i<count;)
+    {
+        Force & force = GetForce(i);
+        float x = force.GetX();
+        float y = force.GetY();
+        if ( force.GetClearing() == 0 || x*x+y*y <= 0.001f*0.001f )
+        {
+            //Move the last force at the position of the removed force.
+            if ( i != count-1 ) force = GetForce(count-1);
+            if ( count > inlineForcesCount ) otherForces.pop_back();
+            count--;
+        }
+        else
+        {
+            //Reducing the length of the force is scaling its coordinates.
+            float factor = 1 - ( 1 - force.GetClearing() ) * elapsedTime;
+            force.SetX(x*factor);
+            force.SetY(y*factor);
+
+            totalX += force.GetX();
+            totalY += force.GetY();
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_FORCESBUFFER_H
+#define GDCPP_FORCESBUFFER_H
+
+#include <vector>
+#include "GDCpp/Runtime/Force.h"
+
+/**
+ * \brief The forces applied to an object, with their resultant.
+ *
+ * The first forces are stored inside the buffer, so that adding a few forces to an object at each
+ * frame does not allocate memory. The resultant of the forces is updated when a force is added
+ * and computed again when the forces are updated (see Update), so that getting it is done in constant time.
+ *
+ * \see RuntimeObject
+ * \ingroup GameEngine
+ */
+class GD_API ForcesBuffer
+{
+public:
+    ForcesBuffer() : count(0), totalX(0), totalY(0) {};
+    virtual ~ForcesBuffer() {};
+
+    /**
+     * \brief Add a force.
+     */
+    void Add(const Force & force)
+    {
+        if ( count < inlineForcesCount )
+            inlineForces[count] = force;
+        else
+            otherForces.push_back(force);
+
+        count++;
+        totalX += force.GetX();
+        totalY += force.GetY();
+    }
+
+    /**
+     * \brief Remove all the forces.
+     */
+    void Clear();
+
+    /**
+     * \brief Reduce the length of the forces according to their clearing, and remove the forces
+     * which are finished (instant forces, or forces with a null length).
+     *
+     * \param elapsedTime The time elapsed since the last update, in seconds.
+     */
+    void Update(float elapsedTime);
+
+    /**
+     * \brief Return the number of forces.
+     */
+    std::size_t GetCount() const { return count; }
+
+    /**
+     * \brief Return the force at the specified index.
+     */
+    const Force & Get(std::size_t index) const { return index < inlineForcesCount ? inlineForces[index] : otherForces[index-inlineForcesCount]; }
+
+    /**
+     * \brief Return the sum of the X coordinates of the forces.
+     */
+    float GetTotalX() const { return totalX; }
+
+    /**
+     * \brief Return the sum of the Y coordinates of the forces.
+     */
+    float GetTotalY() const { return totalY; }
+
+private:
+    Force & GetForce(std::size_t index) { return index < inlineForcesCount ? inlineForces[index] : otherForces[index-inlineForcesCount]; }
+
+    static const std::size_t inlineForcesCount = 4;
+
+    Force inlineForces[inlineForcesCount]; ///< The first forces.
+    std::vector<Force> otherForces; ///< The forces which don't fit in inlineForces.
+    std::size_t count; ///< The number of forces.
+    float totalX; ///< The sum of the X coordinates of the forces.
+    float totalY; ///< The sum of the Y coordinates of the forces.
+};
+
+#endif
@@ -9,56 +9,218 @@
 
 void ObjInstancesHolder::AddObject(const RuntimeObjSPtr & object)
 {
-    objectsInstances[object->GetName()].push_back(object);
-    objectsRawPointersInstances[object->GetName()].push_back(object.get());
+    //An object removed and added again during an iteration is still in allObjects.
+    bool waitingForRemoval = IsInAllObjects(object.get()) && !IsInLists(object.get());
+
+    ObjectsList & list = GetList(object->GetNameId());
+    object->instancesListId = object->GetNameId();
+    object->instancesListSlot = list.objects.size();
+    list.objects.push_back(object);
+    list.rawPointers.push_back(object.get());
+
+    if ( waitingForRemoval )
+    {
+        objectsToBeRemovedCount--;
+        return;
+    }
+
+    object->allInstancesSlot = allObjects.size();
+    allObjects.push_back(object);
+
+    for (std::size_t i = 0;i<object->behaviors.size();++i)
+        behaviorsRegistry.Add(object->behaviors[i].get());
 }
 
 std::vector<RuntimeObject*> ObjInstancesHolder::GetObjectsRawPointers(const gd::String & name)
 {
-    return objectsRawPointersInstances[name];
+    return GetList(RuntimeNamesTable::Get()->GetObjectNameId(name)).rawPointers;
 }
 
-void ObjInstancesHolder::ObjectNameHasChanged(RuntimeObject * object)
+std::vector<RuntimeObject*> ObjInstancesHolder::GetObjectsRawPointers(ObjectNameId nameId)
+{
+    return GetList(nameId).rawPointers;
+}
+
+bool ObjInstancesHolder::IsInLists(const RuntimeObject * object) const
+{
+    return object->instancesListId < lists.size() &&
+        object->instancesListSlot < lists[object->instancesListId].rawPointers.size() &&
+        lists[object->instancesListId].rawPointers[object->instancesListSlot] == object;
+}
+
+bool ObjInstancesHolder::IsInAllObjects(const RuntimeObject * object) const
+{
+    return object->allInstancesSlot < allObjects.size() &&
+        allObjects[object->allInstancesSlot].get() == object;
+}
+
+RuntimeObjSPtr ObjInstancesHolder::RemoveFromList(RuntimeObject * object)
 {
-    std::shared_ptr<RuntimeObject> theObject; //We need the object to keep alive.
+    ObjectsList & list = lists[object->instancesListId];
+    std::size_t slot = object->instancesListSlot;
+    RuntimeObjSPtr removedObject = list.objects[slot];
+
+    object->instancesListId = gd::String::npos;
+    object->instancesListSlot = gd::String::npos;
+
+    //Leave the position empty: it is removed when the list is accessed again.
+    list.objects[slot].reset();
+    list.rawPointers[slot] = NULL;
+    list.removedCount++;
+
+    return removedObject;
+}
+
+void ObjInstancesHolder::RemoveFromAllObjects(RuntimeObject * object)
+{
+    for (std::size_t j = 0;j<object->behaviors.size();++j)
+        behaviorsRegistry.Remove(object->behaviors[j].get());
+
+    std::size_t slot = object->allInstancesSlot;
+    object->allInstancesSlot = gd::String::npos;
+    allObjects[slot].reset(); //The position is removed by the next call to GetAllObjects or BeginIteration.
+    emptySlotsCount++;
+}
+
+void ObjInstancesHolder::CompactList(ObjectsList & list)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0;i<list.rawPointers.size();++i)
+    {
+        if ( !list.rawPointers[i] ) continue;
+
+        if ( i != count )
+        {
+            list.objects[count] = std::move(list.objects[i]);
+            list.rawPointers[count] = list.rawPointers[i];
+            list.rawPointers[count]->instancesListSlot = count;
+        }
+        count++;
+    }
+
+    list.objects.resize(count);
+    list.rawPointers.resize(count);
+    list.removedCount = 0;
+}
 
-    //Find and erase the object from the object lists.
-    for (std::unordered_map<gd::String, RuntimeObjList>::iterator it = objectsInstances.begin() ; it != objectsInstances.end(); ++it )
+void ObjInstancesHolder::RemoveObjectsNotInLists()
+{
+    //Behaviors are removed first, as objects can be destroyed when removed from allObjects.
+    std::size_t count = 0;
+    for (std::size_t i = 0;i<allObjects.size();++i)
     {
-        RuntimeObjList & list = it->second;
-        for (std::size_t i = 0;i<list.size();++i)
+        RuntimeObject * object = allObjects[i].get();
+        if ( !object ) continue;
+        if ( !IsInLists(object) )
+        {
+            object->allInstancesSlot = gd::String::npos;
+            for (std::size_t j = 0;j<object->behaviors.size();++j)
+                behaviorsRegistry.Remove(object->behaviors[j].get());
+
+            continue;
+        }
+
+        if ( i != count )
         {
-            if ( list[i].get() == object )
-            {
-                theObject = list[i];
-                list.erase(list.begin()+i);
-                break;
-            }
+            object->allInstancesSlot = count;
+            allObjects[count] = std::move(allObjects[i]);
         }
+        count++;
     }
-    //Find and erase the object from the object raw pointers lists.
-    for (std::unordered_map<gd::String, std::vector<RuntimeObject*> >::iterator it = objectsRawPointersInstances.begin() ; it != objectsRawPointersInstances.end(); ++it )
+
+    allObjects.resize(count);
+    objectsToBeRemovedCount = 0;
+    emptySlotsCount = 0;
+}
+
+void ObjInstancesHolder::RemoveObject(const RuntimeObjSPtr & object)
+{
+    if ( !IsInLists(object.get()) ) return;
+
+    RuntimeObjSPtr removedObject = RemoveFromList(object.get()); //Keep the object alive until it is removed from allObjects.
+    if ( iterationsCount == 0 )
+        RemoveFromAllObjects(removedObject.get());
+    else //allObjects is being iterated: the object will be removed by EndIteration.
+        objectsToBeRemovedCount++;
+}
+
+void ObjInstancesHolder::RemoveObjects(const gd::String & name)
+{
+    ObjectsList & list = GetList(RuntimeNamesTable::Get()->GetObjectNameId(name));
+    for (std::size_t i = 0;i<list.rawPointers.size();++i)
     {
-        std::vector<RuntimeObject*> & associatedList = it->second;
-        associatedList.erase(std::remove(associatedList.begin(), associatedList.end(), object), associatedList.end());
+        RuntimeObject * object = list.rawPointers[i];
+        object->instancesListId = gd::String::npos;
+        object->instancesListSlot = gd::String::npos;
+        if ( iterationsCount == 0 ) RemoveFromAllObjects(object);
     }
+    if ( iterationsCount > 0 ) //allObjects is being iterated: the objects will be removed by EndIteration.
+        objectsToBeRemovedCount += list.rawPointers.size();
+
+    //The objects are destroyed once they are removed from allObjects and from the list.
+    list.objects.clear();
+    list.rawPointers.clear();
+}
+
+void ObjInstancesHolder::EndIteration()
+{
+    if ( iterationsCount > 0 ) iterationsCount--;
+    if ( iterationsCount > 0 || objectsToBeRemovedCount == 0 ) return;
+
+    RemoveObjectsNotInLists();
+}
+
+void ObjInstancesHolder::Clear()
+{
+    lists.clear();
+    allObjects.clear();
+    objectsToBeRemovedCount = 0;
+    emptySlotsCount = 0;
+    behaviorsRegistry.Clear();
+}
+
+void ObjInstancesHolder::StepBehaviorsPreEvents(RuntimeScene & scene)
+{
+    BeginIteration();
+    behaviorsRegistry.StepPreEvents(scene);
+    EndIteration();
+}
+
+void ObjInstancesHolder::StepBehaviorsPostEvents(RuntimeScene & scene)
+{
+    BeginIteration();
+    behaviorsRegistry.StepPostEvents(scene);
+    EndIteration();
+}
+
+void ObjInstancesHolder::ObjectNameHasChanged(RuntimeObject * object)
+{
+    if ( !IsInLists(object) ) return;
 
-    AddObject(theObject);
+    //Move the object from its list to the list of objects having its new name (it stays in allObjects).
+    RuntimeObjSPtr theObject = RemoveFromList(object); //We need the object to keep alive.
+    ObjectsList & list = GetList(object->GetNameId());
+    object->instancesListId = object->GetNameId();
+    object->instancesListSlot = list.objects.size();
+    list.objects.push_back(theObject);
+    list.rawPointers.push_back(object);
 }
 
 void ObjInstancesHolder::Init(const ObjInstancesHolder & other)
 {
-    objectsInstances.clear();
-    objectsRawPointersInstances.clear();
-    for (std::unordered_map<gd::String, RuntimeObjList>::const_iterator it = other.objectsInstances.begin() ;
-        it != other.objectsInstances.end(); ++it )
+    Clear();
+    iterationsCount = 0;
+    for (std::size_t i = 0;i<other.allObjects.size();++i)
     {
-        for (std::size_t i = 0;i<it->second.size();++i) //We need to really copy the objects
-            AddObject( std::shared_ptr<RuntimeObject>(it->second[i]->Clone()) );
+        if ( other.allObjects[i] && other.IsInLists(other.allObjects[i].get()) ) //Skip objects being removed.
+            AddObject( std::shared_ptr<RuntimeObject>(other.allObjects[i]->Clone()) ); //We need to really copy the objects
     }
 }
 
-ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder & other)
+ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder & other) :
+    objectsToBeRemovedCount(0),
+    emptySlotsCount(0),
+    iterationsCount(0)
 {
     Init(other);
 }
@@ -2,14 +2,18 @@
 #define OBJINSTANCESHOLDER_H
 
 #include <algorithm>
+#include <deque>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <unordered_map>
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+#include "GDCpp/Runtime/BehaviorsRegistry.h"
 
 class RuntimeObject;
+class RuntimeScene;
 
 typedef std::vector < std::shared_ptr<RuntimeObject> > RuntimeObjList;
 typedef std::shared_ptr<RuntimeObject> RuntimeObjSPtr;
@@ -17,6 +21,19 @@ typedef std::shared_ptr<RuntimeObject> RuntimeObjSPtr;
 /**
  * \brief Contains lists of objects classified by the name of the objects.
  *
+ * Lists are indexed by the identifiers of the names of the objects (see RuntimeNamesTable),
+ * so that events generated code can get them without any string lookup.
+ *
+ * Each object stores the position it has in the lists of the container, so that
+ * removing an object or changing its name is done in constant time: the position of the object
+ * is left empty, and the empty positions are removed in a single pass the next time the list is
+ * accessed (see GetObjects and GetAllObjects). The objects stay in the order they were added in (an object whose name has changed
+ * goes at the end of the list of its new name), which is the order used for picking objects in
+ * events and for sorting objects having the same Z order.
+ *
+ * The behaviors of the objects are also kept in a BehaviorsRegistry, so that they are updated
+ * type by type.
+ *
  * \see RuntimeScene
  * \ingroup GameEngine
  */
@@ -26,7 +43,7 @@ public:
     /**
      * \brief Default constructor
      */
-    ObjInstancesHolder() {};
+    ObjInstancesHolder() : objectsToBeRemovedCount(0), emptySlotsCount(0), iterationsCount(0) {};
 
     /**
      * \brief Copy constructor
@@ -51,10 +68,20 @@ public:
 
     /**
      * \brief Get all objects with the specified name
+     * \warning Objects removed while the returned list is used are replaced by null pointers
+     * in it, until the next call to GetObjects.
      */
     inline const RuntimeObjList & GetObjects(const gd::String & name)
     {
-        return objectsInstances[name];
+        return GetList(RuntimeNamesTable::Get()->GetObjectNameId(name)).objects;
+    }
+
+    /**
+     * \brief Get all objects with the specified name identifier
+     */
+    inline const RuntimeObjList & GetObjects(ObjectNameId nameId)
+    {
+        return GetList(nameId).objects;
     }
 
     /**
@@ -63,49 +90,49 @@ public:
     std::vector<RuntimeObject*> GetObjectsRawPointers(const gd::String & name);
 
     /**
-     * \brief Get a list of all objects contained.
+     * \brief Get a "raw pointers" list to objects with the specified name identifier
      */
-    inline RuntimeObjList GetAllObjects()
-    {
-        RuntimeObjList objList;
+    std::vector<RuntimeObject*> GetObjectsRawPointers(ObjectNameId nameId);
 
-        for (std::unordered_map<gd::String, RuntimeObjList>::iterator it = objectsInstances.begin() ; it != objectsInstances.end(); ++it )
-            copy(it->second.begin(), it->second.end(), back_inserter(objList));
-
-        return objList;
+    /**
+     * \brief Get a list of all objects contained, in the order they were added in.
+     *
+     * The list is maintained when objects are added or removed, so it is not
+     * copied. Objects added while iterating on it are appended at the end of the list:
+     * iterate using indices and store the size before the loop to skip them.
+     *
+     * The empty positions left by the objects removed since the last call are removed from the list.
+     * \warning Objects removed while the returned list is used, outside of an iteration, are replaced by
+     * null pointers in it, until the next call to GetAllObjects.
+     *
+     * \see BeginIteration
+     */
+    inline const RuntimeObjList & GetAllObjects()
+    {
+        if ( emptySlotsCount > 0 && iterationsCount == 0 ) RemoveObjectsNotInLists();
+        return allObjects;
     }
 
     /**
      * \brief Remove an object
      *
+     * Outside of an iteration (see BeginIteration), the object and its behaviors are immediately
+     * removed, in constant time: its position in the list of all objects is left empty until the
+     * next call to GetAllObjects or BeginIteration.
+     *
      * \warning During the game, do not directly remove an object using this function, but make its name empty instead. Example:
      * \code
      * myObject->SetName(""); //The scene will take care of deleting the object
      * scene.objectsInstances.ObjectNameHasChanged(myObject);
      * \endcode
      */
-    inline void RemoveObject(const RuntimeObjSPtr & object)
-    {
-        for (std::unordered_map<gd::String, RuntimeObjList>::iterator it = objectsInstances.begin() ; it != objectsInstances.end(); ++it )
-        {
-            RuntimeObjList & associatedList = it->second;
-            associatedList.erase(std::remove(associatedList.begin(), associatedList.end(), object), associatedList.end());
-        }
-        for (std::unordered_map<gd::String, std::vector<RuntimeObject*> >::iterator it = objectsRawPointersInstances.begin() ; it != objectsRawPointersInstances.end(); ++it )
-        {
-            std::vector<RuntimeObject*> & associatedList = it->second;
-            associatedList.erase(std::remove(associatedList.begin(), associatedList.end(), object.get()), associatedList.end());
-        }
-    }
+    void RemoveObject(const RuntimeObjSPtr & object);
 
     /**
      * \brief Remove an entire list of object with a given name
+     * \note This is done in a time proportional to the number of objects removed.
      */
-    inline void RemoveObjects(const gd::String & name)
-    {
-        objectsInstances[name].clear();
-        objectsRawPointersInstances[name].clear();
-    }
+    void RemoveObjects(const gd::String & name);
 
     /**
      * \brief To be called when an object has changed its name.
@@ -115,18 +142,118 @@ public:
     /**
      * \brief Clear the container.
      * \note All objects contained inside are destroyed.
+     * \warning Must not be called while the list of all objects is iterated.
      */
-    inline void Clear()
+    void Clear();
+
+    /**
+     * \brief To be called before iterating on the list returned by GetAllObjects.
+     *
+     * Until the matching call to EndIteration, objects removed from the container are still
+     * kept in the list of all objects (they are removed from the lists of objects by name only)
+     * so that indices are stable during the iteration. An object removed and added again during
+     * the iteration keeps its position in the list of all objects.
+     */
+    inline void BeginIteration()
     {
-        objectsInstances.clear();
-        objectsRawPointersInstances.clear();
+        if ( emptySlotsCount > 0 && iterationsCount == 0 ) RemoveObjectsNotInLists();
+        iterationsCount++;
     }
 
+    /**
+     * \brief To be called after the iteration on the list returned by GetAllObjects.
+     *
+     * The objects removed during the iteration are then removed from the list of all objects,
+     * in a single pass preserving the order of the remaining objects.
+     */
+    void EndIteration();
+
+    /**
+     * \brief Call the behaviors of all the objects so that they do their work before events.
+     *
+     * Behaviors are updated type by type (see BehaviorsRegistry), in an iteration on the objects
+     * (see BeginIteration) so that they can remove objects.
+     */
+    void StepBehaviorsPreEvents(RuntimeScene & scene);
+
+    /**
+     * \brief Call the behaviors of all the objects so that they do their work after events.
+     * \see StepBehaviorsPreEvents
+     */
+    void StepBehaviorsPostEvents(RuntimeScene & scene);
+
+    /**
+     * \brief Return the registry containing the behaviors of all the objects, grouped by type.
+     */
+    const BehaviorsRegistry & GetBehaviorsRegistry() const { return behaviorsRegistry; }
+
 private:
+    /**
+     * \brief The objects having the same name, stored with shared pointers and with raw pointers.
+     * Objects are at the same position in both lists.
+     */
+    struct ObjectsList
+    {
+        ObjectsList() : removedCount(0) {};
+
+        RuntimeObjList objects;
+        std::vector<RuntimeObject*> rawPointers;
+        std::size_t removedCount; ///< The number of empty positions left by removed objects.
+    };
+
     void Init(const ObjInstancesHolder & other);
 
-    std::unordered_map<gd::String, RuntimeObjList > objectsInstances; ///< The list of all objects, classified by name
-    std::unordered_map<gd::String, std::vector<RuntimeObject*> > objectsRawPointersInstances; ///< Clones of the objectsInstances lists, but with raw pointers instead.
+    /**
+     * \brief Return the list of objects with the given name identifier, creating it if necessary.
+     * The empty positions left by removed objects are removed from the list.
+     */
+    inline ObjectsList & GetList(ObjectNameId nameId)
+    {
+        if ( nameId >= lists.size() ) lists.resize(nameId+1);
+        if ( lists[nameId].removedCount > 0 ) CompactList(lists[nameId]);
+        return lists[nameId];
+    }
+
+    /**
+     * \brief Remove the empty positions of the list, preserving the order of the objects.
+     */
+    void CompactList(ObjectsList & list);
+
+    /**
+     * \brief Return true if the object is in a list of the container, at the position stored in the object.
+     */
+    bool IsInLists(const RuntimeObject * object) const;
+
+    /**
+     * \brief Return true if the object is in allObjects, at the position stored in the object.
+     */
+    bool IsInAllObjects(const RuntimeObject * object) const;
+
+    /**
+     * \brief Remove the object from the list containing it by leaving its position empty.
+     * \return The shared pointer to the object that was in the list.
+     */
+    RuntimeObjSPtr RemoveFromList(RuntimeObject * object);
+
+    /**
+     * \brief Remove the object from allObjects, and its behaviors from the registry, by leaving its
+     * position empty. Must not be called during an iteration.
+     */
+    void RemoveFromAllObjects(RuntimeObject * object);
+
+    /**
+     * \brief Remove from allObjects (and their behaviors from the registry) the objects which
+     * are not in the lists anymore, and the empty positions, in a single pass preserving the order
+     * of the other objects.
+     */
+    void RemoveObjectsNotInLists();
+
+    std::deque<ObjectsList> lists; ///< The lists of objects, indexed by the identifier of their name. A deque is used so that references to the lists are never invalidated.
+    RuntimeObjList allObjects; ///< All the objects of the lists, maintained when objects are added or removed.
+    std::size_t objectsToBeRemovedCount; ///< The number of objects of allObjects which are not in the lists anymore.
+    std::size_t emptySlotsCount; ///< The number of empty positions of allObjects, left by objects removed outside of an iteration.
+    std::size_t iterationsCount; ///< The number of iterations on allObjects that are not finished.
+    BehaviorsRegistry behaviorsRegistry; ///< The behaviors of the objects of allObjects.
 };
 
 #endif // OBJINSTANCESHOLDER_H
@@ -0,0 +1,70 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_OBJECTSLISTSVIEW_H
+#define GDCPP_OBJECTSLISTSVIEW_H
+
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+class RuntimeObject;
+
+/**
+ * \brief A non owning view on the lists of objects passed to a function by events generated code.
+ *
+ * Each element is a pair made of the identifier of the name of the objects and a pointer to
+ * their list (the pointer can be NULL). The view is only a pointer to an array of these pairs and
+ * its size: it is cheap to copy and does not allocate memory.
+ *
+ * Events generated code creates the view directly in the arguments of the called function:
+ * \code
+ * PickedObjectsCount(ObjectsListsView({{GDMyObjectNameId, &GDMyObjectObjects1}, {GDOtherObjectNameId, &GDOtherObjectObjects1}}));
+ * \endcode
+ * The array of pairs is then alive until the end of the call. A view must not be used once the array (or
+ * the std::vector) used to construct it is destroyed.
+ *
+ * \see RuntimeNamesTable
+ * \ingroup GameEngine
+ */
+class GD_API ObjectsListsView
+{
+public:
+    typedef std::pair<ObjectNameId, std::vector<RuntimeObject*> *> value_type;
+    typedef const value_type * const_iterator;
+    typedef const_iterator iterator;
+
+    ObjectsListsView() : lists(NULL), listsCount(0) {};
+    ObjectsListsView(std::initializer_list<value_type> lists_) : lists(NULL), listsCount(lists_.size())
+    {
+        //The array of the initializer list is alive until the end of the expression containing the call.
+        if ( listsCount > 0 ) lists = lists_.begin();
+    };
+    ObjectsListsView(const std::vector<value_type> & lists_) : lists(lists_.empty() ? NULL : &lists_[0]), listsCount(lists_.size()) {};
+
+    const_iterator begin() const { return lists; }
+    const_iterator end() const { return lists+listsCount; }
+    std::size_t size() const { return listsCount; }
+    bool empty() const { return listsCount == 0; }
+
+    /**
+     * \brief Return the list of the objects having the specified name, or NULL if there is no such list in the view.
+     */
+    std::vector<RuntimeObject*> * Get(ObjectNameId nameId) const
+    {
+        for (std::size_t i = 0;i<listsCount;++i)
+        {
+            if ( lists[i].first == nameId ) return lists[i].second;
+        }
+
+        return NULL;
+    }
+
+private:
+    const value_type * lists;
+    std::size_t listsCount;
+};
+
+#endif
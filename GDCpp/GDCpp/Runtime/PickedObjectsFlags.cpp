@@ -0,0 +1,64 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/PickedObjectsFlags.h"
+
+std::vector<std::unique_ptr<PickedObjectsFlags::Buffers>> PickedObjectsFlags::unusedBuffers;
+
+PickedObjectsFlags::PickedObjectsFlags(const ObjectsListsView & objectsLists)
+{
+    if ( !unusedBuffers.empty() )
+    {
+        buffers = std::move(unusedBuffers.back());
+        unusedBuffers.pop_back();
+    }
+    else
+        buffers.reset(new Buffers);
+
+    buffers->listsOffsets.clear();
+    std::size_t flagsCount = 0;
+    for(ObjectsListsView::const_iterator it = objectsLists.begin();
+        it != objectsLists.end();++it)
+    {
+        buffers->listsOffsets.push_back(flagsCount);
+        if ( it->second ) flagsCount += it->second->size();
+    }
+    buffers->listsOffsets.push_back(flagsCount);
+
+    buffers->bits.assign((flagsCount+63)/64, 0);
+}
+
+PickedObjectsFlags::~PickedObjectsFlags()
+{
+    unusedBuffers.push_back(std::move(buffers));
+}
+
+void PickedObjectsFlags::TrimNotPickedObjects(const ObjectsListsView & objectsLists) const
+{
+    std::size_t i = 0;
+    for(ObjectsListsView::const_iterator it = objectsLists.begin();
+        it != objectsLists.end();++it, ++i)
+    {
+        if ( !it->second ) continue;
+        std::vector<RuntimeObject*> & arr = *it->second;
+
+        //*This is important*! We can have a list that has already been trimmed just before
+        std::size_t firstFlag = buffers->listsOffsets[i];
+        if ( arr.size() != buffers->listsOffsets[i+1]-firstFlag ) //If the size of the objects list != number of flags...
+            continue; //... then the object list was already trimmed, skip it.
+
+        std::size_t finalSize = 0;
+        for(std::size_t k = 0;k<arr.size();++k)
+        {
+            std::size_t flag = firstFlag+k;
+            if ( (buffers->bits[flag/64] >> (flag%64)) & 1 )
+            {
+                arr[finalSize] = arr[k];
+                finalSize++;
+            }
+        }
+        arr.resize(finalSize);
+    }
+}
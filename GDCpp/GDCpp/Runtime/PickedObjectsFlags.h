@@ -0,0 +1,87 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_PICKEDOBJECTSFLAGS_H
+#define GDCPP_PICKEDOBJECTSFLAGS_H
+
+#include <memory>
+#include <vector>
+#include <SFML/Config.hpp>
+#include "GDCpp/Runtime/ObjectsListsView.h"
+
+/**
+ * \brief A flag for each object of some lists of objects, telling if the object is picked.
+ *
+ * Used by PickObjectsIf and TwoObjectListsTest to remember the objects to keep in the lists
+ * while testing them. The flags are stored as bits in buffers taken from a pool when the flags
+ * are created, and given back to the pool when they are destroyed: once the buffers are large
+ * enough for the lists of the events, creating flags does not allocate memory anymore.
+ *
+ * Flags can be nested (for example when a predicate is itself picking objects): each instance
+ * uses its own buffers.
+ *
+ * \note The pool is shared by all the scenes and is not thread safe: flags must only be used
+ * by the thread running the events.
+ *
+ * \see PickObjectsIf
+ * \see TwoObjectListsTest
+ * \ingroup GameEngine
+ */
+class GD_API PickedObjectsFlags
+{
+public:
+    /**
+     * \brief Create the flags for the objects of the lists, all the objects being not picked.
+     */
+    PickedObjectsFlags(const ObjectsListsView & objectsLists);
+    ~PickedObjectsFlags();
+
+    PickedObjectsFlags(const PickedObjectsFlags &) = delete;
+    PickedObjectsFlags & operator=(const PickedObjectsFlags &) = delete;
+
+    /**
+     * \brief Return true if the object at the specified index of the specified list is picked.
+     */
+    bool IsPicked(std::size_t list, std::size_t index) const
+    {
+        std::size_t flag = buffers->listsOffsets[list]+index;
+        return (buffers->bits[flag/64] >> (flag%64)) & 1;
+    }
+
+    /**
+     * \brief Mark the object at the specified index of the specified list as picked.
+     */
+    void Pick(std::size_t list, std::size_t index)
+    {
+        std::size_t flag = buffers->listsOffsets[list]+index;
+        buffers->bits[flag/64] |= sf::Uint64(1) << (flag%64);
+    }
+
+    /**
+     * \brief Remove from the lists the objects that were not picked.
+     *
+     * Lists are compacted in place, in a single pass, keeping the order of the picked objects.
+     *
+     * \param objectsLists The lists of objects to trim: must be the lists used to create the flags.
+     *
+     * \note A list with a size different from the one it had when the flags were created is considered
+     * as already trimmed, and is skipped (the same list can be in objectsLists and in other lists which
+     * were trimmed just before).
+     */
+    void TrimNotPickedObjects(const ObjectsListsView & objectsLists) const;
+
+private:
+    struct Buffers
+    {
+        std::vector<sf::Uint64> bits; ///< One bit for each object of the lists.
+        std::vector<std::size_t> listsOffsets; ///< The index of the first flag of each list, followed by the total number of flags.
+    };
+
+    std::unique_ptr<Buffers> buffers;
+
+    static std::vector<std::unique_ptr<Buffers>> unusedBuffers; ///< The pool of buffers given back by destroyed flags.
+};
+
+#endif
@@ -7,6 +7,13 @@
 #include "GDCpp/Runtime/Polygon2d.h"
 #include <cmath>
 #include <cfloat>
+#include <algorithm>
+
+//SSE2 is used, when the CPU supports it, by the collision tests of CollisionPolygon.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+    #define GD_POLYGONCOLLISION_SSE2
+    #include <emmintrin.h>
+#endif
 
 namespace
 {
@@ -57,6 +64,14 @@ float distance(float minA, float maxA, float minB, float maxB)
 }
 
 CollisionResult GD_API PolygonCollisionTest(Polygon2d & p1, Polygon2d & p2)
+{
+    p1.ComputeEdges();
+    p2.ComputeEdges();
+
+    return PolygonCollisionTestWithComputedEdges(p1, p2);
+}
+
+CollisionResult GD_API PolygonCollisionTestWithComputedEdges(const Polygon2d & p1, const Polygon2d & p2)
 {
     if(p1.vertices.size() < 3 || p2.vertices.size() < 3)
     {
@@ -67,9 +82,6 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d & p1, Polygon2d & p2)
         return result;
     }
 
-    p1.ComputeEdges();
-    p2.ComputeEdges();
-
     sf::Vector2f edge;
     sf::Vector2f move_axis(0,0);
     sf::Vector2f mtd(0,0);
@@ -128,3 +140,240 @@ CollisionResult GD_API PolygonCollisionTest(Polygon2d & p1, Polygon2d & p2)
 
     return result;
 }
+
+CollisionPolygon::CollisionPolygon(const Polygon2d & polygon) :
+    verticesCount(0)
+{
+    Set(polygon);
+}
+
+void CollisionPolygon::Set(const Polygon2d & polygon)
+{
+    verticesCount = polygon.vertices.size();
+    std::size_t paddedCount = (verticesCount+3)/4*4;
+    verticesX.resize(paddedCount);
+    verticesY.resize(paddedCount);
+    axesX.resize(verticesCount);
+    axesY.resize(verticesCount);
+    if ( verticesCount == 0 ) return;
+
+    for (std::size_t i = 0;i<paddedCount;++i)
+    {
+        //Padding repeats the last vertex, which does not change the projections of the polygon.
+        const sf::Vector2f & vertex = polygon.vertices[i < verticesCount ? i : verticesCount-1];
+        verticesX[i] = vertex.x;
+        verticesY[i] = vertex.y;
+    }
+
+    //Compute the axes the same way as PolygonCollisionTest, so that results are identical.
+    for (std::size_t i = 0;i<verticesCount;++i)
+    {
+        sf::Vector2f edge = polygon.vertices[(i+1) < verticesCount ? i+1 : 0] - polygon.vertices[i];
+        sf::Vector2f axis(-edge.y, edge.x);
+        normalise(axis);
+        axesX[i] = axis.x;
+        axesY[i] = axis.y;
+    }
+
+    center = polygon.ComputeCenter();
+}
+
+namespace
+{
+
+typedef void (*ProjectFunction)(float axisX, float axisY, const CollisionPolygon & p, float & min, float & max);
+
+void projectScalar(float axisX, float axisY, const CollisionPolygon & p, float & min, float & max)
+{
+    float dp = axisX*p.verticesX[0] + axisY*p.verticesY[0];
+
+    min = dp;
+    max = dp;
+
+    for (std::size_t i = 1; i < p.verticesCount; i++)
+    {
+        dp = axisX*p.verticesX[i] + axisY*p.verticesY[i];
+
+        if (dp < min)
+            min = dp;
+        else if (dp > max)
+            max = dp;
+    }
+}
+
+#if defined(GD_POLYGONCOLLISION_SSE2)
+__attribute__((target("sse2")))
+void projectSSE2(float axisX, float axisY, const CollisionPolygon & p, float & min, float & max)
+{
+    //Project 4 vertices at a time (multiplications and addition are done in the same order as projectScalar).
+    const __m128 ax = _mm_set1_ps(axisX);
+    const __m128 ay = _mm_set1_ps(axisY);
+    __m128 dp = _mm_add_ps(_mm_mul_ps(ax, _mm_loadu_ps(&p.verticesX[0])), _mm_mul_ps(ay, _mm_loadu_ps(&p.verticesY[0])));
+    __m128 minimums = dp;
+    __m128 maximums = dp;
+    for (std::size_t i = 4; i < p.verticesX.size(); i += 4)
+    {
+        dp = _mm_add_ps(_mm_mul_ps(ax, _mm_loadu_ps(&p.verticesX[i])), _mm_mul_ps(ay, _mm_loadu_ps(&p.verticesY[i])));
+        minimums = _mm_min_ps(minimums, dp);
+        maximums = _mm_max_ps(maximums, dp);
+    }
+
+    minimums = _mm_min_ps(minimums, _mm_shuffle_ps(minimums, minimums, _MM_SHUFFLE(2, 3, 0, 1)));
+    minimums = _mm_min_ps(minimums, _mm_shuffle_ps(minimums, minimums, _MM_SHUFFLE(1, 0, 3, 2)));
+    maximums = _mm_max_ps(maximums, _mm_shuffle_ps(maximums, maximums, _MM_SHUFFLE(2, 3, 0, 1)));
+    maximums = _mm_max_ps(maximums, _mm_shuffle_ps(maximums, maximums, _MM_SHUFFLE(1, 0, 3, 2)));
+    min = _mm_cvtss_f32(minimums);
+    max = _mm_cvtss_f32(maximums);
+}
+#endif
+
+ProjectFunction GetProjectFunction()
+{
+#if defined(GD_POLYGONCOLLISION_SSE2)
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports("sse2") ) return &projectSSE2;
+#endif
+
+    return &projectScalar;
+}
+
+/**
+ * Do the collision test between two polygons.
+ * \param p1Projections If not NULL, the projections (minimum and maximum) of p1 on each of its axes.
+ */
+CollisionResult collisionTest(const CollisionPolygon & p1, const CollisionPolygon & p2, const float * p1Projections)
+{
+    static const ProjectFunction projectPolygon = GetProjectFunction();
+
+    CollisionResult result;
+    result.collision = false;
+    result.move_axis.x = 0.0f;
+    result.move_axis.y = 0.0f;
+    if (p1.verticesCount < 3 || p2.verticesCount < 3)
+        return result;
+
+    sf::Vector2f move_axis(0,0);
+    float min_dist = FLT_MAX;
+
+    //Iterate over all the axes of the polygons
+    for (std::size_t i = 0; i < p1.verticesCount + p2.verticesCount; i++)
+    {
+        sf::Vector2f axis = i < p1.verticesCount ?
+            sf::Vector2f(p1.axesX[i], p1.axesY[i]) :
+            sf::Vector2f(p2.axesX[i - p1.verticesCount], p2.axesY[i - p1.verticesCount]);
+
+        float minA = 0;
+        float minB = 0;
+        float maxA = 0;
+        float maxB = 0;
+
+        if (p1Projections && i < p1.verticesCount)
+        {
+            minA = p1Projections[2*i];
+            maxA = p1Projections[2*i+1];
+        }
+        else
+            projectPolygon(axis.x, axis.y, p1, minA, maxA);
+        projectPolygon(axis.x, axis.y, p2, minB, maxB);
+
+        float dist = distance(minA, maxA, minB, maxB);
+        if (dist > 0.0f) //If the projections on the axis do not overlap, then their is no collision
+            return result;
+
+        dist = std::abs(dist);
+        if (dist < min_dist)
+        {
+            min_dist = dist;
+            move_axis = axis;
+        }
+    }
+
+    result.collision = true;
+
+    sf::Vector2f d = p1.center - p2.center;
+    if (dotProduct(d, move_axis) < 0.0f) move_axis = -move_axis;
+    result.move_axis = move_axis * min_dist;
+
+    return result;
+}
+
+}
+
+CollisionResult GD_API PolygonCollisionTest(const CollisionPolygon & p1, const CollisionPolygon & p2)
+{
+    return collisionTest(p1, p2, NULL);
+}
+
+bool GD_API PolygonCollisionTest(const CollisionPolygon & polygon, const std::vector<CollisionPolygon> & polygons,
+    std::vector<CollisionResult> & results)
+{
+    static const ProjectFunction projectPolygon = GetProjectFunction();
+
+    //The projections of the polygon on its own axes are the same for all the tests.
+    //The buffer is kept between the calls so that it is only allocated when it grows.
+    static std::vector<float> projections;
+    projections.resize(2*polygon.verticesCount);
+    for (std::size_t i = 0; i < polygon.verticesCount; i++)
+    {
+        float min = 0, max = 0;
+        projectPolygon(polygon.axesX[i], polygon.axesY[i], polygon, min, max);
+        projections[2*i] = min;
+        projections[2*i+1] = max;
+    }
+
+    bool collision = false;
+    results.resize(polygons.size());
+    for (std::size_t i = 0; i < polygons.size(); i++)
+    {
+        results[i] = collisionTest(polygon, polygons[i], projections.empty() ? NULL : &projections[0]);
+        collision = collision || results[i].collision;
+    }
+
+    return collision;
+}
+
+SweepResult GD_API PolygonSweepTest(const Polygon2d & p1, sf::Vector2f direction, const Polygon2d & p2, float margin)
+{
+    SweepResult result;
+    result.collision = false;
+    result.minDistance = 0;
+    result.maxDistance = 0;
+    if(p1.vertices.size() < 3 || p2.vertices.size() < 3) return result;
+
+    float minDistance = -FLT_MAX;
+    float maxDistance = FLT_MAX;
+    for (std::size_t i = 0; i < p1.vertices.size() + p2.vertices.size(); i++)
+    {
+        sf::Vector2f edge = i < p1.vertices.size() ? p1.edges[i] : p2.edges[i - p1.vertices.size()];
+        sf::Vector2f axis(-edge.y, edge.x);
+        normalise(axis);
+
+        float minA = 0, maxA = 0, minB = 0, maxB = 0;
+        project(axis, p1, minA, maxA);
+        project(axis, p2, minB, maxB);
+
+        //Moved by distance, the projections overlap if:
+        //minB + margin <= maxA + distance*speed and minA + distance*speed <= maxB - margin
+        float speed = dotProduct(axis, direction);
+        float lowerLimit = minB + margin - maxA;
+        float upperLimit = maxB - margin - minA;
+        if (speed == 0.0f)
+        {
+            if (lowerLimit > 0.0f || upperLimit < 0.0f) return result; //The movement does not change the projections.
+            continue;
+        }
+
+        float distance1 = lowerLimit / speed;
+        float distance2 = upperLimit / speed;
+        if (speed < 0.0f) std::swap(distance1, distance2);
+
+        if (distance1 > minDistance) minDistance = distance1;
+        if (distance2 < maxDistance) maxDistance = distance2;
+        if (minDistance > maxDistance) return result;
+    }
+
+    result.collision = true;
+    result.minDistance = minDistance;
+    result.maxDistance = maxDistance;
+    return result;
+}
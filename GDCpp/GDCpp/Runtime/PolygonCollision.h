@@ -5,6 +5,7 @@
  */
 #ifndef POLYGONCOLLISION_H
 #define POLYGONCOLLISION_H
+#include <vector>
 #include <SFML/System.hpp>
 class Polygon2d;
 
@@ -33,5 +34,99 @@ struct CollisionResult
  */
 CollisionResult GD_API PolygonCollisionTest(Polygon2d & p1, Polygon2d & p2);
 
+/**
+ * Same as PolygonCollisionTest, but the edges of the polygons must have already been computed
+ * (see Polygon2d::ComputeEdges).
+ *
+ * \ingroup GameEngine
+ */
+CollisionResult GD_API PolygonCollisionTestWithComputedEdges(const Polygon2d & p1, const Polygon2d & p2);
+
+/**
+ * \brief A convex polygon prepared for fast collision tests.
+ *
+ * Vertices are stored as a structure of arrays, padded to a multiple of 4 by repeating the last vertex,
+ * and the axes used by the Separating Axis Theorem (the normalized normals of the edges) are precomputed.
+ * This allows to project the vertices 4 at a time using SSE2 instructions, when the CPU supports them.
+ *
+ * \see PolygonCollisionTest(const CollisionPolygon & p1, const CollisionPolygon & p2)
+ * \ingroup GameEngine
+ */
+class GD_API CollisionPolygon
+{
+public:
+    CollisionPolygon() : verticesCount(0) {};
+    CollisionPolygon(const Polygon2d & polygon);
+    virtual ~CollisionPolygon() {};
+
+    /**
+     * \brief Update the collision polygon from a polygon, reusing the memory already allocated.
+     */
+    void Set(const Polygon2d & polygon);
+
+    std::size_t verticesCount; ///< The number of vertices of the polygon (without the padding).
+    std::vector<float> verticesX; ///< The X coordinates of the vertices, followed by the padding.
+    std::vector<float> verticesY; ///< The Y coordinates of the vertices, followed by the padding.
+    std::vector<float> axesX; ///< The X coordinates of the normalized normal of each edge.
+    std::vector<float> axesY; ///< The Y coordinates of the normalized normal of each edge.
+    sf::Vector2f center; ///< The center of the polygon (see Polygon2d::ComputeCenter).
+};
+
+/**
+ * Do a collision test between the two polygons.
+ *
+ * The result is the same as PolygonCollisionTest(Polygon2d & p1, Polygon2d & p2) called with the original polygons.
+ * \warning Polygons must convexes.
+ *
+ * \ingroup GameEngine
+ */
+CollisionResult GD_API PolygonCollisionTest(const CollisionPolygon & p1, const CollisionPolygon & p2);
+
+/**
+ * Do a collision test between a polygon and each polygon of a list.
+ *
+ * The projections of the polygon on its own axes are only computed once for all the tests.
+ *
+ * \note The projections are stored in a buffer shared by all the calls: the function must only be used
+ * by the thread running the events.
+ *
+ * \param polygon The polygon to be tested (used as the first polygon of each test).
+ * \param polygons The polygons to be tested against the polygon.
+ * \param results Filled with the result of each test, in the same order as polygons.
+ * \return true if the polygon is overlapping at least one polygon.
+ *
+ * \ingroup GameEngine
+ */
+bool GD_API PolygonCollisionTest(const CollisionPolygon & polygon, const std::vector<CollisionPolygon> & polygons,
+    std::vector<CollisionResult> & results);
+
+/**
+ * \brief Contains the result of PolygonSweepTest.
+ * \see PolygonSweepTest
+ * \ingroup GameEngine
+ */
+struct SweepResult
+{
+    bool collision; ///< True if the polygons are overlapping for at least one distance.
+    float minDistance; ///< The distance where the polygons start to overlap (the time of impact).
+    float maxDistance; ///< The distance where the polygons stop to overlap.
+};
+
+/**
+ * Compute the distances the first polygon can be moved along a direction so that it overlaps the second polygon.
+ *
+ * The first polygon, moved by distance*direction, overlaps the second polygon for every distance
+ * between minDistance and maxDistance.
+ * Uses Separating Axis Theorem, like PolygonCollisionTest, with the projections of the first polygon
+ * shifted by the movement.
+ *
+ * \param margin The projections of the polygons on each axis must overlap by at least this length. With a positive
+ * margin, PolygonCollisionTest reports a collision for all the distances found, despite rounding errors.
+ * \warning Polygons must convexes and their edges must have been computed (see Polygon2d::ComputeEdges).
+ *
+ * \ingroup GameEngine
+ */
+SweepResult GD_API PolygonSweepTest(const Polygon2d & p1, sf::Vector2f direction, const Polygon2d & p2, float margin = 0);
+
 #endif // POLYGONCOLLISION_H
 
@@ -36,15 +36,22 @@ bool ResourcesLoader::SetResourceFile(const gd::String & filename)
     return false;
 }
 
+std::unique_lock<std::mutex> ResourcesLoader::LockResourceFile()
+{
+    if (resFile.IsMapped()) return std::unique_lock<std::mutex>();
+
+    return std::unique_lock<std::mutex>(resFileMutex);
+}
+
 void ResourcesLoader::LoadSFMLImage( const gd::String & filename, sf::Image & image )
 {
     if (resFile.ContainsFile(filename))
     {
-        char* buffer = resFile.GetFile(filename);
-        if (buffer==NULL)
+        std::unique_lock<std::mutex> lock = LockResourceFile();
+        DatFile::FileData file = resFile.GetFileData(filename);
+        if (file.data==NULL)
             cout << "Failed to get the file of a SFML image from resource file: " << filename << endl;
-
-        if (!image.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+        else if (!image.loadFromMemory(file.data, file.size))
             cout << "Failed to load a SFML image from resource file: " << filename << endl;
     }
     else if (!image.loadFromFile(filename.ToLocale()))
@@ -64,11 +71,11 @@ void ResourcesLoader::LoadSFMLTexture( const gd::String & filename, sf::Texture
 {
     if (resFile.ContainsFile(filename))
     {
-        char* buffer = resFile.GetFile(filename);
-        if (buffer==NULL)
+        std::unique_lock<std::mutex> lock = LockResourceFile();
+        DatFile::FileData file = resFile.GetFileData(filename);
+        if (file.data==NULL)
             cout << "Failed to get the file of a SFML texture from resource file: " << filename << endl;
-
-        if (!texture.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+        else if (!texture.loadFromMemory(file.data, file.size))
             cout << "Failed to load a SFML texture from resource file: " << filename << endl;
     }
     else if (!texture.loadFromFile(filename.ToLocale()))
@@ -79,16 +86,17 @@ std::pair<sf::Font *, char *> ResourcesLoader::LoadFont(const gd::String & filen
 {
     if (resFile.ContainsFile(filename))
     {
-        char* buffer = resFile.GetFile(filename);
-        size_t bufferSize = resFile.GetFileSize(filename);
-        if (buffer==NULL) {
+        std::unique_lock<std::mutex> lock = LockResourceFile();
+        DatFile::FileData file = resFile.GetFileData(filename);
+        size_t bufferSize = file.size;
+        if (file.data==NULL) {
             cout << "Failed to get the file of a font from resource file:" << filename << endl;
             return std::make_pair((sf::Font*)NULL, (char*)NULL);
         }
 
         sf::Font * font = new sf::Font();
         char * fontBuffer = new char[bufferSize];
-        memcpy(fontBuffer, buffer, bufferSize);
+        memcpy(fontBuffer, file.data, bufferSize);
 
         if (!font->loadFromMemory(fontBuffer, bufferSize))
         {
@@ -120,11 +128,11 @@ sf::SoundBuffer ResourcesLoader::LoadSoundBuffer( const gd::String & filename )
 
     if (resFile.ContainsFile(filename))
     {
-        char* buffer = resFile.GetFile(filename);
-        if (buffer==NULL)
+        std::unique_lock<std::mutex> lock = LockResourceFile();
+        DatFile::FileData file = resFile.GetFileData(filename);
+        if (file.data==NULL)
             cout << "Failed to get the file of a sound buffer from resource file: " << filename << endl;
-
-        if (!sbuffer.loadFromMemory(buffer, resFile.GetFileSize(filename)))
+        else if (!sbuffer.loadFromMemory(file.data, file.size))
             cout << "Failed to load a sound buffer from resource file: " << filename << endl;
     }
     else if (!sbuffer.loadFromFile(filename.ToLocale()))
@@ -139,11 +147,12 @@ gd::String ResourcesLoader::LoadPlainText( const gd::String & filename )
 
     if (resFile.ContainsFile(filename))
     {
-        char* buffer = resFile.GetFile(filename);
-        if (!buffer) {
+        std::unique_lock<std::mutex> lock = LockResourceFile();
+        DatFile::FileData file = resFile.GetFileData(filename);
+        if (!file.data) {
             cout << "Failed to read a file from resource file: " << filename << endl;
         } else {
-            text = gd::String::FromUTF8(std::string(buffer));
+            text = gd::String::FromUTF8(std::string(file.data, file.size));
         }
     }
     else
@@ -169,6 +178,7 @@ char* ResourcesLoader::LoadBinaryFile( const gd::String & filename )
 {
     if (resFile.ContainsFile(filename))
     {
+        std::unique_lock<std::mutex> lock = LockResourceFile();
         char* buffer = resFile.GetFile(filename);
         if (buffer==NULL)
             cout << "Failed to read a binary file from resource file: " << filename << endl;
@@ -17,6 +17,7 @@ class Music;
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <string>
+#include <mutex>
 #include "GDCpp/Runtime/String.h"
 #undef LoadImage //Undef macro from windows.h
 
@@ -78,7 +79,14 @@ private:
     ResourcesLoader() {};
     virtual ~ResourcesLoader() {};
 
+    /**
+     * \brief Lock the access to the resource file if it is not mapped in memory, as its files
+     * are then read in a shared buffer. Resources can be loaded from several threads at once.
+     */
+    std::unique_lock<std::mutex> LockResourceFile();
+
     DatFile resFile; ///< Used to load data from a single resource file.
+    std::mutex resFileMutex; ///< Protect the access to resFile when it is not mapped in memory.
 
     static ResourcesLoader *_singleton;
 };
@@ -0,0 +1,173 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include <algorithm>
+#include <SFML/System/Clock.hpp>
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/ResourcesLoader.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+
+namespace
+{
+    const unsigned int maxWorkersCount = 4;
+}
+
+ResourcesPreloader::ResourcesPreloader() :
+    decodingCount(0),
+    stopWorkers(false)
+{
+}
+
+ResourcesPreloader::~ResourcesPreloader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopWorkers = true;
+    }
+    jobsCondition.notify_all();
+
+    for (std::size_t i = 0;i<workers.size();++i)
+        workers[i].join();
+}
+
+void ResourcesPreloader::StartWorkers()
+{
+    //Keep a core for the main thread.
+    unsigned int coresCount = std::thread::hardware_concurrency();
+    unsigned int workersCount = std::min(coresCount > 2 ? coresCount-1 : 1, maxWorkersCount);
+
+    for (unsigned int i = 0;i<workersCount;++i)
+        workers.push_back(std::thread(&ResourcesPreloader::RunWorker, this));
+}
+
+void ResourcesPreloader::RunWorker()
+{
+    while (true)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobsCondition.wait(lock, [this]() { return stopWorkers || !pendingJobs.empty(); });
+            if (stopWorkers) return;
+
+            job = pendingJobs.front();
+            pendingJobs.pop_front();
+            decodingCount++;
+        }
+
+        gd::ResourcesLoader::Get()->LoadSFMLImage(job.file, job.texture->image);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decodedJobs.push_back(job);
+            decodingCount--;
+        }
+        decodedCondition.notify_all();
+    }
+}
+
+void ResourcesPreloader::Preload(const std::vector<gd::String> & imagesNames, RuntimeGame & game)
+{
+    std::vector<Job> jobs;
+    for (std::size_t i = 0;i<imagesNames.size();++i)
+    {
+        gd::String name = imagesNames[i];
+
+        //Images packed in an atlas are created from the atlas, which is the image to be loaded.
+        if (game.GetResourcesManager().HasResource(name))
+        {
+            gd::ImageResource * image = dynamic_cast<gd::ImageResource*>(&game.GetResourcesManager().GetResource(name));
+            if (image && !image->GetAtlas().empty()) name = image->GetAtlas();
+        }
+
+        if (queuedImages.find(name) != queuedImages.end()) continue;
+
+        //Keep the images already loaded, as they can be unloaded before being used (for example
+        //when the current scene is replaced).
+        if (game.GetImageManager()->HasLoadedSFMLTexture(name))
+        {
+            textures.push_back(game.GetImageManager()->GetSFMLTexture(name));
+            continue;
+        }
+
+        if (!game.GetResourcesManager().HasResource(name)) continue;
+        gd::ImageResource * image = dynamic_cast<gd::ImageResource*>(&game.GetResourcesManager().GetResource(name));
+        if (!image) continue;
+
+        Job job;
+        job.name = name;
+        job.file = image->GetFile();
+        job.smooth = image->smooth;
+        job.texture = std::make_shared<SFMLTextureWrapper>();
+        jobs.push_back(job);
+        queuedImages.insert(name);
+    }
+
+    if (jobs.empty()) return;
+    if (workers.empty()) StartWorkers();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingJobs.insert(pendingJobs.end(), jobs.begin(), jobs.end());
+    }
+    jobsCondition.notify_all();
+}
+
+void ResourcesPreloader::CreateTexture(RuntimeGame & game, Job & job)
+{
+    job.texture->texture.loadFromImage(job.texture->image);
+    job.texture->texture.setSmooth(job.smooth);
+
+    textures.push_back(game.GetImageManager()->SetSFMLTextureAsLoaded(job.name, job.texture));
+    queuedImages.erase(job.name);
+}
+
+void ResourcesPreloader::Update(RuntimeGame & game, sf::Time budget)
+{
+    if (queuedImages.empty()) return;
+
+    sf::Clock clock;
+    do
+    {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (decodedJobs.empty()) return;
+
+            job = decodedJobs.front();
+            decodedJobs.pop_front();
+        }
+
+        CreateTexture(game, job);
+    }
+    while (clock.getElapsedTime() < budget);
+}
+
+void ResourcesPreloader::Finish(RuntimeGame & game)
+{
+    while (!queuedImages.empty())
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            decodedCondition.wait(lock, [this]() {
+                return !decodedJobs.empty() || (pendingJobs.empty() && decodingCount == 0);
+            });
+            if (decodedJobs.empty()) return;
+
+            job = decodedJobs.front();
+            decodedJobs.pop_front();
+        }
+
+        CreateTexture(game, job);
+    }
+}
+
+void ResourcesPreloader::ReleaseTextures()
+{
+    textures.clear();
+}
@@ -0,0 +1,100 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_RESOURCESPRELOADER_H
+#define GDCPP_RESOURCESPRELOADER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <SFML/System/Time.hpp>
+#include "GDCpp/Runtime/String.h"
+class RuntimeGame;
+class SFMLTextureWrapper;
+
+/**
+ * \brief Load images in advance, in background threads, so that launching a scene
+ * does not have to load them.
+ *
+ * Images are decoded by worker threads. The textures are then created on the main
+ * thread (as they need the OpenGL context) when Update or Finish is called, and given to the
+ * gd::ImageManager of the game. The preloader keeps them alive until ReleaseTextures is called.
+ *
+ * \see SceneStack::Prefetch
+ * \see gd::Layout::GetResourcesManifest
+ * \ingroup ResourcesManagement
+ */
+class GD_API ResourcesPreloader
+{
+public:
+    ResourcesPreloader();
+    virtual ~ResourcesPreloader();
+
+    /**
+     * \brief Start loading the images in background. Images already loaded
+     * or not existing in the game are ignored.
+     *
+     * \param imagesNames The names of the images resources.
+     * \param game The game containing the images.
+     */
+    void Preload(const std::vector<gd::String> & imagesNames, RuntimeGame & game);
+
+    /**
+     * \brief Create the textures of the images decoded by the worker threads,
+     * until \a budget is elapsed. Must be called on the main thread.
+     */
+    void Update(RuntimeGame & game, sf::Time budget);
+
+    /**
+     * \brief Wait for all the images to be decoded and create their textures.
+     * Must be called on the main thread.
+     */
+    void Finish(RuntimeGame & game);
+
+    /**
+     * \brief Release the textures loaded by the preloader: they are unloaded
+     * if they are not used anymore.
+     */
+    void ReleaseTextures();
+
+    /**
+     * \brief Return the number of images being loaded.
+     */
+    std::size_t GetPendingImagesCount() const { return queuedImages.size(); }
+
+private:
+    ResourcesPreloader(const ResourcesPreloader &) = delete;
+    ResourcesPreloader & operator=(const ResourcesPreloader &) = delete;
+
+    struct Job
+    {
+        gd::String name; ///< The name of the image resource.
+        gd::String file; ///< The file of the image.
+        bool smooth;
+        std::shared_ptr<SFMLTextureWrapper> texture; ///< The texture, whose image is filled by the worker threads.
+    };
+
+    void StartWorkers();
+    void RunWorker();
+    void CreateTexture(RuntimeGame & game, Job & job);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex; ///< Protect the members shared with the worker threads (jobs lists, decodingCount and stopWorkers).
+    std::condition_variable jobsCondition; ///< Notified when a job is added or when the workers must stop.
+    std::condition_variable decodedCondition; ///< Notified when a job is decoded.
+    std::deque<Job> pendingJobs; ///< The images to be decoded.
+    std::deque<Job> decodedJobs; ///< The images decoded, waiting for their textures to be created.
+    std::size_t decodingCount; ///< The number of images being decoded by the worker threads.
+    bool stopWorkers;
+
+    std::set<gd::String> queuedImages; ///< The images being loaded (used only by the main thread).
+    std::vector<std::shared_ptr<SFMLTextureWrapper>> textures; ///< The textures loaded, kept alive until ReleaseTextures is called.
+};
+
+#endif
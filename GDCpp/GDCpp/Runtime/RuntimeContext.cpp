@@ -24,6 +24,11 @@ std::vector<RuntimeObject*> RuntimeContext::GetObjectsRawPointers(const gd::Stri
     return scene->objectsInstances.GetObjectsRawPointers(name);
 }
 
+std::vector<RuntimeObject*> RuntimeContext::GetObjectsRawPointers(ObjectNameId nameId)
+{
+    return scene->objectsInstances.GetObjectsRawPointers(nameId);
+}
+
 RuntimeVariablesContainer & RuntimeContext::GetSceneVariables()
 {
 	return scene->GetVariables();
@@ -33,22 +38,3 @@ RuntimeVariablesContainer & RuntimeContext::GetGameVariables()
 {
 	return scene->game->GetVariables();
 }
-
-RuntimeContext & RuntimeContext::ClearObjectListsMap()
-{
-    temporaryMap.clear();
-
-    return *this;
-}
-
-RuntimeContext & RuntimeContext::AddObjectListToMap(const gd::String & objectName, std::vector<RuntimeObject*> & list)
-{
-    temporaryMap[objectName] = &list;
-
-    return *this;
-}
-
-std::map <gd::String, std::vector<RuntimeObject*> *> RuntimeContext::ReturnObjectListsMap()
-{
-    return temporaryMap;
-}
@@ -5,6 +5,8 @@
 #include <string>
 #include <map>
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 class RuntimeObject;
 class RuntimeScene;
 class RuntimeVariablesContainer;
@@ -32,6 +34,12 @@ public:
      */
     std::vector<RuntimeObject*> GetObjectsRawPointers(const gd::String & name);
 
+    /**
+     * \brief Same as GetObjectsRawPointers, using the identifier of the name of the objects.
+     * \see RuntimeNamesTable
+     */
+    std::vector<RuntimeObject*> GetObjectsRawPointers(ObjectNameId nameId);
+
     /**
      * \brief Shortcut for scene->GetVariables();
      */
@@ -54,14 +62,9 @@ public:
      */
     void StartNewFrame();
 
-    RuntimeContext & ClearObjectListsMap();
-    RuntimeContext & AddObjectListToMap(const gd::String & objectName, std::vector<RuntimeObject*> & list);
-    std::map <gd::String, std::vector<RuntimeObject*> *> ReturnObjectListsMap();
-
     RuntimeScene * scene; ///< The associated scene.
 
 private:
-    std::map <gd::String, std::vector<RuntimeObject*> *> temporaryMap;
     std::map <std::size_t, bool> onceConditionsTriggered;
     std::map <std::size_t, bool> onceConditionsTriggeredLastFrame;
 };
@@ -9,6 +9,7 @@
 
 RuntimeLayer::RuntimeLayer(gd::Layer & layer, const sf::View & defaultView) :
     name(layer.GetName()),
+    id(RuntimeNamesTable::Get()->GetLayerId(name)),
     isVisible(layer.GetVisibility())
 {
     for (std::size_t i = 0;i<layer.GetCameraCount();++i)
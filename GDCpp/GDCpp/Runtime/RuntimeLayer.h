@@ -7,6 +7,7 @@
 #define RUNTIMELAYER_H
 #include <SFML/Graphics.hpp>
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
 namespace gd { class Camera; }
 namespace gd { class Layer; }
 
@@ -111,20 +112,26 @@ private:
 class GD_API RuntimeLayer
 {
 public:
-    RuntimeLayer() : isVisible(true) {};
+    RuntimeLayer() : id(RuntimeNamesTable::Get()->GetLayerId("")), isVisible(true) {};
     RuntimeLayer(gd::Layer & layer, const sf::View & defaultView);
     virtual ~RuntimeLayer() {};
 
     /**
      * Change layer name
      */
-    virtual void SetName(const gd::String & name_) { name = name_; }
+    virtual void SetName(const gd::String & name_) { name = name_; id = RuntimeNamesTable::Get()->GetLayerId(name); }
 
     /**
      * Get layer name
      */
     virtual const gd::String & GetName() const { return name; }
 
+    /**
+     * Get the identifier of the layer name
+     * \see RuntimeNamesTable
+     */
+    LayerId GetId() const { return id; }
+
     /**
      * Change if layer is displayed or not
      */
@@ -163,6 +170,7 @@ public:
 private:
 
     gd::String name; ///< The name of the layer
+    LayerId id; ///< The identifier of the name of the layer
     bool isVisible; ///< True if the layer is visible
     std::vector < RuntimeCamera > cameras; ///< The camera displayed by the layer
 };
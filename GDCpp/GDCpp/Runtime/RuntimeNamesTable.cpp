@@ -0,0 +1,66 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+#include "GDCpp/Runtime/Project/Project.h"
+#include "GDCpp/Runtime/Project/Layout.h"
+#include "GDCpp/Runtime/Project/Layer.h"
+#include "GDCpp/Runtime/Project/Object.h"
+#include "GDCpp/Runtime/Project/Behavior.h"
+
+RuntimeNamesTable * RuntimeNamesTable::_singleton = NULL;
+gd::String RuntimeNamesTable::NamesList::badName;
+
+std::size_t RuntimeNamesTable::NamesList::GetId(const gd::String & name)
+{
+    std::unordered_map<gd::String, std::size_t>::const_iterator it = ids.find(name);
+    if ( it != ids.end() ) return it->second;
+
+    names.push_back(name);
+    ids[name] = names.size()-1;
+    return names.size()-1;
+}
+
+const gd::String & RuntimeNamesTable::NamesList::GetName(std::size_t id) const
+{
+    return id < names.size() ? names[id] : badName;
+}
+
+void RuntimeNamesTable::InternNamesFrom(const gd::Project & project, const gd::Layout & layout)
+{
+    GetObjectNameId(""); //Name of the objects deleted from the scene.
+    GetLayerId(""); //Name of the base layer.
+
+    auto internObjects = [this](const std::vector<std::shared_ptr<gd::Object>> & objects) {
+        for (std::size_t i = 0;i<objects.size();++i)
+        {
+            GetObjectNameId(objects[i]->GetName());
+            for (auto it = objects[i]->GetAllBehaviors().cbegin(); it != objects[i]->GetAllBehaviors().cend(); ++it)
+                GetBehaviorNameId(it->first);
+        }
+    };
+    internObjects(project.GetObjects());
+    internObjects(layout.GetObjects());
+
+    for (std::size_t i = 0;i<layout.GetLayersCount();++i)
+        GetLayerId(layout.GetLayer(i).GetName());
+}
+
+RuntimeNamesTable * RuntimeNamesTable::Get()
+{
+    if ( NULL == _singleton )
+        _singleton = new RuntimeNamesTable;
+
+    return _singleton;
+}
+
+void RuntimeNamesTable::DestroySingleton()
+{
+    if ( NULL != _singleton )
+    {
+        delete _singleton;
+        _singleton = NULL;
+    }
+}
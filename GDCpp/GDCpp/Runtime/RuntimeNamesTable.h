@@ -0,0 +1,111 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef RUNTIMENAMESTABLE_H
+#define RUNTIMENAMESTABLE_H
+
+#include <unordered_map>
+#include <vector>
+#include "GDCpp/Runtime/String.h"
+namespace gd { class Project; }
+namespace gd { class Layout; }
+
+typedef std::size_t ObjectNameId; ///< Identifier of an object name, see RuntimeNamesTable.
+typedef std::size_t LayerId; ///< Identifier of a layer name, see RuntimeNamesTable.
+typedef std::size_t BehaviorNameId; ///< Identifier of a behavior name, see RuntimeNamesTable.
+typedef std::size_t VariableNameId; ///< Identifier of a variable name, see RuntimeNamesTable.
+
+/**
+ * \brief Associate the names of objects, layers, behaviors and variables to integer identifiers.
+ *
+ * Identifiers are dense (starting from 0) and never change once a name was interned, so that they can
+ * be used as indices in arrays and stored by events generated code, avoiding string
+ * hashing and comparisons during the game. The names used by a scene are interned when the scene is loaded.
+ *
+ * \see ObjInstancesHolder
+ * \see RuntimeObject::IsOnLayer
+ * \see RuntimeVariablesContainer::GetByNameId
+ *
+ * \ingroup GameEngine
+ */
+class GD_API RuntimeNamesTable
+{
+public:
+    /**
+     * \brief Get the identifier of an object name, interning the name if necessary.
+     */
+    ObjectNameId GetObjectNameId(const gd::String & name) { return objectsNames.GetId(name); }
+
+    /**
+     * \brief Get the object name associated to an identifier.
+     */
+    const gd::String & GetObjectName(ObjectNameId id) const { return objectsNames.GetName(id); }
+
+    /**
+     * \brief Get the identifier of a layer name, interning the name if necessary.
+     */
+    LayerId GetLayerId(const gd::String & name) { return layersNames.GetId(name); }
+
+    /**
+     * \brief Get the layer name associated to an identifier.
+     */
+    const gd::String & GetLayerName(LayerId id) const { return layersNames.GetName(id); }
+
+    /**
+     * \brief Get the identifier of a behavior name, interning the name if necessary.
+     */
+    BehaviorNameId GetBehaviorNameId(const gd::String & name) { return behaviorsNames.GetId(name); }
+
+    /**
+     * \brief Get the behavior name associated to an identifier.
+     */
+    const gd::String & GetBehaviorName(BehaviorNameId id) const { return behaviorsNames.GetName(id); }
+
+    /**
+     * \brief Get the identifier of a variable name, interning the name if necessary.
+     */
+    VariableNameId GetVariableNameId(const gd::String & name) { return variablesNames.GetId(name); }
+
+    /**
+     * \brief Get the variable name associated to an identifier.
+     */
+    const gd::String & GetVariableName(VariableNameId id) const { return variablesNames.GetName(id); }
+
+    /**
+     * \brief Intern the names of the objects (global and of the layout), layers and behaviors used by a layout.
+     */
+    void InternNamesFrom(const gd::Project & project, const gd::Layout & layout);
+
+    static RuntimeNamesTable * Get();
+    static void DestroySingleton();
+
+private:
+    RuntimeNamesTable() {};
+    virtual ~RuntimeNamesTable() {};
+
+    /**
+     * \brief The names of a kind of element, associated to identifiers.
+     */
+    class NamesList
+    {
+    public:
+        std::size_t GetId(const gd::String & name);
+        const gd::String & GetName(std::size_t id) const;
+
+    private:
+        std::unordered_map<gd::String, std::size_t> ids; ///< The identifier of each name.
+        std::vector<gd::String> names; ///< The name of each identifier.
+        static gd::String badName;
+    };
+
+    NamesList objectsNames;
+    NamesList layersNames;
+    NamesList behaviorsNames;
+    NamesList variablesNames;
+
+    static RuntimeNamesTable * _singleton;
+};
+
+#endif // RUNTIMENAMESTABLE_H
@@ -21,21 +21,30 @@ using namespace std;
 
 RuntimeObject::RuntimeObject(RuntimeScene & scene, const gd::Object & object) :
     name(object.GetName()),
+    nameId(RuntimeNamesTable::Get()->GetObjectNameId(name)),
     type(object.GetType()),
     X(0),
     Y(0),
     zOrder(0),
     hidden(false),
-    objectVariables(object.GetVariables())
+    layerId(RuntimeNamesTable::Get()->GetLayerId("")),
+    objectVariables(object.GetVariables()),
+    instancesListId(gd::String::npos),
+    instancesListSlot(gd::String::npos),
+    allInstancesSlot(gd::String::npos),
+    renderingLayer(gd::String::npos),
+    renderingPosition(gd::String::npos),
+    renderingOrder(gd::String::npos)
 {
     ClearForce();
 
     behaviors.clear();
-    //Insert the new behaviors.
+    //Insert the new behaviors, in the order of their names.
+    behaviors.reserve(object.GetAllBehaviors().size());
     for (auto it = object.GetAllBehaviors().cbegin() ; it != object.GetAllBehaviors().cend(); ++it )
     {
-    	behaviors[it->first] = std::unique_ptr<gd::Behavior>(it->second->Clone());
-    	behaviors[it->first]->SetOwner(this);
+    	behaviors.push_back(std::unique_ptr<gd::Behavior>(it->second->Clone()));
+    	behaviors.back()->SetOwner(this);
     }
 }
 
@@ -47,6 +56,7 @@ RuntimeObject::~RuntimeObject()
 void RuntimeObject::Init(const RuntimeObject & object)
 {
     name = object.name;
+    nameId = object.nameId;
     type = object.type;
     objectVariables = object.objectVariables;
 
@@ -55,14 +65,16 @@ void RuntimeObject::Init(const RuntimeObject & object)
     zOrder = object.zOrder;
     hidden = object.hidden;
     layer = object.layer;
+    layerId = object.layerId;
     force5 = object.force5;
     forces = object.forces;
 
     behaviors.clear();
-    for (auto it = object.behaviors.cbegin() ; it != object.behaviors.cend(); ++it )
+    behaviors.reserve(object.behaviors.size());
+    for (std::size_t i = 0;i<object.behaviors.size();++i)
     {
-    	behaviors[it->first] = std::unique_ptr<gd::Behavior>(it->second->Clone());
-    	behaviors[it->first]->SetOwner(this);
+    	behaviors.push_back(std::unique_ptr<gd::Behavior>(object.behaviors[i]->Clone()));
+    	behaviors.back()->SetOwner(this);
     }
 }
 
@@ -107,7 +119,7 @@ bool RuntimeObject::ChangeProperty(std::size_t propertyNb, gd::String newValue)
         else
             SetHidden(false);
     }
-    else if ( propertyNb == 4 ) { layer = newValue; }
+    else if ( propertyNb == 4 ) { SetLayer(newValue); }
     else if ( propertyNb == 5 ) {SetZOrder(newValue.To<int>());}
     else if ( propertyNb == 6 ) {return false;}
     else if ( propertyNb == 7 ) {return false;}
@@ -127,6 +139,7 @@ std::size_t RuntimeObject::GetNumberOfProperties() const
 void RuntimeObject::DeleteFromScene(RuntimeScene & scene)
 {
     name = "";
+    nameId = RuntimeNamesTable::Get()->GetObjectNameId(name);
 
     //Notify scene that object's name has changed.
     scene.objectsInstances.ObjectNameHasChanged(this);
@@ -142,13 +155,13 @@ void RuntimeObject::PutAroundAPosition( float positionX, float positionY, float
 
 void RuntimeObject::AddForce( float x, float y, float clearing )
 {
-    forces.push_back( Force(x,y, clearing) );
+    forces.Add( Force(x,y, clearing) );
 }
 
 void RuntimeObject::AddForceUsingPolarCoordinates( float angle, float length, float clearing )
 {
     angle *= 3.14159/180.0;
-    forces.push_back( Force(cos(angle)*length,sin(angle)*length, clearing) );
+    forces.Add( Force(cos(angle)*length,sin(angle)*length, clearing) );
 }
 /**
  * Add a force toward a position
@@ -160,7 +173,7 @@ void RuntimeObject::AddForceTowardPosition( float positionX, float positionY, fl
 	double x = positionX - (GetDrawableX()+GetCenterX());
 	float angle = atan2(y,x);
 
-    forces.push_back( Force(cos(angle)*length, sin(angle)*length, clearing) );
+    forces.Add( Force(cos(angle)*length, sin(angle)*length, clearing) );
 }
 
 
@@ -182,17 +195,18 @@ void RuntimeObject::AddForceToMoveAround( float positionX, float positionY, floa
     int newX = cos(newangle/180.f*3.14159f) * distance;
     int newY = sin(newangle/180.f*3.14159f) * distance;
 
-    forces.push_back( Force(newX-oldX, newY-oldY, clearing) );
+    forces.Add( Force(newX-oldX, newY-oldY, clearing) );
 }
 
-void RuntimeObject::Duplicate(RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists)
+void RuntimeObject::Duplicate(RuntimeScene & scene, ObjectsListsView pickedObjectLists)
 {
     std::shared_ptr<RuntimeObject> newObject = std::shared_ptr<RuntimeObject>(Clone());
 
     scene.objectsInstances.AddObject(newObject);
 
-    if ( pickedObjectLists[name] != NULL && find(pickedObjectLists[name]->begin(), pickedObjectLists[name]->end(), newObject.get()) == pickedObjectLists[name]->end() )
-        pickedObjectLists[name]->push_back( newObject.get() );
+    std::vector<RuntimeObject*> * list = pickedObjectLists.Get(nameId);
+    if ( list != NULL && find(list->begin(), list->end(), newObject.get()) == list->end() )
+        list->push_back( newObject.get() );
 }
 
 bool RuntimeObject::IsStopped()
@@ -255,10 +269,10 @@ double RuntimeObject::GetDistanceWithObject(RuntimeObject * object)
     return sqrt(GetSqDistanceWithObject(object));
 }
 
-bool RuntimeObject::SeparateFromObjects(std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists)
+bool RuntimeObject::SeparateFromObjects(ObjectsListsView pickedObjectLists)
 {
     vector<RuntimeObject*> objects;
-    for (std::map <gd::String, std::vector<RuntimeObject*> *>::const_iterator it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
+    for (ObjectsListsView::const_iterator it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
     {
         if ( it->second != NULL )
         {
@@ -278,8 +292,8 @@ bool RuntimeObject::SeparateFromObjects(const std::vector<RuntimeObject*> & obje
     {
         if ( objects[j] != this )
         {
-            std::vector<Polygon2d> hitBoxes = GetHitBoxes(objects[j]->GetAABB());
-            vector<Polygon2d> otherHitBoxes = objects[j]->GetHitBoxes(GetAABB());
+            const vector<CollisionPolygon> & hitBoxes = GetCollisionPolygons(objects[j]->GetAABB());
+            const vector<CollisionPolygon> & otherHitBoxes = objects[j]->GetCollisionPolygons(GetAABB());
             for (std::size_t k = 0;k<hitBoxes.size();++k)
             {
                 for (std::size_t l = 0;l<otherHitBoxes.size();++l)
@@ -361,8 +375,8 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject * obj2)
     sf::FloatRect objRect = obj1->GetAABB();
     sf::FloatRect obj2Rect = obj2->GetAABB();
 
-    vector<Polygon2d> objHitboxes = obj1->GetHitBoxes(obj2Rect);
-    vector<Polygon2d> obj2Hitboxes = obj2->GetHitBoxes(objRect);
+    const vector<CollisionPolygon> & objHitboxes = obj1->GetCollisionPolygons(obj2Rect);
+    const vector<CollisionPolygon> & obj2Hitboxes = obj2->GetCollisionPolygons(objRect);
     for (std::size_t k = 0;k<objHitboxes.size();++k)
     {
         for (std::size_t l = 0;l<obj2Hitboxes.size();++l)
@@ -375,10 +389,10 @@ bool RuntimeObject::IsCollidingWith(RuntimeObject * obj2)
     return false;
 }
 
-void RuntimeObject::SeparateObjectsWithoutForces( std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists)
+void RuntimeObject::SeparateObjectsWithoutForces( ObjectsListsView pickedObjectLists)
 {
     vector<RuntimeObject*> objects2;
-    for (std::map <gd::String, std::vector<RuntimeObject*> *>::const_iterator it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
+    for (ObjectsListsView::const_iterator it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
     {
         if ( it->second != NULL )
         {
@@ -421,10 +435,10 @@ void RuntimeObject::SeparateObjectsWithoutForces( std::map <gd::String, std::vec
     }
 }
 
-void RuntimeObject::SeparateObjectsWithForces( std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists)
+void RuntimeObject::SeparateObjectsWithForces( ObjectsListsView pickedObjectLists)
 {
     vector<RuntimeObject*> objects2;
-    for (std::map <gd::String, std::vector<RuntimeObject*> *>::const_iterator it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
+    for (ObjectsListsView::const_iterator it = pickedObjectLists.begin();it!=pickedObjectLists.end();++it)
     {
         if ( it->second != NULL )
         {
@@ -558,9 +572,28 @@ std::vector<Polygon2d> RuntimeObject::GetHitBoxes(sf::FloatRect hint) const
     return GetHitBoxes();
 }
 
+const std::vector<Polygon2d> & RuntimeObject::GetHitBoxesWithEdges(sf::FloatRect hint) const
+{
+    hitBoxesBuffer = GetHitBoxes(hint);
+    for (std::size_t i = 0;i<hitBoxesBuffer.size();++i)
+        hitBoxesBuffer[i].ComputeEdges();
+
+    return hitBoxesBuffer;
+}
+
+const std::vector<CollisionPolygon> & RuntimeObject::GetCollisionPolygons(sf::FloatRect hint) const
+{
+    const std::vector<Polygon2d> & hitBoxes = GetHitBoxesWithEdges(hint);
+    collisionPolygonsBuffer.resize(hitBoxes.size());
+    for (std::size_t i = 0;i<hitBoxes.size();++i)
+        collisionPolygonsBuffer[i].Set(hitBoxes[i]);
+
+    return collisionPolygonsBuffer;
+}
+
 bool RuntimeObject::CursorOnObject(RuntimeScene & scene, bool)
 {
-    RuntimeLayer & theLayer = scene.GetRuntimeLayer(layer);
+    RuntimeLayer & theLayer = scene.GetRuntimeLayer(layerId);
     auto insideObject = [this](const sf::Vector2f & pos) {
         return GetDrawableX() <= pos.x
             && GetDrawableX() + GetWidth()  >= pos.x
@@ -590,12 +623,22 @@ bool RuntimeObject::CursorOnObject(RuntimeScene & scene, bool)
 
 Behavior* RuntimeObject::GetBehaviorRawPointer(const gd::String & name)
 {
-    return behaviors.find(name)->second.get();
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        if ( behaviors[i]->GetName() == name ) return behaviors[i].get();
+    }
+
+    return NULL;
 }
 
 Behavior* RuntimeObject::GetBehaviorRawPointer(const gd::String & name) const
 {
-    return behaviors.find(name)->second.get();
+    for (std::size_t i = 0;i<behaviors.size();++i)
+    {
+        if ( behaviors[i]->GetName() == name ) return behaviors[i].get();
+    }
+
+    return NULL;
 }
 
 bool RuntimeObject::ClearForce()
@@ -603,7 +646,7 @@ bool RuntimeObject::ClearForce()
     force5.SetLength(0); //Clear the deprecated force
     force5.SetClearing(0);
 
-    forces.clear();
+    forces.Clear();
 
     return true;
 }
@@ -613,39 +656,11 @@ bool RuntimeObject::UpdateForce( float elapsedTime )
     force5.SetLength( force5.GetLength() - force5.GetLength() * ( 1 - force5.GetClearing() ) * elapsedTime );
     if ( force5.GetClearing() == 0 ) force5.SetLength(0);
 
-    for ( std::size_t i = 0; i < forces.size();)
-    {
-        if ( forces[i].GetClearing() == 0 || forces[i].GetLength() <= 0.001 )
-            forces.erase(forces.begin()+i);
-        else
-        {
-            forces[i].SetLength( forces[i].GetLength() - forces[i].GetLength() * ( 1 - forces[i].GetClearing() ) * elapsedTime );
-            ++i;
-        }
-
-    }
+    forces.Update(elapsedTime);
 
     return true;
 }
 
-float RuntimeObject::TotalForceX() const
-{
-    float ForceXsimple = 0;
-    for ( std::size_t i = 0; i < forces.size();i++ )
-        ForceXsimple += forces[i].GetX();
-
-    return ForceXsimple + force5.GetX();
-}
-
-float RuntimeObject::TotalForceY() const
-{
-    float ForceYsimple = 0;
-    for ( std::size_t i = 0; i < forces.size();i++ )
-        ForceYsimple += forces[i].GetY();
-
-    return ForceYsimple + force5.GetY();
-}
-
 float RuntimeObject::TotalForceAngle() const
 {
     Force ForceMoyenne;
@@ -666,14 +681,14 @@ float RuntimeObject::TotalForceLength() const
 
 void RuntimeObject::DoBehaviorsPreEvents(RuntimeScene & scene)
 {
-    for (auto it = behaviors.cbegin() ; it != behaviors.cend(); ++it )
-        it->second->StepPreEvents(scene);
+    for (std::size_t i = 0;i<behaviors.size();++i)
+        behaviors[i]->StepPreEvents(scene);
 }
 
 void RuntimeObject::DoBehaviorsPostEvents(RuntimeScene & scene)
 {
-    for (auto it = behaviors.cbegin() ; it != behaviors.cend(); ++it )
-        it->second->StepPostEvents(scene);
+    for (std::size_t i = 0;i<behaviors.size();++i)
+        behaviors[i]->StepPostEvents(scene);
 }
 
 bool RuntimeObject::VariableExists(const gd::String & variable)
@@ -12,13 +12,19 @@
 #include <vector>
 #include "GDCpp/Runtime/RuntimeVariablesContainer.h"
 #include "GDCpp/Runtime/Force.h"
+#include "GDCpp/Runtime/ForcesBuffer.h"
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
 #include "GDCpp/Runtime/String.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+#include "GDCpp/Runtime/ObjectsListsView.h"
 #include "GDCpp/Runtime/Project/Behavior.h"
 #include <SFML/Graphics/Rect.hpp>
 namespace gd { class InitialInstance; }
 namespace gd { class Object; }
 namespace sf { class RenderTarget; }
-class Polygon2d;
+namespace sf { class Sprite; }
+namespace sf { struct BlendMode; }
 class RuntimeScene;
 
 /**
@@ -62,7 +68,16 @@ public:
     /**
      * \brief Copy constructor. Calls Init().
      */
-    RuntimeObject(const RuntimeObject & object) { Init(object); };
+    RuntimeObject(const RuntimeObject & object) :
+        instancesListId(gd::String::npos),
+        instancesListSlot(gd::String::npos),
+        allInstancesSlot(gd::String::npos),
+        renderingLayer(gd::String::npos),
+        renderingPosition(gd::String::npos),
+        renderingOrder(gd::String::npos)
+    {
+        Init(object);
+    };
 
     /**
      * \brief Assignment operator. Calls Init().
@@ -97,6 +112,17 @@ public:
      */
     virtual bool Draw(sf::RenderTarget & renderTarget) {return true;};
 
+    /**
+     * \brief Return the sprite drawn by the object if it can be drawn with the sprites of other objects
+     * by SpriteBatchRenderer, or NULL if the object must be drawn by calling Draw.
+     *
+     * The sprite is drawn with the blend mode and without any shader. The bounding box of the object (see GetAABB)
+     * must contain the sprite, as the object is not drawn when its bounding box is outside the view.
+     *
+     * \param blendMode Set to the blend mode to be used to draw the sprite.
+     */
+    virtual const sf::Sprite * GetSpriteForBatching(sf::BlendMode & blendMode) const {return NULL;};
+
     /** \name Object's variables
      * Members functions providing access to the object's variables.
      */
@@ -131,18 +157,35 @@ public:
 
     /**
      * Only used by GD events generated code
+     * \return The behavior with the specified name, or NULL if the object has no such behavior.
      */
     gd::Behavior* GetBehaviorRawPointer(const gd::String & name);
 
     /**
      * Only used by GD events generated code
+     * \return The behavior with the specified name, or NULL if the object has no such behavior.
      */
     gd::Behavior* GetBehaviorRawPointer(const gd::String & name) const;
 
+    /**
+     * \brief Return the behavior at the specified position.
+     *
+     * Behaviors are stored in the order of their names, as in the gd::Object used to create the
+     * object: the events code generator uses this when the position of a behavior is known.
+     * Only used by GD events generated code
+     */
+    gd::Behavior* GetBehaviorRawPointer(std::size_t index) { return behaviors[index].get(); }
+
+    /**
+     * \brief Return the behavior at the specified position.
+     * Only used by GD events generated code
+     */
+    gd::Behavior* GetBehaviorRawPointer(std::size_t index) const { return behaviors[index].get(); }
+
     /**
      * \brief Return true if the object has the behavior with the specified name.
      */
-    virtual bool HasBehaviorNamed(const gd::String & name) const { return behaviors.find(name) != behaviors.end(); };
+    virtual bool HasBehaviorNamed(const gd::String & name) const { return GetBehaviorRawPointer(name) != NULL; };
     ///@}
 
     /**
@@ -150,6 +193,12 @@ public:
      */
     inline const gd::String & GetName() const { return name; };
 
+    /**
+     * \brief Get the identifier of the name of the object
+     * \see RuntimeNamesTable
+     */
+    inline ObjectNameId GetNameId() const { return nameId; };
+
     /**
      * \brief Get the type of the object
      */
@@ -183,18 +232,33 @@ public:
     /**
      * \brief Change the layer of the object
      */
-    inline void SetLayer(const gd::String & layer_) { layer = layer_;}
+    inline void SetLayer(const gd::String & layer_) { layer = layer_; layerId = RuntimeNamesTable::Get()->GetLayerId(layer); }
+
+    /**
+     * \brief Change the layer of the object, using the identifier of the layer name
+     */
+    inline void SetLayer(LayerId layerId_) { layerId = layerId_; layer = RuntimeNamesTable::Get()->GetLayerName(layerId); }
 
     /**
      * \brief Get the layer of the object
      */
     inline const gd::String & GetLayer() const { return layer; }
 
+    /**
+     * \brief Get the identifier of the layer of the object
+     */
+    inline LayerId GetLayerId() const { return layerId; }
+
     /**
      * \brief Check if the object is on a layer.
      */
     inline bool IsOnLayer(const gd::String & layer_) const { return layer == layer_; }
 
+    /**
+     * \brief Check if the object is on a layer, using the identifier of the layer name.
+     */
+    inline bool IsOnLayer(LayerId layerId_) const { return layerId == layerId_; }
+
     /**
      * \brief Get the object AABB
      */
@@ -212,6 +276,27 @@ public:
      */
     virtual std::vector<Polygon2d> GetHitBoxes(sf::FloatRect hint) const;
 
+    /**
+     * \brief Get the object hitbox(es) preferably intersecting with hint, with their edges already computed
+     * (see Polygon2d::ComputeEdges).
+     *
+     * The returned reference is valid until the object is changed or the method is called again.
+     * \note The default implementation stores the hitboxes given by GetHitBoxes(hint). Objects caching their
+     * hitboxes should redefine it to avoid copying them.
+     */
+    virtual const std::vector<Polygon2d> & GetHitBoxesWithEdges(sf::FloatRect hint) const;
+
+    /**
+     * \brief Get the object hitbox(es) preferably intersecting with hint, prepared for fast
+     * collision tests (see CollisionPolygon).
+     *
+     * The returned reference is valid until the object is changed or the method is called again.
+     * \note The default implementation converts the hitboxes given by GetHitBoxesWithEdges(hint),
+     * reusing the memory of the previous call. Objects caching their hitboxes should redefine it
+     * to only convert them when they are changed.
+     */
+    virtual const std::vector<CollisionPolygon> & GetCollisionPolygons(sf::FloatRect hint) const;
+
     /**
      * \brief Check collision between two objects using their hitboxes.
      * \note If bounding circles of objects are not colliding, hit boxes are not tested.
@@ -355,8 +440,8 @@ public:
      */
     bool UpdateForce(float ElapsedTime);
 
-    float TotalForceX() const;
-    float TotalForceY() const;
+    float TotalForceX() const { return forces.GetTotalX() + force5.GetX(); };
+    float TotalForceY() const { return forces.GetTotalY() + force5.GetY(); };
     float TotalForceAngle() const;
     float TotalForceLength() const;
     ///@}
@@ -430,7 +515,7 @@ public:
 
     void SetXY( const char* xOperator, float xValue, const char* yOperator, float yValue );
 
-    void Duplicate( RuntimeScene & scene, std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists );
+    void Duplicate( RuntimeScene & scene, ObjectsListsView pickedObjectLists );
     void ActivateBehavior( const gd::String & behaviorName, bool activate = true );
     bool BehaviorActivated( const gd::String & behaviorName );
 
@@ -440,35 +525,50 @@ public:
     double GetSqDistanceWithObject( RuntimeObject * other );
     double GetDistanceWithObject( RuntimeObject * other );
 
-    bool SeparateFromObjects( std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists);
+    bool SeparateFromObjects( ObjectsListsView pickedObjectLists);
 
     /** \deprecated
      */
-    void SeparateObjectsWithoutForces( std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists);
+    void SeparateObjectsWithoutForces( ObjectsListsView pickedObjectLists);
 
     /** \deprecated
      */
-    void SeparateObjectsWithForces( std::map <gd::String, std::vector<RuntimeObject*> *> pickedObjectLists);
+    void SeparateObjectsWithForces( ObjectsListsView pickedObjectLists);
     ///@}
 
 protected:
 
     gd::String                                             name; ///< The full name of the object
+    ObjectNameId                                           nameId; ///< The identifier of the name of the object
     gd::String                                             type; ///< Which type is the object. ( To test if we can do something reserved to some objects with it )
     float                                                  X; ///<X position on the scene
     float                                                  Y; ///<Y position on the scene
     int                                                    zOrder; ///<Z order on the scene, to choose if an object is displayed before another object.
     bool                                                   hidden; ///<True to prevent the object from being rendered.
     gd::String                                             layer; ///<Name of the layer on which the object is.
-    std::map<gd::String, std::unique_ptr<gd::Behavior>>    behaviors; ///<Contains all behaviors of the object. Behaviors are the ownership of the object
+    LayerId                                                layerId; ///<Identifier of the name of the layer on which the object is.
+    std::vector<std::unique_ptr<gd::Behavior>>             behaviors; ///<Contains all behaviors of the object, in the order of their names (as in gd::Object). Behaviors are the ownership of the object
     RuntimeVariablesContainer                              objectVariables; ///<List of the variables of the object
-    std::vector < Force >                                  forces; ///< Forces applied to the object
+    ForcesBuffer                                           forces; ///< Forces applied to the object
 
     /**
      * \brief Initialize object using another object. Used by copy-ctor and assign-op.
      * \warning Don't forget to update me if members were changed!
      */
     void Init(const RuntimeObject & object);
+
+private:
+    friend class ObjInstancesHolder;
+    friend class SpriteBatchRenderer;
+
+    std::size_t                                            instancesListId; ///< Used by ObjInstancesHolder: index of the list containing the object.
+    std::size_t                                            instancesListSlot; ///< Used by ObjInstancesHolder: position of the object in this list.
+    std::size_t                                            allInstancesSlot; ///< Used by ObjInstancesHolder: position of the object in the list of all objects.
+    std::size_t                                            renderingLayer; ///< Used by SpriteBatchRenderer: index of the layer of the object during the last frame.
+    std::size_t                                            renderingPosition; ///< Used by SpriteBatchRenderer: position of the object in its layer during the last frame.
+    std::size_t                                            renderingOrder; ///< Used by SpriteBatchRenderer: position of the object in the list of all objects, to sort objects having the same Z order.
+    mutable std::vector<Polygon2d>                         hitBoxesBuffer; ///< Used by the default implementation of GetHitBoxesWithEdges.
+    mutable std::vector<CollisionPolygon>                  collisionPolygonsBuffer; ///< Used by the default implementation of GetCollisionPolygons.
 };
 
 #endif // RUNTIMEOBJECT_H
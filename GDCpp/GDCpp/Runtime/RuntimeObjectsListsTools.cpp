@@ -10,12 +10,13 @@
 #include "RuntimeObject.h"
 #include "RuntimeObjectsListsTools.h"
 
-void GD_API PickOnly(RuntimeObjectsLists & pickedObjectsLists, RuntimeObject * thisOne)
+void GD_API PickOnly(const ObjectsListsView & pickedObjectsLists, RuntimeObject * thisOne)
 {
     for (auto it = pickedObjectsLists.begin();it!=pickedObjectsLists.end();++it)
     {
         if (it->second != NULL) it->second->clear();
     }
 
-    if (pickedObjectsLists[thisOne->GetName()] != NULL) pickedObjectsLists[thisOne->GetName()]->push_back(thisOne);
+    std::vector<RuntimeObject*> * list = pickedObjectsLists.Get(thisOne->GetNameId());
+    if (list != NULL) list->push_back(thisOne);
 }
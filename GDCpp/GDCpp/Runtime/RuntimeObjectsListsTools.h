@@ -11,8 +11,10 @@
 #include <map>
 #include "RuntimeScene.h"
 #include "RuntimeObject.h"
-
-typedef std::map <gd::String, std::vector<RuntimeObject*> *> RuntimeObjectsLists;
+#include "SpatialHash.h"
+#include "BroadphaseBuffers.h"
+#include "ObjectsListsView.h"
+#include "PickedObjectsFlags.h"
 
 /**
  * \brief Keep only the specified object in the lists of picked objects.
@@ -20,7 +22,7 @@ typedef std::map <gd::String, std::vector<RuntimeObject*> *> RuntimeObjectsLists
  * \param thisOne The object to keep in the lists
  * \ingroup GameEngine
  */
-void GD_API PickOnly(RuntimeObjectsLists & pickedObjectsLists, RuntimeObject * thisOne);
+void GD_API PickOnly(const ObjectsListsView & pickedObjectsLists, RuntimeObject * thisOne);
 
 /**
  * \brief Filter objects to keep only the one that fullfil the predicate
@@ -35,23 +37,16 @@ void GD_API PickOnly(RuntimeObjectsLists & pickedObjectsLists, RuntimeObject * t
  * \ingroup GameEngine
  */
 template <typename Pred>
-bool PickObjectsIf(const RuntimeObjectsLists & pickedObjectsLists, bool negatePredicate, Pred predicate)
+bool PickObjectsIf(const ObjectsListsView & pickedObjectsLists, bool negatePredicate, Pred predicate)
 {
 	bool isTrue = false;
 
-    //Create a boolean for each object
-    std::vector < std::vector<bool> > pickedList;
-    for(RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-        it != pickedObjectsLists.end();++it)
-    {
-        std::vector<bool> arr;
-        arr.assign(it->second->size(), false);
-        pickedList.push_back(arr);
-    }
+    //Create a flag for each object
+    PickedObjectsFlags pickedList(pickedObjectsLists);
 
     //Pick objects which are fulfulling the predicate.
     std::size_t i = 0;
-    for(RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
+    for(ObjectsListsView::const_iterator it = pickedObjectsLists.begin();
         it != pickedObjectsLists.end();++it, ++i)
     {
         if ( !it->second ) continue;
@@ -60,32 +55,14 @@ bool PickObjectsIf(const RuntimeObjectsLists & pickedObjectsLists, bool negatePr
         for(std::size_t k = 0;k<arr1.size();++k)
         {
             if (negatePredicate ^ predicate(arr1[k])) {
-                pickedList[i][k] = true;
+                pickedList.Pick(i, k);
                 isTrue = true;
             }
         }
     }
 
     //Trim not picked objects from lists.
-    i = 0;
-    for(RuntimeObjectsLists::const_iterator it = pickedObjectsLists.begin();
-        it != pickedObjectsLists.end();++it, ++i)
-    {
-        size_t finalSize = 0;
-        if ( !it->second ) continue;
-        std::vector<RuntimeObject*> & arr = *it->second;
-
-        for(std::size_t k = 0;k<arr.size();++k)
-        {
-            RuntimeObject * obj = arr[k];
-            if ( pickedList[i][k] )
-            {
-                arr[finalSize] = obj;
-                finalSize++;
-            }
-        }
-        arr.resize(finalSize);
-    }
+    pickedList.TrimNotPickedObjects(pickedObjectsLists);
 
     return isTrue;
 }
@@ -105,49 +82,34 @@ bool PickObjectsIf(const RuntimeObjectsLists & pickedObjectsLists, bool negatePr
  * comment at the end of the algorithm, when trimming the list).
  *
  * Cost (Worst case, predicate being always false):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Clearing NbObjList1+NbObjList2 flags)
  *  + Cost(predicate)*NbObjList1*NbObjList2
- *  + Cost(Testing NbObjList1+NbObjList2 booleans)
+ *  + Cost(Testing NbObjList1+NbObjList2 flags)
  *  + Cost(Removing NbObjList1+NbObjList2 objects from all the lists)
  *
  * Cost (Best case, predicate being always true):
- *    Cost(Creating tables with a total of NbObjList1+NbObjList2 booleans)
+ *    Cost(Clearing NbObjList1+NbObjList2 flags)
  *  + Cost(predicate)*(NbObjList1+NbObjList2)
- *  + Cost(Testing NbObjList1+NbObjList2 booleans)
+ *  + Cost(Testing NbObjList1+NbObjList2 flags)
  *
  * \ingroup GameEngine
  */
 template <typename Pred>
-bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
-                               RuntimeObjectsLists objectsLists2,
+bool TwoObjectListsTest(ObjectsListsView objectsLists1,
+                               ObjectsListsView objectsLists2,
                                bool negatePredicate,
                                Pred predicate)
 {
     bool isTrue = false;
 
-    //Create a boolean for each object
-    std::vector < std::vector<bool> > pickedList1;
-    std::vector < std::vector<bool> > pickedList2;
-
-    for(RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
-        it != objectsLists1.end();++it)
-    {
-        std::vector<bool> arr;
-        arr.assign(it->second->size(), false);
-        pickedList1.push_back(arr);
-    }
-    for(RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-        it != objectsLists2.end();++it)
-    {
-        std::vector<bool> arr;
-        arr.assign(it->second->size(), false);
-        pickedList2.push_back(arr);
-    }
+    //Create a flag for each object
+    PickedObjectsFlags pickedList1(objectsLists1);
+    PickedObjectsFlags pickedList2(objectsLists2);
 
     //Launch the function each object of the first list with each object
     //of the second list.
     std::size_t i = 0;
-    for(RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
+    for(ObjectsListsView::const_iterator it = objectsLists1.begin();
         it != objectsLists1.end();++it, ++i)
     {
         if ( !it->second ) continue;
@@ -157,22 +119,22 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
             bool atLeastOneObject = false;
 
             std::size_t j = 0;
-            for(RuntimeObjectsLists::const_iterator it2 = objectsLists2.begin();
+            for(ObjectsListsView::const_iterator it2 = objectsLists2.begin();
                 it2 != objectsLists2.end();++it2, ++j)
             {
                 if ( !it2->second ) continue;
                 const std::vector<RuntimeObject*> & arr2 = *it2->second;
 
                 for(std::size_t l = 0;l<arr2.size();++l) {
-                    if ( pickedList1[i][k] && pickedList2[j][l]) continue; //Avoid unnecessary costly call to functor.
+                    if ( pickedList1.IsPicked(i, k) && pickedList2.IsPicked(j, l)) continue; //Avoid unnecessary costly call to functor.
 
                     if ( arr1[k] != arr2[l] && predicate(arr1[k], arr2[l]) ) {
                         if ( !negatePredicate ) {
                             isTrue = true;
 
                             //Pick the objects
-                            pickedList1[i][k] = true;
-                            pickedList2[j][l] = true;
+                            pickedList1.Pick(i, k);
+                            pickedList2.Pick(j, l);
                         }
 
                         atLeastOneObject = true;
@@ -182,58 +144,141 @@ bool TwoObjectListsTest(RuntimeObjectsLists objectsLists1,
 
             if ( !atLeastOneObject && negatePredicate ) { //The object is not overlapping any other object.
                 isTrue = true;
-                pickedList1[i][k] = true;
+                pickedList1.Pick(i, k);
             }
         }
     }
 
     //Trim not picked objects from lists.
-    i = 0;
-    for(RuntimeObjectsLists::const_iterator it = objectsLists1.begin();
-        it != objectsLists1.end();++it, ++i)
+    pickedList1.TrimNotPickedObjects(objectsLists1);
+    if ( !negatePredicate ) pickedList2.TrimNotPickedObjects(objectsLists2);
+
+    return isTrue;
+}
+
+/**
+ * \brief Same as TwoObjectListsTest, but the predicate is only called for pairs of objects
+ * that are near each other.
+ *
+ * The objects of the second lists are put in a SpatialHash, which is queried for each object
+ * of the first lists: as long as the objects are spread in the scene, the cost is approximately
+ * proportional to NbObjList1+NbObjList2 instead of NbObjList1*NbObjList2.
+ *
+ * \param radius A function returning, for an object, a distance around its center such that the predicate can only be
+ * true for two objects if the distance between their centers, on each axis, is not greater than the sum of their radius.
+ *
+ * \see TwoObjectListsTest
+ * \ingroup GameEngine
+ */
+template <typename Radius, typename Pred>
+bool TwoObjectListsTestWithBroadphase(ObjectsListsView objectsLists1,
+                               ObjectsListsView objectsLists2,
+                               bool negatePredicate,
+                               Radius radius,
+                               Pred predicate)
+{
+    typedef BroadphaseBuffers::Candidate Candidate;
+
+    auto getBounds = [&radius](RuntimeObject * object) {
+        float r = radius(object);
+        return sf::FloatRect(object->GetDrawableX()+object->GetCenterX()-r,
+                             object->GetDrawableY()+object->GetCenterY()-r, 2*r, 2*r);
+    };
+
+    //With only a few objects, testing all the pairs is faster.
+    std::size_t objectsCount1 = 0, objectsCount2 = 0;
+    for(ObjectsListsView::const_iterator it = objectsLists1.begin();
+        it != objectsLists1.end();++it)
+        if ( it->second ) objectsCount1 += it->second->size();
+    for(ObjectsListsView::const_iterator it = objectsLists2.begin();
+        it != objectsLists2.end();++it)
+        if ( it->second ) objectsCount2 += it->second->size();
+
+    if ( objectsCount1*objectsCount2 < 256 )
+        return TwoObjectListsTest(objectsLists1, objectsLists2, negatePredicate, predicate);
+
+    //Compute the bounds of all objects, in buffers reused by the next tests.
+    BroadphaseBuffers buffers;
+    std::vector<sf::FloatRect> & bounds1 = buffers.GetBounds1();
+    std::vector<sf::FloatRect> & bounds2 = buffers.GetBounds2();
+    std::vector<Candidate> & candidates = buffers.GetCandidates();
+    double totalSize = 0;
+    for(ObjectsListsView::const_iterator it = objectsLists1.begin();
+        it != objectsLists1.end();++it)
     {
-        size_t finalSize = 0;
         if ( !it->second ) continue;
-        std::vector<RuntimeObject*> & arr = *it->second;
-
-        for(std::size_t k = 0;k<arr.size();++k)
-        {
-            RuntimeObject * obj = arr[k];
-            if ( pickedList1[i][k] )
-            {
-                arr[finalSize] = obj;
-                finalSize++;
-            }
+        for(std::size_t k = 0;k<it->second->size();++k) {
+            bounds1.push_back(getBounds((*it->second)[k]));
+            totalSize += bounds1.back().width;
+        }
+    }
+    std::size_t listIndex = 0;
+    for(ObjectsListsView::const_iterator it = objectsLists2.begin();
+        it != objectsLists2.end();++it, ++listIndex)
+    {
+        if ( !it->second ) continue;
+        for(std::size_t l = 0;l<it->second->size();++l) {
+            Candidate candidate = {(*it->second)[l], listIndex, l};
+            candidates.push_back(candidate);
+            bounds2.push_back(getBounds(candidate.object));
+            totalSize += bounds2.back().width;
         }
-        arr.resize(finalSize);
     }
 
-    if ( !negatePredicate ) {
-        std::size_t i = 0;
-        for(RuntimeObjectsLists::const_iterator it = objectsLists2.begin();
-            it != objectsLists2.end();++it, ++i)
-        {
-            size_t finalSize = 0;
-            if ( !it->second ) continue;
-            std::vector<RuntimeObject*> & arr = *it->second;
+    //The cells of the grid have the average size of the objects.
+    SpatialHash & grid = buffers.GetGrid();
+    grid.Clear(totalSize/(bounds1.size()+bounds2.size()));
+    for(std::size_t n = 0;n<bounds2.size();++n)
+        grid.Insert(n, bounds2[n]);
+    grid.Prepare();
+
+    bool isTrue = false;
 
-            //*This is important*! We can have a list that has already been trimmed just before
-            if ( arr.size() != pickedList2[i].size() ) //If the size of the objects list != size of the boolean "picked" list...
-                continue; //... then the object list was already trimmed, skip it.
+    //Create a flag for each object
+    PickedObjectsFlags pickedList1(objectsLists1);
+    PickedObjectsFlags pickedList2(objectsLists2);
 
-            for(std::size_t k = 0;k<arr.size();++k)
-            {
-                RuntimeObject * obj = arr[k];
-                if ( pickedList2[i][k] )
-                {
-                    arr[finalSize] = obj;
-                    finalSize++;
+    //Launch the function for each object of the first list with the objects
+    //of the second list which are near it.
+    std::size_t i = 0;
+    std::size_t n = 0;
+    for(ObjectsListsView::const_iterator it = objectsLists1.begin();
+        it != objectsLists1.end();++it, ++i)
+    {
+        if ( !it->second ) continue;
+        const std::vector<RuntimeObject*> & arr1 = *it->second;
+
+        for(std::size_t k = 0;k<arr1.size();++k, ++n) {
+            bool atLeastOneObject = false;
+
+            grid.ForEachCandidate(bounds1[n], [&](std::size_t c) {
+                const Candidate & candidate = candidates[c];
+                if ( pickedList1.IsPicked(i, k) && pickedList2.IsPicked(candidate.list, candidate.index)) return; //Avoid unnecessary costly call to functor.
+
+                if ( arr1[k] != candidate.object && predicate(arr1[k], candidate.object) ) {
+                    if ( !negatePredicate ) {
+                        isTrue = true;
+
+                        //Pick the objects
+                        pickedList1.Pick(i, k);
+                        pickedList2.Pick(candidate.list, candidate.index);
+                    }
+
+                    atLeastOneObject = true;
                 }
+            });
+
+            if ( !atLeastOneObject && negatePredicate ) { //The object is not overlapping any other object.
+                isTrue = true;
+                pickedList1.Pick(i, k);
             }
-            arr.resize(finalSize);
         }
     }
 
+    //Trim not picked objects from lists.
+    pickedList1.TrimNotPickedObjects(objectsLists1);
+    if ( !negatePredicate ) pickedList2.TrimNotPickedObjects(objectsLists2);
+
     return isTrue;
 }
 #endif
@@ -14,6 +14,7 @@
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
 #include "GDCpp/Runtime/Project/Layout.h"
 #include "GDCpp/Runtime/Project/Project.h"
 #include "GDCpp/Runtime/Project/Object.h"
@@ -158,6 +159,9 @@ bool RuntimeScene::RenderAndStep()
     if( GetProfiler() && GetProfiler()->profilingActivated )
     {
         GetProfiler()->lastRenderingTime = GetProfiler()->renderingClock.getTimeMicroseconds();
+        GetProfiler()->lastDrawCallsCount = spriteBatchRenderer.GetDrawCallsCount();
+        GetProfiler()->lastPathfindingTime = GetProfiler()->pathfindingTime;
+        GetProfiler()->pathfindingTime = 0;
         GetProfiler()->totalSceneTime += GetProfiler()->lastRenderingTime + GetProfiler()->lastEventsTime;
         GetProfiler()->totalEventsTime += GetProfiler()->lastEventsTime;
         GetProfiler()->Update();
@@ -213,9 +217,8 @@ void RuntimeScene::Render()
 
     renderWindow->clear( sf::Color( GetBackgroundColorRed(), GetBackgroundColorGreen(), GetBackgroundColorBlue() ) );
 
-    //Sort object by order to render them
-    RuntimeObjList allObjects = objectsInstances.GetAllObjects();
-    OrderObjectsByZOrder(allObjects);
+    //Sort objects of each layer by Z order to render them
+    spriteBatchRenderer.Update(objectsInstances.GetAllObjects(), layers, !StandardSortMethod());
 
     #if !defined(ANDROID) //TODO: OpenGL
     //To allow using OpenGL to draw:
@@ -257,12 +260,8 @@ void RuntimeScene::Render()
                 //Prepare SFML rendering
                 renderWindow->setView(camera.GetSFMLView());
 
-                //Rendering all objects
-                for (std::size_t id = 0;id < allObjects.size();++id)
-                {
-                    if (allObjects[id]->GetLayer() == layers[layerIndex].GetName())
-                        allObjects[id]->Draw(*renderWindow);
-                }
+                //Rendering all objects of the layer
+                spriteBatchRenderer.DrawLayer(layerIndex, *renderWindow);
             }
         }
     }
@@ -275,14 +274,14 @@ void RuntimeScene::Render()
     renderWindow->display();
 }
 
-bool RuntimeScene::OrderObjectsByZOrder(RuntimeObjList & objList)
+bool RuntimeScene::OrderObjectsByZOrder(std::vector<RuntimeObject*> & objList)
 {
     if ( StandardSortMethod() )
-        std::sort( objList.begin(), objList.end(), [](const RuntimeObjSPtr & o1, const RuntimeObjSPtr & o2) {
+        std::sort( objList.begin(), objList.end(), [](const RuntimeObject * o1, const RuntimeObject * o2) {
             return o1->GetZOrder() < o2->GetZOrder();
         });
     else
-        std::stable_sort( objList.begin(), objList.end(), [](const RuntimeObjSPtr & o1, const RuntimeObjSPtr & o2) {
+        std::stable_sort( objList.begin(), objList.end(), [](const RuntimeObject * o1, const RuntimeObject * o2) {
             return o1->GetZOrder() < o2->GetZOrder();
         });
 
@@ -300,39 +299,75 @@ RuntimeLayer & RuntimeScene::GetRuntimeLayer(const gd::String & name)
     return badRuntimeLayer;
 }
 
+RuntimeLayer & RuntimeScene::GetRuntimeLayer(LayerId id)
+{
+    for (std::size_t i = 0;i<layers.size();++i)
+    {
+        if ( layers[i].GetId() == id )
+            return layers[i];
+    }
+
+    return badRuntimeLayer;
+}
+
 void RuntimeScene::ManageObjectsAfterEvents()
 {
-    //Delete objects that were removed.
-    RuntimeObjList allObjects = objectsInstances.GetAllObjects();
-    for (std::size_t id = 0;id<allObjects.size();++id)
+    //Delete objects that were removed: they have an empty name (see RuntimeObject::DeleteFromScene)
+    //so they are all in the same list, which is removed at once.
+    const RuntimeObjList & deletedObjects = objectsInstances.GetObjects("");
+    for (std::size_t id = 0;id<deletedObjects.size();++id)
     {
-    	if ( allObjects[id]->GetName().empty() )
-        {
-            for (std::size_t i = 0;i<extensionsToBeNotifiedOnObjectDeletion.size();++i)
-                extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(*this, allObjects[id].get());
+        for (std::size_t i = 0;i<extensionsToBeNotifiedOnObjectDeletion.size();++i)
+            extensionsToBeNotifiedOnObjectDeletion[i]->ObjectDeletedFromScene(*this, deletedObjects[id].get());
+    }
+    objectsInstances.RemoveObjects("");
 
-            objectsInstances.RemoveObject(allObjects[id]); //Remove from objects instances, not from the temporary list!
+    //Update objects positions and forces. The objects having forces are gathered with
+    //their resultant, so that only these objects are moved.
+    const RuntimeObjList & allObjects = objectsInstances.GetAllObjects();
+    double elapsedTime = static_cast<double>(timeManager.GetElapsedTime())/1000000.0;
+    objectsInstances.BeginIteration();
+    movedObjects.clear();
+    movedObjectsOffsetsX.clear();
+    movedObjectsOffsetsY.clear();
+    for (std::size_t id = 0, count = allObjects.size();id<count;++id)
+    {
+        RuntimeObject * object = allObjects[id].get();
+        float forceX = object->TotalForceX();
+        float forceY = object->TotalForceY();
+        if ( forceX != 0 || forceY != 0 )
+        {
+            movedObjects.push_back(object);
+            movedObjectsOffsetsX.push_back(forceX);
+            movedObjectsOffsetsY.push_back(forceY);
         }
+        object->UpdateForce(elapsedTime);
     }
 
-    //Update objects positions, forces and behaviors
-    allObjects = objectsInstances.GetAllObjects();
-    double elapsedTime = static_cast<double>(timeManager.GetElapsedTime())/1000000.0;
-    for (std::size_t id = 0;id<allObjects.size();++id)
+    for (std::size_t i = 0, count = movedObjects.size();i<count;++i)
     {
-        allObjects[id]->SetX( allObjects[id]->GetX() + (allObjects[id]->TotalForceX() * elapsedTime));
-        allObjects[id]->SetY( allObjects[id]->GetY() + (allObjects[id]->TotalForceY() * elapsedTime));
-        allObjects[id]->UpdateTime(elapsedTime);
-        allObjects[id]->UpdateForce(elapsedTime);
-        allObjects[id]->DoBehaviorsPostEvents(*this);
+        movedObjectsOffsetsX[i] *= elapsedTime;
+        movedObjectsOffsetsY[i] *= elapsedTime;
     }
+    for (std::size_t i = 0, count = movedObjects.size();i<count;++i)
+    {
+        RuntimeObject * object = movedObjects[i];
+        object->SetX( object->GetX() + movedObjectsOffsetsX[i] );
+        object->SetY( object->GetY() + movedObjectsOffsetsY[i] );
+    }
+
+    for (std::size_t id = 0, count = allObjects.size();id<count;++id)
+        allObjects[id]->UpdateTime(elapsedTime);
+    objectsInstances.EndIteration();
+
+    //Update behaviors, type by type
+    objectsInstances.StepBehaviorsPostEvents(*this);
 }
 
 void RuntimeScene::ManageObjectsBeforeEvents()
 {
-    RuntimeObjList allObjects = objectsInstances.GetAllObjects();
-    for (std::size_t id = 0;id<allObjects.size();++id)
-        allObjects[id]->DoBehaviorsPreEvents(*this);
+    //Update behaviors, type by type
+    objectsInstances.StepBehaviorsPreEvents(*this);
 }
 
 /**
@@ -419,6 +454,9 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances( const gd::Layout & scene, co
     objectsInstances.Clear();
     timeManager.Reset();
 
+    //Give an identifier to the names of objects, layers and behaviors
+    RuntimeNamesTable::Get()->InternNamesFrom(*game, scene);
+
     std::cout << ".";
     codeExecutionEngine->runtimeContext.scene = this;
     inputManager.DisableInputWhenFocusIsLost(IsInputDisabledWhenFocusIsLost());
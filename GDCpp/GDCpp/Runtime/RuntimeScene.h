@@ -15,6 +15,7 @@
 #include <SFML/System.hpp>
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
 #include "GDCpp/Runtime/RuntimeLayer.h"
+#include "GDCpp/Runtime/SpriteBatchRenderer.h"
 #include "GDCpp/Runtime/TimeManager.h"
 #include "GDCpp/Runtime/InputManager.h"
 #include "GDCpp/Runtime/BehaviorsRuntimeSharedDataHolder.h"
@@ -96,6 +97,11 @@ public:
      */
     RuntimeLayer & GetRuntimeLayer(const gd::String & name);
 
+    /**
+     * Get the layer with specified name identifier.
+     */
+    RuntimeLayer & GetRuntimeLayer(LayerId id);
+
     /**
      * \brief Return the shared data for a behavior.
      * \warning Be careful, no check is made to ensure that the shared data exist.
@@ -188,6 +194,17 @@ public:
     SceneChange GetRequestedChange() { return requestedChange; }
     void RequestChange(SceneChange::Change change, gd::String sceneName = "");
 
+    /**
+     * \brief Request the images of a scene to be loaded in background (see SceneStack::Prefetch).
+     */
+    void RequestPrefetch(const gd::String & sceneName) { requestedPrefetches.push_back(sceneName); }
+
+    /**
+     * \brief Return the scenes requested to be preloaded since the last call to ClearRequestedPrefetches.
+     */
+    const std::vector<gd::String> & GetRequestedPrefetches() const { return requestedPrefetches; }
+    void ClearRequestedPrefetches() { requestedPrefetches.clear(); }
+
 protected:
 
     /**
@@ -198,7 +215,7 @@ protected:
     /**
      * \brief Order an object list according to object's Z coordinate.
      */
-    bool OrderObjectsByZOrder( RuntimeObjList & objList );
+    bool OrderObjectsByZOrder( std::vector<RuntimeObject*> & objList );
 
     /**
      * \brief Render a frame in the window
@@ -228,8 +245,13 @@ protected:
     std::vector < ExtensionBase * >         extensionsToBeNotifiedOnObjectDeletion; ///< List, built during LoadFromScene, containing a list of extensions which must be notified when an object is deleted.
     BehaviorsRuntimeSharedDataHolder        behaviorsSharedDatas; ///<Contains all behaviors shared datas.
     std::vector < RuntimeLayer >            layers; ///< The layers used at runtime to display the scene.
+    SpriteBatchRenderer                     spriteBatchRenderer; ///< Render the objects layer by layer, sorted by Z order. Kept between frames to sort objects incrementally.
+    std::vector < RuntimeObject * >         movedObjects; ///< Used by ManageObjectsAfterEvents: the objects having forces.
+    std::vector < double >                  movedObjectsOffsetsX; ///< Used by ManageObjectsAfterEvents: the X offset of each object of movedObjects.
+    std::vector < double >                  movedObjectsOffsetsY; ///< Used by ManageObjectsAfterEvents: the Y offset of each object of movedObjects.
     std::shared_ptr<CodeExecutionEngine>    codeExecutionEngine;
     SceneChange                             requestedChange; ///< What should be done at the end of the frame.
+    std::vector<gd::String>                 requestedPrefetches; ///< The scenes to be preloaded at the end of the frame.
     sf::Clock                               clock; ///< The clock used to track time.
 
     static RuntimeLayer badRuntimeLayer; ///< Null object return by GetLayer when no appropriate layer could be found.
@@ -48,6 +48,8 @@ RuntimeSpriteObject::RuntimeSpriteObject(RuntimeScene & scene, const gd::SpriteO
     animationSpeedScale(1.f),
     ptrToCurrentSprite( NULL ),
     needUpdateCurrentSprite(true),
+    needUpdateHitBoxes(true),
+    needUpdateCollisionPolygons(true),
     opacity( 255 ),
     blendMode(0),
     isFlippedX(false),
@@ -97,14 +99,24 @@ bool RuntimeSpriteObject::Draw( sf::RenderTarget & renderTarget )
     //Don't draw anything if hidden
     if ( hidden ) return true;
 
-    renderTarget.draw( GetCurrentSFMLSprite(), sf::RenderStates(blendMode == 0 ? sf::BlendAlpha :
-                                                               (blendMode == 1 ? sf::BlendAdd :
-                                                               (blendMode == 2 ? sf::BlendMultiply :
-                                                                sf::BlendNone))));
+    sf::BlendMode sfmlBlendMode;
+    renderTarget.draw( *GetSpriteForBatching(sfmlBlendMode), sf::RenderStates(sfmlBlendMode));
 
     return true;
 }
 
+const sf::Sprite * RuntimeSpriteObject::GetSpriteForBatching(sf::BlendMode & sfmlBlendMode) const
+{
+    if ( hidden ) return NULL;
+
+    sfmlBlendMode = blendMode == 0 ? sf::BlendAlpha :
+                   (blendMode == 1 ? sf::BlendAdd :
+                   (blendMode == 2 ? sf::BlendMultiply :
+                    sf::BlendNone));
+
+    return &GetCurrentSFMLSprite();
+}
+
 float RuntimeSpriteObject::GetDrawableX() const
 {
     return X - GetCurrentSprite().GetOrigin().GetX()*fabs(scaleX);
@@ -245,12 +257,14 @@ void RuntimeSpriteObject::CopyImageOnImageOfCurrentSprite(RuntimeScene & scene,
     std::shared_ptr<SFMLTextureWrapper> dest = ptrToCurrentSprite->GetSFMLTexture();
 
     //Make sure the coordinates are correct.
-    if ( xPosition < 0 || static_cast<unsigned>(xPosition) >= dest->texture.getSize().x) return;
-    if ( yPosition < 0 || static_cast<unsigned>(yPosition) >= dest->texture.getSize().y) return;
+    const sf::IntRect destRect = dest->GetDisplayedTextureRect();
+    if ( xPosition < 0 || xPosition >= destRect.width) return;
+    if ( yPosition < 0 || yPosition >= destRect.height) return;
 
     //Update texture and pixel perfect collision mask
     dest->image.copy(scene.GetImageManager()->GetSFMLTexture(imageName)->image, xPosition, yPosition, sf::IntRect(0, 0, 0, 0), useTransparency);
     dest->texture.loadFromImage(dest->image);
+    dest->InvalidateAlphaMask();
 }
 
 void RuntimeSpriteObject::MakeColorTransparent( const gd::String & colorStr )
@@ -267,6 +281,7 @@ void RuntimeSpriteObject::MakeColorTransparent( const gd::String & colorStr )
     //Update texture and pixel perfect collision mask
     dest->image.createMaskFromColor(  sf::Color( colors[0].To<int>(), colors[1].To<int>(), colors[2].To<int>()));
     dest->texture.loadFromImage(dest->image);
+    dest->InvalidateAlphaMask();
 }
 
 void RuntimeSpriteObject::SetColor(const gd::String & colorStr)
@@ -315,12 +330,14 @@ void RuntimeSpriteObject::UpdateCurrentSprite() const
     ptrToCurrentSprite->GetSFMLSprite().setColor( sf::Color( colorR, colorV, colorB, opacity ) );
 
     needUpdateCurrentSprite = false;
+    needUpdateHitBoxes = true;
 }
 
 void RuntimeSpriteObject::UpdateTime(float elapsedTime)
 {
     if ( animationStopped || currentAnimation >= GetAnimationsCount() ) return;
 
+    std::size_t oldSprite = currentSprite;
     timeElapsedOnCurrentSprite += elapsedTime * animationSpeedScale;
 
     const gd::Direction & direction = animations[currentAnimation].Get().GetDirection( currentDirection );
@@ -344,7 +361,7 @@ void RuntimeSpriteObject::UpdateTime(float elapsedTime)
         else  currentSprite = direction.GetSpritesCount() - 1;
     }
 
-    needUpdateCurrentSprite = true;
+    if ( currentSprite != oldSprite ) needUpdateCurrentSprite = true; //Avoid updating the sprite and its hitboxes if the frame is the same.
 }
 
 const sf::Sprite & RuntimeSpriteObject::GetCurrentSFMLSprite() const
@@ -363,26 +380,74 @@ const gd::Sprite & RuntimeSpriteObject::GetCurrentSprite() const
 
 std::vector<Polygon2d> RuntimeSpriteObject::GetHitBoxes() const
 {
+    return GetHitBoxesWithEdges(sf::FloatRect());
+}
+
+const std::vector<Polygon2d> & RuntimeSpriteObject::GetHitBoxesWithEdges(sf::FloatRect) const
+{
+    const sf::Sprite & currentSFMLSprite = GetCurrentSFMLSprite(); //Update the current sprite if needed.
+    if ( !needUpdateHitBoxes ) return hitBoxes;
+
+    needUpdateHitBoxes = false;
+    needUpdateCollisionPolygons = true;
     if ( currentAnimation >= animations.size() )
     {
-        std::vector<Polygon2d> hitboxes; //Invalid animation, bail out.
-        return hitboxes;
+        hitBoxes.clear(); //Invalid animation, bail out.
+        return hitBoxes;
     }
-    const sf::Sprite & currentSFMLSprite = GetCurrentSFMLSprite();
 
-    std::vector<Polygon2d> polygons = GetCurrentSprite().GetCollisionMask();
-    for (std::size_t i = 0;i<polygons.size();++i)
+    //Transform the collision mask of the sprite, reusing the memory of the previous hitboxes.
+    //The mask is not copied: the automatic mask is the bounding box of the sprite, and the
+    //custom mask is read from the sprite.
+    const sf::Transform & transform = currentSFMLSprite.getTransform();
+    const sf::FloatRect localBounds = currentSFMLSprite.getLocalBounds();
+    auto transformVertex = [&](float x, float y) {
+        return transform.transformPoint(
+            !isFlippedX ? x : localBounds.width-x,
+            !isFlippedY ? y : localBounds.height-y);
+    };
+
+    const gd::Sprite & sprite = GetCurrentSprite();
+    if ( sprite.IsCollisionMaskAutomatic() )
     {
-        for (std::size_t j = 0;j<polygons[i].vertices.size();++j)
-        {
-            sf::Vector2f newVertice = currentSFMLSprite.getTransform().transformPoint(
-                            !isFlippedX ? polygons[i].vertices[j].x : GetCurrentSprite().GetSFMLSprite().getLocalBounds().width-polygons[i].vertices[j].x,
-                            !isFlippedY ? polygons[i].vertices[j].y : GetCurrentSprite().GetSFMLSprite().getLocalBounds().height-polygons[i].vertices[j].y);
-            polygons[i].vertices[j] = newVertice;
-        }
+        const sf::FloatRect spriteBounds = sprite.GetSFMLSprite().getLocalBounds();
+        hitBoxes.resize(1);
+        hitBoxes[0].vertices.resize(4);
+        hitBoxes[0].vertices[0] = transformVertex(0, 0);
+        hitBoxes[0].vertices[1] = transformVertex(spriteBounds.width, 0);
+        hitBoxes[0].vertices[2] = transformVertex(spriteBounds.width, spriteBounds.height);
+        hitBoxes[0].vertices[3] = transformVertex(0, spriteBounds.height);
+        hitBoxes[0].ComputeEdges();
+
+        return hitBoxes;
+    }
+
+    const std::vector<Polygon2d> & mask = sprite.GetCustomCollisionMask();
+    hitBoxes.resize(mask.size());
+    for (std::size_t i = 0;i<mask.size();++i)
+    {
+        const std::vector<sf::Vector2f> & maskVertices = mask[i].vertices;
+        hitBoxes[i].vertices.resize(maskVertices.size());
+        for (std::size_t j = 0;j<maskVertices.size();++j)
+            hitBoxes[i].vertices[j] = transformVertex(maskVertices[j].x, maskVertices[j].y);
+
+        hitBoxes[i].ComputeEdges();
     }
 
-    return polygons;
+    return hitBoxes;
+}
+
+const std::vector<CollisionPolygon> & RuntimeSpriteObject::GetCollisionPolygons(sf::FloatRect hint) const
+{
+    const std::vector<Polygon2d> & currentHitBoxes = GetHitBoxesWithEdges(hint); //Update the hitboxes if needed.
+    if ( !needUpdateCollisionPolygons ) return collisionPolygons;
+
+    needUpdateCollisionPolygons = false;
+    collisionPolygons.resize(currentHitBoxes.size());
+    for (std::size_t i = 0;i<currentHitBoxes.size();++i)
+        collisionPolygons[i].Set(currentHitBoxes[i]);
+
+    return collisionPolygons;
 }
 
 bool RuntimeSpriteObject::SetSprite( std::size_t nb )
@@ -555,7 +620,7 @@ bool RuntimeSpriteObject::CursorOnObject(RuntimeScene & scene, bool accurate)
     accurate = false;
     #endif
 
-    RuntimeLayer & theLayer = scene.GetRuntimeLayer(layer);
+    RuntimeLayer & theLayer = scene.GetRuntimeLayer(layerId);
     auto insideObject = [this, accurate](const sf::Vector2f & pos) {
         if (GetDrawableX() <= pos.x
             && GetDrawableX() + GetWidth()  >= pos.x
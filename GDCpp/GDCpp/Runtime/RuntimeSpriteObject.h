@@ -58,6 +58,7 @@ public:
     virtual bool ExtraInitializationFromInitialInstance(const gd::InitialInstance & position);
 
     virtual bool Draw(sf::RenderTarget & renderTarget);
+    virtual const sf::Sprite * GetSpriteForBatching(sf::BlendMode & blendMode) const;
 
     #if defined(GD_IDE_ONLY)
     virtual void GetPropertyForDebugger (std::size_t propertyNb, gd::String & name, gd::String & value) const;
@@ -84,6 +85,8 @@ public:
     virtual float GetAngle() const;
 
     virtual std::vector<Polygon2d> GetHitBoxes() const;
+    virtual const std::vector<Polygon2d> & GetHitBoxesWithEdges(sf::FloatRect hint) const;
+    virtual const std::vector<CollisionPolygon> & GetCollisionPolygons(sf::FloatRect hint) const;
     virtual bool CursorOnObject(RuntimeScene & scene, bool accurate);
 
     /**
@@ -314,6 +317,11 @@ private:
     mutable gd::Sprite * ptrToCurrentSprite; //Pointer to the current sprite
     mutable bool needUpdateCurrentSprite;
 
+    mutable std::vector<Polygon2d> hitBoxes; ///< The hitboxes of the current sprite, transformed to scene coordinates, with their edges computed.
+    mutable bool needUpdateHitBoxes; ///< True if the hitboxes must be updated (the current sprite was changed or updated).
+    mutable std::vector<CollisionPolygon> collisionPolygons; ///< The hitboxes, prepared for fast collision tests.
+    mutable bool needUpdateCollisionPolygons; ///< True if collisionPolygons must be updated from the hitboxes.
+
     std::vector < AnimationProxy > animations;
 
     float opacity;
@@ -5,6 +5,7 @@
  */
 #include <iostream>
 #include <string>
+#include <unordered_map>
 #include "GDCore/Project/Variable.h"
 #include "GDCore/TinyXml/tinyxml.h"
 #include "GDCore/Project/VariablesContainer.h"
@@ -26,9 +27,40 @@ RuntimeVariablesContainer& RuntimeVariablesContainer::operator=(const gd::Variab
     return *this;
 }
 
+RuntimeVariablesContainer::RuntimeVariablesContainer(const RuntimeVariablesContainer & other)
+{
+    Init(other);
+}
+
+RuntimeVariablesContainer& RuntimeVariablesContainer::operator=(const RuntimeVariablesContainer & other)
+{
+    if ( this != &other )
+    {
+        Clear();
+        Init(other);
+    }
+
+    return *this;
+}
+
+void RuntimeVariablesContainer::Init(const RuntimeVariablesContainer & other)
+{
+    std::unordered_map<const gd::Variable*, gd::Variable*> copies;
+    for(std::map < gd::String, gd::Variable* >::const_iterator it = other.variables.begin();it != other.variables.end();++it)
+    {
+        gd::Variable * newVariable = new gd::Variable(*it->second);
+        variables[it->first] = newVariable;
+        copies[it->second] = newVariable;
+    }
+
+    for (std::size_t i = 0;i<other.variablesArray.size();++i)
+        variablesArray.push_back(copies[other.variablesArray[i]]);
+}
+
 void RuntimeVariablesContainer::Clear()
 {
     variablesArray.clear();
+    variablesByNameId.clear();
     for(std::map < gd::String, gd::Variable* >::iterator it = variables.begin();it != variables.end();++it)
         delete it->second;
     variables.clear();
@@ -73,6 +105,15 @@ const gd::Variable & RuntimeVariablesContainer::Get(const gd::String & name) con
     return *newVariable;
 }
 
+gd::Variable & RuntimeVariablesContainer::RegisterNameId(VariableNameId nameId)
+{
+    gd::Variable & variable = Get(RuntimeNamesTable::Get()->GetVariableName(nameId));
+    if ( nameId >= variablesByNameId.size() ) variablesByNameId.resize(nameId+1, NULL);
+    variablesByNameId[nameId] = &variable;
+
+    return variable;
+}
+
 gd::Variable & RuntimeVariablesContainer::GetBadVariable()
 {
     return badVariable;
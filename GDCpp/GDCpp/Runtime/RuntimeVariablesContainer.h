@@ -10,6 +10,7 @@
 #include <map>
 #include <vector>
 #include "GDCore/Project/Variable.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
 namespace gd { class VariablesContainer; };
 class BadRuntimeVariablesContainer;
 class BadVariable;
@@ -41,6 +42,16 @@ public:
      */
     RuntimeVariablesContainer() {};
 
+    /**
+     * \brief Copy constructor: the variables are copied.
+     */
+    RuntimeVariablesContainer(const RuntimeVariablesContainer & other);
+
+    /**
+     * \brief Assignment operator: the variables are copied.
+     */
+    RuntimeVariablesContainer& operator=(const RuntimeVariablesContainer & other);
+
     /**
      * \brief Initialize a RuntimeVariablesContainer from a gd::VariablesContainer.
      *
@@ -91,6 +102,20 @@ public:
      */
     virtual const gd::Variable & Get(std::size_t index) const { return *variablesArray[index]; }
 
+    /**
+     * \brief Return a reference to the variable whose name has the specified identifier (see RuntimeNamesTable).
+     *
+     * The variable is created if it does not exist. Once the variable was returned, getting it again
+     * is done in constant time, without comparing strings.
+     * \note This specific overload can used by code generated from events when the variable is not declared,
+     * so that its index is not known at the time of the code generation.
+     */
+    virtual gd::Variable & GetByNameId(VariableNameId nameId)
+    {
+        if ( nameId < variablesByNameId.size() && variablesByNameId[nameId] ) return *variablesByNameId[nameId];
+        return RegisterNameId(nameId);
+    }
+
     /**
      * \brief Return a "bad" variable that can be used when no other valid variable can be used.
      */
@@ -122,8 +147,20 @@ private:
      */
     void Clear();
 
+    /**
+     * \brief Copy the variables of another container.
+     */
+    void Init(const RuntimeVariablesContainer & other);
+
+    /**
+     * \brief Get (or create) the variable having the name with the specified identifier, and
+     * store it in variablesByNameId.
+     */
+    gd::Variable & RegisterNameId(VariableNameId nameId);
+
     std::vector < gd::Variable* > variablesArray;
     mutable std::map < gd::String, gd::Variable* > variables;
+    std::vector < gd::Variable* > variablesByNameId; ///< The variables returned by GetByNameId, indexed by the identifiers of their names (NULL for other names).
     static BadVariable badVariable;
     static BadRuntimeVariablesContainer badVariablesContainer;
 };
@@ -166,6 +203,7 @@ public:
     virtual const gd::Variable & Get(const gd::String & name) const { return RuntimeVariablesContainer::GetBadVariable(); }
     virtual gd::Variable & Get(std::size_t index) { return RuntimeVariablesContainer::GetBadVariable(); }
     virtual const gd::Variable & Get(std::size_t index) const { return RuntimeVariablesContainer::GetBadVariable(); }
+    virtual gd::Variable & GetByNameId(VariableNameId nameId) { return RuntimeVariablesContainer::GetBadVariable(); }
     virtual void Merge(const gd::VariablesContainer & container) {}
 };
 
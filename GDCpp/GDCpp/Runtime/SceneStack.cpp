@@ -14,7 +14,15 @@ bool SceneStack::Step()
 	if (stack.empty()) return false;
 
 	auto scene = stack.back();
-	if (scene->RenderAndStep())
+	bool changeRequested = scene->RenderAndStep();
+
+	//Start loading the scenes requested by the events before changing the scene,
+	//so that the images shared with the next scene are kept.
+	for (std::size_t i = 0;i<scene->GetRequestedPrefetches().size();++i)
+		Prefetch(scene->GetRequestedPrefetches()[i]);
+	scene->ClearRequestedPrefetches();
+
+	if (changeRequested)
 	{
 		auto request = scene->GetRequestedChange();
         if (request.change == RuntimeScene::SceneChange::STOP_GAME) {
@@ -33,6 +41,7 @@ bool SceneStack::Step()
         }
 	}
 
+	preloader.Update(game, sf::milliseconds(4));
 	return true;
 }
 
@@ -53,8 +62,14 @@ std::shared_ptr<RuntimeScene> SceneStack::Push(gd::String newSceneName)
         return std::shared_ptr<RuntimeScene>();
     }
 
+    //Decode the images of the scene in parallel, if they were not already prefetched.
+    Prefetch(newSceneName);
+    preloader.Finish(game);
+
 	auto newScene = std::make_shared<RuntimeScene>(window, &game);
-    if (!newScene->LoadFromScene(game.GetLayout(newSceneName)))
+    bool loaded = newScene->LoadFromScene(game.GetLayout(newSceneName));
+    preloader.ReleaseTextures(); //Textures are now kept alive by the objects of the scene.
+    if (!loaded)
     {
         if (errorCallback) errorCallback("Unable to load scene \"" + newSceneName + "\".");
         return std::shared_ptr<RuntimeScene>();
@@ -73,6 +88,9 @@ std::shared_ptr<RuntimeScene> SceneStack::Push(gd::String newSceneName)
 
 std::shared_ptr<RuntimeScene> SceneStack::Replace(gd::String newSceneName, bool clear)
 {
+    //Keep the images shared with the new scene before the current scenes are destroyed.
+    Prefetch(newSceneName);
+
     if (clear)
     {
         while (!stack.empty()) stack.pop_back();
@@ -83,3 +101,10 @@ std::shared_ptr<RuntimeScene> SceneStack::Replace(gd::String newSceneName, bool
     }
 	return Push(newSceneName);
 }
+
+void SceneStack::Prefetch(const gd::String & sceneName)
+{
+    if (!game.HasLayoutNamed(sceneName)) return;
+
+    preloader.Preload(game.GetLayout(sceneName).GetResourcesManifest(), game);
+}
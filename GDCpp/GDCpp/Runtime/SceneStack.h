@@ -7,6 +7,7 @@
 #include <functional>
 #include <memory>
 #include <GDCpp/Runtime/String.h>
+#include <GDCpp/Runtime/ResourcesPreloader.h>
 class RuntimeGame;
 class RuntimeScene;
 namespace sf { class RenderWindow; }
@@ -32,8 +33,10 @@ public:
 	/**
 	 * \brief Execute one step of the game.
 	 *
-	 * RuntimeScene::RenderAndStep is called on the current scene. If a scene change was requested,
-	 * the stack is updated.
+	 * RuntimeScene::RenderAndStep is called on the current scene. The scenes to be preloaded by the
+	 * scene (see RuntimeScene::RequestPrefetch) are prefetched and, if a scene change was requested,
+	 * the stack is updated. The images being preloaded (see Prefetch) are given a few milliseconds
+	 * to be uploaded.
 	 *
 	 * This method is typically called in a loop until it returns false.
 	 * \return false if game must be stopped.
@@ -64,6 +67,17 @@ public:
 	 */
 	std::shared_ptr<RuntimeScene> Replace(gd::String newSceneName, bool clear = false);
 
+	/**
+	 * \brief Start loading in background the images used by a scene, while the current scene
+	 * is played, so that launching it with Push or Replace is faster.
+	 *
+	 * Loaded images are kept in memory until the next scene is launched.
+	 * Events can prefetch a scene using the "Preload a scene" action.
+	 * \param sceneName The name of the scene, as found in the RuntimeGame.
+	 * \see gd::Layout::GetResourcesManifest
+	 */
+	void Prefetch(const gd::String & sceneName);
+
 	/**
 	 * \brief Set the callback called when an error occurs (loading failed...)
 	 */
@@ -78,6 +92,7 @@ private:
 	RuntimeGame & game;
 	sf::RenderWindow * window;
 	std::vector<std::shared_ptr<RuntimeScene>> stack;
+	ResourcesPreloader preloader;
 	std::function<void(gd::String)> errorCallback;
 	std::function<bool(std::shared_ptr<RuntimeScene>)> loadCallback;
 };
@@ -0,0 +1,71 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/SpatialHash.h"
+#include <cmath>
+
+SpatialHash::SpatialHash() :
+    cellSize(1),
+    queryStamp(1)
+{
+}
+
+void SpatialHash::Clear(float cellSize_)
+{
+    cellSize = cellSize_ > 0 && std::isfinite(cellSize_) ? cellSize_ : 1;
+    entries.clear();
+    largeItems.clear();
+    itemsStamps.clear();
+}
+
+void SpatialHash::Insert(std::size_t item, const sf::FloatRect & bounds)
+{
+    if ( item >= itemsStamps.size() ) itemsStamps.resize(item+1, 0);
+    itemsStamps[item] = queryStamp;
+
+    int left, top, right, bottom;
+    if ( !GetCellsRange(bounds, left, top, right, bottom) )
+    {
+        largeItems.push_back(item);
+        return;
+    }
+
+    for (int x = left;x<=right;++x)
+    {
+        for (int y = top;y<=bottom;++y)
+        {
+            Entry entry = {GetCellKey(x, y), item};
+            entries.push_back(entry);
+        }
+    }
+}
+
+void SpatialHash::Prepare()
+{
+    std::sort(entries.begin(), entries.end());
+}
+
+bool SpatialHash::GetCellsRange(const sf::FloatRect & bounds, int & left, int & top, int & right, int & bottom) const
+{
+    //Cells coordinates are clamped to a range that fits in an int.
+    const double maxCoordinate = 1e9;
+    double x1 = std::floor(bounds.left/cellSize);
+    double y1 = std::floor(bounds.top/cellSize);
+    double x2 = std::floor((bounds.left+bounds.width)/cellSize);
+    double y2 = std::floor((bounds.top+bounds.height)/cellSize);
+    if ( !(std::fabs(x1) < maxCoordinate && std::fabs(y1) < maxCoordinate &&
+           std::fabs(x2) < maxCoordinate && std::fabs(y2) < maxCoordinate) )
+        return false;
+
+    if ( x2 < x1 ) std::swap(x1, x2);
+    if ( y2 < y1 ) std::swap(y1, y2);
+    if ( (x2-x1+1)*(y2-y1+1) > maxCellsPerItem ) return false;
+
+    left = static_cast<int>(x1);
+    top = static_cast<int>(y1);
+    right = static_cast<int>(x2);
+    bottom = static_cast<int>(y2);
+    return true;
+}
@@ -0,0 +1,125 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_SPATIALHASH_H
+#define GDCPP_SPATIALHASH_H
+
+#include <vector>
+#include <algorithm>
+#include <SFML/Graphics/Rect.hpp>
+
+/**
+ * \brief A uniform grid used to quickly find the items whose bounds are overlapping an area.
+ *
+ * Items are identified by an index (starting from 0) and are inserted with their bounds. Once all
+ * the items are inserted, call Prepare() before querying the grid with ForEachCandidate.
+ *
+ * Cells are not allocated separately: the grid is stored as a sorted list of (cell, item) entries,
+ * so that it can be rebuilt at each query of the events without allocating memory once the internal
+ * buffers are large enough.
+ *
+ * \see TwoObjectListsTestWithBroadphase
+ *
+ * \ingroup GameEngine
+ */
+class GD_API SpatialHash
+{
+public:
+    SpatialHash();
+    virtual ~SpatialHash() {};
+
+    /**
+     * \brief Remove all the items and change the size of the cells of the grid.
+     * \param cellSize The size of a (square) cell. Should be approximately the size of the items.
+     */
+    void Clear(float cellSize);
+
+    /**
+     * \brief Insert an item in the grid.
+     * \param item The index identifying the item.
+     * \param bounds The bounding box of the item.
+     */
+    void Insert(std::size_t item, const sf::FloatRect & bounds);
+
+    /**
+     * \brief Must be called after inserting the items and before querying the grid.
+     */
+    void Prepare();
+
+    /**
+     * \brief Call the function for each item whose cells are overlapping the area.
+     *
+     * The function is called only once per item, but can be called for items not overlapping exactly the area:
+     * the caller must do the exact test.
+     */
+    template <typename F>
+    void ForEachCandidate(const sf::FloatRect & area, F function)
+    {
+        queryStamp++;
+        int left, top, right, bottom;
+        if ( !GetCellsRange(area, left, top, right, bottom) )
+        {
+            //The area is too large: all items are candidates.
+            for (std::size_t item = 0;item<itemsStamps.size();++item)
+            {
+                if ( itemsStamps[item] != 0 ) function(item);
+            }
+            return;
+        }
+
+        for (int x = left;x<=right;++x)
+        {
+            for (int y = top;y<=bottom;++y)
+            {
+                Entry searched = {GetCellKey(x, y), 0};
+                std::vector<Entry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), searched);
+                for (;it != entries.end() && it->cell == searched.cell;++it)
+                    Visit(it->item, function);
+            }
+        }
+        for (std::size_t i = 0;i<largeItems.size();++i)
+            Visit(largeItems[i], function);
+    }
+
+    /**
+     * \brief The maximum number of cells covered by an item before it is considered as a "large" item,
+     * tested against all queries.
+     */
+    static const int maxCellsPerItem = 64;
+
+private:
+    struct Entry
+    {
+        long long cell;
+        std::size_t item;
+
+        bool operator<(const Entry & other) const { return cell < other.cell || (cell == other.cell && item < other.item); }
+    };
+
+    template <typename F>
+    void Visit(std::size_t item, F & function)
+    {
+        if ( itemsStamps[item] == queryStamp ) return;
+
+        itemsStamps[item] = queryStamp;
+        function(item);
+    }
+
+    /**
+     * \brief Compute the range of cells covered by bounds.
+     * \return false if the bounds are covering too much cells (or are invalid).
+     */
+    bool GetCellsRange(const sf::FloatRect & bounds, int & left, int & top, int & right, int & bottom) const;
+
+    static long long GetCellKey(int x, int y) { return (static_cast<long long>(x) << 32) | static_cast<unsigned int>(y); }
+
+    float cellSize;
+    std::vector<Entry> entries; ///< The cells covered by each item, sorted by cell.
+    std::vector<std::size_t> largeItems; ///< Items covering too much cells.
+    std::vector<std::size_t> itemsStamps; ///< For each item, the last query that visited it (0 if the item was not inserted).
+    std::size_t queryStamp; ///< Incremented at each query to avoid visiting an item more than once.
+};
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/Runtime/SpriteBatchRenderer.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeLayer.h"
+
+namespace
+{
+
+/**
+ * \brief Return the bounding box of the area displayed by the view.
+ */
+sf::FloatRect GetViewBounds(const sf::View & view)
+{
+    float angle = view.getRotation()*3.14159265f/180.0f;
+    float cosAngle = std::fabs(std::cos(angle));
+    float sinAngle = std::fabs(std::sin(angle));
+    float width = view.getSize().x*cosAngle + view.getSize().y*sinAngle;
+    float height = view.getSize().x*sinAngle + view.getSize().y*cosAngle;
+
+    return sf::FloatRect(view.getCenter().x-width/2, view.getCenter().y-height/2, width, height);
+}
+
+bool AreOverlapping(const sf::FloatRect & a, const sf::FloatRect & b)
+{
+    return a.left <= b.left+b.width && b.left <= a.left+a.width &&
+        a.top <= b.top+b.height && b.top <= a.top+a.height;
+}
+
+}
+
+SpriteBatchRenderer::SpriteBatchRenderer() :
+    batchTexture(NULL),
+    drawCallsCount(0)
+{
+}
+
+void SpriteBatchRenderer::Update(const RuntimeObjList & allObjects, const std::vector<RuntimeLayer> & layers, bool stableSort)
+{
+    drawCallsCount = 0;
+
+    layersIndices.clear();
+    layersObjects.resize(layers.size());
+    for (std::size_t i = 0;i<layers.size();++i)
+    {
+        if ( layers[i].GetId() >= layersIndices.size() ) layersIndices.resize(layers[i].GetId()+1, gd::String::npos);
+        layersIndices[layers[i].GetId()] = i;
+
+        LayerObjects & layer = layersObjects[i];
+        layer.previousPositions.assign(layer.objects.size(), NULL);
+        layer.addedObjects.clear();
+    }
+
+    //Put back each object at the position it had in the previous frame, if it is still
+    //in the same layer. The position is only a hint, used if it is not already taken.
+    for (std::size_t i = 0;i<allObjects.size();++i)
+    {
+        RuntimeObject * object = allObjects[i].get();
+        object->renderingOrder = i;
+        LayerId layerId = object->GetLayerId();
+        if ( layerId >= layersIndices.size() || layersIndices[layerId] == gd::String::npos ) continue;
+
+        std::size_t layerIndex = layersIndices[layerId];
+        LayerObjects & layer = layersObjects[layerIndex];
+        if ( object->renderingLayer == layerIndex && object->renderingPosition < layer.previousPositions.size() &&
+             layer.previousPositions[object->renderingPosition] == NULL )
+            layer.previousPositions[object->renderingPosition] = object;
+        else
+            layer.addedObjects.push_back(object);
+    }
+
+    for (std::size_t i = 0;i<layersObjects.size();++i)
+    {
+        LayerObjects & layer = layersObjects[i];
+        layer.objects.clear();
+        for (std::size_t j = 0;j<layer.previousPositions.size();++j)
+            if ( layer.previousPositions[j] ) layer.objects.push_back(layer.previousPositions[j]);
+        layer.objects.insert(layer.objects.end(), layer.addedObjects.begin(), layer.addedObjects.end());
+
+        SortByZOrder(layer.objects, stableSort);
+        for (std::size_t j = 0;j<layer.objects.size();++j)
+        {
+            layer.objects[j]->renderingLayer = i;
+            layer.objects[j]->renderingPosition = j;
+        }
+    }
+}
+
+void SpriteBatchRenderer::SortByZOrder(std::vector<RuntimeObject*> & objects, bool stableSort)
+{
+    //Objects having the same Z order are sorted by their position in the list of all objects,
+    //so that the result does not depend on the order of the previous frame.
+    auto isBefore = [stableSort](const RuntimeObject * o1, const RuntimeObject * o2) {
+        if ( o1->GetZOrder() != o2->GetZOrder() ) return o1->GetZOrder() < o2->GetZOrder();
+        return stableSort && o1->renderingOrder < o2->renderingOrder;
+    };
+
+    std::size_t movesCount = 0;
+    const std::size_t maxMovesCount = 8*objects.size();
+    for (std::size_t i = 1;i<objects.size();++i)
+    {
+        RuntimeObject * object = objects[i];
+
+        std::size_t j = i;
+        for (;j>0 && isBefore(object, objects[j-1]);--j)
+            objects[j] = objects[j-1];
+        objects[j] = object;
+
+        movesCount += i-j;
+        if ( movesCount > maxMovesCount ) //The objects are too far from being sorted.
+        {
+            std::sort(objects.begin(), objects.end(), isBefore);
+            return;
+        }
+    }
+}
+
+void SpriteBatchRenderer::DrawLayer(std::size_t layerIndex, sf::RenderTarget & renderTarget)
+{
+    sf::FloatRect viewBounds = GetViewBounds(renderTarget.getView());
+    const std::vector<RuntimeObject*> & objects = layersObjects[layerIndex].objects;
+    for (std::size_t i = 0;i<objects.size();++i)
+    {
+        sf::BlendMode blendMode;
+        const sf::Sprite * sprite = objects[i]->GetSpriteForBatching(blendMode);
+        if ( sprite )
+        {
+            if ( AreOverlapping(objects[i]->GetAABB(), viewBounds) )
+                AddToBatch(*sprite, blendMode, renderTarget);
+        }
+        else
+        {
+            DrawBatch(renderTarget);
+            objects[i]->Draw(renderTarget);
+            if ( !objects[i]->IsHidden() ) drawCallsCount++;
+        }
+    }
+
+    DrawBatch(renderTarget);
+}
+
+void SpriteBatchRenderer::AddToBatch(const sf::Sprite & sprite, const sf::BlendMode & blendMode, sf::RenderTarget & renderTarget)
+{
+    if ( !sprite.getTexture() ) return;
+    if ( sprite.getTexture() != batchTexture || blendMode != batchBlendMode )
+    {
+        DrawBatch(renderTarget);
+        batchTexture = sprite.getTexture();
+        batchBlendMode = blendMode;
+    }
+
+    //Same vertices as the ones of sf::Sprite, transformed in the scene.
+    const sf::IntRect & rect = sprite.getTextureRect();
+    const sf::Transform & transform = sprite.getTransform();
+    float width = std::abs(rect.width);
+    float height = std::abs(rect.height);
+    float left = rect.left;
+    float right = left + rect.width;
+    float top = rect.top;
+    float bottom = top + rect.height;
+
+    batchVertices.push_back(sf::Vertex(transform.transformPoint(0, 0), sprite.getColor(), sf::Vector2f(left, top)));
+    batchVertices.push_back(sf::Vertex(transform.transformPoint(0, height), sprite.getColor(), sf::Vector2f(left, bottom)));
+    batchVertices.push_back(sf::Vertex(transform.transformPoint(width, height), sprite.getColor(), sf::Vector2f(right, bottom)));
+    batchVertices.push_back(sf::Vertex(transform.transformPoint(width, 0), sprite.getColor(), sf::Vector2f(right, top)));
+}
+
+void SpriteBatchRenderer::DrawBatch(sf::RenderTarget & renderTarget)
+{
+    if ( batchVertices.empty() ) return;
+
+    sf::RenderStates states(batchBlendMode);
+    states.texture = batchTexture;
+    renderTarget.draw(&batchVertices[0], batchVertices.size(), sf::Quads, states);
+    drawCallsCount++;
+
+    batchVertices.clear();
+    batchTexture = NULL;
+}
@@ -0,0 +1,106 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCPP_SPRITEBATCHRENDERER_H
+#define GDCPP_SPRITEBATCHRENDERER_H
+
+#include <vector>
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "GDCpp/Runtime/ObjInstancesHolder.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+class RuntimeObject;
+class RuntimeLayer;
+namespace sf { class RenderTarget; }
+namespace sf { class Sprite; }
+namespace sf { class Texture; }
+
+/**
+ * \brief Render the objects of a scene layer by layer, drawing consecutive sprites sharing the same texture at once.
+ *
+ * The objects of each layer are kept in a list sorted by Z order. The lists are updated at each frame (see Update):
+ * objects are kept at the position they had in the previous frame, so that sorting them again is only a pass on
+ * the list when only a few objects were added or changed their Z order. Objects having the same Z order are sorted
+ * by their position in the list of all the objects, as if the list was sorted with std::stable_sort.
+ *
+ * When drawing a layer (see DrawLayer), consecutive objects returning a sprite with RuntimeObject::GetSpriteForBatching
+ * and sharing the same texture and blend mode are drawn with a single draw call. Those objects are not drawn when their
+ * bounding box (see RuntimeObject::GetAABB) is outside the view. Other objects are drawn by calling RuntimeObject::Draw.
+ *
+ * \see RuntimeScene::Render
+ * \ingroup GameEngine
+ */
+class GD_API SpriteBatchRenderer
+{
+public:
+    SpriteBatchRenderer();
+    virtual ~SpriteBatchRenderer() {};
+
+    /**
+     * \brief Update the lists of objects of the layers, sorted by Z order.
+     *
+     * Objects on a layer which is not in the layers are not rendered.
+     * \param allObjects All the objects of the scene.
+     * \param layers The layers of the scene.
+     * \param stableSort If true, the objects having the same Z order are sorted by their position in \a allObjects.
+     * Otherwise, their order is unspecified.
+     */
+    void Update(const RuntimeObjList & allObjects, const std::vector<RuntimeLayer> & layers, bool stableSort = true);
+
+    /**
+     * \brief Draw the objects of a layer in the render target, using the current view of the target.
+     * \param layerIndex The index of the layer in the layers passed to Update.
+     */
+    void DrawLayer(std::size_t layerIndex, sf::RenderTarget & renderTarget);
+
+    /**
+     * \brief Return the objects of a layer, sorted by Z order, as updated by the last call to Update.
+     * \param layerIndex The index of the layer in the layers passed to Update.
+     */
+    const std::vector<RuntimeObject*> & GetLayerObjects(std::size_t layerIndex) const { return layersObjects[layerIndex].objects; }
+
+    /**
+     * \brief Return the number of draw calls done by DrawLayer since the last call to Update.
+     */
+    std::size_t GetDrawCallsCount() const { return drawCallsCount; }
+
+private:
+    /**
+     * \brief The objects of a layer.
+     */
+    struct LayerObjects
+    {
+        std::vector<RuntimeObject*> objects; ///< The objects, sorted by Z order.
+        std::vector<RuntimeObject*> previousPositions; ///< Used during Update: the objects put at the position they had in the previous frame.
+        std::vector<RuntimeObject*> addedObjects; ///< Used during Update: the objects which were not in the layer in the previous frame.
+    };
+
+    /**
+     * \brief Sort the objects by Z order using an insertion sort, which is fast when the objects
+     * are almost sorted, and falling back to std::sort when too many objects must be moved.
+     * \param stableSort If true, objects having the same Z order are sorted by RuntimeObject::renderingOrder.
+     */
+    static void SortByZOrder(std::vector<RuntimeObject*> & objects, bool stableSort);
+
+    /**
+     * \brief Add the sprite to the batch, drawing the batch first if the sprite can't be drawn with it.
+     */
+    void AddToBatch(const sf::Sprite & sprite, const sf::BlendMode & blendMode, sf::RenderTarget & renderTarget);
+
+    /**
+     * \brief Draw the sprites of the batch, if any, and empty it.
+     */
+    void DrawBatch(sf::RenderTarget & renderTarget);
+
+    std::vector<LayerObjects> layersObjects; ///< The objects of each layer, in the order of the layers of the scene.
+    std::vector<std::size_t> layersIndices; ///< The index of each layer in layersObjects, indexed by the layer identifiers.
+    std::vector<sf::Vertex> batchVertices; ///< The vertices of the sprites of the batch, drawn as quads.
+    const sf::Texture * batchTexture; ///< The texture of the sprites of the batch.
+    sf::BlendMode batchBlendMode; ///< The blend mode of the sprites of the batch.
+    std::size_t drawCallsCount;
+};
+
+#endif
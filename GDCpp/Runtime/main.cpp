@@ -18,6 +18,7 @@
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/ResourcesLoader.h"
 #include "GDCpp/Runtime/FontManager.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
 #include "GDCpp/Runtime/SoundManager.h"
 #include "GDCpp/Runtime/SceneNameMangler.h"
 #include "GDCpp/Runtime/Project/Project.h"
@@ -206,6 +207,7 @@ int main( int argc, char *p_argv[] )
 
     runtimeGame.GetSoundManager().ClearAllSoundsAndMusics();
     FontManager::Get()->DestroySingleton();
+    RuntimeNamesTable::Get()->DestroySingleton();
 
     gd::CloseLibrary(codeLibrary);
 
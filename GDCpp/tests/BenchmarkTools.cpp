@@ -0,0 +1,107 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Allocation counting for the benchmarks of GDevelop C++ Platform.
+ *
+ * All the variants of the global operator new and delete are replaced so that
+ * they stay consistent with each other. They only count allocations while an
+ * AllocationsCounter is alive and otherwise behave as the default operators.
+ */
+#include "BenchmarkTools.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<std::size_t> activeCountersCount(0);
+    std::atomic<std::size_t> allocationsCount(0);
+
+    void * CountedAllocate(std::size_t size)
+    {
+        if (activeCountersCount.load(std::memory_order_relaxed) != 0)
+            allocationsCount.fetch_add(1, std::memory_order_relaxed);
+
+        return std::malloc(size ? size : 1);
+    }
+}
+
+namespace BenchmarkTools
+{
+
+AllocationsCounter::AllocationsCounter() :
+    allocationsAtStart(allocationsCount.load())
+{
+    activeCountersCount++;
+}
+
+AllocationsCounter::~AllocationsCounter()
+{
+    activeCountersCount--;
+}
+
+std::size_t AllocationsCounter::Get() const
+{
+    return allocationsCount.load() - allocationsAtStart;
+}
+
+}
+
+void * operator new(std::size_t size)
+{
+    void * ptr = CountedAllocate(size);
+    if (!ptr) throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new[](std::size_t size)
+{
+    void * ptr = CountedAllocate(size);
+    if (!ptr) throw std::bad_alloc();
+
+    return ptr;
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr, const std::nothrow_t &) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
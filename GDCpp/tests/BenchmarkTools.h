@@ -0,0 +1,88 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tools used by the benchmarks of GDevelop C++ Platform.
+ *
+ * Benchmarks are hidden test cases, tagged with [.][benchmark]: they are not run
+ * by default. Launch them using:
+ * \code
+ * GDCpp_tests [benchmark]
+ * \endcode
+ */
+#ifndef GDCPP_TESTS_BENCHMARKTOOLS_H
+#define GDCPP_TESTS_BENCHMARKTOOLS_H
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+namespace BenchmarkTools
+{
+
+/**
+ * \brief Count the heap allocations done between its construction and its
+ * destruction.
+ *
+ * Allocations are only counted while at least one counter is alive, so the
+ * rest of the tests are not affected.
+ */
+class AllocationsCounter
+{
+public:
+    AllocationsCounter();
+    ~AllocationsCounter();
+
+    /**
+     * \brief Return the number of heap allocations done since the construction
+     * of the counter.
+     */
+    std::size_t Get() const;
+
+private:
+    AllocationsCounter(const AllocationsCounter &) = delete;
+    AllocationsCounter & operator=(const AllocationsCounter &) = delete;
+
+    std::size_t allocationsAtStart;
+};
+
+/**
+ * \brief Measure the time and the heap allocations done between its construction
+ * and the call to Stop.
+ */
+class Measure
+{
+public:
+    Measure() :
+        start(std::chrono::high_resolution_clock::now())
+    {
+    };
+
+    /**
+     * \brief Stop the measure, and print it with the specified label, dividing
+     * the results by the number of iterations.
+     */
+    void Stop(const std::string & label, std::size_t iterations = 1)
+    {
+        std::size_t allocations = allocationsCounter.Get();
+        double elapsed = std::chrono::duration<double, std::micro>(
+            std::chrono::high_resolution_clock::now() - start).count();
+        if (iterations == 0) iterations = 1;
+
+        std::cout << label << ": "
+            << elapsed / iterations << " us, "
+            << static_cast<double>(allocations) / iterations << " allocations"
+            << (iterations > 1 ? " (per iteration)" : "") << std::endl;
+    };
+
+private:
+    std::chrono::high_resolution_clock::time_point start;
+    AllocationsCounter allocationsCounter;
+};
+
+}
+
+#endif
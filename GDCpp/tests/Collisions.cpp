@@ -0,0 +1,167 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering pixel perfect collisions.
+ */
+#include "catch.hpp"
+#include "GDCore/Project/ImageManager.h"
+#include "GDCpp/Runtime/Collisions.h"
+#include "BenchmarkTools.h"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+/**
+ * \brief Create a mask of the given size, with the pixels set according to the function.
+ */
+template <typename F>
+AlphaBitmask CreateMask(unsigned int width, unsigned int height, F isOpaque)
+{
+	std::vector<sf::Uint8> pixels(width*height*4, 255);
+	for (unsigned int y = 0;y<height;++y)
+		for (unsigned int x = 0;x<width;++x)
+			pixels[(y*width+x)*4+3] = isOpaque(x, y) ? 255 : 0;
+
+	AlphaBitmask mask;
+	mask.Create(width, height, &pixels[0], 1);
+	return mask;
+}
+
+bool AlwaysOpaque(unsigned int, unsigned int) { return true; }
+bool RandomlyOpaque(unsigned int, unsigned int) { return std::rand() % 8 == 0; }
+bool OnlyBottomRightPixel(unsigned int x, unsigned int y) { return x == 99 && y == 99; }
+bool OnlyLastPixel(unsigned int x, unsigned int y) { return x == 255 && y == 255; }
+
+sf::Transform CreateInverseTransform(float x, float y, float angle = 0, float scale = 1)
+{
+	sf::Transform transform;
+	transform.translate(x, y).rotate(angle).scale(scale, scale);
+	return transform.getInverse();
+}
+
+/**
+ * \brief The straightforward pixel perfect test, transforming each point of the area.
+ */
+bool ReferenceCollisionTest(const AlphaBitmask & mask1, const sf::Transform & inverseTransform1,
+	const AlphaBitmask & mask2, const sf::Transform & inverseTransform2, const sf::FloatRect & area)
+{
+	for (int j = std::floor(area.top);j<std::ceil(area.top+area.height);++j)
+	{
+		for (int i = std::floor(area.left);i<std::ceil(area.left+area.width);++i)
+		{
+			sf::Vector2f o1 = inverseTransform1.transformPoint(i, j);
+			sf::Vector2f o2 = inverseTransform2.transformPoint(i, j);
+			if ( o1.x >= 0 && o1.y >= 0 && o1.x < mask1.GetWidth() && o1.y < mask1.GetHeight() &&
+				o2.x >= 0 && o2.y >= 0 && o2.x < mask2.GetWidth() && o2.y < mask2.GetHeight() &&
+				mask1.IsSet(o1.x, o1.y) && mask2.IsSet(o2.x, o2.y) )
+				return true;
+		}
+	}
+
+	return false;
+}
+
+}
+
+TEST_CASE( "Collisions", "[game-engine]" ) {
+	SECTION("AlphaBitmask") {
+		std::vector<sf::Uint8> pixels(70*2*4, 0);
+		pixels[(0*70+3)*4+3] = 255;
+		pixels[(1*70+65)*4+3] = 128;
+		pixels[(1*70+66)*4+3] = 1;
+
+		AlphaBitmask mask;
+		mask.Create(70, 2, &pixels[0], 1);
+		REQUIRE(mask.GetWidth() == 70);
+		REQUIRE(mask.GetHeight() == 2);
+		REQUIRE(mask.IsSet(3, 0) == true);
+		REQUIRE(mask.IsSet(4, 0) == false);
+		REQUIRE(mask.IsSet(65, 1) == true);
+		REQUIRE(mask.IsSet(66, 1) == false);
+		REQUIRE(mask.GetBits(0, 0) == 8);
+		REQUIRE(mask.GetBits(60, 1) == 32);
+		REQUIRE(mask.GetBits(65, 1) == 1);
+
+		mask.Create(70, 2, &pixels[0], 0);
+		REQUIRE(mask.IsSet(66, 1) == true);
+	}
+	SECTION("Translated masks") {
+		AlphaBitmask opaque = CreateMask(100, 100, AlwaysOpaque);
+		AlphaBitmask corner = CreateMask(100, 100, OnlyBottomRightPixel);
+
+		sf::FloatRect area(50, 50, 50, 50);
+		REQUIRE(AlphaBitmasksCollisionTest(opaque, CreateInverseTransform(0, 0), opaque, CreateInverseTransform(50, 50), area) == true);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, CreateInverseTransform(0, 0), opaque, CreateInverseTransform(50, 50), area) == true);
+		REQUIRE(AlphaBitmasksCollisionTest(opaque, CreateInverseTransform(50, 50), corner, CreateInverseTransform(0, 0), area) == true);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, CreateInverseTransform(0, 0), corner, CreateInverseTransform(50, 50), area) == false);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, CreateInverseTransform(0, 0), corner, CreateInverseTransform(0, 0), sf::FloatRect(0, 0, 100, 100)) == true);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, CreateInverseTransform(0, 0), corner, CreateInverseTransform(0, 0), sf::FloatRect(0, 0, 99, 99)) == false);
+	}
+	SECTION("Rotated and scaled masks") {
+		AlphaBitmask corner = CreateMask(100, 100, OnlyBottomRightPixel);
+		AlphaBitmask opaque = CreateMask(10, 10, AlwaysOpaque);
+
+		//The bottom right pixel of the rotated mask is now at the bottom left.
+		sf::Transform rotated = CreateInverseTransform(100, 0, 90);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, rotated, opaque, CreateInverseTransform(0, 90), sf::FloatRect(0, 90, 10, 10)) == true);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, rotated, opaque, CreateInverseTransform(90, 90), sf::FloatRect(90, 90, 10, 10)) == false);
+
+		sf::Transform scaled = CreateInverseTransform(0, 0, 0, 2);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, scaled, opaque, CreateInverseTransform(195, 195), sf::FloatRect(195, 195, 5, 5)) == true);
+		REQUIRE(AlphaBitmasksCollisionTest(corner, scaled, opaque, CreateInverseTransform(185, 185), sf::FloatRect(185, 185, 10, 10)) == false);
+	}
+	SECTION("Results are identical to the straightforward implementation") {
+		std::srand(42);
+		AlphaBitmask mask1 = CreateMask(150, 40, RandomlyOpaque);
+		AlphaBitmask mask2 = CreateMask(37, 90, RandomlyOpaque);
+		for (std::size_t i = 0;i<500;++i)
+		{
+			float x = std::rand() % 200 - 100 + (i % 2 ? 0.5f : 0);
+			float y = std::rand() % 200 - 100;
+			float angle = i % 3 == 0 ? std::rand() % 360 : 0;
+			sf::Transform inverseTransform1 = CreateInverseTransform(0, 0);
+			sf::Transform inverseTransform2 = CreateInverseTransform(x, y, angle);
+			sf::FloatRect area(-150, -150, 300, 300);
+
+			REQUIRE(AlphaBitmasksCollisionTest(mask1, inverseTransform1, mask2, inverseTransform2, area) ==
+				ReferenceCollisionTest(mask1, inverseTransform1, mask2, inverseTransform2, area));
+		}
+	}
+}
+
+TEST_CASE( "Collisions benchmark", "[.][benchmark]" ) {
+	AlphaBitmask corner = CreateMask(256, 256, OnlyLastPixel);
+	sf::FloatRect area(0, 0, 255, 255);
+	const std::size_t testsCount = 1000;
+
+	std::size_t collisions = 0;
+	{
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<testsCount;++i)
+			if (ReferenceCollisionTest(corner, CreateInverseTransform(0, 0), corner, CreateInverseTransform(0, 0), area)) collisions++;
+
+		measure.Stop("Straightforward test of 256x256 masks", testsCount);
+	}
+	{
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<testsCount;++i)
+			if (AlphaBitmasksCollisionTest(corner, CreateInverseTransform(0, 0, 45), corner, CreateInverseTransform(0, 0, 45), area)) collisions++;
+
+		measure.Stop("Test of 256x256 rotated masks", testsCount);
+	}
+	{
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<testsCount;++i)
+			if (AlphaBitmasksCollisionTest(corner, CreateInverseTransform(0, 0), corner, CreateInverseTransform(0, 0), area)) collisions++;
+
+		measure.Stop("Test of 256x256 unrotated masks", testsCount);
+	}
+
+	REQUIRE(collisions == 0);
+}
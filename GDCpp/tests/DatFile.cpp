@@ -0,0 +1,132 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering DatFile class.
+ */
+#include "catch.hpp"
+#include "GDCpp/Runtime/DatFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+void WriteFile(const std::string & filename, const std::string & content)
+{
+	std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+	file.write(content.data(), content.size());
+}
+
+}
+
+TEST_CASE( "DatFile", "[game-engine]" ) {
+	SECTION("Create and read a DAT file") {
+		std::vector<gd::String> files;
+		for (std::size_t i = 0;i<20;++i)
+		{
+			files.push_back("DatFileTest" + gd::String::From(i) + ".txt");
+			WriteFile(files.back().ToLocale(), "Content of file " + std::to_string(i) + std::string(i*100, 'x'));
+		}
+		WriteFile("DatFileTestEmpty.txt", "");
+		files.push_back("DatFileTestEmpty.txt");
+
+		{
+			DatFile datFile;
+			REQUIRE(datFile.Create(files, ".", "DatFileTest.egd"));
+		}
+
+		DatFile datFile;
+		REQUIRE(datFile.Read("DatFileTest.egd"));
+		for (std::size_t i = 0;i<20;++i)
+		{
+			std::string expectedContent = "Content of file " + std::to_string(i) + std::string(i*100, 'x');
+			REQUIRE(datFile.ContainsFile(files[i]));
+			REQUIRE(datFile.GetFileSize(files[i]) == expectedContent.size());
+
+			DatFile::FileData file = datFile.GetFileData(files[i]);
+			REQUIRE(file.data != NULL);
+			REQUIRE(std::string(file.data, file.size) == expectedContent);
+
+			char * buffer = datFile.GetFile(files[i]);
+			REQUIRE(buffer != NULL);
+			REQUIRE(std::string(buffer, expectedContent.size()) == expectedContent);
+		}
+		REQUIRE(datFile.ContainsFile("DatFileTestEmpty.txt"));
+		REQUIRE(datFile.GetFileData("DatFileTestEmpty.txt").size == 0);
+		REQUIRE(!datFile.ContainsFile("DatFileTest20.txt"));
+		REQUIRE(datFile.GetFileData("DatFileTest20.txt").data == NULL);
+		REQUIRE(datFile.GetFile("DatFileTest20.txt") == NULL);
+
+		for (std::size_t i = 0;i<files.size();++i)
+			std::remove(files[i].ToLocale().c_str());
+		std::remove("DatFileTest.egd");
+	}
+	SECTION("Read a DAT file of version 0.1") {
+		std::string content = "Content of the file";
+
+		sDATHeader header;
+		memset(&header, 0, sizeof(sDATHeader));
+		memcpy(header.uniqueID, "EXEGD", 5);
+		memcpy(header.version, "0.1", 3);
+		header.nb_files = 1;
+
+		sFileEntry entry;
+		memset(&entry, 0, sizeof(sFileEntry));
+		strcpy(entry.name, "File.txt");
+		entry.size = content.size();
+		entry.offset = sizeof(sDATHeader) + sizeof(sFileEntry);
+
+		WriteFile("DatFileTest.egd", std::string(reinterpret_cast<const char*>(&header), sizeof(sDATHeader)) +
+			std::string(reinterpret_cast<const char*>(&entry), sizeof(sFileEntry)) + content);
+
+		{
+			DatFile datFile;
+			REQUIRE(datFile.Read("DatFileTest.egd"));
+			REQUIRE(datFile.ContainsFile("File.txt"));
+			REQUIRE(!datFile.ContainsFile("OtherFile.txt"));
+			REQUIRE(datFile.GetFileSize("File.txt") == content.size());
+
+			DatFile::FileData file = datFile.GetFileData("File.txt");
+			REQUIRE(std::string(file.data, file.size) == content);
+		}
+		std::remove("DatFileTest.egd");
+	}
+	SECTION("Invalid files") {
+		DatFile datFile;
+		REQUIRE(!datFile.Read("DatFileTestNotExisting.egd"));
+
+		WriteFile("DatFileTest.egd", "Not a DAT file");
+		REQUIRE(!datFile.Read("DatFileTest.egd"));
+		REQUIRE(!datFile.ContainsFile("File.txt"));
+		std::remove("DatFileTest.egd");
+	}
+	SECTION("Invalid names table") {
+		//A DAT file having an entry whose name is out of the names table.
+		sDATHeader header;
+		memcpy(header.uniqueID, "EXEGD", 5);
+		memcpy(header.version, "0.2", 3);
+		header.nb_files = 1;
+		uint32_t namesSize = 4;
+		sFileEntryV2 entry;
+		memset(&entry, 0, sizeof(sFileEntryV2));
+		entry.nameOffset = 2;
+		entry.nameLength = 10;
+
+		std::string content;
+		content.append(reinterpret_cast<const char*>(&header), sizeof(sDATHeader));
+		content.append(reinterpret_cast<const char*>(&namesSize), sizeof(uint32_t));
+		content.append(reinterpret_cast<const char*>(&entry), sizeof(sFileEntryV2));
+		content.append("abcd");
+		WriteFile("DatFileTest.egd", content);
+
+		DatFile datFile;
+		REQUIRE(!datFile.Read("DatFileTest.egd"));
+		REQUIRE(!datFile.ContainsFile("abcd"));
+		std::remove("DatFileTest.egd");
+	}
+}
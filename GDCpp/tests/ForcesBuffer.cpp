@@ -0,0 +1,57 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering ForcesBuffer class.
+ */
+#include "catch.hpp"
+#include "GDCpp/Runtime/ForcesBuffer.h"
+#include <cmath>
+
+TEST_CASE( "ForcesBuffer", "[game-engine]" ) {
+	SECTION("Resultant") {
+		ForcesBuffer forces;
+		for (std::size_t i = 0;i<10;++i)
+			forces.Add(Force(i, -2.0f*i, 1));
+
+		REQUIRE(forces.GetCount() == 10);
+		REQUIRE(forces.GetTotalX() == Approx(45));
+		REQUIRE(forces.GetTotalY() == Approx(-90));
+		REQUIRE(forces.Get(7).GetX() == Approx(7));
+
+		ForcesBuffer copy = forces;
+		forces.Clear();
+		REQUIRE(forces.GetCount() == 0);
+		REQUIRE(forces.GetTotalX() == 0);
+		REQUIRE(copy.GetCount() == 10);
+		REQUIRE(copy.GetTotalY() == Approx(-90));
+	}
+	SECTION("Update") {
+		ForcesBuffer forces;
+		forces.Add(Force(10, 0, 0)); //Instant force
+		forces.Add(Force(30, 40, 0.5)); //Length is reduced by half each second
+		forces.Add(Force(0, 0, 1)); //Null force
+		for (std::size_t i = 0;i<5;++i)
+			forces.Add(Force(1, 1, 1)); //Permanent forces
+
+		forces.Update(0.5);
+		REQUIRE(forces.GetCount() == 6);
+		REQUIRE(forces.GetTotalX() == Approx(22.5+5));
+		REQUIRE(forces.GetTotalY() == Approx(30+5));
+
+		//Same as reducing the length of the force.
+		Force force(30, 40, 0.5);
+		force.SetLength(force.GetLength() - force.GetLength()*(1-force.GetClearing())*0.5);
+		for (std::size_t i = 0;i<forces.GetCount();++i)
+		{
+			if ( forces.Get(i).GetClearing() == 0.5 )
+			{
+				REQUIRE(forces.Get(i).GetX() == Approx(force.GetX()));
+				REQUIRE(forces.Get(i).GetY() == Approx(force.GetY()));
+				REQUIRE(forces.Get(i).GetLength() == Approx(force.GetLength()));
+			}
+		}
+	}
+}
@@ -15,6 +15,42 @@
 #include "GDCpp/Runtime/RuntimeScene.h"
 #include "GDCpp/Runtime/ObjInstancesHolder.h"
 #include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/Project/Behavior.h"
+#include "BenchmarkTools.h"
+#include <SFML/Graphics/RenderWindow.hpp>
+
+namespace
+{
+
+/**
+ * \brief A behavior counting how many times it was updated, and in how many batches.
+ */
+class CountingBehavior : public gd::Behavior
+{
+public:
+	CountingBehavior(const gd::String & type, const gd::String & name) : stepsCount(0)
+	{
+		SetTypeName(type);
+		SetName(name);
+	}
+	virtual Behavior* Clone() const { return new CountingBehavior(*this); }
+
+	virtual void StepAllPreEvents(RuntimeScene & scene, const std::vector<Behavior*> & behaviors)
+	{
+		batchesCount++;
+		gd::Behavior::StepAllPreEvents(scene, behaviors);
+	}
+
+	std::size_t stepsCount;
+	static std::size_t batchesCount;
+
+private:
+	virtual void DoStepPreEvents(RuntimeScene & scene) { stepsCount++; }
+};
+
+std::size_t CountingBehavior::batchesCount = 0;
+
+}
 
 TEST_CASE( "ObjInstancesHolder", "[common]" ) {
 	SECTION("Basics") {
@@ -62,4 +98,303 @@ TEST_CASE( "ObjInstancesHolder", "[common]" ) {
 		REQUIRE(container.GetObjects("2").size() == 3);
 		REQUIRE(container.GetObjectsRawPointers("2").size() == 3);
 	}
+	SECTION("Iteration with deferred removal") {
+		gd::Object obj1("1");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::shared_ptr<RuntimeObject> obj1A(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> obj1B(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> obj1C(new RuntimeObject(scene, obj1));
+
+		ObjInstancesHolder container;
+		container.AddObject(obj1A);
+		container.AddObject(obj1B);
+
+		const RuntimeObjList & allObjects = container.GetAllObjects();
+		REQUIRE(allObjects.size() == 2);
+
+		container.BeginIteration();
+		container.RemoveObject(obj1A);
+		container.AddObject(obj1C);
+		REQUIRE(container.GetObjects("1").size() == 2);
+		REQUIRE(allObjects.size() == 3); //Removal is deferred, added objects are at the end.
+		REQUIRE(allObjects[0] == obj1A);
+		REQUIRE(allObjects[2] == obj1C);
+		container.EndIteration();
+
+		REQUIRE(allObjects.size() == 2);
+		REQUIRE(allObjects[0] == obj1B); //The order of the remaining objects is preserved.
+		REQUIRE(allObjects[1] == obj1C);
+
+		//Changing the name of an object must not duplicate it.
+		obj1B->DeleteFromScene(scene); //obj1B is not in the scene: only its name is changed.
+		container.ObjectNameHasChanged(obj1B.get());
+		REQUIRE(allObjects.size() == 2);
+		REQUIRE(container.GetObjects("1").size() == 1);
+		REQUIRE(container.GetObjects("").size() == 1);
+	}
+	SECTION("Removing and adding again an object during an iteration") {
+		gd::Object obj1("1");
+		obj1.AddBehavior(new CountingBehavior("TypeA", "A"));
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::shared_ptr<RuntimeObject> obj1A(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> obj1B(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> obj1C(new RuntimeObject(scene, obj1));
+
+		ObjInstancesHolder container;
+		container.AddObject(obj1A);
+		container.AddObject(obj1B);
+		container.AddObject(obj1C);
+
+		const RuntimeObjList & allObjects = container.GetAllObjects();
+		container.BeginIteration();
+		container.RemoveObject(obj1B);
+		container.AddObject(obj1B);
+		REQUIRE(allObjects.size() == 3); //The object is not added twice.
+		REQUIRE(container.GetObjects("1").size() == 3);
+		REQUIRE(container.GetObjects("1")[2] == obj1B);
+		container.EndIteration();
+
+		REQUIRE(allObjects.size() == 3);
+		REQUIRE(allObjects[0] == obj1A); //The object kept its position.
+		REQUIRE(allObjects[1] == obj1B);
+		REQUIRE(allObjects[2] == obj1C);
+		REQUIRE(container.GetBehaviorsRegistry().GetBehaviors(0).size() == 3);
+
+		//The object can still be removed.
+		container.RemoveObject(obj1B);
+		REQUIRE(container.GetBehaviorsRegistry().GetBehaviors(0).size() == 2);
+		REQUIRE(container.GetAllObjects().size() == 2);
+		REQUIRE(container.GetAllObjects()[0] == obj1A);
+		REQUIRE(container.GetAllObjects()[1] == obj1C);
+	}
+	SECTION("Removal outside of an iteration") {
+		gd::Object obj1("1");
+		obj1.AddBehavior(new CountingBehavior("TypeA", "A"));
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		ObjInstancesHolder container;
+		std::vector<std::weak_ptr<RuntimeObject>> objects;
+		for (std::size_t i = 0;i<4;++i)
+		{
+			std::shared_ptr<RuntimeObject> object(new RuntimeObject(scene, obj1));
+			container.AddObject(object);
+			objects.push_back(object);
+		}
+
+		//The object and its behaviors are removed at once, leaving an empty position
+		//in the list of all objects.
+		const RuntimeObjList & allObjects = container.GetAllObjects();
+		container.RemoveObject(objects[1].lock());
+		REQUIRE(objects[1].expired());
+		REQUIRE(container.GetBehaviorsRegistry().GetBehaviors(0).size() == 3);
+		REQUIRE(allObjects.size() == 4);
+		REQUIRE(allObjects[1] == nullptr);
+
+		container.RemoveObjects("1");
+		REQUIRE(objects[0].expired());
+		REQUIRE(objects[3].expired());
+		REQUIRE(container.GetBehaviorsRegistry().GetBehaviors(0).size() == 0);
+
+		//The empty positions are removed the next time the list is accessed.
+		REQUIRE(container.GetAllObjects().size() == 0);
+	}
+	SECTION("Order of the objects") {
+		gd::Object obj1("1");
+		gd::Object obj2("2");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::vector<std::shared_ptr<RuntimeObject>> objects;
+		for (std::size_t i = 0;i<8;++i)
+		{
+			objects.push_back(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, i % 2 ? obj2 : obj1)));
+			scene.objectsInstances.AddObject(objects.back());
+		}
+
+		//Delete objects like events would do, and remove them at the end of the frame.
+		objects[0]->DeleteFromScene(scene);
+		objects[3]->DeleteFromScene(scene);
+		objects[4]->DeleteFromScene(scene);
+		scene.objectsInstances.RemoveObjects("");
+
+		//Objects are still in the order they were created in, so that picking and
+		//sorting objects having the same Z order do not depend on removed objects.
+		const RuntimeObjList & allObjects = scene.objectsInstances.GetAllObjects();
+		REQUIRE(allObjects.size() == 5);
+		REQUIRE(allObjects[0] == objects[1]);
+		REQUIRE(allObjects[1] == objects[2]);
+		REQUIRE(allObjects[2] == objects[5]);
+		REQUIRE(allObjects[3] == objects[6]);
+		REQUIRE(allObjects[4] == objects[7]);
+
+		std::vector<RuntimeObject*> objects1 = scene.objectsInstances.GetObjectsRawPointers("1");
+		REQUIRE(objects1.size() == 2);
+		REQUIRE(objects1[0] == objects[2].get());
+		REQUIRE(objects1[1] == objects[6].get());
+		const RuntimeObjList & objects2 = scene.objectsInstances.GetObjects("2");
+		REQUIRE(objects2.size() == 3);
+		REQUIRE(objects2[0] == objects[1]);
+		REQUIRE(objects2[1] == objects[5]);
+		REQUIRE(objects2[2] == objects[7]);
+
+		//Removing an object in the middle of a list keeps the order of the others.
+		scene.objectsInstances.RemoveObject(objects[5]);
+		REQUIRE(scene.objectsInstances.GetObjects("2").size() == 2);
+		REQUIRE(scene.objectsInstances.GetObjects("2")[0] == objects[1]);
+		REQUIRE(scene.objectsInstances.GetObjects("2")[1] == objects[7]);
+		REQUIRE(scene.objectsInstances.GetAllObjects().size() == 4);
+		REQUIRE(scene.objectsInstances.GetAllObjects()[2] == objects[6]);
+	}
+	SECTION("Removal and name changes") {
+		gd::Object obj1("1");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::vector<std::shared_ptr<RuntimeObject>> objects;
+		for (std::size_t i = 0;i<5;++i)
+		{
+			objects.push_back(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+			scene.objectsInstances.AddObject(objects.back());
+		}
+
+		//Delete the first and the last object of the list, and an object in the middle.
+		objects[0]->DeleteFromScene(scene);
+		objects[4]->DeleteFromScene(scene);
+		objects[2]->DeleteFromScene(scene);
+		REQUIRE(scene.objectsInstances.GetObjects("1").size() == 2);
+		REQUIRE(scene.objectsInstances.GetObjects("").size() == 3);
+		REQUIRE(scene.objectsInstances.GetAllObjects().size() == 5);
+
+		std::vector<RuntimeObject*> remainingObjects = scene.objectsInstances.GetObjectsRawPointers("1");
+		REQUIRE(std::find(remainingObjects.begin(), remainingObjects.end(), objects[1].get()) != remainingObjects.end());
+		REQUIRE(std::find(remainingObjects.begin(), remainingObjects.end(), objects[3].get()) != remainingObjects.end());
+
+		//Removing an object twice or an object not in the container does nothing.
+		scene.objectsInstances.RemoveObject(objects[2]);
+		scene.objectsInstances.RemoveObject(objects[2]);
+		REQUIRE(scene.objectsInstances.GetObjects("").size() == 2);
+		REQUIRE(scene.objectsInstances.GetAllObjects().size() == 4);
+
+		scene.objectsInstances.RemoveObjects("");
+		REQUIRE(scene.objectsInstances.GetObjects("").size() == 0);
+		REQUIRE(scene.objectsInstances.GetAllObjects().size() == 2);
+
+		//The remaining objects can still be removed.
+		scene.objectsInstances.RemoveObject(objects[3]);
+		REQUIRE(scene.objectsInstances.GetObjects("1").size() == 1);
+		REQUIRE(scene.objectsInstances.GetObjects("1")[0] == objects[1]);
+		REQUIRE(scene.objectsInstances.GetAllObjects().size() == 1);
+		REQUIRE(scene.objectsInstances.GetAllObjects()[0] == objects[1]);
+	}
+	SECTION("Behaviors are updated type by type") {
+		gd::Object obj1("1");
+		obj1.AddBehavior(new CountingBehavior("TypeA", "A"));
+		obj1.AddBehavior(new CountingBehavior("TypeB", "B"));
+		gd::Object obj2("2");
+		obj2.AddBehavior(new CountingBehavior("TypeA", "A"));
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::vector<std::shared_ptr<RuntimeObject>> objects;
+		for (std::size_t i = 0;i<6;++i)
+		{
+			objects.push_back(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, i % 2 ? obj1 : obj2)));
+			scene.objectsInstances.AddObject(objects.back());
+		}
+
+		//Behaviors are stored in the order of their names.
+		REQUIRE(objects[1]->GetBehaviorRawPointer(0) == objects[1]->GetBehaviorRawPointer("A"));
+		REQUIRE(objects[1]->GetBehaviorRawPointer(1) == objects[1]->GetBehaviorRawPointer("B"));
+		REQUIRE(objects[1]->GetBehaviorRawPointer("NotExisting") == NULL);
+		REQUIRE(objects[0]->HasBehaviorNamed("A"));
+		REQUIRE(!objects[0]->HasBehaviorNamed("B"));
+
+		const BehaviorsRegistry & registry = scene.objectsInstances.GetBehaviorsRegistry();
+		REQUIRE(registry.GetTypesCount() == 2);
+		REQUIRE(registry.GetBehaviors(0).size() == 6);
+		REQUIRE(registry.GetBehaviors(1).size() == 3);
+
+		CountingBehavior::batchesCount = 0;
+		scene.objectsInstances.StepBehaviorsPreEvents(scene);
+		REQUIRE(CountingBehavior::batchesCount == 2);
+		for (std::size_t i = 0;i<objects.size();++i)
+			REQUIRE(static_cast<CountingBehavior*>(objects[i]->GetBehaviorRawPointer("A"))->stepsCount == 1);
+
+		//Deactivated behaviors are not updated.
+		objects[0]->GetBehaviorRawPointer("A")->Activate(false);
+		scene.objectsInstances.StepBehaviorsPreEvents(scene);
+		REQUIRE(static_cast<CountingBehavior*>(objects[0]->GetBehaviorRawPointer("A"))->stepsCount == 1);
+		REQUIRE(static_cast<CountingBehavior*>(objects[1]->GetBehaviorRawPointer("A"))->stepsCount == 2);
+
+		//Behaviors of removed objects are removed from the registry.
+		scene.objectsInstances.RemoveObject(objects[1]);
+		REQUIRE(registry.GetBehaviors(0).size() == 5);
+		REQUIRE(registry.GetBehaviors(1).size() == 2);
+		for (std::size_t i = 0;i<registry.GetBehaviors(0).size();++i)
+			REQUIRE(registry.GetBehaviors(0)[i] != objects[1]->GetBehaviorRawPointer("A"));
+	}
+}
+
+TEST_CASE( "ObjInstancesHolder removal benchmark", "[.][benchmark]" ) {
+	gd::Object obj1("1");
+
+	for (std::size_t instancesCount : {1000, 10000, 50000})
+	{
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+		std::vector<std::shared_ptr<RuntimeObject>> objects;
+		for (std::size_t i = 0;i<instancesCount;++i)
+		{
+			objects.push_back(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+			scene.objectsInstances.AddObject(objects.back());
+		}
+
+		//Delete half of the objects in a frame, like a scene destroying lots of projectiles.
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<instancesCount;i += 2)
+			objects[i]->DeleteFromScene(scene);
+		scene.RenderAndStep();
+
+		measure.Stop("Deleting " + gd::String::From(instancesCount/2).ToUTF8() + " instances among " +
+			gd::String::From(instancesCount).ToUTF8());
+		REQUIRE(scene.objectsInstances.GetAllObjects().size() == instancesCount/2);
+	}
+}
+
+TEST_CASE( "ObjInstancesHolder benchmark", "[.][benchmark]" ) {
+	gd::Object obj1("1");
+	gd::Object obj2("2");
+
+	//The scene is rendered in a hidden window, so that the frames include the rendering
+	//of the objects (RuntimeScene::Render does nothing without a window).
+	sf::RenderWindow window(sf::VideoMode(320, 240), "ObjInstancesHolder benchmark", sf::Style::None);
+	window.setVisible(false);
+
+	for (std::size_t instancesCount : {1000, 5000, 20000, 50000})
+	{
+		RuntimeGame game;
+		RuntimeScene scene(&window, &game);
+		scene.LoadFromScene(game.InsertNewLayout("Scene", 0)); //Create the layers of the scene.
+		for (std::size_t i = 0;i<instancesCount;++i)
+			scene.objectsInstances.AddObject(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, i % 2 ? obj1 : obj2)));
+
+		scene.RenderAndStep(); //Warm up
+		const std::size_t framesCount = 100;
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<framesCount;++i)
+			scene.RenderAndStep();
+
+		measure.Stop("Frame (events and rendering) with " + gd::String::From(instancesCount).ToUTF8() + " instances", framesCount);
+	}
 }
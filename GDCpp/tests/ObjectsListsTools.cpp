@@ -15,7 +15,62 @@
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
+#include "GDCpp/Runtime/PickedObjectsFlags.h"
 #include "GDCpp/Extensions/Builtin/RuntimeSceneTools.h"
+#include "GDCpp/Extensions/Builtin/ObjectTools.h"
+#include "BenchmarkTools.h"
+#include <cstdlib>
+#include <cmath>
+
+namespace
+{
+
+/**
+ * \brief An object with a size, to test collisions.
+ */
+class SizedRuntimeObject : public RuntimeObject
+{
+public:
+	SizedRuntimeObject(RuntimeScene & scene, const gd::Object & object, float size_) :
+		RuntimeObject(scene, object), size(size_) {};
+
+	virtual float GetWidth() const { return size; };
+	virtual float GetHeight() const { return size; };
+
+private:
+	float size;
+};
+
+/**
+ * \brief PickObjectsIf as it was implemented before PickedObjectsFlags, creating a
+ * list of booleans for each list of objects.
+ */
+template <typename Pred>
+bool PickObjectsIfWithBooleansLists(const ObjectsListsView & pickedObjectsLists, Pred predicate)
+{
+	bool isTrue = false;
+	std::vector < std::vector<bool> > pickedList;
+	for(ObjectsListsView::const_iterator it = pickedObjectsLists.begin();it != pickedObjectsLists.end();++it)
+	{
+		pickedList.push_back(std::vector<bool>(it->second->size(), false));
+		for(std::size_t k = 0;k<it->second->size();++k)
+			if (predicate((*it->second)[k])) pickedList.back()[k] = isTrue = true;
+	}
+
+	std::size_t i = 0;
+	for(ObjectsListsView::const_iterator it = pickedObjectsLists.begin();it != pickedObjectsLists.end();++it, ++i)
+	{
+		std::vector<RuntimeObject*> & arr = *it->second;
+		std::size_t finalSize = 0;
+		for(std::size_t k = 0;k<arr.size();++k)
+			if ( pickedList[i][k] ) arr[finalSize++] = arr[k];
+		arr.resize(finalSize);
+	}
+
+	return isTrue;
+}
+
+}
 
 TEST_CASE( "ObjectsListsTools", "[game-engine]" ) {
 	gd::Object obj1("1");
@@ -23,6 +78,8 @@ TEST_CASE( "ObjectsListsTools", "[game-engine]" ) {
 
 	RuntimeGame game;
 	RuntimeScene scene(NULL, &game);
+	ObjectNameId nameId1 = RuntimeNamesTable::Get()->GetObjectNameId("1");
+	ObjectNameId nameId2 = RuntimeNamesTable::Get()->GetObjectNameId("2");
 
 	RuntimeObject obj1A(scene, obj1);
 	RuntimeObject obj1B(scene, obj1);
@@ -31,30 +88,97 @@ TEST_CASE( "ObjectsListsTools", "[game-engine]" ) {
 	RuntimeObject obj2A(scene, obj2);
 	RuntimeObject obj2B(scene, obj2);
 	RuntimeObject obj2C(scene, obj2);
+	SECTION("ObjectsListsView") {
+		std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B};
+		std::vector<RuntimeObject*> list2 = {&obj2A};
+		std::vector<ObjectsListsView::value_type> lists = {{nameId1, &list1}, {nameId2, &list2}};
+
+		ObjectsListsView view(lists);
+		REQUIRE(view.size() == 2);
+		REQUIRE(view.begin()->second == &list1);
+		REQUIRE(view.Get(nameId2) == &list2);
+		REQUIRE(view.Get(RuntimeNamesTable::Get()->GetObjectNameId("NotInTheView")) == NULL);
+		REQUIRE(ObjectsListsView().empty());
+
+		//Passing lists as generated by events code does not allocate memory.
+		BenchmarkTools::AllocationsCounter allocationsCounter;
+		double count = PickedObjectsCount(ObjectsListsView({{nameId1, &list1}, {nameId2, &list2}}));
+		bool picked = PickNearestObject(ObjectsListsView({{nameId1, &list1}, {nameId2, &list2}}), 0, 0, false);
+
+		REQUIRE(allocationsCounter.Get() == 0);
+		REQUIRE(count == 3);
+		REQUIRE(picked == true);
+		REQUIRE(list1.size() == 1);
+		REQUIRE(list2.size() == 0);
+	}
+	SECTION("PickedObjectsFlags") {
+		std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
+		std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B};
+		std::vector<ObjectsListsView::value_type> lists = {{nameId1, &list1}, {nameId2, &list2}};
+
+		{
+			PickedObjectsFlags flags(lists);
+			flags.Pick(0, 0);
+			flags.Pick(0, 2);
+			flags.Pick(1, 1);
+			REQUIRE(flags.IsPicked(0, 0) == true);
+			REQUIRE(flags.IsPicked(0, 1) == false);
+			REQUIRE(flags.IsPicked(1, 0) == false);
+			REQUIRE(flags.IsPicked(1, 1) == true);
+
+			//Flags created while other flags are used are independent.
+			PickedObjectsFlags otherFlags(lists);
+			REQUIRE(otherFlags.IsPicked(0, 0) == false);
+
+			flags.TrimNotPickedObjects(lists);
+			REQUIRE(list1.size() == 2);
+			REQUIRE(list1[0] == &obj1A);
+			REQUIRE(list1[1] == &obj1C);
+			REQUIRE(list2.size() == 1);
+			REQUIRE(list2[0] == &obj2B);
+
+			//Lists which were already trimmed are skipped.
+			otherFlags.TrimNotPickedObjects(lists);
+			REQUIRE(list1.size() == 2);
+			REQUIRE(list2.size() == 1);
+		}
+
+		//Buffers of destroyed flags are reused.
+		BenchmarkTools::AllocationsCounter allocationsCounter;
+		{
+			PickedObjectsFlags flags(lists);
+			flags.Pick(0, 1);
+			flags.TrimNotPickedObjects(lists);
+		}
+
+		REQUIRE(allocationsCounter.Get() == 0);
+		REQUIRE(list1.size() == 1);
+		REQUIRE(list1[0] == &obj1C);
+		REQUIRE(list2.size() == 0);
+	}
 	SECTION("PickObjectsIf") {
-		std::map <gd::String, std::vector<RuntimeObject*> *> map;
 		std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-		map["1"] = &list1;
+		std::vector<ObjectsListsView::value_type> lists = {{nameId1, &list1}};
 
-		REQUIRE(PickObjectsIf(map, false, [](RuntimeObject*){
+		REQUIRE(PickObjectsIf(lists, false, [](RuntimeObject*){
 			return true;
 		}) == true);
 
 		REQUIRE(list1.size() == 3);
 
-		REQUIRE(PickObjectsIf(map, true, [](RuntimeObject*){
+		REQUIRE(PickObjectsIf(lists, true, [](RuntimeObject*){
 			return false;
 		}) == true);
 
 		REQUIRE(list1.size() == 3);
 
-		REQUIRE(PickObjectsIf(map, false, [&obj1A, &obj1C](RuntimeObject* obj){
+		REQUIRE(PickObjectsIf(lists, false, [&obj1A, &obj1C](RuntimeObject* obj){
 			return obj == &obj1A || obj == &obj1C;
 		}) == true);
 
 		REQUIRE(list1.size() == 2);
 
-		REQUIRE(PickObjectsIf(map, true, [&obj1C](RuntimeObject* obj){
+		REQUIRE(PickObjectsIf(lists, true, [&obj1C](RuntimeObject* obj){
 			return obj == &obj1C;
 		}) == true);
 
@@ -63,30 +187,28 @@ TEST_CASE( "ObjectsListsTools", "[game-engine]" ) {
 	}
 	SECTION("TwoObjectListsTest") {
 
-		std::map <gd::String, std::vector<RuntimeObject*> *> map1;
-		std::map <gd::String, std::vector<RuntimeObject*> *> map2;
 		std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
 		std::vector<RuntimeObject*> list2 = {&obj2A, &obj2B, &obj2C};
-		map1["1"] = &list1;
-		map2["2"] = &list2;
+		std::vector<ObjectsListsView::value_type> lists1 = {{nameId1, &list1}};
+		std::vector<ObjectsListsView::value_type> lists2 = {{nameId2, &list2}};
 
-		REQUIRE(TwoObjectListsTest(map1, map2, false, [](RuntimeObject*, RuntimeObject*){
+		REQUIRE(TwoObjectListsTest(lists1, lists2, false, [](RuntimeObject*, RuntimeObject*){
 			return true;
 		}) == true);
-		REQUIRE(TwoObjectListsTest(map1, map2, true, [](RuntimeObject*, RuntimeObject*){
+		REQUIRE(TwoObjectListsTest(lists1, lists2, true, [](RuntimeObject*, RuntimeObject*){
 			return false;
 		}) == true);
 
 		REQUIRE(list1.size() == 3); //Lists should not have been changed.
 		REQUIRE(list2.size() == 3);
 
-		REQUIRE( TwoObjectListsTest(map1, map2, true, [&obj1B, &obj2C](RuntimeObject* obj1, RuntimeObject* obj2){
+		REQUIRE( TwoObjectListsTest(lists1, lists2, true, [&obj1B, &obj2C](RuntimeObject* obj1, RuntimeObject* obj2){
 			return obj1 == &obj1B && obj2 == &obj2C;
 		}) == true);
 		REQUIRE(list1.size() == 2); //obj1B should have been filtered out.
 		REQUIRE(list2.size() == 3); //but not obj2C
 
-		REQUIRE( TwoObjectListsTest(map1, map2, false, [&obj1A, &obj2C](RuntimeObject* obj1, RuntimeObject* obj2){
+		REQUIRE( TwoObjectListsTest(lists1, lists2, false, [&obj1A, &obj2C](RuntimeObject* obj1, RuntimeObject* obj2){
 			return obj1 == &obj1A && obj2 == &obj2C;
 		}) == true);
 		REQUIRE(list1.size() == 1); //All objects but obj1A and obj2C
@@ -94,10 +216,68 @@ TEST_CASE( "ObjectsListsTools", "[game-engine]" ) {
 		REQUIRE(list1[0] == &obj1A);
 		REQUIRE(list2[0] == &obj2C);
 	}
+	SECTION("TwoObjectListsTestWithBroadphase") {
+		//Spread objects on a grid, some of them overlapping, and check that the results
+		//are the same as when testing all the pairs.
+		std::vector<std::shared_ptr<RuntimeObject>> objects;
+		std::vector<RuntimeObject*> list1, list2, expectedList1, expectedList2;
+		std::srand(42);
+		for (std::size_t i = 0;i<400;++i)
+		{
+			objects.push_back(std::make_shared<SizedRuntimeObject>(scene, i % 2 ? obj1 : obj2, 4 + std::rand() % 40));
+			objects.back()->SetX(std::rand() % 1000);
+			objects.back()->SetY(std::rand() % 1000);
+			(i % 2 ? list1 : list2).push_back(objects.back().get());
+		}
+
+		for (bool inverted : {false, true})
+		{
+			expectedList1 = list1;
+			expectedList2 = list2;
+			std::vector<ObjectsListsView::value_type> expectedLists1 = {{nameId1, &expectedList1}};
+			std::vector<ObjectsListsView::value_type> expectedLists2 = {{nameId2, &expectedList2}};
+			bool expectedResult = TwoObjectListsTest(expectedLists1, expectedLists2, inverted, [](RuntimeObject * obj1, RuntimeObject * obj2) {
+				return obj1->IsCollidingWith(obj2);
+			});
+
+			std::vector<RuntimeObject*> pickedList1 = list1;
+			std::vector<RuntimeObject*> pickedList2 = list2;
+			std::vector<ObjectsListsView::value_type> lists1 = {{nameId1, &pickedList1}};
+			std::vector<ObjectsListsView::value_type> lists2 = {{nameId2, &pickedList2}};
+			REQUIRE(HitBoxesCollision(lists1, lists2, inverted) == expectedResult);
+			REQUIRE(pickedList1 == expectedList1);
+			REQUIRE(pickedList2 == expectedList2);
+			REQUIRE(pickedList1.size() != 0);
+			REQUIRE(pickedList1.size() != list1.size());
+		}
+
+		std::vector<RuntimeObject*> pickedList1 = list1;
+		std::vector<RuntimeObject*> pickedList2 = list2;
+		std::vector<ObjectsListsView::value_type> lists1 = {{nameId1, &pickedList1}};
+		std::vector<ObjectsListsView::value_type> lists2 = {{nameId2, &pickedList2}};
+		expectedList1 = list1;
+		expectedList2 = list2;
+		std::vector<ObjectsListsView::value_type> expectedLists1 = {{nameId1, &expectedList1}};
+		std::vector<ObjectsListsView::value_type> expectedLists2 = {{nameId2, &expectedList2}};
+		REQUIRE(DistanceBetweenObjects(lists1, lists2, 30, false) == TwoObjectListsTest(expectedLists1, expectedLists2, false, [](RuntimeObject * obj1, RuntimeObject * obj2) {
+			float X = obj1->GetDrawableX()+obj1->GetCenterX() - (obj2->GetDrawableX()+obj2->GetCenterX());
+			float Y = obj1->GetDrawableY()+obj1->GetCenterY() - (obj2->GetDrawableY()+obj2->GetCenterY());
+			return (X*X+Y*Y) <= 30*30;
+		}));
+		REQUIRE(pickedList1 == expectedList1);
+		REQUIRE(pickedList2 == expectedList2);
+
+		//The buffers of the broadphase are reused by the next tests.
+		pickedList1 = list1;
+		pickedList2 = list2;
+		BenchmarkTools::AllocationsCounter allocationsCounter;
+		DistanceBetweenObjects(lists1, lists2, 30, false);
+		REQUIRE(allocationsCounter.Get() == 0);
+		REQUIRE(pickedList1 == expectedList1);
+	}
 	SECTION("PickNearestObject") {
-		std::map <gd::String, std::vector<RuntimeObject*> *> map;
 		std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-		map["1"] = &list1;
+		std::vector<ObjectsListsView::value_type> lists = {{nameId1, &list1}};
 		obj1A.SetX(50);
 		obj1A.SetY(50);
 		obj1B.SetX(160);
@@ -105,19 +285,141 @@ TEST_CASE( "ObjectsListsTools", "[game-engine]" ) {
 		obj1C.SetX(100);
 		obj1C.SetY(300);
 
-		REQUIRE(PickNearestObject(map, 100, 90, false) == true);
+		REQUIRE(PickNearestObject(lists, 100, 90, false) == true);
 		REQUIRE(list1.size() == 1);
 		REQUIRE(list1[0] == &obj1A);
 
 		SECTION("Furthest") {
-			std::map <gd::String, std::vector<RuntimeObject*> *> map;
 			std::vector<RuntimeObject*> list1 = {&obj1A, &obj1B, &obj1C};
-			map["1"] = &list1;
+			std::vector<ObjectsListsView::value_type> lists = {{nameId1, &list1}};
 
 
-			REQUIRE(PickNearestObject(map, 100, 90, true) == true);
+			REQUIRE(PickNearestObject(lists, 100, 90, true) == true);
 			REQUIRE(list1.size() == 1);
 			REQUIRE(list1[0] == &obj1C);
 		}
 	}
 }
+
+TEST_CASE( "HitBoxesCollision benchmark", "[.][benchmark]" ) {
+	gd::Object obj1("1");
+	gd::Object obj2("2");
+	RuntimeGame game;
+	RuntimeScene scene(NULL, &game);
+	ObjectNameId nameId1 = RuntimeNamesTable::Get()->GetObjectNameId("1");
+	ObjectNameId nameId2 = RuntimeNamesTable::Get()->GetObjectNameId("2");
+
+	for (std::size_t objectsCount : {1000, 10000})
+	{
+		//Half of the objects are "enemies", the other half "bullets", all moving in a scene
+		//big enough to have a constant density of objects.
+		std::vector<std::shared_ptr<RuntimeObject>> objects;
+		float sceneSize = std::sqrt(static_cast<float>(objectsCount))*100;
+		std::srand(42);
+		for (std::size_t i = 0;i<objectsCount;++i)
+		{
+			objects.push_back(std::make_shared<SizedRuntimeObject>(scene, i % 2 ? obj1 : obj2, 32));
+			objects.back()->SetX(std::rand() % static_cast<int>(sceneSize));
+			objects.back()->SetY(std::rand() % static_cast<int>(sceneSize));
+		}
+
+		const std::size_t framesCount = 10;
+		for (bool useBroadphase : {true, false})
+		{
+			if (!useBroadphase && objectsCount > 1000) continue; //Testing all pairs would be too long.
+
+			BenchmarkTools::Measure measure;
+			for (std::size_t frame = 0;frame<framesCount;++frame)
+			{
+				std::vector<RuntimeObject*> list1, list2;
+				for (std::size_t i = 0;i<objects.size();++i)
+				{
+					objects[i]->SetX(objects[i]->GetX() + (i % 2 ? 3 : -3));
+					(i % 2 ? list1 : list2).push_back(objects[i].get());
+				}
+				std::vector<ObjectsListsView::value_type> lists1 = {{nameId1, &list1}};
+				std::vector<ObjectsListsView::value_type> lists2 = {{nameId2, &list2}};
+
+				if (useBroadphase)
+					HitBoxesCollision(lists1, lists2, false);
+				else
+					TwoObjectListsTest(lists1, lists2, false, [](RuntimeObject * obj1, RuntimeObject * obj2) {
+						return obj1->IsCollidingWith(obj2);
+					});
+			}
+
+			measure.Stop(std::string(useBroadphase ? "HitBoxesCollision" : "Testing all pairs") + " with " +
+				gd::String::From(objectsCount).ToUTF8() + " moving objects", framesCount);
+		}
+	}
+}
+
+TEST_CASE( "Conditions benchmark", "[.][benchmark]" ) {
+	gd::Object obj1("1");
+	gd::Object obj2("2");
+	RuntimeGame game;
+	RuntimeScene scene(NULL, &game);
+	ObjectNameId nameId1 = RuntimeNamesTable::Get()->GetObjectNameId("1");
+	ObjectNameId nameId2 = RuntimeNamesTable::Get()->GetObjectNameId("2");
+
+	//A scene with 500 events, each one copying the lists of objects of the scene (as
+	//generated code does) and then testing a condition on them.
+	const std::size_t eventsCount = 500;
+	const std::size_t framesCount = 100;
+	std::vector<std::shared_ptr<RuntimeObject>> objects;
+	std::vector<RuntimeObject*> sceneList1, sceneList2;
+	std::srand(42);
+	for (std::size_t i = 0;i<40;++i)
+	{
+		objects.push_back(std::make_shared<RuntimeObject>(scene, i % 2 ? obj1 : obj2));
+		objects.back()->SetX(std::rand() % 1000);
+		(i % 2 ? sceneList1 : sceneList2).push_back(objects.back().get());
+	}
+
+	std::vector<RuntimeObject*> list1, list2;
+	list1.reserve(sceneList1.size());
+	list2.reserve(sceneList2.size());
+	auto isOnTheLeft = [](RuntimeObject * obj) { return obj->GetX() < 500; };
+	auto isOnTheLeftOf = [](RuntimeObject * obj1, RuntimeObject * obj2) { return obj1->GetX() < obj2->GetX(); };
+
+	for (bool useBooleansLists : {true, false})
+	{
+		std::size_t pickedCount = 0;
+		BenchmarkTools::Measure measure;
+		for (std::size_t frame = 0;frame<framesCount;++frame)
+		{
+			for (std::size_t event = 0;event<eventsCount;++event)
+			{
+				list1 = sceneList1;
+				list2 = sceneList2;
+				if (event % 2 == 0)
+				{
+					if (useBooleansLists)
+						PickObjectsIfWithBooleansLists(ObjectsListsView({{nameId1, &list1}, {nameId2, &list2}}), isOnTheLeft);
+					else
+						PickObjectsIf(ObjectsListsView({{nameId1, &list1}, {nameId2, &list2}}), false, isOnTheLeft);
+				}
+				else
+					TwoObjectListsTest(ObjectsListsView({{nameId1, &list1}}), ObjectsListsView({{nameId2, &list2}}), false, isOnTheLeftOf);
+
+				pickedCount += list1.size() + list2.size();
+			}
+		}
+
+		measure.Stop(std::string(useBooleansLists ? "Picking with lists of booleans" : "Picking with PickedObjectsFlags") + " in a frame of " +
+			gd::String::From(eventsCount).ToUTF8() + " events", framesCount);
+		REQUIRE(pickedCount != 0);
+	}
+
+	//Once the buffers are large enough, a frame does not allocate memory.
+	BenchmarkTools::AllocationsCounter allocationsCounter;
+	for (std::size_t event = 0;event<eventsCount;++event)
+	{
+		list1 = sceneList1;
+		list2 = sceneList2;
+		PickObjectsIf(ObjectsListsView({{nameId1, &list1}, {nameId2, &list2}}), false, isOnTheLeft);
+		TwoObjectListsTest(ObjectsListsView({{nameId1, &list1}}), ObjectsListsView({{nameId2, &list2}}), false, isOnTheLeftOf);
+	}
+
+	REQUIRE(allocationsCounter.Get() == 0);
+}
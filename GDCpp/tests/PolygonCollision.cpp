@@ -0,0 +1,209 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering collisions between polygons.
+ */
+#include "catch.hpp"
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "GDCpp/Runtime/PolygonCollision.h"
+#include "BenchmarkTools.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+
+float RandomFloat(float min, float max)
+{
+	return min + (max - min) * (std::rand() % 100000) / 100000.0f;
+}
+
+/**
+ * \brief Create a random convex polygon, with its vertices on a circle.
+ */
+Polygon2d CreateRandomPolygon()
+{
+	std::size_t verticesCount = 3 + std::rand() % 6;
+	float centerX = RandomFloat(-100, 100);
+	float centerY = RandomFloat(-100, 100);
+	float radius = RandomFloat(1, 50);
+	float startAngle = RandomFloat(0, 6.28f);
+
+	Polygon2d polygon;
+	for (std::size_t i = 0;i<verticesCount;++i)
+	{
+		float angle = startAngle + i * 6.2831853f / verticesCount;
+		polygon.vertices.push_back(sf::Vector2f(centerX + radius * std::cos(angle), centerY + radius * std::sin(angle)));
+	}
+
+	return polygon;
+}
+
+bool AreIdentical(const CollisionResult & result1, const CollisionResult & result2)
+{
+	return result1.collision == result2.collision &&
+		std::memcmp(&result1.move_axis.x, &result2.move_axis.x, sizeof(float)) == 0 &&
+		std::memcmp(&result1.move_axis.y, &result2.move_axis.y, sizeof(float)) == 0;
+}
+
+}
+
+TEST_CASE( "PolygonCollision", "[game-engine]" ) {
+	SECTION("Rectangles") {
+		Polygon2d rect1 = Polygon2d::CreateRectangle(10, 10);
+		Polygon2d rect2 = Polygon2d::CreateRectangle(10, 10);
+		rect2.Move(8, 0);
+		Polygon2d rect3 = Polygon2d::CreateRectangle(10, 10);
+		rect3.Move(20, 0);
+
+		REQUIRE(PolygonCollisionTest(rect1, rect2).collision == true);
+		REQUIRE(PolygonCollisionTest(rect1, rect3).collision == false);
+		REQUIRE(PolygonCollisionTest(CollisionPolygon(rect1), CollisionPolygon(rect2)).collision == true);
+		REQUIRE(PolygonCollisionTest(CollisionPolygon(rect1), CollisionPolygon(rect3)).collision == false);
+
+		CollisionResult result = PolygonCollisionTest(CollisionPolygon(rect1), CollisionPolygon(rect2));
+		REQUIRE(result.move_axis.x == -2);
+		REQUIRE(result.move_axis.y == 0);
+	}
+	SECTION("Degenerated polygons") {
+		Polygon2d segment;
+		segment.vertices.push_back(sf::Vector2f(0, 0));
+		segment.vertices.push_back(sf::Vector2f(10, 10));
+
+		REQUIRE(PolygonCollisionTest(CollisionPolygon(segment), CollisionPolygon(Polygon2d::CreateRectangle(10, 10))).collision == false);
+		REQUIRE(PolygonCollisionTest(CollisionPolygon(), CollisionPolygon()).collision == false);
+	}
+	SECTION("Results are identical to the Polygon2d implementation") {
+		std::srand(42);
+		for (std::size_t i = 0;i<10000;++i)
+		{
+			Polygon2d polygon1 = CreateRandomPolygon();
+			Polygon2d polygon2 = CreateRandomPolygon();
+
+			CollisionResult expected = PolygonCollisionTest(polygon1, polygon2);
+			CollisionResult result = PolygonCollisionTest(CollisionPolygon(polygon1), CollisionPolygon(polygon2));
+			REQUIRE(AreIdentical(result, expected));
+		}
+	}
+	SECTION("Batched tests") {
+		std::srand(42);
+		CollisionPolygon polygon(CreateRandomPolygon());
+		std::vector<CollisionPolygon> polygons;
+		for (std::size_t i = 0;i<1000;++i)
+			polygons.push_back(CollisionPolygon(CreateRandomPolygon()));
+
+		std::vector<CollisionResult> results;
+		bool atLeastOneCollision = false;
+		for (std::size_t i = 0;i<polygons.size();++i)
+			atLeastOneCollision = atLeastOneCollision || PolygonCollisionTest(polygon, polygons[i]).collision;
+
+		REQUIRE(PolygonCollisionTest(polygon, polygons, results) == atLeastOneCollision);
+		REQUIRE(results.size() == polygons.size());
+		for (std::size_t i = 0;i<polygons.size();++i)
+			REQUIRE(AreIdentical(results[i], PolygonCollisionTest(polygon, polygons[i])));
+
+		//Once the buffers are large enough, batched tests don't allocate memory.
+		{
+			BenchmarkTools::AllocationsCounter allocationsCounter;
+			PolygonCollisionTest(polygon, polygons, results);
+			REQUIRE(allocationsCounter.Get() == 0);
+		}
+
+		//Reusing a collision polygon gives the same results.
+		polygon.Set(Polygon2d::CreateRectangle(4, 4));
+		REQUIRE(AreIdentical(PolygonCollisionTest(polygon, polygons[0]),
+			PolygonCollisionTest(CollisionPolygon(Polygon2d::CreateRectangle(4, 4)), polygons[0])));
+	}
+	SECTION("Sweep tests") {
+		Polygon2d rect1 = Polygon2d::CreateRectangle(10, 10);
+		Polygon2d rect2 = Polygon2d::CreateRectangle(10, 10);
+		rect2.Move(30, 0);
+		rect1.ComputeEdges();
+		rect2.ComputeEdges();
+
+		SweepResult result = PolygonSweepTest(rect1, sf::Vector2f(1, 0), rect2);
+		REQUIRE(result.collision == true);
+		REQUIRE(result.minDistance == 20);
+		REQUIRE(result.maxDistance == 40);
+
+		result = PolygonSweepTest(rect1, sf::Vector2f(-1, 0), rect2, 1);
+		REQUIRE(result.collision == true);
+		REQUIRE(result.minDistance == -39);
+		REQUIRE(result.maxDistance == -21);
+
+		REQUIRE(PolygonSweepTest(rect1, sf::Vector2f(0, 1), rect2).collision == false);
+	}
+	SECTION("Sweep tests are consistent with collision tests") {
+		std::srand(42);
+		for (std::size_t i = 0;i<2000;++i)
+		{
+			Polygon2d polygon1 = CreateRandomPolygon();
+			Polygon2d polygon2 = CreateRandomPolygon();
+			polygon1.ComputeEdges();
+			polygon2.ComputeEdges();
+			float angle = RandomFloat(0, 6.28f);
+			sf::Vector2f direction(std::cos(angle), std::sin(angle));
+
+			//With a margin, the polygons are surely overlapping between the distances found.
+			//Without margin, they are surely not overlapping far from these distances.
+			SweepResult result = PolygonSweepTest(polygon1, direction, polygon2, 0.5f);
+			SweepResult resultWithoutMargin = PolygonSweepTest(polygon1, direction, polygon2);
+			for (std::size_t j = 0;j<10;++j)
+			{
+				float distance = RandomFloat(-300, 300);
+				Polygon2d moved = polygon1;
+				moved.Move(distance*direction.x, distance*direction.y);
+
+				if (result.collision && distance > result.minDistance && distance < result.maxDistance)
+					REQUIRE(PolygonCollisionTest(moved, polygon2).collision == true);
+				if (!resultWithoutMargin.collision ||
+					distance < resultWithoutMargin.minDistance - 0.1f || distance > resultWithoutMargin.maxDistance + 0.1f)
+					REQUIRE(PolygonCollisionTest(moved, polygon2).collision == false);
+			}
+		}
+	}
+}
+
+TEST_CASE( "PolygonCollision benchmark", "[.][benchmark]" ) {
+	std::srand(42);
+	const std::size_t polygonsCount = 1000;
+	std::vector<Polygon2d> polygons;
+	std::vector<CollisionPolygon> collisionPolygons;
+	for (std::size_t i = 0;i<polygonsCount;++i)
+	{
+		polygons.push_back(i % 2 ? CreateRandomPolygon() : Polygon2d::CreateRectangle(RandomFloat(1, 50), RandomFloat(1, 50)));
+		collisionPolygons.push_back(CollisionPolygon(polygons.back()));
+	}
+
+	std::size_t collisions = 0;
+	{
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<polygonsCount;++i)
+			for (std::size_t j = 0;j<polygonsCount;++j)
+				if (PolygonCollisionTest(polygons[i], polygons[j]).collision) collisions++;
+
+		measure.Stop("Polygon2d tests", polygonsCount*polygonsCount);
+	}
+	{
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<polygonsCount;++i)
+			for (std::size_t j = 0;j<polygonsCount;++j)
+				if (PolygonCollisionTest(collisionPolygons[i], collisionPolygons[j]).collision) collisions--;
+
+		measure.Stop("CollisionPolygon tests", polygonsCount*polygonsCount);
+	}
+	{
+		std::vector<CollisionResult> results;
+		BenchmarkTools::Measure measure;
+		for (std::size_t i = 0;i<polygonsCount;++i)
+			PolygonCollisionTest(collisionPolygons[i], collisionPolygons, results);
+
+		measure.Stop("CollisionPolygon batched tests", polygonsCount*polygonsCount);
+	}
+
+	REQUIRE(collisions == 0);
+}
@@ -0,0 +1,104 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the images loaded in background by ResourcesPreloader.
+ */
+#include "catch.hpp"
+#include "GDCpp/Runtime/ResourcesPreloader.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+#include <cstdio>
+#include <SFML/Graphics/Image.hpp>
+
+namespace
+{
+
+/**
+ * \brief Save an image of the given size, and add it to the resources of the game.
+ */
+void AddImage(RuntimeGame & game, const gd::String & name, unsigned int width, unsigned int height)
+{
+	gd::String file = "ResourcesPreloaderTest" + name + ".png";
+	sf::Image image;
+	image.create(width, height, sf::Color::Red);
+	image.saveToFile(file.ToLocale());
+
+	gd::ImageResource resource;
+	resource.SetName(name);
+	resource.SetFile(file);
+	game.GetResourcesManager().AddResource(resource);
+}
+
+}
+
+TEST_CASE( "ResourcesPreloader", "[game-engine][resources]" ) {
+	RuntimeGame game;
+	AddImage(game, "a", 16, 8);
+	AddImage(game, "b", 32, 4);
+	std::vector<gd::String> images = {"a", "b", "not existing"};
+
+	SECTION("Finish") {
+		ResourcesPreloader preloader;
+		preloader.Preload(images, game);
+		REQUIRE(preloader.GetPendingImagesCount() == 2);
+		REQUIRE(!game.GetImageManager()->HasLoadedSFMLTexture("a"));
+
+		//Images being loaded are not queued again.
+		preloader.Preload(images, game);
+		REQUIRE(preloader.GetPendingImagesCount() == 2);
+
+		preloader.Finish(game);
+		REQUIRE(preloader.GetPendingImagesCount() == 0);
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("a"));
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("b"));
+		REQUIRE(game.GetImageManager()->GetSFMLTexture("a")->texture.getSize() == sf::Vector2u(16, 8));
+		REQUIRE(game.GetImageManager()->GetSFMLTexture("b")->texture.getSize() == sf::Vector2u(32, 4));
+		REQUIRE(!game.GetImageManager()->HasLoadedSFMLTexture("not existing"));
+
+		//Images already loaded are not loaded again.
+		preloader.Preload(images, game);
+		REQUIRE(preloader.GetPendingImagesCount() == 0);
+	}
+	SECTION("Update") {
+		ResourcesPreloader preloader;
+		preloader.Preload(images, game);
+
+		//Textures are created as the images are decoded by the worker threads.
+		for (std::size_t i = 0;i<10000 && preloader.GetPendingImagesCount() != 0;++i)
+			preloader.Update(game, sf::milliseconds(4));
+
+		REQUIRE(preloader.GetPendingImagesCount() == 0);
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("a"));
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("b"));
+	}
+	SECTION("Textures are kept until they are released") {
+		game.GetImageManager()->SetMemoryBudget(1);
+
+		ResourcesPreloader preloader;
+		preloader.Preload(images, game);
+		preloader.Finish(game);
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("a"));
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("b"));
+
+		//Once released, the textures not used anymore can be unloaded.
+		preloader.ReleaseTextures();
+		game.GetImageManager()->SetSFMLTextureAsLoaded("c", std::make_shared<SFMLTextureWrapper>());
+		REQUIRE(!game.GetImageManager()->HasLoadedSFMLTexture("a"));
+		REQUIRE(!game.GetImageManager()->HasLoadedSFMLTexture("b"));
+	}
+	SECTION("Destroyed while loading") {
+		{
+			ResourcesPreloader preloader;
+			preloader.Preload(images, game);
+		}
+		REQUIRE(!game.GetImageManager()->HasLoadedSFMLTexture("a"));
+	}
+
+	std::vector<gd::String> resources = game.GetResourcesManager().GetAllResourcesList();
+	for (std::size_t i = 0;i<resources.size();++i)
+		std::remove(game.GetResourcesManager().GetResource(resources[i]).GetFile().ToLocale().c_str());
+}
@@ -0,0 +1,65 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeNamesTable class.
+ */
+#include "catch.hpp"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/ObjInstancesHolder.h"
+
+TEST_CASE( "RuntimeNamesTable", "[common]" ) {
+	SECTION("Names and identifiers") {
+		RuntimeNamesTable * table = RuntimeNamesTable::Get();
+
+		ObjectNameId id1 = table->GetObjectNameId("NamesTableObject1");
+		ObjectNameId id2 = table->GetObjectNameId("NamesTableObject2");
+		REQUIRE(id1 != id2);
+		REQUIRE(table->GetObjectNameId("NamesTableObject1") == id1);
+		REQUIRE(table->GetObjectName(id1) == "NamesTableObject1");
+		REQUIRE(table->GetObjectName(id2) == "NamesTableObject2");
+
+		//Objects, layers and behaviors names are independent.
+		LayerId layerId = table->GetLayerId("NamesTableObject1");
+		REQUIRE(table->GetLayerName(layerId) == "NamesTableObject1");
+		BehaviorNameId behaviorId = table->GetBehaviorNameId("NamesTableBehavior");
+		REQUIRE(table->GetBehaviorName(behaviorId) == "NamesTableBehavior");
+
+		REQUIRE(table->GetObjectName(static_cast<ObjectNameId>(-1)) == "");
+	}
+	SECTION("Objects identifiers") {
+		gd::Object obj1("NamesTableObject1");
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::shared_ptr<RuntimeObject> obj1A(new RuntimeObject(scene, obj1));
+		ObjectNameId id1 = RuntimeNamesTable::Get()->GetObjectNameId("NamesTableObject1");
+		REQUIRE(obj1A->GetNameId() == id1);
+
+		obj1A->SetLayer("NamesTableLayer");
+		REQUIRE(obj1A->GetLayerId() == RuntimeNamesTable::Get()->GetLayerId("NamesTableLayer"));
+		REQUIRE(obj1A->IsOnLayer(RuntimeNamesTable::Get()->GetLayerId("NamesTableLayer")));
+		REQUIRE(obj1A->IsOnLayer(RuntimeNamesTable::Get()->GetLayerId("")) == false);
+
+		obj1A->SetLayer(RuntimeNamesTable::Get()->GetLayerId(""));
+		REQUIRE(obj1A->GetLayer() == "");
+
+		ObjInstancesHolder container;
+		container.AddObject(obj1A);
+		REQUIRE(container.GetObjects(id1).size() == 1);
+		REQUIRE(container.GetObjectsRawPointers(id1)[0] == obj1A.get());
+		REQUIRE(&container.GetObjects(id1) == &container.GetObjects("NamesTableObject1"));
+
+		obj1A->DeleteFromScene(scene); //obj1A is not in the scene: only its name is changed.
+		REQUIRE(obj1A->GetNameId() == RuntimeNamesTable::Get()->GetObjectNameId(""));
+		container.ObjectNameHasChanged(obj1A.get());
+		REQUIRE(container.GetObjects(id1).size() == 0);
+		REQUIRE(container.GetObjects("").size() == 1);
+	}
+}
@@ -18,6 +18,8 @@
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/RuntimeObjectsListsTools.h"
 #include "GDCpp/Runtime/RuntimeSpriteObject.h"
+#include "GDCpp/Runtime/Polygon2d.h"
+#include "BenchmarkTools.h"
 
 TEST_CASE( "RuntimeSpriteObject", "[game-engine]" ) {
 	RuntimeGame game;
@@ -86,4 +88,62 @@ TEST_CASE( "RuntimeSpriteObject", "[game-engine]" ) {
 			REQUIRE(object.GetCurrentAnimationName() == "First animation");
 		}
 	}
+	SECTION("Hitboxes") {
+		gd::SpriteObject obj2("SpriteObjectWithMask");
+		{
+			gd::Animation anim;
+			gd::Sprite sprite;
+			Polygon2d square = Polygon2d::CreateRectangle(10, 10);
+			square.Move(5, 5);
+			sprite.SetCustomCollisionMask(std::vector<Polygon2d>(1, square));
+			sprite.SetCollisionMaskAutomatic(false);
+			anim.SetDirectionsCount(1);
+			anim.GetDirection(0).AddSprite(sprite);
+			obj2.AddAnimation(anim);
+		}
+		RuntimeSpriteObject object2(scene, obj2);
+
+		const std::vector<Polygon2d> & hitBoxes = object2.GetHitBoxesWithEdges(sf::FloatRect());
+		REQUIRE(hitBoxes.size() == 1);
+		REQUIRE(hitBoxes[0].vertices.size() == 4);
+		REQUIRE(hitBoxes[0].edges.size() == 4);
+		sf::Vector2f firstVertex = hitBoxes[0].vertices[0];
+
+		//Hitboxes are cached...
+		REQUIRE(&object2.GetHitBoxesWithEdges(sf::FloatRect()) == &hitBoxes);
+		REQUIRE(object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0] == firstVertex);
+
+		//...and updated when the object is moved.
+		object2.SetX(100);
+		REQUIRE(object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0].x == firstVertex.x + 100);
+		REQUIRE(object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0].y == firstVertex.y);
+		REQUIRE(object2.GetHitBoxes()[0].vertices[0] == hitBoxes[0].vertices[0]);
+
+		object2.SetScaleX(2);
+		REQUIRE(object2.GetHitBoxesWithEdges(sf::FloatRect())[0].edges[0].x == 20);
+
+		//Updating the hitboxes does not copy the collision mask.
+		float scaledVertexX = object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0].x;
+		BenchmarkTools::AllocationsCounter allocationsCounter;
+		object2.SetX(200);
+		REQUIRE(object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0].x == scaledVertexX + 100);
+		REQUIRE(allocationsCounter.Get() == 0);
+
+		//Hitboxes prepared for collision tests are updated with the hitboxes.
+		const std::vector<CollisionPolygon> & collisionPolygons = object2.GetCollisionPolygons(sf::FloatRect());
+		REQUIRE(collisionPolygons.size() == 1);
+		REQUIRE(collisionPolygons[0].verticesCount == 4);
+		REQUIRE(collisionPolygons[0].verticesX[0] == object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0].x);
+		REQUIRE(&object2.GetCollisionPolygons(sf::FloatRect()) == &collisionPolygons);
+		object2.SetY(50);
+		REQUIRE(object2.GetCollisionPolygons(sf::FloatRect())[0].verticesY[0] == object2.GetHitBoxesWithEdges(sf::FloatRect())[0].vertices[0].y);
+
+		//Collisions between objects are tested with them.
+		RuntimeSpriteObject object3(scene, obj2);
+		object3.SetX(object2.GetX());
+		object3.SetY(object2.GetY());
+		REQUIRE(object2.IsCollidingWith(&object3) == true);
+		object3.SetY(object2.GetY() + 1000);
+		REQUIRE(object2.IsCollidingWith(&object3) == false);
+	}
 }
@@ -0,0 +1,87 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering RuntimeVariablesContainer and CachedVariableChild classes.
+ */
+#include "catch.hpp"
+#include "GDCore/Project/Variable.h"
+#include "GDCore/Project/VariablesContainer.h"
+#include "GDCpp/Runtime/RuntimeVariablesContainer.h"
+#include "GDCpp/Runtime/RuntimeNamesTable.h"
+#include "GDCpp/Runtime/CachedVariableChild.h"
+
+TEST_CASE( "RuntimeVariablesContainer", "[game-engine]" ) {
+	gd::VariablesContainer declaredVariables;
+	declaredVariables.Insert("Declared", gd::Variable(), 0).SetValue(42);
+	VariableNameId declaredNameId = RuntimeNamesTable::Get()->GetVariableNameId("Declared");
+	VariableNameId undeclaredNameId = RuntimeNamesTable::Get()->GetVariableNameId("Undeclared");
+
+	SECTION("Access with the identifier of the name") {
+		RuntimeVariablesContainer variables(declaredVariables);
+		REQUIRE(&variables.GetByNameId(declaredNameId) == &variables.Get(0));
+		REQUIRE(variables.GetByNameId(declaredNameId).GetValue() == 42);
+
+		REQUIRE(!variables.Has("Undeclared"));
+		variables.GetByNameId(undeclaredNameId).SetValue(3);
+		REQUIRE(variables.Has("Undeclared"));
+		REQUIRE(&variables.GetByNameId(undeclaredNameId) == &variables.Get("Undeclared"));
+		REQUIRE(variables.Get("Undeclared").GetValue() == 3);
+
+		REQUIRE(&RuntimeVariablesContainer::GetBadVariablesContainer().GetByNameId(declaredNameId) ==
+			&RuntimeVariablesContainer::GetBadVariable());
+	}
+	SECTION("Copies") {
+		RuntimeVariablesContainer variables(declaredVariables);
+		variables.Get("Undeclared").GetChild("Child").SetString("Hello");
+
+		RuntimeVariablesContainer copy = variables;
+		copy.Get(0).SetValue(1);
+		copy.GetByNameId(undeclaredNameId).GetChild("Child").SetString("World");
+		REQUIRE(variables.Get(0).GetValue() == 42);
+		REQUIRE(variables.Get("Undeclared").GetChild("Child").GetString() == "Hello");
+		REQUIRE(copy.Get("Declared").GetValue() == 1);
+		REQUIRE(copy.Get("Undeclared").GetChild("Child").GetString() == "World");
+
+		copy = variables;
+		REQUIRE(copy.GetByNameId(undeclaredNameId).GetChild("Child").GetString() == "Hello");
+	}
+}
+
+TEST_CASE( "CachedVariableChild", "[game-engine]" ) {
+	gd::Variable variable;
+	gd::Variable otherVariable;
+	CachedVariableChild cachedChild("Child");
+
+	cachedChild.Get(variable).SetValue(1);
+	cachedChild.Get(otherVariable).SetValue(2);
+	REQUIRE(&cachedChild.Get(variable) == &variable.GetChild("Child"));
+	REQUIRE(cachedChild.Get(variable).GetValue() == 1);
+	REQUIRE(cachedChild.Get(otherVariable).GetValue() == 2);
+
+	//The child is found again when the structure is changed.
+	variable.RemoveChild("Child");
+	REQUIRE(cachedChild.Get(variable).GetValue() == 0);
+	REQUIRE(&cachedChild.Get(variable) == &variable.GetChild("Child"));
+
+	variable = otherVariable;
+	REQUIRE(cachedChild.Get(variable).GetValue() == 2);
+	cachedChild.Get(variable).SetValue(3);
+	REQUIRE(otherVariable.GetChild("Child").GetValue() == 2);
+
+	//Destroying structures whose children were not returned does not change the structure version.
+	std::size_t structureVersion = gd::Variable::GetStructureVersion();
+	{
+		gd::Variable copy(otherVariable);
+		REQUIRE(copy.GetAllChildren().size() == 1);
+	}
+	REQUIRE(gd::Variable::GetStructureVersion() == structureVersion);
+
+	{
+		gd::Variable copy(otherVariable);
+		copy.GetChild("Child").SetValue(4);
+	}
+	REQUIRE(gd::Variable::GetStructureVersion() != structureVersion);
+}
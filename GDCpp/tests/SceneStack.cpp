@@ -15,6 +15,12 @@
 #include "GDCpp/Runtime/RuntimeGame.h"
 #include "GDCpp/Runtime/RuntimeObject.h"
 #include "GDCpp/Runtime/SceneStack.h"
+#include "GDCpp/Runtime/ImageManager.h"
+#include "GDCpp/Runtime/Project/ResourcesManager.h"
+#include "GDCpp/Extensions/Builtin/RuntimeSceneTools.h"
+#include <cstdio>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/Sleep.hpp>
 
 TEST_CASE( "SceneStack", "[game-engine]" ) {
 	RuntimeGame game;
@@ -61,4 +67,28 @@ TEST_CASE( "SceneStack", "[game-engine]" ) {
 		});
 		stack.Replace("Scene 1", true);
 	}
+
+	SECTION("Preload a scene") {
+		sf::Image image;
+		image.create(8, 8, sf::Color::Red);
+		image.saveToFile("SceneStackTestImage.png");
+		gd::ImageResource resource;
+		resource.SetName("Image");
+		resource.SetFile("SceneStackTestImage.png");
+		game.GetResourcesManager().AddResource(resource);
+		game.GetLayout("Scene 2").SetResourcesManifest({"Image"});
+
+		//The image is loaded in background while the scene is played.
+		auto scene = stack.Push("Scene 1");
+		PrefetchScene(*scene, "Scene 2");
+		for (std::size_t i = 0;i<1000 && !game.GetImageManager()->HasLoadedSFMLTexture("Image");++i)
+		{
+			REQUIRE(stack.Step() == true);
+			sf::sleep(sf::milliseconds(1));
+		}
+		REQUIRE(game.GetImageManager()->HasLoadedSFMLTexture("Image"));
+		REQUIRE(scene->GetRequestedPrefetches().empty());
+
+		std::remove("SceneStackTestImage.png");
+	}
 }
@@ -0,0 +1,179 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2016 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering SpriteBatchRenderer class.
+ */
+#include "catch.hpp"
+#include "GDCore/Project/Layer.h"
+#include "GDCore/Project/Object.h"
+#include "GDCpp/Runtime/RuntimeGame.h"
+#include "GDCpp/Runtime/RuntimeLayer.h"
+#include "GDCpp/Runtime/RuntimeObject.h"
+#include "GDCpp/Runtime/RuntimeScene.h"
+#include "GDCpp/Runtime/SpriteBatchRenderer.h"
+#include "BenchmarkTools.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+
+RuntimeLayer CreateLayer(const gd::String & name)
+{
+	gd::Layer layer;
+	layer.SetName(name);
+	return RuntimeLayer(layer, sf::View());
+}
+
+bool IsSortedByZOrder(const std::vector<RuntimeObject*> & objects)
+{
+	return std::is_sorted(objects.begin(), objects.end(), [](const RuntimeObject * o1, const RuntimeObject * o2) {
+		return o1->GetZOrder() < o2->GetZOrder();
+	});
+}
+
+}
+
+TEST_CASE( "SpriteBatchRenderer", "[game-engine]" ) {
+	gd::Object obj("1");
+	RuntimeGame game;
+	RuntimeScene scene(NULL, &game);
+
+	std::vector<RuntimeLayer> layers = {CreateLayer(""), CreateLayer("Foreground")};
+	RuntimeObjList objects;
+	for (std::size_t i = 0;i<6;++i)
+	{
+		objects.push_back(std::make_shared<RuntimeObject>(scene, obj));
+		objects.back()->SetZOrder(10-i);
+		objects.back()->SetLayer(i % 2 ? "Foreground" : "");
+	}
+
+	SpriteBatchRenderer renderer;
+	SECTION("Objects are sorted by Z order in their layer") {
+		renderer.Update(objects, layers);
+		REQUIRE(renderer.GetLayerObjects(0).size() == 3);
+		REQUIRE(renderer.GetLayerObjects(1).size() == 3);
+		REQUIRE(renderer.GetLayerObjects(0)[0] == objects[4].get());
+		REQUIRE(renderer.GetLayerObjects(0)[2] == objects[0].get());
+		REQUIRE(renderer.GetLayerObjects(1)[0] == objects[5].get());
+		REQUIRE(renderer.GetLayerObjects(1)[2] == objects[1].get());
+	}
+	SECTION("Lists are updated when objects are changed") {
+		renderer.Update(objects, layers);
+
+		objects[0]->SetZOrder(0);
+		objects[2]->SetLayer("Foreground");
+		objects[3]->SetLayer("NotExisting");
+		objects.erase(objects.begin()+5);
+		objects.push_back(std::make_shared<RuntimeObject>(scene, obj));
+		objects.back()->SetZOrder(7);
+		renderer.Update(objects, layers);
+
+		const std::vector<RuntimeObject*> & layer0 = renderer.GetLayerObjects(0);
+		const std::vector<RuntimeObject*> & layer1 = renderer.GetLayerObjects(1);
+		REQUIRE(layer0.size() == 3);
+		REQUIRE(layer0[0] == objects[0].get());
+		REQUIRE(layer0[1] == objects[4].get());
+		REQUIRE(layer0[2] == objects[5].get());
+		REQUIRE(layer1.size() == 2);
+		REQUIRE(layer1[0] == objects[2].get());
+		REQUIRE(layer1[1] == objects[1].get());
+	}
+	SECTION("Objects having the same Z order are sorted by their position in the list of objects") {
+		for (std::size_t i = 0;i<objects.size();++i)
+			objects[i]->SetZOrder(0);
+		renderer.Update(objects, layers);
+		std::vector<RuntimeObject*> layer0 = {objects[0].get(), objects[2].get(), objects[4].get()};
+		REQUIRE(renderer.GetLayerObjects(0) == layer0);
+
+		//The order does not depend on the previous frames.
+		objects[0]->SetZOrder(1);
+		objects[4]->SetLayer("Foreground");
+		renderer.Update(objects, layers);
+		objects[0]->SetZOrder(0);
+		objects[4]->SetLayer("");
+		renderer.Update(objects, layers);
+		REQUIRE(renderer.GetLayerObjects(0) == layer0);
+
+		std::reverse(objects.begin(), objects.end());
+		renderer.Update(objects, layers);
+		std::reverse(layer0.begin(), layer0.end());
+		REQUIRE(renderer.GetLayerObjects(0) == layer0);
+	}
+	SECTION("Many changes") {
+		std::srand(42);
+		for (std::size_t i = 0;i<1000;++i)
+		{
+			objects.push_back(std::make_shared<RuntimeObject>(scene, obj));
+			objects.back()->SetZOrder(std::rand() % 100);
+		}
+
+		for (std::size_t frame = 0;frame<10;++frame)
+		{
+			for (std::size_t i = 0;i<objects.size();++i)
+				if (std::rand() % 4 == 0) objects[i]->SetZOrder(std::rand() % 100);
+
+			renderer.Update(objects, layers);
+			REQUIRE(renderer.GetLayerObjects(0).size() == 1003);
+			REQUIRE(IsSortedByZOrder(renderer.GetLayerObjects(0)));
+			REQUIRE(IsSortedByZOrder(renderer.GetLayerObjects(1)));
+
+			//Same result as a stable sort of all the objects.
+			RuntimeObjList sortedObjects = objects;
+			std::stable_sort(sortedObjects.begin(), sortedObjects.end(), [](const RuntimeObjSPtr & o1, const RuntimeObjSPtr & o2) {
+				return o1->GetZOrder() < o2->GetZOrder();
+			});
+			std::vector<RuntimeObject*> expectedLayer0;
+			for (std::size_t i = 0;i<sortedObjects.size();++i)
+				if (sortedObjects[i]->GetLayer() == "") expectedLayer0.push_back(sortedObjects[i].get());
+			REQUIRE(renderer.GetLayerObjects(0) == expectedLayer0);
+		}
+	}
+}
+
+TEST_CASE( "SpriteBatchRenderer benchmark", "[.][benchmark]" ) {
+	gd::Object obj("1");
+	RuntimeGame game;
+	RuntimeScene scene(NULL, &game);
+	std::vector<RuntimeLayer> layers = {CreateLayer(""), CreateLayer("Background"), CreateLayer("Foreground")};
+
+	//Objects in 3 layers, a few of them changing their Z order at each frame.
+	const std::size_t objectsCount = 10000;
+	const std::size_t framesCount = 100;
+	RuntimeObjList objects;
+	std::srand(42);
+	for (std::size_t i = 0;i<objectsCount;++i)
+	{
+		objects.push_back(std::make_shared<RuntimeObject>(scene, obj));
+		objects.back()->SetZOrder(std::rand() % 1000);
+		objects.back()->SetLayer(i % 3 == 0 ? "" : (i % 3 == 1 ? "Background" : "Foreground"));
+	}
+
+	{
+		std::vector<RuntimeObject*> objectsToRender;
+		BenchmarkTools::Measure measure;
+		for (std::size_t frame = 0;frame<framesCount;++frame)
+		{
+			objects[frame]->SetZOrder(std::rand() % 1000);
+
+			objectsToRender.clear();
+			for (std::size_t i = 0;i<objects.size();++i)
+				objectsToRender.push_back(objects[i].get());
+			scene.OrderObjectsByZOrder(objectsToRender);
+		}
+		measure.Stop("Sorting all objects", framesCount);
+	}
+	{
+		SpriteBatchRenderer renderer;
+		BenchmarkTools::Measure measure;
+		for (std::size_t frame = 0;frame<framesCount;++frame)
+		{
+			objects[frame]->SetZOrder(std::rand() % 1000);
+			renderer.Update(objects, layers);
+		}
+		measure.Stop("Updating the layers of SpriteBatchRenderer", framesCount);
+	}
+}